@@ -51,6 +51,7 @@ if(UNIX AND NOT APPLE)
     endfunction()
 
 
+    installLib(${QT_INSTALL_LIBS} libQt5Concurrent.so.5)
     installLib(${QT_INSTALL_LIBS} libQt5Core.so.5)
     installLib(${QT_INSTALL_LIBS} libQt5DBus.so.5)
     installLib(${QT_INSTALL_LIBS} libQt5Gui.so.5)
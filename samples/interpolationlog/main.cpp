@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+//! \ingroup sampleinterpolationlog
+
+#include "blackmisc/simulation/interpolationbinarylog.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/swiftdirectories.h"
+
+#include <stdio.h>
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Simulation;
+
+//! main
+int main(int argc, char *argv[])
+{
+    QCoreApplication qa(argc, argv);
+    QTextStream out(stdout, QIODevice::WriteOnly);
+
+    const QStringList args = qa.arguments();
+    if (args.size() < 2)
+    {
+        out << "Usage: " << QFileInfo(args.first()).fileName() << " file.ipl [csv|html] [output file]" << Qt::endl;
+        out << "Converts a binary interpolation log (.drv logint bin) to CSV or HTML" << Qt::endl;
+        return 1;
+    }
+
+    const QString fileName = args.at(1);
+    const QString format = args.size() > 2 ? args.at(2).toLower() : QStringLiteral("csv");
+    if (format != "csv" && format != "html")
+    {
+        out << "Unknown format " << format << Qt::endl;
+        return 1;
+    }
+
+    QVector<CInterpolationBinaryLog::Record> records;
+    const CStatusMessage m = CInterpolationBinaryLog::readFile(fileName, records);
+    out << m.getMessage() << Qt::endl;
+    if (m.isFailure()) { return 1; }
+
+    QString output = args.size() > 3 ? args.at(3) : QString();
+    if (output.isEmpty())
+    {
+        const QFileInfo fi(fileName);
+        output = CFileUtils::appendFilePaths(fi.absolutePath(), fi.completeBaseName() + "." + format);
+    }
+
+    QString content;
+    if (format == "csv") { content = CInterpolationBinaryLog::toCsv(records); }
+    else
+    {
+        // same template as the HTML interpolation logs, if available
+        const QString htmlTemplate = CFileUtils::readFileToString(CSwiftDirectories::htmlTemplateFilePath());
+        const QString html = QStringLiteral("Entries: %1\n\n%2").arg(records.size()).arg(CInterpolationBinaryLog::toHtml(records));
+        content = htmlTemplate.contains("%1") ? htmlTemplate.arg(html) : QStringLiteral("<html><body>\n%1</body></html>\n").arg(html);
+    }
+
+    if (!CFileUtils::writeStringToFile(content, output))
+    {
+        out << "Cannot write " << output << Qt::endl;
+        return 1;
+    }
+    out << "Written " << records.size() << " records to " << output << Qt::endl;
+    return 0;
+}
@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#ifndef BLACKSAMPLE_INTERPOLATIONLOG_H
+#define BLACKSAMPLE_INTERPOLATIONLOG_H
+
+// just a dummy header, documentation will go here
+
+/*!
+ * \defgroup sampleinterpolationlog Sample Interpolation Log
+ * \ingroup samples
+ * \brief Converts a binary interpolation log (.drv logint bin) to CSV or HTML
+ */
+
+#endif
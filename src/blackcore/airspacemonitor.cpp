@@ -18,6 +18,7 @@
 #include "blackmisc/network/user.h"
 #include "blackmisc/network/voicecapabilities.h"
 #include "blackmisc/pq/units.h"
+#include "blackmisc/simulation/latencytrace.h"
 #include "blackmisc/test/testing.h"
 #include "blackmisc/mixin/mixincompare.h"
 #include "blackmisc/iterator.h"
@@ -1171,6 +1172,7 @@ namespace BlackCore
     {
         Q_ASSERT_X(CThreadUtils::isInThisThread(this), Q_FUNC_INFO, "Called in different thread");
         if (!this->isConnectedAndNotShuttingDown()) { return; }
+        const CLatencyTraceScope trace(CLatencyTrace::AirspaceMonitor, situation);
 
         const CCallsign callsign(situation.getCallsign());
         Q_ASSERT_X(!callsign.isEmpty(), Q_FUNC_INFO, "Empty callsign");
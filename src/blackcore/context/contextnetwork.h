@@ -176,6 +176,7 @@ namespace BlackCore::Context
         virtual BlackMisc::Aviation::CAtcStationList getClosestAtcStationsOnline(int number) const = 0;
 
         //! Aircraft list
+        //! \remark over DBus this and the other aircraft in range getters return a synchronized copy, up to 1s old
         virtual BlackMisc::Simulation::CSimulatedAircraftList getAircraftInRange() const = 0;
 
         //! Aircraft callsigns
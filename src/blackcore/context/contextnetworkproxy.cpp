@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
 
 #include "blackcore/context/contextnetworkproxy.h"
+#include "blackcore/corefacade.h"
+#include "blackmisc/simulation/aircraftinrangesync.h"
 #include "blackmisc/dbus.h"
 #include "blackmisc/dbusserver.h"
 #include "blackmisc/genericdbusinterface.h"
@@ -98,28 +100,40 @@ namespace BlackCore::Context
         return m_dBusInterface->callDBusRet<BlackMisc::Aviation::CAtcStationList>(QLatin1String("getClosestAtcStationsOnline"), number);
     }
 
+    const CAircraftInRangeReplica *CContextNetworkProxy::getSynchronizedReplica() const
+    {
+        const CAircraftInRangeReplica *replica = this->getRuntime() ? this->getRuntime()->getAircraftInRangeReplica() : nullptr;
+        return replica && replica->getRevision() >= 0 ? replica : nullptr;
+    }
+
     CSimulatedAircraftList CContextNetworkProxy::getAircraftInRange() const
     {
+        // synchronized replica avoids transferring the whole list
+        if (const CAircraftInRangeReplica *replica = this->getSynchronizedReplica()) { return replica->getAircraftInRange(); }
         return m_dBusInterface->callDBusRet<BlackMisc::Simulation::CSimulatedAircraftList>(QLatin1String("getAircraftInRange"));
     }
 
     CCallsignSet CContextNetworkProxy::getAircraftInRangeCallsigns() const
     {
+        if (const CAircraftInRangeReplica *replica = this->getSynchronizedReplica()) { return replica->getAircraftInRange().getCallsigns(); }
         return m_dBusInterface->callDBusRet<BlackMisc::Aviation::CCallsignSet>(QLatin1String("getAircraftInRangeCallsigns"));
     }
 
     int CContextNetworkProxy::getAircraftInRangeCount() const
     {
+        if (const CAircraftInRangeReplica *replica = this->getSynchronizedReplica()) { return replica->getAircraftInRange().size(); }
         return m_dBusInterface->callDBusRet<int>(QLatin1String("getAircraftInRangeCount"));
     }
 
     bool CContextNetworkProxy::isAircraftInRange(const CCallsign &callsign) const
     {
+        if (const CAircraftInRangeReplica *replica = this->getSynchronizedReplica()) { return replica->getAircraftInRange().containsCallsign(callsign); }
         return m_dBusInterface->callDBusRet<bool>(QLatin1String("isAircraftInRange"), callsign);
     }
 
     CSimulatedAircraft CContextNetworkProxy::getAircraftInRangeForCallsign(const CCallsign &callsign) const
     {
+        if (const CAircraftInRangeReplica *replica = this->getSynchronizedReplica()) { return replica->getAircraftInRange().findFirstByCallsign(callsign); }
         return m_dBusInterface->callDBusRet<BlackMisc::Simulation::CSimulatedAircraft>(QLatin1String("getAircraftInRangeForCallsign"), callsign);
     }
 
@@ -46,6 +46,7 @@ namespace BlackMisc
     namespace Simulation
     {
         class CAircraftModel;
+        class CAircraftInRangeReplica;
     }
 }
 
@@ -258,6 +259,10 @@ namespace BlackCore
             //! Relay connection signals to local signals.
             void relaySignals(const QString &serviceName, QDBusConnection &connection);
 
+            //! Aircraft in range replica, if synchronized
+            //! \remark all aircraft in range getters use it, so they return the same data, up to one publish interval (1s) old
+            const BlackMisc::Simulation::CAircraftInRangeReplica *getSynchronizedReplica() const;
+
         protected:
             //! Constructor
             CContextNetworkProxy(CCoreFacadeConfig::ContextMode mode, CCoreFacade *runtime) : IContextNetwork(mode, runtime), m_dBusInterface(nullptr) {}
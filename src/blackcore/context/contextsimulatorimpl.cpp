@@ -1109,7 +1109,9 @@ namespace BlackCore::Context
     {
         if (m_debugEnabled) { CLogMessage(this, CLogCategories::contextSlot()).debug() << Q_FUNC_INFO << callsign; }
         if (!m_simulatorPlugin.second) { return false; }
-        return m_simulatorPlugin.second->followAircraft(callsign);
+        const bool followed = m_simulatorPlugin.second->followAircraft(callsign);
+        if (followed) { m_simulatorPlugin.second->setFollowedAircraft(callsign); }
+        return followed;
     }
 
     void CContextSimulator::recalculateAllAircraft()
@@ -14,6 +14,7 @@
 #include "blackcore/context/contextsimulator.h"
 #include "blackmisc/sharedstate/datalinkdbus.h"
 #include "blackmisc/loghistory.h"
+#include "blackmisc/simulation/aircraftinrangesync.h"
 #include "blackcore/context/contextsimulatorimpl.h"
 #include "blackcore/data/launchersetup.h"
 #include "blackcore/corefacadeconfig.h"
@@ -37,6 +38,7 @@
 #include <QStringBuilder>
 #include <QString>
 #include <QElapsedTimer>
+#include <QTimer>
 #include <QtGlobal>
 
 using namespace BlackMisc;
@@ -128,6 +130,18 @@ namespace BlackCore
             m_logHistory->initialize(m_dataLinkDBus);
         }
 
+        // aircraft in range, synchronized by deltas, only needed when the network context is served over DBus
+        if (m_config.getModeNetwork() == CCoreFacadeConfig::LocalInDBusServer)
+        {
+            m_aircraftInRangeJournal = new CAircraftInRangeJournal(this);
+            m_aircraftInRangeJournal->initialize(m_dataLinkDBus);
+        }
+        else if (m_config.getModeNetwork() == CCoreFacadeConfig::Remote)
+        {
+            m_aircraftInRangeReplica = new CAircraftInRangeReplica(this);
+            m_aircraftInRangeReplica->initialize(m_dataLinkDBus);
+        }
+
         if (m_config.all(CCoreFacadeConfig::NotUsed))
         {
             m_initalized = true;
@@ -314,6 +328,18 @@ namespace BlackCore
             Q_ASSERT(c);
             times.insert("Post setup, connects audio", time.restart());
         }
+
+        // publish aircraft in range deltas, remote GUIs apply them instead of fetching the whole list
+        if (m_aircraftInRangeJournal && m_contextNetwork && m_contextNetwork->isUsingImplementingObject())
+        {
+            m_aircraftInRangeTimer = new QTimer(this);
+            m_aircraftInRangeTimer->setObjectName("CCoreFacade::m_aircraftInRangeTimer");
+            connect(m_aircraftInRangeTimer, &QTimer::timeout, this, [=] {
+                if (!m_aircraftInRangeJournal || !this->getCContextNetwork()) { return; }
+                m_aircraftInRangeJournal->publish(this->getCContextNetwork()->getAircraftInRange());
+            });
+            m_aircraftInRangeTimer->start(1000);
+        }
     }
 
     QString CCoreFacade::getDBusAddress() const
@@ -345,6 +371,12 @@ namespace BlackCore
         m_logHistory = nullptr;
         delete m_logHistorySource;
         m_logHistorySource = nullptr;
+        delete m_aircraftInRangeTimer;
+        m_aircraftInRangeTimer = nullptr;
+        delete m_aircraftInRangeJournal;
+        m_aircraftInRangeJournal = nullptr;
+        delete m_aircraftInRangeReplica;
+        m_aircraftInRangeReplica = nullptr;
         delete m_dataLinkDBus;
         m_dataLinkDBus = nullptr;
 
@@ -18,6 +18,8 @@
 #include <QObject>
 #include <QString>
 
+class QTimer;
+
 namespace BlackMisc
 {
     class CDBusServer;
@@ -28,6 +30,11 @@ namespace BlackMisc
     {
         class CDataLinkDBus;
     }
+    namespace Simulation
+    {
+        class CAircraftInRangeJournal;
+        class CAircraftInRangeReplica;
+    }
 }
 namespace BlackCore
 {
@@ -68,6 +75,10 @@ namespace BlackCore
         //! Transport mechanism for sharing state between applications
         BlackMisc::SharedState::CDataLinkDBus *getDataLinkDBus() { return this->m_dataLinkDBus; }
 
+        //! Replica of the aircraft in range, kept in sync by deltas
+        //! \remarks only available if the network context is remote, nullptr otherwise
+        const BlackMisc::Simulation::CAircraftInRangeReplica *getAircraftInRangeReplica() const { return this->m_aircraftInRangeReplica; }
+
         //! DBus server (if applicable)
         const BlackMisc::CDBusServer *getDBusServer() const { return this->m_dbusServer; }
 
@@ -193,6 +204,9 @@ namespace BlackCore
         BlackMisc::SharedState::CDataLinkDBus *m_dataLinkDBus = nullptr;
         BlackMisc::CLogHistory *m_logHistory = nullptr;
         BlackMisc::CLogHistorySource *m_logHistorySource = nullptr;
+        BlackMisc::Simulation::CAircraftInRangeJournal *m_aircraftInRangeJournal = nullptr;
+        BlackMisc::Simulation::CAircraftInRangeReplica *m_aircraftInRangeReplica = nullptr;
+        QTimer *m_aircraftInRangeTimer = nullptr; //!< publishes the aircraft in range deltas
 
         // contexts:
         // There is a reason why we do not use smart pointers here. When the context is deleted
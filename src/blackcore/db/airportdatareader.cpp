@@ -12,6 +12,8 @@
 #include <QElapsedTimer>
 #include <QFileInfo>
 #include <QPointer>
+#include <QReadLocker>
+#include <QWriteLocker>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -27,7 +29,19 @@ namespace BlackCore::Db
 
     BlackMisc::Aviation::CAirportList CAirportDataReader::getAirports() const
     {
-        return m_airportCache.get();
+        // airports with a geo index for range and closest queries, indexed again when the cache has changed
+        const CAirportList airports = m_airportCache.get();
+        if (airports.isEmpty()) { return airports; }
+        {
+            QReadLocker l(&m_lockIndexedAirports);
+            if (m_indexedAirports.hasGeoIndex() && m_indexedAirports.size() == airports.size() && m_indexedAirports.cbegin() == airports.cbegin()) { return m_indexedAirports; }
+        }
+
+        CAirportList indexedAirports(airports);
+        indexedAirports.attachGeoIndex();
+        QWriteLocker l(&m_lockIndexedAirports);
+        m_indexedAirports = indexedAirports;
+        return indexedAirports;
     }
 
     CAirport CAirportDataReader::getAirportForIcaoDesignator(const QString &designator) const
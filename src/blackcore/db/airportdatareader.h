@@ -13,6 +13,7 @@
 #include "blackmisc/network/entityflags.h"
 
 #include <QNetworkAccessManager>
+#include <QReadWriteLock>
 #include <atomic>
 
 namespace BlackCore::Db
@@ -64,6 +65,8 @@ namespace BlackCore::Db
     private:
         BlackMisc::CData<BlackCore::Data::TDbAirportCache> m_airportCache { this, &CAirportDataReader::airportCacheChanged }; //!< cache file
         std::atomic_bool m_syncedAirportCache { false }; //!< already synchronized?
+        mutable BlackMisc::Aviation::CAirportList m_indexedAirports; //!< cached airports with geo index
+        mutable QReadWriteLock m_lockIndexedAirports; //!< lock for m_indexedAirports
 
         //! Reader URL (we read from where?) used to detect changes of location
         BlackMisc::CData<BlackCore::Data::TDbModelReaderBaseUrl> m_readerUrlCache { this, &CAirportDataReader::baseUrlCacheChanged };
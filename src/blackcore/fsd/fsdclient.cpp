@@ -39,6 +39,7 @@
 
 #include "blackmisc/aviation/flightplan.h"
 #include "blackmisc/network/rawfsdmessage.h"
+#include "blackmisc/simulation/latencytrace.h"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/threadutils.h"
 #include "blackmisc/logmessage.h"
@@ -1247,6 +1248,7 @@ namespace BlackCore::Fsd
         situation.setCurrentUtcTime();
         const qint64 offsetTimeMs = receivedPositionFixTsAndGetOffsetTime(situation.getCallsign(), situation.getMSecsSinceEpoch());
         situation.setTimeOffsetMs(offsetTimeMs);
+        this->traceReceivedSituation(situation);
 
         // I did have a situation where I got wrong transponder codes (KB)
         // So I now check for a valid code in order to detect such codes
@@ -1286,6 +1288,7 @@ namespace BlackCore::Fsd
         situation.setCurrentUtcTime();
         const qint64 offsetTimeMs = receivedPositionFixTsAndGetOffsetTime(situation.getCallsign(), situation.getMSecsSinceEpoch());
         situation.setTimeOffsetMs(offsetTimeMs);
+        this->traceReceivedSituation(situation);
 
         CAircraftParts parts;
         parts.setLights(data.m_lights);
@@ -2211,6 +2214,8 @@ namespace BlackCore::Fsd
     {
         if (m_socket->bytesAvailable() < 1) { return; }
 
+        // all lines read now are considered received now
+        m_traceReceivedNs = CLatencyTrace::isEnabled() ? CLatencyTrace::nowNs() : -1;
         int lines = 0;
 
         // reads at least one line if available
@@ -2241,6 +2246,13 @@ namespace BlackCore::Fsd
         }
     }
 
+    void CFSDClient::traceReceivedSituation(CAircraftSituation &situation) const
+    {
+        if (m_traceReceivedNs < 0) { return; }
+        situation.setTraceReceivedNs(m_traceReceivedNs);
+        CLatencyTrace::record(CLatencyTrace::FsdReceived, situation.getCallsign(), m_traceReceivedNs, m_traceReceivedNs, CLatencyTrace::nowNs());
+    }
+
     QString CFSDClient::socketErrorString(QAbstractSocket::SocketError error) const
     {
         QString e = CFSDClient::socketErrorToQString(error);
@@ -428,6 +428,9 @@ namespace BlackCore::Fsd
         // Type to string
         const QString &messageTypeToString(MessageType mt) const;
 
+        //! Stamp the situation with the receive time of the current line for the latency trace
+        void traceReceivedSituation(BlackMisc::Aviation::CAircraftSituation &situation) const;
+
         //! @{
         //! Handle response tokens
         void handleAtcDataUpdate(const QStringList &tokens);
@@ -607,6 +610,7 @@ namespace BlackCore::Fsd
         QTimer m_fsdSendMessageTimer { this }; //!< FSD message sending
 
         qint64 m_additionalOffsetTime = 0; //!< additional offset time
+        qint64 m_traceReceivedNs = -1; //!< latency trace, receive time of the lines currently parsed
 
         std::atomic_bool m_statistics { false };
         QMap<QString, int> m_callStatistics; //!< how many calls?
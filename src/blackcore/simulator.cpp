@@ -6,11 +6,14 @@
 #include "blackcore/webdataservices.h"
 #include "blackcore/application.h"
 #include "blackmisc/simulation/data/modelcaches.h"
+#include "blackmisc/simulation/interpolationbinarylog.h"
+#include "blackmisc/simulation/latencytrace.h"
 #include "blackmisc/math/mathutils.h"
 #include "blackmisc/crashhandler.h"
 #include "blackmisc/directoryutils.h"
 #include "blackmisc/threadutils.h"
 #include "blackmisc/logmessage.h"
+#include "blackmisc/stringutils.h"
 #include "blackmisc/verify.h"
 
 #include <QFlag>
@@ -24,7 +27,13 @@
 #include <QDir>
 #include <QUrl>
 #include <QDesktopServices>
+#include <QtConcurrentMap>
+#include <algorithm>
 #include <functional>
+#include <numeric>
+#include <limits>
+#include <tuple>
+#include <vector>
 
 using namespace BlackConfig;
 using namespace BlackMisc;
@@ -188,6 +197,9 @@ namespace BlackCore
         m_callsignsToBeRendered.clear();
         this->resetLastSentValues(); // clear all last sent values
         m_updateRemoteAircraftInProgress = false;
+        m_updateTiers.clear();
+        m_budgetDeferredFrames.clear();
+        m_followedAircraft = {};
 
         this->clearInterpolationSetupsPerCallsign();
         this->resetAircraftStatistics();
@@ -236,8 +248,8 @@ namespace BlackCore
     void ISimulator::clearData(const CCallsign &callsign)
     {
         m_statsPhysicallyRemovedAircraft++;
-        m_lastSentParts.remove(callsign);
-        m_lastSentSituations.remove(callsign);
+        m_lastSentFingerprints.remove(callsign);
+        m_budgetDeferredFrames.remove(callsign);
         m_loopbackSituations.clear();
         this->removeInterpolationSetupPerCallsign(callsign);
     }
@@ -354,6 +366,12 @@ namespace BlackCore
         m_statsUpdateAircraftLimited = 0;
         m_statsLastUpdateAircraftRequestedMs = 0;
         m_statsUpdateAircraftRequestedDeltaMs = 0;
+        m_statsUpdateTierSkipped = 0;
+        m_statsUpdateTierSinceMs = QDateTime::currentMSecsSinceEpoch();
+        m_statsBudgetDeferred = 0;
+        m_statsBudgetDeferredFrames = 0;
+        m_statsBudgetLastDeferred = 0;
+        m_statsBudgetMaxFramesWaited = 0;
         ISimulationEnvironmentProvider::resetSimulationEnvironmentStatistics();
     }
 
@@ -419,6 +437,28 @@ namespace BlackCore
                 CLogMessage(this).info(u"Started writing interpolation log");
                 return true;
             }
+            if (part2 == "bin" || part2 == "binary")
+            {
+                // all aircraft for the whole session, see CInterpolationBinaryLog
+                const QString part3 = parser.part(3).toLower();
+                CInterpolationAndRenderingSetupGlobal setup = this->getInterpolationSetupGlobal();
+                if (part3 == "off" || part3 == "false")
+                {
+                    m_interpolationLogger.stopBinaryLog();
+                    if (setup.setLogInterpolation(false)) { this->setInterpolationSetupGlobal(setup); }
+                    CLogMessage(this).info(u"Stopped binary interpolation log, %1") << CInterpolationBinaryLog::getStatistics();
+                    return true;
+                }
+                if (part3 == "stats")
+                {
+                    CLogMessage(this).info(CInterpolationBinaryLog::getStatistics());
+                    return true;
+                }
+                const CStatusMessage m = m_interpolationLogger.startBinaryLog();
+                if (m.isSuccess() && setup.setLogInterpolation(true)) { this->setInterpolationSetupGlobal(setup); }
+                CLogMessage::preformatted(m);
+                return m.isSuccess();
+            }
             if (part2 == "show")
             {
                 const QDir dir(CInterpolationLogger::getLogDirectory());
@@ -531,6 +571,71 @@ namespace BlackCore
             return true;
         }
 
+        // distance based update tiers
+        if (part1.startsWith("tiers"))
+        {
+            if (parser.hasPart(2))
+            {
+                // .drv tiers off or .drv tiers nearNM farNM midFrames farFrames
+                CInterpolationAndRenderingSetupGlobal setup = this->getInterpolationSetupGlobal();
+                const bool changed = parser.matchesPart(2, "off") ?
+                                         setup.setUpdateTiers(setup.getUpdateTierNearDistance(), setup.getUpdateTierFarDistance(), 1, 1) :
+                                         setup.setUpdateTiers(CLength(parser.toDouble(2, 10.0), CLengthUnit::NM()), CLength(parser.toDouble(3, 30.0), CLengthUnit::NM()), parser.toInt(4, 2), parser.toInt(5, 5));
+                if (changed) { this->setInterpolationSetupGlobal(setup); }
+                if (!setup.isUsingUpdateTiers()) { m_updateTiers.clear(); }
+            }
+            CLogMessage(this).info(u"Remote aircraft update tiers: %1") << this->updateTiersInfo();
+            return true;
+        }
+
+        // time budget for updating the remote aircraft of one frame
+        if (part1.startsWith("budget"))
+        {
+            if (parser.hasPart(2) && !parser.matchesPart(2, "stats"))
+            {
+                // .drv budget ms or .drv budget off
+                CInterpolationAndRenderingSetupGlobal setup = this->getInterpolationSetupGlobal();
+                const bool changed = setup.setFrameBudgetMs(parser.matchesPart(2, "off") ? 0 : parser.toInt(2, 0));
+                if (changed) { this->setInterpolationSetupGlobal(setup); }
+                if (!setup.isUsingFrameBudget()) { m_budgetDeferredFrames.clear(); }
+            }
+            CLogMessage(this).info(u"Remote aircraft frame budget: %1") << this->frameBudgetInfo();
+            return true;
+        }
+
+        // tolerances of the last sent values
+        if (part1.startsWith("sent"))
+        {
+            if (parser.hasPart(2))
+            {
+                // .drv sent positionM altitudeM angleDeg
+                const CLength position(parser.toDouble(2, -1), CLengthUnit::m());
+                const CLength altitude(parser.toDouble(3, -1), CLengthUnit::m());
+                const CAngle angle(parser.toDouble(4, -1), CAngleUnit::deg());
+                m_lastSentFingerprints.setTolerances(position, altitude, angle);
+            }
+            CLogMessage(this).info(u"Last sent values: %1") << m_lastSentFingerprints.toQString();
+            return true;
+        }
+
+        // latency trace from FSD to simulator
+        if (part1.startsWith("trace"))
+        {
+            const QString part2 = parser.part(2).toLower();
+            if (part2 == "on" || part2 == "true") { CLatencyTrace::setEnabled(true); }
+            else if (part2 == "off" || part2 == "false") { CLatencyTrace::setEnabled(false); }
+            else if (part2 == "clear" || part2 == "clr") { CLatencyTrace::clear(); }
+            else if (part2 == "write" || part2 == "save")
+            {
+                CLogMessage::preformatted(CLatencyTrace::writeChromeTrace());
+                return true;
+            }
+            else if (!part2.isEmpty() && part2 != "show") { return false; }
+
+            CLogMessage(this).info(u"Latency trace %1\n%2") << boolToOnOff(CLatencyTrace::isEnabled()) << CLatencyTrace::getHistogram();
+            return true;
+        }
+
         // CG override
         if (part1 == QStringView(u"cg"))
         {
@@ -586,11 +691,17 @@ namespace BlackCore
         CSimpleCommandParser::registerCommand({ ".drv unload", "unload driver" });
         CSimpleCommandParser::registerCommand({ ".drv cg length clear|modelstr.", "override CG" });
         CSimpleCommandParser::registerCommand({ ".drv limit number/secs.", "limit updates to number per second (0..off)" });
+        CSimpleCommandParser::registerCommand({ ".drv tiers [near far midFrames farFrames]|off", "update aircraft far away less often, distances in NM" });
+        CSimpleCommandParser::registerCommand({ ".drv budget [ms]|off|stats", "time budget per frame for remote aircraft, others are deferred" });
+        CSimpleCommandParser::registerCommand({ ".drv sent [position altitude angle]", "tolerances for changes sent to simulator, m and deg" });
+        CSimpleCommandParser::registerCommand({ ".drv trace on|off|clear|show", "latency trace from FSD to simulator, show histogram" });
+        CSimpleCommandParser::registerCommand({ ".drv trace write", "write latency trace as Chrome trace JSON to log directory" });
         CSimpleCommandParser::registerCommand({ ".drv logint callsign", "log interpolator for callsign" });
         CSimpleCommandParser::registerCommand({ ".drv logint off", "no log information for interpolator" });
         CSimpleCommandParser::registerCommand({ ".drv logint write", "write interpolator log to file" });
         CSimpleCommandParser::registerCommand({ ".drv logint clear", "clear current log" });
         CSimpleCommandParser::registerCommand({ ".drv logint max number", "max. number of entries logged" });
+        CSimpleCommandParser::registerCommand({ ".drv logint bin on|off|stats", "log all aircraft to binary file in log directory" });
         CSimpleCommandParser::registerCommand({ ".drv pos callsign", "show position for callsign" });
         CSimpleCommandParser::registerCommand({ ".drv spline|linear callsign", "set spline/linear interpolator for one/all callsign(s)" });
         CSimpleCommandParser::registerCommand({ ".drv aircraft readd callsign", "add again (re-add) a given callsign" });
@@ -617,17 +728,12 @@ namespace BlackCore
     bool ISimulator::isEqualLastSent(const CAircraftSituation &compare) const
     {
         Q_ASSERT_X(compare.hasCallsign(), Q_FUNC_INFO, "Need callsign");
-        if (!m_lastSentSituations.contains(compare.getCallsign())) { return false; }
-        if (compare.isNull()) { return false; }
-        return compare.equalPbhVectorAltitudeElevation(m_lastSentSituations.value(compare.getCallsign()));
-        // return compare.equalPbhVectorAltitude(m_lastSentSituations.value(compare.getCallsign()));
+        return m_lastSentFingerprints.isEqualLastSent(compare);
     }
 
     bool ISimulator::isEqualLastSent(const CAircraftParts &compare, const CCallsign &callsign) const
     {
-        if (callsign.isEmpty()) { return false; }
-        if (!m_lastSentParts.contains(callsign)) { return false; }
-        return compare.equalValues(m_lastSentParts.value(callsign));
+        return m_lastSentFingerprints.isEqualLastSent(compare, callsign);
     }
 
     void ISimulator::rememberLastSent(const CAircraftSituation &sent)
@@ -637,7 +743,11 @@ namespace BlackCore
         const bool hasCs = sent.hasCallsign();
         BLACK_VERIFY_X(hasCs, Q_FUNC_INFO, "Need callsign");
         if (!hasCs) { return; }
-        m_lastSentSituations.insert(sent.getCallsign(), sent);
+
+        // first interpolated situation of a traced position is sent now
+        const qint64 traceStartNs = sent.hasTraceReceivedNs() ? CLatencyTrace::nowNs() : -1;
+        m_lastSentFingerprints.rememberLastSent(sent);
+        if (traceStartNs >= 0) { CLatencyTrace::record(CLatencyTrace::SimulatorSend, sent.getCallsign(), sent.getTraceReceivedNs(), traceStartNs, CLatencyTrace::nowNs()); }
     }
 
     void ISimulator::rememberLastSent(const CAircraftParts &sent, const CCallsign &callsign)
@@ -646,18 +756,31 @@ namespace BlackCore
         // https://discordapp.com/channels/539048679160676382/568904623151382546/575712119513677826
         BLACK_VERIFY_X(!callsign.isEmpty(), Q_FUNC_INFO, "Need callsign");
         if (callsign.isEmpty()) { return; }
-        m_lastSentParts.insert(callsign, sent);
+        m_lastSentFingerprints.rememberLastSent(sent, callsign);
     }
 
-    CAircraftSituationList ISimulator::getLastSentCanLikelySkipNearGroundInterpolation() const
+    bool ISimulator::rememberLastSentIfChanged(const CAircraftSituation &sent, bool force)
     {
-        const QList<CAircraftSituation> situations = m_lastSentSituations.values();
-        CAircraftSituationList skipped;
-        for (const CAircraftSituation &s : situations)
-        {
-            if (s.canLikelySkipNearGroundInterpolation()) { skipped.push_back(s); }
-        }
-        return skipped;
+        const bool hasCs = sent.hasCallsign();
+        BLACK_VERIFY_X(hasCs, Q_FUNC_INFO, "Need callsign");
+        if (!hasCs) { return true; }
+
+        const qint64 traceStartNs = sent.hasTraceReceivedNs() ? CLatencyTrace::nowNs() : -1;
+        if (!m_lastSentFingerprints.rememberLastSentIfChanged(sent, force)) { return false; }
+        if (traceStartNs >= 0) { CLatencyTrace::record(CLatencyTrace::SimulatorSend, sent.getCallsign(), sent.getTraceReceivedNs(), traceStartNs, CLatencyTrace::nowNs()); }
+        return true;
+    }
+
+    bool ISimulator::rememberLastSentIfChanged(const CAircraftParts &sent, const CCallsign &callsign, bool force)
+    {
+        BLACK_VERIFY_X(!callsign.isEmpty(), Q_FUNC_INFO, "Need callsign");
+        if (callsign.isEmpty()) { return true; }
+        return m_lastSentFingerprints.rememberLastSentIfChanged(sent, callsign, force);
+    }
+
+    CCallsignSet ISimulator::getLastSentCanLikelySkipNearGroundInterpolation() const
+    {
+        return m_lastSentFingerprints.getLastSentCanLikelySkipNearGroundInterpolation();
     }
 
     bool ISimulator::isAnyConnectedStatus(SimulatorStatus status)
@@ -736,6 +859,7 @@ namespace BlackCore
     void ISimulator::onRecalculatedRenderedAircraft(const CAirspaceAircraftSnapshot &snapshot)
     {
         if (!snapshot.isValidSnapshot()) { return; }
+        this->updateDistanceTiers(snapshot);
 
         // for unrestricted values all add/remove actions are directly linked
         // when changing back from restricted->unrestricted an one time update is required
@@ -1022,16 +1146,79 @@ namespace BlackCore
         return limInfo.arg(m_statsUpdateAircraftLimited).arg(m_limitUpdateAircraftBucket.getTokensPerSecond());
     }
 
+    QString ISimulator::updateTiersInfo() const
+    {
+        const CInterpolationAndRenderingSetupGlobal setup = this->getInterpolationSetupGlobal();
+        if (!setup.isUsingUpdateTiers()) { return QStringLiteral("no update tiers"); }
+        static const QString info("Tiers: %1, %2 aircraft not every frame, %3 interpolations/sec. skipped");
+        return info.arg(setup.getUpdateTiersText()).arg(m_updateTiers.size()).arg(this->getStatisticsUpdateTierSkippedPerSecond(), 0, 'f', 1);
+    }
+
+    double ISimulator::getStatisticsUpdateTierSkippedPerSecond() const
+    {
+        if (m_statsUpdateTierSinceMs < 0 || m_statsUpdateTierSkipped < 1) { return 0.0; }
+        const qint64 dt = QDateTime::currentMSecsSinceEpoch() - m_statsUpdateTierSinceMs;
+        if (dt < 1) { return 0.0; }
+        return 1000.0 * m_statsUpdateTierSkipped / dt;
+    }
+
+    QString ISimulator::frameBudgetInfo() const
+    {
+        const CInterpolationAndRenderingSetupGlobal setup = this->getInterpolationSetupGlobal();
+        if (!setup.isUsingFrameBudget()) { return QStringLiteral("no frame budget"); }
+        static const QString info("Budget: %1, %2 aircraft deferred in %3 frame(s), last %4, max.%5 frame(s) waited, send %6us/aircraft");
+        return info.arg(setup.getFrameBudgetText()).arg(m_statsBudgetDeferred).arg(m_statsBudgetDeferredFrames).arg(m_statsBudgetLastDeferred).arg(m_statsBudgetMaxFramesWaited).arg(m_budgetSendNsPerAircraft / 1000.0, 0, 'f', 1);
+    }
+
+    bool ISimulator::isUpdateDueByDistance(const CCallsign &callsign, bool updateAllAircraft)
+    {
+        if (updateAllAircraft || m_updateTiers.isEmpty()) { return true; }
+        const auto it = m_updateTiers.constFind(callsign);
+        if (it == m_updateTiers.cend() || it->frames < 2) { return true; }
+        if ((m_statsUpdateAircraftRuns + it->phase) % it->frames == 0) { return true; }
+
+        if (m_statsUpdateTierSinceMs < 0) { m_statsUpdateTierSinceMs = QDateTime::currentMSecsSinceEpoch(); }
+        m_statsUpdateTierSkipped++;
+        return false;
+    }
+
+    void ISimulator::updateDistanceTiers(const CAirspaceAircraftSnapshot &snapshot)
+    {
+        // the callsigns of the snapshot are a set ordered by callsign, the order by distance is taken from the aircraft
+        // ranks are also used by the frame budget
+        const CSimulatedAircraftList enabledAircraft = this->getAircraftInRange().findByCallsigns(snapshot.getEnabledAircraftCallsignsByDistance());
+        m_distanceRanks = getDistanceRanks(enabledAircraft);
+
+        const CInterpolationAndRenderingSetupGlobal setup = this->getInterpolationSetupGlobal();
+        if (!setup.isUsingUpdateTiers())
+        {
+            m_updateTiers.clear();
+            return;
+        }
+
+        // consecutive aircraft of a tier get consecutive phases
+        CSimulatedAircraftList byDistance(enabledAircraft);
+        byDistance.sortByDistanceToReferencePositionRenderedCallsign();
+        QHash<CCallsign, UpdateTier> tiers;
+        QHash<int, int> aircraftPerTier;
+        for (const CSimulatedAircraft &aircraft : std::as_const(byDistance))
+        {
+            const int frames = setup.getUpdateTierFrames(aircraft.getRelativeDistance());
+            if (frames < 2) { continue; }
+            int &count = aircraftPerTier[frames];
+            tiers.insert(aircraft.getCallsign(), { frames, count++ % frames });
+        }
+        m_updateTiers = tiers;
+    }
+
     void ISimulator::resetLastSentValues()
     {
-        m_lastSentParts.clear();
-        m_lastSentSituations.clear();
+        m_lastSentFingerprints.clear();
     }
 
     void ISimulator::resetLastSentValues(const CCallsign &callsign)
     {
-        m_lastSentParts.remove(callsign);
-        m_lastSentSituations.remove(callsign);
+        m_lastSentFingerprints.remove(callsign);
     }
 
     void ISimulator::unload()
@@ -1141,6 +1328,170 @@ namespace BlackCore
         if (m_statsMaxUpdateTimeMs < dt) { m_statsMaxUpdateTimeMs = dt; }
         if (m_statsLastUpdateAircraftRequestedMs > 0) { m_statsUpdateAircraftRequestedDeltaMs = startTime - m_statsLastUpdateAircraftRequestedMs; }
         if (limited) { m_statsUpdateAircraftLimited++; }
+
+        if (m_frameBudgetTimer.isValid())
+        {
+            // what the driver needed to send the interpolated aircraft, used to stop interpolating early enough
+            if (m_budgetInterpolated > 0)
+            {
+                const double sendNs = static_cast<double>(m_frameBudgetTimer.nsecsElapsed() - m_budgetInterpolationNs) / m_budgetInterpolated;
+                m_budgetSendNsPerAircraft = m_budgetSendNsPerAircraft > 0 ? 0.9 * m_budgetSendNsPerAircraft + 0.1 * sendNs : sendNs;
+            }
+            m_frameBudgetTimer.invalidate();
+
+            if (m_statsUpdateAircraftRuns % 50 == 0)
+            {
+                m_simulatorInternals.setValue(QStringLiteral("swift/frameBudgetMs"), this->getInterpolationSetupGlobal().getFrameBudgetMs());
+                m_simulatorInternals.setValue(QStringLiteral("swift/frameBudgetDeferred"), m_statsBudgetDeferred);
+                m_simulatorInternals.setValue(QStringLiteral("swift/frameBudgetDeferredFrames"), m_statsBudgetDeferredFrames);
+                m_simulatorInternals.setValue(QStringLiteral("swift/frameBudgetMaxFramesWaited"), m_statsBudgetMaxFramesWaited);
+            }
+        }
+    }
+
+    QVector<CInterpolationResult> ISimulator::interpolateRemoteAircraft(const QVector<InterpolationRequest> &requests, qint64 currentTimestamp, bool updateAllAircraft,
+                                                                       QVector<CInterpolationAndRenderingSetupPerCallsign> *o_setups, QVector<bool> *o_deferred)
+    {
+        // a full update, e.g. after moving the own aircraft, is never deferred
+        const int budgetMs = this->getInterpolationSetupGlobal().getFrameBudgetMs();
+        const bool budgeted = o_deferred && budgetMs > 0 && !updateAllAircraft && requests.size() > 1;
+        if (budgeted) { m_frameBudgetTimer.start(); }
+
+        const QVector<int> order = budgeted ? this->getFrameBudgetPriorityOrder(requests) : QVector<int>();
+        QVector<InterpolationJob> jobs;
+        jobs.reserve(requests.size());
+        for (int i = 0; i < requests.size(); ++i)
+        {
+            const int aircraftNumber = budgeted ? order.at(i) : i;
+            const InterpolationRequest &request = requests.at(aircraftNumber);
+            jobs.push_back({ request.interpolator, this->getInterpolationSetupConsolidated(request.callsign, updateAllAircraft), aircraftNumber, {} });
+        }
+
+        int interpolated = jobs.size();
+        if (budgeted)
+        {
+            interpolated = this->interpolateWithinFrameBudget(jobs, currentTimestamp, budgetMs);
+            this->updateFrameBudgetStatistics(jobs, requests, interpolated);
+        }
+        else { interpolateBatch(jobs, currentTimestamp); }
+
+        // back to the order of the requests
+        QVector<CInterpolationResult> results(requests.size());
+        if (o_setups) { o_setups->fill({}, requests.size()); }
+        if (o_deferred) { o_deferred->fill(false, requests.size()); }
+        for (int j = 0; j < jobs.size(); ++j)
+        {
+            const InterpolationJob &job = jobs.at(j);
+            if (j < interpolated) { results[job.aircraftNumber] = job.result; }
+            else { (*o_deferred)[job.aircraftNumber] = true; }
+            if (o_setups) { (*o_setups)[job.aircraftNumber] = job.setup; }
+        }
+        return results;
+    }
+
+    QVector<int> ISimulator::getFrameBudgetPriorityOrder(const QVector<InterpolationRequest> &requests) const
+    {
+        QVector<FrameBudgetPriority> priorities;
+        priorities.reserve(requests.size());
+        for (const InterpolationRequest &request : requests)
+        {
+            const CCallsign &callsign = request.callsign;
+            priorities.push_back({ m_budgetDeferredFrames.value(callsign, 0), callsign == m_followedAircraft,
+                                   m_lastSentFingerprints.isLastSentMovingNearGround(callsign), m_distanceRanks.value(callsign, std::numeric_limits<int>::max()) });
+        }
+        return getFrameBudgetPriorityOrder(priorities);
+    }
+
+    QVector<int> ISimulator::getFrameBudgetPriorityOrder(const QVector<FrameBudgetPriority> &priorities)
+    {
+        QVector<int> order(priorities.size());
+        std::iota(order.begin(), order.end(), 0);
+
+        // deferred aircraft first, so every aircraft is updated eventually
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            const FrameBudgetPriority &pa = priorities.at(a);
+            const FrameBudgetPriority &pb = priorities.at(b);
+            return std::make_tuple(-pa.deferredFrames, !pa.followed, !pa.movingNearGround, pa.distanceRank) <
+                   std::make_tuple(-pb.deferredFrames, !pb.followed, !pb.movingNearGround, pb.distanceRank);
+        });
+        return order;
+    }
+
+    QHash<CCallsign, int> ISimulator::getDistanceRanks(const CSimulatedAircraftList &aircraft)
+    {
+        CSimulatedAircraftList byDistance(aircraft);
+        byDistance.sortByDistanceToReferencePositionRenderedCallsign();
+        QHash<CCallsign, int> ranks;
+        ranks.reserve(byDistance.size());
+        for (const CSimulatedAircraft &a : std::as_const(byDistance)) { ranks.insert(a.getCallsign(), ranks.size()); }
+        return ranks;
+    }
+
+    int ISimulator::interpolateWithinFrameBudget(QVector<InterpolationJob> &jobs, qint64 currentTimestamp, int budgetMs)
+    {
+        // single aircraft are timed one by one, many aircraft are interpolated in parallel chunks
+        const int chunk = jobs.size() < ParallelInterpolationThreshold ? 1 : ParallelInterpolationThreshold;
+        const qint64 budgetNs = budgetMs * 1000000LL;
+        const qint64 startNs = m_frameBudgetTimer.nsecsElapsed(); // setups already consolidated
+        InterpolationJob *data = jobs.data();
+        int interpolated = 0;
+        while (interpolated < jobs.size())
+        {
+            const int next = qMin(chunk, jobs.size() - interpolated);
+            interpolateBatch(data + interpolated, data + interpolated + next, currentTimestamp, next > 1);
+            interpolated += next;
+
+            // projected: time so far, sending the interpolated aircraft, and the next chunk
+            const qint64 elapsedNs = m_frameBudgetTimer.nsecsElapsed();
+            const double interpolationNsPerChunk = static_cast<double>(elapsedNs - startNs) * next / interpolated;
+            const double projectedNs = elapsedNs + interpolated * m_budgetSendNsPerAircraft + interpolationNsPerChunk + next * m_budgetSendNsPerAircraft;
+            if (projectedNs > budgetNs) { break; }
+        }
+        m_budgetInterpolationNs = m_frameBudgetTimer.nsecsElapsed();
+        m_budgetInterpolated = interpolated;
+        return interpolated;
+    }
+
+    void ISimulator::updateFrameBudgetStatistics(const QVector<InterpolationJob> &jobs, const QVector<InterpolationRequest> &requests, int interpolated)
+    {
+        for (int j = 0; j < jobs.size(); ++j)
+        {
+            const CCallsign &callsign = requests.at(jobs.at(j).aircraftNumber).callsign;
+            if (j < interpolated)
+            {
+                m_budgetDeferredFrames.remove(callsign);
+                continue;
+            }
+            const int frames = ++m_budgetDeferredFrames[callsign];
+            if (frames > m_statsBudgetMaxFramesWaited) { m_statsBudgetMaxFramesWaited = frames; }
+        }
+
+        const int deferred = jobs.size() - interpolated;
+        m_statsBudgetLastDeferred = deferred;
+        if (deferred < 1) { return; }
+        m_statsBudgetDeferred += deferred;
+        m_statsBudgetDeferredFrames++;
+    }
+
+    void ISimulator::interpolateBatch(QVector<InterpolationJob> &jobs, qint64 currentTimestamp, bool parallel)
+    {
+        interpolateBatch(jobs.begin(), jobs.end(), currentTimestamp, parallel);
+    }
+
+    void ISimulator::interpolateBatch(InterpolationJob *begin, InterpolationJob *end, qint64 currentTimestamp, bool parallel)
+    {
+        // each interpolator only touches its own state, the logger and providers are thread safe
+        const auto interpolate = [currentTimestamp](InterpolationJob &job) {
+            if (!job.interpolator)
+            {
+                job.result.reset();
+                return;
+            }
+            job.result = job.interpolator->getInterpolation(currentTimestamp, job.setup, job.aircraftNumber);
+        };
+
+        if (!parallel || (end - begin) < ParallelInterpolationThreshold) { std::for_each(begin, end, interpolate); }
+        else { QtConcurrent::blockingMap(begin, end, interpolate); }
     }
 
     void ISimulator::onOwnModelChanged(const CAircraftModel &newModel)
@@ -15,6 +15,7 @@
 #include "blackmisc/simulation/interpolationrenderingsetup.h"
 #include "blackmisc/simulation/simulatorinternals.h"
 #include "blackmisc/simulation/interpolatormulti.h"
+#include "blackmisc/simulation/lastsentfingerprints.h"
 #include "blackmisc/simulation/ownaircraftprovider.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
 #include "blackmisc/simulation/simulationenvironmentprovider.h"
@@ -35,10 +36,14 @@
 #include "blackmisc/tokenbucket.h"
 #include "blackconfig/buildconfig.h"
 
+#include <QElapsedTimer>
 #include <QFlags>
+#include <QHash>
 #include <QObject>
 #include <QString>
+#include <QVector>
 #include <atomic>
+#include <limits>
 
 namespace BlackMisc::Network
 {
@@ -272,6 +277,8 @@ namespace BlackCore
         //! .drv cg length clear|modelstring  set overridden CG for model string      BlackCore::ISimulator
         //! .drv unload                       unload plugin                           BlackCore::ISimulator
         //! .drv limit number                 limit the number of updates             BlackCore::ISimulator
+        //! .drv tiers near far mid far|off   update aircraft far away less often     BlackCore::ISimulator
+        //! .drv sent position altitude angle tolerances for changes sent               BlackCore::ISimulator
         //! .drv logint callsign              log interpolator for callsign           BlackCore::ISimulator
         //! .drv logint off                   no log information for interpolator     BlackCore::ISimulator
         //! .drv logint write                 write interpolator log to file          BlackCore::ISimulator
@@ -296,6 +303,43 @@ namespace BlackCore
         //! Interpolation messages for callsign
         virtual BlackMisc::CStatusMessageList getInterpolationMessages(const BlackMisc::Aviation::CCallsign &callsign) const = 0;
 
+        //! Interpolation of one aircraft in a frame, independent of all other aircraft
+        struct InterpolationJob
+        {
+            BlackMisc::Simulation::CInterpolatorMulti *interpolator = nullptr; //!< interpolator of the aircraft
+            BlackMisc::Simulation::CInterpolationAndRenderingSetupPerCallsign setup; //!< consolidated setup
+            int aircraftNumber = -1; //!< number of the aircraft in this frame
+            BlackMisc::Simulation::CInterpolationResult result; //!< result, set by ISimulator::interpolateBatch
+        };
+
+        //! Run the interpolations of one frame
+        //! \remark with parallel set and enough jobs the interpolations are spread over the global thread pool
+        static void interpolateBatch(QVector<InterpolationJob> &jobs, qint64 currentTimestamp, bool parallel = true);
+
+        //! Run the interpolations of a contiguous range of jobs
+        //! \sa interpolateBatch
+        static void interpolateBatch(InterpolationJob *begin, InterpolationJob *end, qint64 currentTimestamp, bool parallel = true);
+
+        //! Below this number of aircraft interpolation is done in the calling thread
+        static constexpr int ParallelInterpolationThreshold = 32;
+
+        //! Priority of one aircraft when using a frame budget
+        struct FrameBudgetPriority
+        {
+            int deferredFrames = 0; //!< frames deferred in a row
+            bool followed = false; //!< followed in the simulator
+            bool movingNearGround = false; //!< last sent values moving near ground
+            int distanceRank = std::numeric_limits<int>::max(); //!< rank by distance, 0 is nearest
+        };
+
+        //! Order of the aircraft when using a frame budget, as indexes of the priorities
+        //! \remark aircraft deferred longest first, then the followed aircraft, aircraft moving near ground and by distance
+        static QVector<int> getFrameBudgetPriorityOrder(const QVector<FrameBudgetPriority> &priorities);
+
+        //! Rank of the aircraft by their relative distance, 0 is nearest
+        //! \remark a CCallsignSet is ordered by callsign, so the ranks are taken from the aircraft
+        static QHash<BlackMisc::Aviation::CCallsign, int> getDistanceRanks(const BlackMisc::Simulation::CSimulatedAircraftList &aircraft);
+
         //! Get the data for auto publishing
         const BlackMisc::Simulation::CAutoPublishData &getPublishData() const { return m_autoPublishing; }
 
@@ -336,6 +380,24 @@ namespace BlackCore
         //! Info about update aircraft limitations
         QString updateAircraftLimitationInfo() const;
 
+        //! Info about the distance based update tiers and the interpolations saved by them
+        QString updateTiersInfo() const;
+
+        //! Interpolations per second skipped by the distance based update tiers
+        double getStatisticsUpdateTierSkippedPerSecond() const;
+
+        //! Info about the frame budget and the aircraft deferred to the next frame
+        QString frameBudgetInfo() const;
+
+        //! Aircraft deferred to the next frame as the frame budget was used up
+        int getStatisticsBudgetDeferred() const { return m_statsBudgetDeferred; }
+
+        //! Frames in which aircraft were deferred
+        int getStatisticsBudgetDeferredFrames() const { return m_statsBudgetDeferredFrames; }
+
+        //! The aircraft followed in the simulator, updated first when using a frame budget
+        void setFollowedAircraft(const BlackMisc::Aviation::CCallsign &callsign) { m_followedAircraft = callsign; }
+
         //! Reset the last sent values
         void resetLastSentValues();
 
@@ -510,8 +572,16 @@ namespace BlackCore
         //! Remember as last sent
         void rememberLastSent(const BlackMisc::Aviation::CAircraftParts &sent, const BlackMisc::Aviation::CCallsign &callsign);
 
-        //! Last sent situations
-        BlackMisc::Aviation::CAircraftSituationList getLastSentCanLikelySkipNearGroundInterpolation() const;
+        //! Remember as last sent if not equal to the last sent situation, or if forced
+        //! \return true if the situation is to be sent
+        bool rememberLastSentIfChanged(const BlackMisc::Aviation::CAircraftSituation &sent, bool force = false);
+
+        //! Remember as last sent if not equal to the last sent parts, or if forced
+        //! \return true if the parts are to be sent
+        bool rememberLastSentIfChanged(const BlackMisc::Aviation::CAircraftParts &sent, const BlackMisc::Aviation::CCallsign &callsign, bool force = false);
+
+        //! Callsigns whose last sent situation can likely skip near ground interpolation
+        BlackMisc::Aviation::CCallsignSet getLastSentCanLikelySkipNearGroundInterpolation() const;
 
         //! Limit reached (max number of updates by token bucket if enabled)
         bool isUpdateAircraftLimited(qint64 timestamp = -1);
@@ -534,6 +604,30 @@ namespace BlackCore
         //! Update stats and flags
         void finishUpdateRemoteAircraftAndSetStatistics(qint64 startTime, bool limited = false);
 
+        //! One remote aircraft to be interpolated in the current frame
+        struct InterpolationRequest
+        {
+            BlackMisc::Aviation::CCallsign callsign; //!< callsign of the aircraft
+            BlackMisc::Simulation::CInterpolatorMulti *interpolator = nullptr; //!< interpolator of the aircraft
+        };
+
+        //! Interpolate all given remote aircraft for the current frame
+        //! \remark the setups are consolidated in the calling thread, the interpolations are spread over the global thread pool if there are many aircraft
+        //! \remark results are in the order of the requests, the request index is used as aircraft number
+        //! \remark with a frame budget and o_deferred the aircraft are interpolated by priority until the budget is used up,
+        //!         the remaining aircraft are deferred and neither interpolated nor to be sent in this frame
+        //! \param o_setups optionally returns the consolidated setups used, in the same order
+        //! \param o_deferred optionally returns the aircraft deferred to the next frame, in the same order
+        QVector<BlackMisc::Simulation::CInterpolationResult> interpolateRemoteAircraft(const QVector<InterpolationRequest> &requests, qint64 currentTimestamp, bool updateAllAircraft,
+                                                                                      QVector<BlackMisc::Simulation::CInterpolationAndRenderingSetupPerCallsign> *o_setups = nullptr,
+                                                                                      QVector<bool> *o_deferred = nullptr);
+
+
+        //! Is the aircraft due for an update in this frame?
+        //! \remark aircraft further away are updated less often, see BlackMisc::Simulation::CInterpolationAndRenderingSetupGlobal::getUpdateTierFrames
+        //! \remark skipped aircraft are neither interpolated nor sent, the simulator smooths the frames in between
+        bool isUpdateDueByDistance(const BlackMisc::Aviation::CCallsign &callsign, bool updateAllAircraft);
+
         //! Own model has been changed
         virtual void onOwnModelChanged(const BlackMisc::Simulation::CAircraftModel &newModel);
 
@@ -577,8 +671,7 @@ namespace BlackCore
         BlackMisc::Simulation::CSimulatorInternals m_simulatorInternals; //!< setup read from the sim
         BlackMisc::Simulation::CInterpolationLogger m_interpolationLogger; //!< log.interpolation
         BlackMisc::Simulation::CAutoPublishData m_autoPublishing; //!< for the DB
-        BlackMisc::Aviation::CAircraftSituationPerCallsign m_lastSentSituations; //!< last situations sent to simulator
-        BlackMisc::Aviation::CAircraftPartsPerCallsign m_lastSentParts; //!< last parts sent to simulator
+        BlackMisc::Simulation::CLastSentFingerprints m_lastSentFingerprints; //!< last situations and parts sent to simulator
 
         // some optional functionality which can be used by the simulators as needed
         BlackMisc::Simulation::CSimulatedAircraftList m_addAgainAircraftWhenRemoved; //!< add this model again when removed, normally used to change model
@@ -609,10 +702,48 @@ namespace BlackCore
         //! Display a logged situation in simulator
         void displayLoggedSituationInSimulator(const BlackMisc::Aviation::CCallsign &cs, bool stopLogging, int times = 40);
 
+        //! Assign the aircraft of the snapshot to the distance based update tiers
+        void updateDistanceTiers(const BlackMisc::Simulation::CAirspaceAircraftSnapshot &snapshot);
+
+        //! Update tier of one aircraft
+        struct UpdateTier
+        {
+            int frames = 1; //!< updated every n-th frame
+            int phase = 0; //!< spreads the aircraft of a tier over the frames
+        };
+
+        //! Order of the requests when using a frame budget
+        //! \sa ISimulator::getFrameBudgetPriorityOrder(const QVector<FrameBudgetPriority> &)
+        QVector<int> getFrameBudgetPriorityOrder(const QVector<InterpolationRequest> &requests) const;
+
+        //! Interpolate the jobs in order until the frame budget is used up
+        //! \return number of jobs interpolated
+        int interpolateWithinFrameBudget(QVector<InterpolationJob> &jobs, qint64 currentTimestamp, int budgetMs);
+
+        //! Count the deferred aircraft of a budgeted frame
+        void updateFrameBudgetStatistics(const QVector<InterpolationJob> &jobs, const QVector<InterpolationRequest> &requests, int interpolated);
+
         // statistics values of how often those functions are called
         // those are the added counters, overflow will not be an issue here (discussed in T171 review)
         int m_statsPhysicallyAddedAircraft = 0; //!< statistics, how many aircraft added
         int m_statsPhysicallyRemovedAircraft = 0; //!< statistics, how many aircraft removed
+        int m_statsUpdateTierSkipped = 0; //!< statistics, interpolations skipped by update tiers
+        qint64 m_statsUpdateTierSinceMs = -1; //!< statistics, counting skipped interpolations since
+
+        QHash<BlackMisc::Aviation::CCallsign, UpdateTier> m_updateTiers; //!< tiers of aircraft not updated every frame
+
+        // frame budget
+        int m_statsBudgetDeferred = 0; //!< statistics, aircraft deferred to the next frame
+        int m_statsBudgetDeferredFrames = 0; //!< statistics, frames with deferred aircraft
+        int m_statsBudgetLastDeferred = 0; //!< statistics, aircraft deferred in the last budgeted frame
+        int m_statsBudgetMaxFramesWaited = 0; //!< statistics, max.frames an aircraft was deferred in a row
+        int m_budgetInterpolated = 0; //!< aircraft interpolated in the current budgeted frame
+        qint64 m_budgetInterpolationNs = 0; //!< time used in the current budgeted frame until interpolated
+        double m_budgetSendNsPerAircraft = 0; //!< smoothed time of the driver to send one aircraft
+        QElapsedTimer m_frameBudgetTimer; //!< started with a budgeted frame
+        BlackMisc::Aviation::CCallsign m_followedAircraft; //!< aircraft followed in the simulator
+        QHash<BlackMisc::Aviation::CCallsign, int> m_budgetDeferredFrames; //!< frames an aircraft has been deferred in a row
+        QHash<BlackMisc::Aviation::CCallsign, int> m_distanceRanks; //!< rank by distance from the last snapshot, 0 is nearest
 
         // misc.
         bool m_networkConnected = false; //!< flight network connected
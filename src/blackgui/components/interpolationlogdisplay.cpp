@@ -155,7 +155,7 @@ namespace BlackGui::Components
             ui->le_UpdateTimes->home(false);
             ui->le_UpdateCount->setText(QString::number(m_simulator->getStatisticsUpdateRuns()));
             ui->le_UpdateReqTime->setText(msTimeStr.arg(m_simulator->getStatisticsAircraftUpdatedRequestedDeltaMs()));
-            ui->le_Limited->setText(m_simulator->updateAircraftLimitationInfo());
+            ui->le_Limited->setText(m_simulator->updateAircraftLimitationInfo() + QStringLiteral(" | ") + m_simulator->updateTiersInfo() + QStringLiteral(" | ") + m_simulator->frameBudgetInfo());
 
             ui->le_SimulatorSpecific->setText(m_simulator->getStatisticsSimulatorSpecific());
             ui->le_SimulatorSpecific->home(false);
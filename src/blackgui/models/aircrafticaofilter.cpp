@@ -68,4 +68,14 @@ namespace BlackGui::Models
         }
         return outContainer;
     }
+
+    QList<CAircraftIcaoFilter::SearchTerm> CAircraftIcaoFilter::getSearchTerms() const
+    {
+        QList<SearchTerm> terms;
+        if (!this->isValid() || m_id >= 0) { return terms; }
+        if (!m_designator.isEmpty()) { terms.push_back({ CAircraftIcaoCode::IndexAircraftDesignator, m_designator }); }
+        if (!m_family.isEmpty()) { terms.push_back({ CAircraftIcaoCode::IndexFamily, m_family }); }
+        if (!m_manufacturer.isEmpty()) { terms.push_back({ CAircraftIcaoCode::IndexManufacturer, m_manufacturer }); }
+        return terms;
+    }
 } // namespace
@@ -30,6 +30,9 @@ namespace BlackGui::Models
         //! \copydoc IModelFilter::filter
         virtual BlackMisc::Aviation::CAircraftIcaoCodeList filter(const BlackMisc::Aviation::CAircraftIcaoCodeList &inContainer) const override;
 
+        //! \copydoc IModelFilter::getSearchTerms
+        virtual QList<SearchTerm> getSearchTerms() const override;
+
     private:
         int m_id = -1;
         QString m_designator;
@@ -148,6 +148,16 @@ namespace BlackGui::Models
         return outContainer;
     }
 
+    QList<CAircraftModelFilter::SearchTerm> CAircraftModelFilter::getSearchTerms() const
+    {
+        QList<SearchTerm> terms;
+        if (!this->isEnabled() || m_id >= 0) { return terms; }
+        if (!m_modelKey.isEmpty()) { terms.push_back({ CAircraftModel::IndexModelString, m_modelKey }); }
+        if (!m_description.isEmpty()) { terms.push_back({ CAircraftModel::IndexDescription, m_description }); }
+        if (!m_fileName.isEmpty()) { terms.push_back({ CAircraftModel::IndexFileName, m_fileName }); }
+        return terms;
+    }
+
     bool CAircraftModelFilter::valid() const
     {
         const bool allEmpty =
@@ -39,6 +39,9 @@ namespace BlackGui::Models
         //! \copydoc IModelFilter::filter
         virtual BlackMisc::Simulation::CAircraftModelList filter(const BlackMisc::Simulation::CAircraftModelList &inContainer) const override;
 
+        //! \copydoc IModelFilter::getSearchTerms
+        virtual QList<SearchTerm> getSearchTerms() const override;
+
     private:
         int m_id = -1;
         QString m_modelKey;
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#include "blackgui/models/filtersearchindex.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace BlackGui::Models
+{
+    CFilterSearchIndex::CFilterSearchIndex(const QVector<QString> &values)
+    {
+        m_keys.reserve(values.size());
+        for (int row = 0; row < values.size(); ++row)
+        {
+            const QString key = normalized(values[row]);
+            m_keys.push_back(key);
+            m_rowsByKey[key].push_back(row);
+            for (int i = 0; i + 3 <= key.size(); ++i)
+            {
+                QVector<int> &rows = m_rowsByTrigram[trigram(key.constData() + i)];
+                if (rows.isEmpty() || rows.back() != row) { rows.push_back(row); }
+            }
+        }
+    }
+
+    QVector<int> CFilterSearchIndex::matchingRows(const QString &expression) const
+    {
+        const QString filter = normalized(expression);
+
+        // no wildcard, the whole value
+        if (!expression.contains('*')) { return m_rowsByKey.value(filter); }
+
+        // wildcard in the middle only, IModelFilter::stringMatchesFilterExpression matches values containing a wildcard
+        const bool startsWithWildcard = filter.startsWith('*');
+        const bool endsWithWildcard = filter.endsWith('*');
+        if (!startsWithWildcard && !endsWithWildcard)
+        {
+            QVector<int> rows;
+            for (int row = 0; row < m_keys.size(); ++row)
+            {
+                if (m_keys[row].contains('*')) { rows.push_back(row); }
+            }
+            return rows;
+        }
+
+        QString needle(filter);
+        needle.remove('*');
+        const auto matches = [&](const QString &key) {
+            if (key.isEmpty()) { return false; }
+            if (startsWithWildcard && endsWithWildcard) { return key.contains(needle); }
+            return endsWithWildcard ? key.startsWith(needle) : key.endsWith(needle);
+        };
+
+        QVector<int> rows;
+        if (needle.size() < 3)
+        {
+            for (int row = 0; row < m_keys.size(); ++row)
+            {
+                if (matches(m_keys[row])) { rows.push_back(row); }
+            }
+            return rows;
+        }
+        for (int row : this->trigramCandidates(needle))
+        {
+            if (matches(m_keys[row])) { rows.push_back(row); }
+        }
+        return rows;
+    }
+
+    QVector<int> CFilterSearchIndex::intersected(const QVector<int> &rows1, const QVector<int> &rows2)
+    {
+        QVector<int> rows;
+        rows.reserve(qMin(rows1.size(), rows2.size()));
+        std::set_intersection(rows1.cbegin(), rows1.cend(), rows2.cbegin(), rows2.cend(), std::back_inserter(rows));
+        return rows;
+    }
+
+    QVector<int> CFilterSearchIndex::trigramCandidates(const QString &needle) const
+    {
+        // shortest row lists first, so the intersection shrinks quickly
+        QVector<const QVector<int> *> lists;
+        for (int i = 0; i + 3 <= needle.size(); ++i)
+        {
+            const auto it = m_rowsByTrigram.constFind(trigram(needle.constData() + i));
+            if (it == m_rowsByTrigram.cend()) { return {}; }
+            lists.push_back(&it.value());
+        }
+        std::sort(lists.begin(), lists.end(), [](const QVector<int> *a, const QVector<int> *b) { return a->size() < b->size(); });
+
+        QVector<int> rows = *lists.front();
+        for (int i = 1; i < lists.size() && !rows.isEmpty(); ++i) { rows = intersected(rows, *lists[i]); }
+        return rows;
+    }
+} // namespace
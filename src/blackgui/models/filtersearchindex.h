@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKGUI_MODELS_FILTERSEARCHINDEX_H
+#define BLACKGUI_MODELS_FILTERSEARCHINDEX_H
+
+#include "blackgui/blackguiexport.h"
+#include "blackmisc/propertyaccessor.h"
+#include "blackmisc/propertyindex.h"
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace BlackGui::Models
+{
+    /*!
+     * Search index of one column for model filters.
+     *
+     * The values of all rows are normalized once (trimmed, case folded) and split into trigrams,
+     * so a filter expression as used by IModelFilter::stringMatchesFilterExpression
+     * ("abc", "abc*", "*abc", "*abc*") only checks the rows containing all trigrams of the expression.
+     */
+    class BLACKGUI_EXPORT CFilterSearchIndex
+    {
+    public:
+        //! Index of a property of all objects of the container
+        template <class Container>
+        static CFilterSearchIndex fromContainer(const Container &container, const BlackMisc::CPropertyIndex &index)
+        {
+            using ObjectType = typename Container::value_type;
+            const BlackMisc::CPropertyAccessor<ObjectType> accessor(index);
+            const bool isString = accessor.getKeyType() == BlackMisc::CPropertyAccessorTable<ObjectType>::StringKey;
+            QVector<QString> values;
+            values.reserve(container.size());
+            for (const ObjectType &object : container)
+            {
+                values.push_back(isString ? accessor.string(object) : accessor.value(object).toString());
+            }
+            return CFilterSearchIndex(values);
+        }
+
+        //! Default constructor, empty index
+        CFilterSearchIndex() = default;
+
+        //! Index of the values of all rows
+        explicit CFilterSearchIndex(const QVector<QString> &values);
+
+        //! Number of rows
+        int size() const { return m_keys.size(); }
+
+        //! Rows matching the filter expression, ascending
+        //! \remark case insensitive, as IModelFilter::stringMatchesFilterExpression
+        QVector<int> matchingRows(const QString &expression) const;
+
+        //! Normalized search key of a value
+        static QString normalized(const QString &value) { return value.trimmed().toCaseFolded(); }
+
+        //! Rows in both sorted row lists
+        static QVector<int> intersected(const QVector<int> &rows1, const QVector<int> &rows2);
+
+    private:
+        //! Trigram as key
+        static quint64 trigram(const QChar *c) { return (static_cast<quint64>(c[0].unicode()) << 32) | (static_cast<quint64>(c[1].unicode()) << 16) | c[2].unicode(); }
+
+        //! Rows whose key contains all trigrams of the needle, not checked
+        QVector<int> trigramCandidates(const QString &needle) const;
+
+        QVector<QString> m_keys; //!< normalized values by row
+        QHash<QString, QVector<int>> m_rowsByKey; //!< rows by normalized value
+        QHash<quint64, QVector<int>> m_rowsByTrigram; //!< rows by trigram, ascending and unique
+    };
+} // namespace
+
+#endif // guard
@@ -6,14 +6,19 @@
 
 #include "blackgui/models/listmodelbase.h"
 #include "blackgui/models/allmodelcontainers.h"
+#include "blackgui/models/modelsortkeys.h"
 #include "blackgui/guiutility.h"
 #include "blackmisc/variant.h"
 #include "blackmisc/worker.h"
 
 #include <QFlags>
+#include <QHash>
 #include <QJsonDocument>
 #include <QList>
 #include <QMimeData>
+#include <QThread>
+#include <algorithm>
+#include <numeric>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -25,6 +30,12 @@ namespace BlackGui::Models
         : CListModelBaseNonTemplate(translationContext, parent)
     {}
 
+    template <typename T, bool UseCompare>
+    CListModelBase<T, UseCompare>::~CListModelBase()
+    {
+        this->cancelBackgroundFilter();
+    }
+
     template <typename T, bool UseCompare>
     int CListModelBase<T, UseCompare>::rowCount(const QModelIndex &parentIndex) const
     {
@@ -105,9 +116,16 @@ namespace BlackGui::Models
         default: break; // continue here
         }
 
-        // Formatted data
-        const ObjectType obj = this->containerOrFilteredContainer()[row];
-        return formatter->data(role, obj.propertyByIndex(propertyIndex)).getQVariant();
+        // Formatted data, display data of the shown cells is cached
+        const CPropertyAccessor<ObjectType> &accessor = this->columnAccessor(col, propertyIndex);
+        if (role == Qt::DisplayRole)
+        {
+            if (const QVariant *cached = this->cachedDisplayData(index)) { return *cached; }
+        }
+        const ObjectType &obj = this->containerOrFilteredContainer()[row];
+        const QVariant formatted = formatter->data(role, accessor.value(obj)).getQVariant();
+        if (role == Qt::DisplayRole) { this->cacheDisplayData(index, formatted); }
+        return formatted;
     }
 
     template <typename T, bool UseCompare>
@@ -149,6 +167,7 @@ namespace BlackGui::Models
         const int row = index.row();
         if (row < 0 || row >= this->container().size()) { return false; }
         m_container[row] = obj;
+        this->clearDisplayCache();
         return true;
     }
 
@@ -159,11 +178,6 @@ namespace BlackGui::Models
 
         // Keep sorting out of begin/end reset model
         ContainerType sortedContainer;
-        ContainerType selection;
-        if (m_selectionModel)
-        {
-            selection = m_selectionModel->selectedObjects();
-        }
         const int oldSize = m_container.size();
         const bool performSort = sort && container.size() > 1 && this->hasValidSortColumn();
         if (performSort)
@@ -172,6 +186,18 @@ namespace BlackGui::Models
             sortedContainer = this->sortContainerByColumn(container, sortColumn, m_sortOrder);
         }
 
+        // rows keep their selection and scroll position
+        if (this->isIncrementalUpdates() && this->updateIncrementally(performSort ? sortedContainer : container))
+        {
+            return m_container.size();
+        }
+
+        ContainerType selection;
+        if (m_selectionModel)
+        {
+            selection = m_selectionModel->selectedObjects();
+        }
+
         this->beginResetModel();
         m_container = performSort ? sortedContainer : container;
         this->updateFilteredContainer(); // use sorted container for filtered if applicable
@@ -191,6 +217,133 @@ namespace BlackGui::Models
         return newSize;
     }
 
+    template <typename T, bool UseCompare>
+    bool CListModelBase<T, UseCompare>::updateIncrementally(const ContainerType &container)
+    {
+        const bool filtered = this->hasFilter();
+        ContainerType &rows = filtered ? m_containerFiltered : m_container;
+        const ContainerType newRows = filtered ? m_filter->filter(container) : container;
+        if (rows.isEmpty() || newRows.isEmpty()) { return false; }
+
+        // unique keys
+        const auto rowKeys = [this](const ContainerType &objects, QVector<QString> &keys, QHash<QString, int> &keyRows) {
+            keys.reserve(objects.size());
+            keyRows.reserve(objects.size());
+            for (const ObjectType &object : objects)
+            {
+                const QString key = this->getRowKey(object);
+                if (key.isEmpty() || keyRows.contains(key)) { return false; }
+                keyRows.insert(key, keys.size());
+                keys.push_back(key);
+            }
+            return true;
+        };
+        QVector<QString> keys;
+        QVector<QString> newKeys;
+        QHash<QString, int> oldRows;
+        QHash<QString, int> newKeyRows;
+        if (!rowKeys(rows, keys, oldRows) || !rowKeys(newRows, newKeys, newKeyRows)) { return false; }
+
+        // mostly new rows, a reset is cheaper
+        const int common = static_cast<int>(std::count_if(keys.cbegin(), keys.cend(), [&](const QString &key) { return newKeyRows.contains(key); }));
+        if (common < qMax(keys.size(), newKeys.size()) / 2) { return false; }
+
+        // removed rows, bottom up in contiguous ranges
+        bool rowsChanged = false;
+        for (int row = keys.size() - 1; row >= 0;)
+        {
+            if (newKeyRows.contains(keys[row]))
+            {
+                row--;
+                continue;
+            }
+            const int last = row;
+            while (row >= 0 && !newKeyRows.contains(keys[row])) { row--; }
+            const int first = row + 1;
+            this->beginRemoveRows(QModelIndex(), first, last);
+            rows.erase(rows.begin() + first, rows.begin() + last + 1);
+            keys.remove(first, last - first + 1);
+            this->endRemoveRows();
+            rowsChanged = true;
+        }
+
+        // moved rows, the remaining rows in the new order, persistent indexes (selection) move along
+        QVector<int> order(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return newKeyRows.value(keys[a]) < newKeyRows.value(keys[b]); });
+        bool moved = false;
+        for (int i = 0; i < order.size() && !moved; ++i) { moved = order[i] != i; }
+        if (moved)
+        {
+            emit this->layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+            QVector<int> newRowOfRow(order.size());
+            ContainerType reordered;
+            QVector<QString> reorderedKeys;
+            reorderedKeys.reserve(order.size());
+            for (int i = 0; i < order.size(); ++i)
+            {
+                newRowOfRow[order[i]] = i;
+                reordered.push_back(rows[order[i]]);
+                reorderedKeys.push_back(keys[order[i]]);
+            }
+            rows = reordered;
+            keys = reorderedKeys;
+            const QModelIndexList persistentIndexes = this->persistentIndexList();
+            for (const QModelIndex &index : persistentIndexes)
+            {
+                if (index.row() < 0 || index.row() >= newRowOfRow.size()) { continue; }
+                this->changePersistentIndex(index, this->index(newRowOfRow[index.row()], index.column()));
+            }
+            emit this->layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+            rowsChanged = true;
+        }
+
+        // inserted rows, in contiguous ranges
+        for (int row = 0; row < newKeys.size();)
+        {
+            if (row < keys.size() && keys[row] == newKeys[row])
+            {
+                row++;
+                continue;
+            }
+            Q_ASSERT_X(!oldRows.contains(newKeys[row]), Q_FUNC_INFO, "Expect a new row");
+            int last = row;
+            while (last + 1 < newKeys.size() && !oldRows.contains(newKeys[last + 1])) { last++; }
+            this->beginInsertRows(QModelIndex(), row, last);
+            for (int r = row; r <= last; ++r)
+            {
+                rows.insert(rows.begin() + r, newRows[r]);
+                keys.insert(r, newKeys[r]);
+            }
+            this->endInsertRows();
+            rowsChanged = true;
+            row = last + 1;
+        }
+
+        // changed rows, one signal for all of them
+        int firstChanged = -1;
+        int lastChanged = -1;
+        for (int row = 0; row < rows.size(); ++row)
+        {
+            if (std::as_const(rows)[row] == newRows[row]) { continue; }
+            rows[row] = newRows[row];
+            if (firstChanged < 0) { firstChanged = row; }
+            lastChanged = row;
+        }
+        m_container = container; // same rows, shared data
+
+        if (firstChanged >= 0)
+        {
+            // also emits modelDataChanged, see onDataChanged
+            emit this->dataChanged(this->index(firstChanged, 0), this->index(lastChanged, this->columnCount() - 1));
+        }
+        else if (rowsChanged)
+        {
+            this->emitModelDataChanged();
+        }
+        return true;
+    }
+
     template <typename T, bool UseCompare>
     void CListModelBase<T, UseCompare>::update(const QModelIndex &index, const ObjectType &object)
     {
@@ -253,7 +406,7 @@ namespace BlackGui::Models
     void CListModelBase<T, UseCompare>::removeFilter()
     {
         if (!this->hasFilter()) { return; }
-        m_filter.reset(nullptr);
+        m_filter.reset();
         this->beginResetModel();
         this->updateFilteredContainer();
         this->endResetModel();
@@ -278,7 +431,7 @@ namespace BlackGui::Models
         {
             m_filter = std::move(filter);
             this->beginResetModel();
-            this->updateFilteredContainer();
+            this->updateFilteredContainerMaybeInBackground();
             this->endResetModel();
             this->emitModelDataChanged();
         }
@@ -444,6 +597,7 @@ namespace BlackGui::Models
     template <typename T, bool UseCompare>
     void CListModelBase<T, UseCompare>::updateFilteredContainer()
     {
+        this->cancelBackgroundFilter();
         if (this->hasFilter())
         {
             m_containerFiltered = m_filter->filter(m_container);
@@ -454,6 +608,104 @@ namespace BlackGui::Models
         }
     }
 
+    template <typename T, bool UseCompare>
+    void CListModelBase<T, UseCompare>::updateFilteredContainerMaybeInBackground()
+    {
+        if (!this->hasFilter() || !m_backgroundFiltering || m_container.size() < backgroundFilterThreshold)
+        {
+            this->updateFilteredContainer();
+            return;
+        }
+        this->cancelBackgroundFilter();
+        m_containerFiltered.clear();
+        this->startBackgroundFilter();
+    }
+
+    template <typename T, bool UseCompare>
+    void CListModelBase<T, UseCompare>::startBackgroundFilter()
+    {
+        // search indexes are kept as long as the container does not change
+        if (m_searchIndexContainer != m_container)
+        {
+            m_searchIndexes.clear();
+            m_searchIndexContainer = m_container;
+        }
+
+        const int generation = m_filterGeneration;
+        const ContainerType container = m_container;
+        const std::shared_ptr<const IModelFilter<ContainerType>> filter = m_filter;
+        const SearchIndexes indexes = m_searchIndexes;
+        m_filterWorker = CWorker::fromTask(this, "ModelFilter", [this, generation, container, filter, indexes]() {
+            // the next filter abandons this one
+            const QThread *thread = QThread::currentThread();
+
+            // only rows matching all search terms are passed to the filter
+            SearchIndexes newIndexes;
+            QVector<int> rows;
+            bool allRows = true;
+            for (const auto &term : filter->getSearchTerms())
+            {
+                if (thread->isInterruptionRequested()) { return; }
+                std::shared_ptr<const CFilterSearchIndex> index = indexes.value(term.first);
+                if (!index)
+                {
+                    index = std::make_shared<const CFilterSearchIndex>(CFilterSearchIndex::fromContainer(container, term.first));
+                    newIndexes.insert(term.first, index);
+                }
+                const QVector<int> matchingRows = index->matchingRows(term.second);
+                rows = allRows ? matchingRows : CFilterSearchIndex::intersected(rows, matchingRows);
+                allRows = false;
+            }
+            if (!newIndexes.isEmpty())
+            {
+                QMetaObject::invokeMethod(this, [=] {
+                    if (m_searchIndexContainer != container) { return; }
+                    for (auto it = newIndexes.cbegin(); it != newIndexes.cend(); ++it) { m_searchIndexes.insert(it.key(), it.value()); }
+                }, Qt::QueuedConnection);
+            }
+
+            // filtered in chunks, matching rows are shown as they are found
+            const int count = allRows ? container.size() : rows.size();
+            for (int first = 0; first < count; first += BackgroundFilterChunkSize)
+            {
+                if (thread->isInterruptionRequested()) { return; }
+                ContainerType chunk;
+                const int last = qMin(count, first + BackgroundFilterChunkSize);
+                for (int i = first; i < last; ++i) { chunk.push_back(container[allRows ? i : rows[i]]); }
+                const ContainerType filtered = filter->filter(chunk);
+                if (filtered.isEmpty()) { continue; }
+                QMetaObject::invokeMethod(this, [=] { this->appendFilteredRows(generation, filtered); }, Qt::QueuedConnection);
+            }
+            QMetaObject::invokeMethod(this, [=] { this->backgroundFilterFinished(generation); }, Qt::QueuedConnection);
+        });
+    }
+
+    template <typename T, bool UseCompare>
+    void CListModelBase<T, UseCompare>::cancelBackgroundFilter()
+    {
+        ++m_filterGeneration;
+        if (m_filterWorker) { m_filterWorker->abandon(); }
+        m_filterWorker.clear();
+    }
+
+    template <typename T, bool UseCompare>
+    void CListModelBase<T, UseCompare>::appendFilteredRows(int generation, const ContainerType &rows)
+    {
+        if (generation != m_filterGeneration || m_modelDestroyed) { return; }
+        const int first = m_containerFiltered.size();
+        this->beginInsertRows(QModelIndex(), first, first + rows.size() - 1);
+        m_containerFiltered.push_back(rows);
+        this->endInsertRows();
+    }
+
+    template <typename T, bool UseCompare>
+    void CListModelBase<T, UseCompare>::backgroundFilterFinished(int generation)
+    {
+        if (generation != m_filterGeneration || m_modelDestroyed) { return; }
+        m_filterWorker.clear();
+        this->emitModelDataChanged();
+    }
+
     template <typename T, bool UseCompare>
     void CListModelBase<T, UseCompare>::emitModelDataChanged()
     {
@@ -551,13 +803,48 @@ namespace BlackGui::Models
         // sort the values
         const auto tieBreakersCopy = m_sortTieBreakers; //! \todo workaround T579 still not thread-safe, but less likely to crash
         const std::integral_constant<bool, UseCompare> marker {};
+        QVector<CPropertyAccessor<ObjectType>> accessors({ CPropertyAccessor<ObjectType>(propertyIndex) });
+        for (const CPropertyIndex &tieBreaker : tieBreakersCopy) { accessors.push_back(CPropertyAccessor<ObjectType>(tieBreaker)); }
         const auto p = [=](const ObjectType &a, const ObjectType &b) -> bool {
-            return Private::compareForModelSort<ObjectType>(a, b, order, propertyIndex, tieBreakersCopy, marker);
+            // indexes resolved once, not for every comparison
+            if constexpr (UseCompare) { return Private::compareForModelSort<ObjectType>(a, b, order, accessors); }
+            else { return Private::compareForModelSort<ObjectType>(a, b, order, propertyIndex, tieBreakersCopy, marker); }
         };
 
+        // larger containers: sort column extracted once, the comparator only for equal keys
+        const CModelSortKeys keys = CModelSortKeys::fromContainer(container, propertyIndex, UseCompare);
+        if (keys.isValid())
+        {
+            const QVector<int> rows = keys.sortedRows(order, [&](int a, int b) { return p(container[a], container[b]); });
+
+            // keys and comparePropertyByIndex can order differently, then the comparator is used
+            bool sorted = true;
+            for (int i = 1; i < rows.size() && sorted; ++i) { sorted = !p(container[rows[i]], container[rows[i - 1]]); }
+            if (sorted)
+            {
+                ContainerType sortedContainer;
+                for (int row : rows) { sortedContainer.push_back(container[row]); }
+                return sortedContainer;
+            }
+        }
+
         return container.sorted(p);
     }
 
+    template <typename T, bool UseCompare>
+    const CPropertyAccessor<typename CListModelBase<T, UseCompare>::ObjectType> &CListModelBase<T, UseCompare>::columnAccessor(int column, const CPropertyIndex &index) const
+    {
+        if (column >= m_columnAccessors.size()) { m_columnAccessors.resize(column + 1); }
+        CPropertyAccessor<ObjectType> &accessor = m_columnAccessors[column];
+        if (accessor.getIndex() != index)
+        {
+            // columns redefined, e.g. by another mode
+            accessor = CPropertyAccessor<ObjectType>(index);
+            this->clearDisplayCache();
+        }
+        return accessor;
+    }
+
     template <typename T, bool UseCompare>
     QMimeData *CListModelBase<T, UseCompare>::mimeData(const QModelIndexList &indexes) const
     {
@@ -6,14 +6,17 @@
 #ifndef BLACKGUI_MODELS_LISTMODELBASE_H
 #define BLACKGUI_MODELS_LISTMODELBASE_H
 
+#include "blackgui/models/filtersearchindex.h"
 #include "blackgui/models/listmodelbasenontemplate.h"
 #include "blackgui/models/modelfilter.h"
 #include "blackgui/models/selectionmodel.h"
+#include "blackmisc/propertyaccessor.h"
 
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QModelIndex>
 #include <QModelIndexList>
+#include <QPointer>
 #include <QString>
 #include <QVariant>
 #include <QVector>
@@ -40,7 +43,7 @@ namespace BlackGui::Models
         using ObjectType = typename T::value_type;
 
         //! Destructor
-        virtual ~CListModelBase() override {}
+        virtual ~CListModelBase() override;
 
         //! \name Functions from QStandardItemModel
         //! @{
@@ -99,6 +102,7 @@ namespace BlackGui::Models
         //! Update by new container
         //! \return int size after update
         //! \remarks a sorting is performed only if a valid sort column is set
+        //! \remarks objects with row keys are updated by a row diff, otherwise the model is reset
         virtual int update(const ContainerType &container, bool sort = true);
 
         //! Asynchronous update
@@ -195,16 +199,62 @@ namespace BlackGui::Models
         virtual void onChangedDigest() override;
         //! @}
 
+        //! Unique key of an object for incremental updates, empty if there is no key
+        //! \sa setIncrementalUpdates
+        virtual QString getRowKey(const ObjectType &object) const
+        {
+            Q_UNUSED(object)
+            return {};
+        }
+
         //! Update filtered container
         void updateFilteredContainer();
 
         //! Model changed
         void emitModelDataChanged();
 
+        //! Update the displayed rows by inserting, removing, moving and changing rows
+        //! \return false if a reset is needed, e.g. for missing or duplicate keys or mostly new rows
+        bool updateIncrementally(const ContainerType &container);
+
+        //! Update the filtered container for a changed filter, large containers are filtered in background
+        //! \remark like updateFilteredContainer to be called between beginResetModel and endResetModel,
+        //!         rows found in background are inserted later
+        //! \remark data updates use updateFilteredContainer, so selection and view sizes stay valid
+        void updateFilteredContainerMaybeInBackground();
+
+        //! Property of a column resolved against ObjectType, cached per column
+        const BlackMisc::CPropertyAccessor<ObjectType> &columnAccessor(int column, const BlackMisc::CPropertyIndex &index) const;
+
         ContainerType m_container; //!< used container
         ContainerType m_containerFiltered; //!< cache for filtered container data
-        std::unique_ptr<IModelFilter<ContainerType>> m_filter; //!< used filter
+        std::shared_ptr<IModelFilter<ContainerType>> m_filter; //!< used filter, shared with the background filter
         ISelectionModel<ContainerType> *m_selectionModel = nullptr; //!< selection model
+        mutable QVector<BlackMisc::CPropertyAccessor<ObjectType>> m_columnAccessors; //!< \sa columnAccessor
+
+    private:
+        //! Search indexes by property
+        using SearchIndexes = QHash<BlackMisc::CPropertyIndex, std::shared_ptr<const CFilterSearchIndex>>;
+
+        //! Rows filtered in background per chunk
+        static constexpr int BackgroundFilterChunkSize = 2048;
+
+        //! Filter m_container in background
+        void startBackgroundFilter();
+
+        //! Stop a running background filter, its results are ignored
+        void cancelBackgroundFilter();
+
+        //! Rows found by the background filter
+        void appendFilteredRows(int generation, const ContainerType &rows);
+
+        //! Background filter finished
+        void backgroundFilterFinished(int generation);
+
+        QPointer<BlackMisc::CWorker> m_filterWorker; //!< running background filter
+        int m_filterGeneration = 0; //!< incremented for each filter run, results of older runs are ignored
+        ContainerType m_searchIndexContainer; //!< container of the search indexes
+        SearchIndexes m_searchIndexes; //!< search indexes of m_searchIndexContainer, built by the background filter
     };
 
     namespace Private
@@ -225,6 +275,18 @@ namespace BlackGui::Models
             return (order == Qt::AscendingOrder) ? (c < 0) : (c > 0);
         }
 
+        //! Sort with compiled accessors, the sort property followed by the tie breakers
+        template <class ObjectType>
+        bool compareForModelSort(const ObjectType &a, const ObjectType &b, Qt::SortOrder order, const QVector<BlackMisc::CPropertyAccessor<ObjectType>> &accessors)
+        {
+            for (const BlackMisc::CPropertyAccessor<ObjectType> &accessor : accessors)
+            {
+                const int c = accessor.compare(a, b);
+                if (c != 0) { return (order == Qt::AscendingOrder) ? (c < 0) : (c > 0); }
+            }
+            return false;
+        }
+
         //! Sort without compare function
         template <typename ObjectType>
         bool compareForModelSort(const ObjectType &a, const ObjectType &b, Qt::SortOrder order, const BlackMisc::CPropertyIndex &index, const BlackMisc::CPropertyIndexList &tieBreakers, std::false_type)
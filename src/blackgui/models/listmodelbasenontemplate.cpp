@@ -179,6 +179,30 @@ namespace BlackGui::Models
 
         // connect
         connect(this, &CListModelBaseNonTemplate::dataChanged, this, &CListModelBaseNonTemplate::onDataChanged);
+
+        // cached display data is only valid until the rows change
+        connect(this, &CListModelBaseNonTemplate::dataChanged, this, &CListModelBaseNonTemplate::clearDisplayCache);
+        connect(this, &CListModelBaseNonTemplate::modelReset, this, &CListModelBaseNonTemplate::clearDisplayCache);
+        connect(this, &CListModelBaseNonTemplate::layoutChanged, this, &CListModelBaseNonTemplate::clearDisplayCache);
+        connect(this, &CListModelBaseNonTemplate::rowsInserted, this, &CListModelBaseNonTemplate::clearDisplayCache);
+        connect(this, &CListModelBaseNonTemplate::rowsRemoved, this, &CListModelBaseNonTemplate::clearDisplayCache);
+        connect(this, &CListModelBaseNonTemplate::rowsMoved, this, &CListModelBaseNonTemplate::clearDisplayCache);
+    }
+
+    void CListModelBaseNonTemplate::setDisplayCacheSize(int cells)
+    {
+        m_displayCache.setMaxCost(qMax(0, cells));
+    }
+
+    const QVariant *CListModelBaseNonTemplate::cachedDisplayData(const QModelIndex &index) const
+    {
+        return m_displayCache.object(displayCacheKey(index));
+    }
+
+    void CListModelBaseNonTemplate::cacheDisplayData(const QModelIndex &index, const QVariant &data) const
+    {
+        if (m_displayCache.maxCost() < 1) { return; }
+        m_displayCache.insert(displayCacheKey(index), new QVariant(data));
     }
 
 } // namespace
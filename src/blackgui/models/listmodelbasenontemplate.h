@@ -13,6 +13,7 @@
 #include "blackmisc/digestsignal.h"
 #include "blackmisc/variant.h"
 
+#include <QCache>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QModelIndex>
@@ -43,6 +44,12 @@ namespace BlackGui::Models
         //! Number of elements when to use asynchronous updates
         static constexpr int asyncThreshold = 50;
 
+        //! Number of elements when a filter is applied in background
+        static constexpr int backgroundFilterThreshold = 5000;
+
+        //! Number of formatted cells kept by default
+        static constexpr int displayCacheSize = 10000;
+
         //! Destructor
         virtual ~CListModelBaseNonTemplate() override {}
 
@@ -144,6 +151,27 @@ namespace BlackGui::Models
         //! Using void column at the end?
         bool endsWithEmptyColumn() const { return m_columns.endsWithEmptyColumn(); }
 
+        //! Update by a diff of the rows instead of a model reset, if the objects have unique keys
+        void setIncrementalUpdates(bool incremental) { m_incrementalUpdates = incremental; }
+
+        //! Update by a diff of the rows?
+        bool isIncrementalUpdates() const { return m_incrementalUpdates; }
+
+        //! Filter large containers in background, the matching rows are inserted as they are found
+        void setBackgroundFiltering(bool background) { m_backgroundFiltering = background; }
+
+        //! Filter large containers in background?
+        bool isBackgroundFiltering() const { return m_backgroundFiltering; }
+
+        //! Formatted display data of the least recently shown cells is kept, 0 switches the cache off
+        void setDisplayCacheSize(int cells);
+
+        //! Number of formatted cells kept
+        int getDisplayCacheSize() const { return m_displayCache.maxCost(); }
+
+        //! Number of formatted cells currently cached
+        int getDisplayCacheCount() const { return m_displayCache.count(); }
+
     signals:
         //! Asynchronous update finished
         void asyncUpdateFinished();
@@ -178,14 +206,29 @@ namespace BlackGui::Models
         //! \param parent
         CListModelBaseNonTemplate(const QString &translationContext, QObject *parent = nullptr);
 
+        //! Cached display data of a cell, nullptr if not cached
+        const QVariant *cachedDisplayData(const QModelIndex &index) const;
+
+        //! Cache display data of a cell
+        void cacheDisplayData(const QModelIndex &index, const QVariant &data) const;
+
+        //! Forget all cached display data, for changes not signalled by the model
+        void clearDisplayCache() const { m_displayCache.clear(); }
+
         CColumns m_columns; //!< columns metadata
         int m_sortColumn; //!< currently sorted column
         bool m_modelDestroyed = false; //!< \todo rudimentary workaround for T579, can be removed
+        bool m_incrementalUpdates = true; //!< update by row diff if the objects have keys
+        bool m_backgroundFiltering = true; //!< filter large containers in background
         Qt::SortOrder m_sortOrder; //!< sort order (asc/desc)
         Qt::DropActions m_dropActions = Qt::IgnoreAction; //!< drop actions
         BlackMisc::CPropertyIndexList m_sortTieBreakers; //!< how column values are sorted if equal, if no value is given this is random
 
     private:
+        //! Key of a cell in the display cache
+        static quint64 displayCacheKey(const QModelIndex &index) { return (static_cast<quint64>(index.row()) << 32) | static_cast<quint32>(index.column()); }
+
+        mutable QCache<quint64, QVariant> m_displayCache { displayCacheSize }; //!< formatted display data by cell, least recently used are dropped
         BlackMisc::CDigestSignal m_dsModelsChanged { this, &CListModelBaseNonTemplate::changed, &CListModelBaseNonTemplate::onChangedDigest, 500, 10 };
     };
 
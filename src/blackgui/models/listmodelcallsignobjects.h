@@ -64,6 +64,9 @@ namespace BlackGui::Models
         //! Constructor
         CListModelCallsignObjects(const QString &translationContext, QObject *parent = nullptr);
 
+        //! \copydoc BlackGui::Models::CListModelBase::getRowKey
+        virtual QString getRowKey(const ObjectType &object) const override { return object.getCallsign().asString(); }
+
     private:
         BlackMisc::Aviation::CCallsignSet m_highlightCallsigns; //!< callsigns to be highlighted
         QColor m_highlightColor = Qt::green;
@@ -72,6 +72,9 @@ namespace BlackGui::Models
         //! Constructor
         CListModelDbObjects(const QString &translationContext, QObject *parent = nullptr);
 
+        //! \copydoc BlackGui::Models::CListModelBase::getRowKey
+        virtual QString getRowKey(const ObjectType &object) const override { return object.getDbKeyAsString(); }
+
     private:
         QList<KeyType> m_highlightKeys; //!< keys to be highlighted
         QColor m_highlightColor = Qt::green;
@@ -67,6 +67,15 @@ namespace BlackGui::Models
         return outContainer;
     }
 
+    QList<CLiveryFilter::SearchTerm> CLiveryFilter::getSearchTerms() const
+    {
+        QList<SearchTerm> terms;
+        if (!this->isEnabled() || m_id >= 0) { return terms; }
+        if (!m_combinedCode.isEmpty()) { terms.push_back({ CLivery::IndexCombinedCode, m_combinedCode }); }
+        if (!m_description.isEmpty()) { terms.push_back({ CLivery::IndexDescription, m_description }); }
+        return terms;
+    }
+
     bool CLiveryFilter::valid() const
     {
         if (filterByLiveryType()) { return true; }
@@ -34,6 +34,9 @@ namespace BlackGui::Models
         //! \copydoc IModelFilter::filter
         virtual BlackMisc::Aviation::CLiveryList filter(const BlackMisc::Aviation::CLiveryList &inContainer) const override;
 
+        //! \copydoc IModelFilter::getSearchTerms
+        virtual QList<SearchTerm> getSearchTerms() const override;
+
     private:
         int m_id = -1;
         QString m_combinedCode;
@@ -22,8 +22,11 @@
 #include "blackmisc/simulation/distributorlist.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/statusmessagelist.h"
+#include "blackmisc/propertyindex.h"
 #include "blackmisc/variant.h"
 
+#include <QList>
+#include <QPair>
 #include <QString>
 #include <Qt>
 #include <memory>
@@ -56,6 +59,13 @@ namespace BlackGui::Models
         //! Return an implementation-specific value object representing the filter
         virtual BlackMisc::CVariant getAsValueObject() const { return {}; }
 
+        //! Property and filter expression, matched as by stringMatchesFilterExpression
+        using SearchTerm = QPair<BlackMisc::CPropertyIndex, QString>;
+
+        //! Terms every object passing the filter matches
+        //! \remark used to preselect the rows by a search index, the filter is still applied to those rows
+        virtual QList<SearchTerm> getSearchTerms() const { return {}; }
+
     protected:
         //! Standard string search supporting wildcard at begin and end: "*xyz", "abc*"
         bool stringMatchesFilterExpression(const QString &value, const QString &filter, Qt::CaseSensitivity cs = Qt::CaseInsensitive) const;
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#include "blackgui/models/modelsortkeys.h"
+
+#include <QDateTime>
+#include <QThread>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+
+using namespace BlackMisc;
+
+namespace BlackGui::Models
+{
+    CModelSortKeys::CModelSortKeys(const QVector<CVariant> &values, bool caseInsensitive)
+    {
+        if (values.isEmpty()) { return; }
+
+        // mixed types are ordered by type first, left to the comparator
+        const int userType = values.front().userType();
+        for (const CVariant &value : values)
+        {
+            if (value.userType() != userType) { return; }
+        }
+
+        const CVariant &first = values.front();
+        if (first.isArithmetic())
+        {
+            m_numbers.reserve(values.size());
+            for (const CVariant &value : values) { m_numbers.push_back(value.toDouble()); }
+            m_type = NumericKeys;
+        }
+        else if (userType == QMetaType::QDateTime)
+        {
+            m_timestamps.reserve(values.size());
+            for (const CVariant &value : values)
+            {
+                const QDateTime ts = value.toDateTime();
+                m_timestamps.push_back(ts.isValid() ? ts.toMSecsSinceEpoch() : std::numeric_limits<qint64>::min());
+            }
+            m_type = TimestampKeys;
+        }
+        else if (userType == QMetaType::QString)
+        {
+            m_strings.reserve(values.size());
+            for (const CVariant &value : values)
+            {
+                const QString s = value.getQVariant().toString();
+                m_strings.push_back(caseInsensitive ? s.toCaseFolded() : s);
+            }
+            m_type = StringKeys;
+        }
+        else { return; }
+
+        m_size = values.size();
+    }
+
+    QVector<int> CModelSortKeys::sortedRows(Qt::SortOrder order, const RowLess &tieLess, int *changedRows) const
+    {
+        const bool ascending = (order == Qt::AscendingOrder);
+        const RowLess less = [&](int a, int b) {
+            const int c = this->compareKeys(a, b);
+            if (c != 0) { return ascending ? c < 0 : c > 0; }
+            return tieLess(a, b);
+        };
+
+        // Rows already in order are kept, a row out of order was changed or added.
+        // If a row does not fit, either the row or the row before is the one out of order.
+        QVector<int> inOrder;
+        QVector<int> changed;
+        inOrder.reserve(m_size);
+        for (int row = 0; row < m_size; ++row)
+        {
+            if (inOrder.isEmpty() || !less(row, inOrder.back()))
+            {
+                inOrder.push_back(row);
+            }
+            else if (inOrder.size() < 2 || !less(row, inOrder[inOrder.size() - 2]))
+            {
+                changed.push_back(inOrder.back());
+                inOrder.back() = row;
+            }
+            else
+            {
+                changed.push_back(row);
+            }
+        }
+        if (changedRows) { *changedRows = changed.size(); }
+        if (changed.isEmpty()) { return inOrder; }
+
+        // many changes, sort all rows
+        if (changed.size() > m_size / 8)
+        {
+            QVector<int> rows(m_size);
+            std::iota(rows.begin(), rows.end(), 0);
+            parallelSort(rows, less);
+            if (changedRows) { *changedRows = m_size; }
+            return rows;
+        }
+
+        // only the changed rows are sorted and merged in
+        parallelSort(changed, less);
+        QVector<int> rows(m_size);
+        std::merge(inOrder.cbegin(), inOrder.cend(), changed.cbegin(), changed.cend(), rows.begin(), less);
+        return rows;
+    }
+
+    QVector<QPair<int, int>> CModelSortKeys::chunks(int rows)
+    {
+        constexpr int minChunkSize = 2048;
+        const int count = qBound(1, rows / minChunkSize, qMax(1, QThread::idealThreadCount()));
+        QVector<QPair<int, int>> chunks;
+        chunks.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            chunks.push_back({ static_cast<int>(static_cast<qint64>(rows) * i / count), static_cast<int>(static_cast<qint64>(rows) * (i + 1) / count) });
+        }
+        return chunks;
+    }
+
+    int CModelSortKeys::compareKeys(int a, int b) const
+    {
+        switch (m_type)
+        {
+        case NumericKeys:
+            if (m_numbers[a] < m_numbers[b]) { return -1; }
+            return m_numbers[b] < m_numbers[a] ? 1 : 0;
+        case TimestampKeys:
+            if (m_timestamps[a] < m_timestamps[b]) { return -1; }
+            return m_timestamps[b] < m_timestamps[a] ? 1 : 0;
+        case StringKeys: return m_strings[a].compare(m_strings[b]);
+        default: break;
+        }
+        return 0;
+    }
+
+    void CModelSortKeys::parallelSort(QVector<int> &rows, const RowLess &less)
+    {
+        const QVector<QPair<int, int>> parts = chunks(rows.size());
+        if (parts.size() < 2)
+        {
+            std::sort(rows.begin(), rows.end(), less);
+            return;
+        }
+
+        // sort the chunks, then merge neighbours until one range is left
+        int *data = rows.data();
+        QtConcurrent::blockingMap(parts, [&](const QPair<int, int> &part) {
+            std::sort(data + part.first, data + part.second, less);
+        });
+
+        QVector<QPair<int, int>> ranges = parts;
+        while (ranges.size() > 1)
+        {
+            QVector<std::array<int, 3>> merges;
+            QVector<QPair<int, int>> merged;
+            for (int i = 0; i + 1 < ranges.size(); i += 2)
+            {
+                merges.push_back({ { ranges[i].first, ranges[i].second, ranges[i + 1].second } });
+                merged.push_back({ ranges[i].first, ranges[i + 1].second });
+            }
+            if (ranges.size() % 2 != 0) { merged.push_back(ranges.back()); }
+
+            QtConcurrent::blockingMap(merges, [&](const std::array<int, 3> &merge) {
+                std::inplace_merge(data + merge[0], data + merge[1], data + merge[2], less);
+            });
+            ranges = merged;
+        }
+    }
+} // namespace
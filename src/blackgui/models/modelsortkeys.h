@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKGUI_MODELS_MODELSORTKEYS_H
+#define BLACKGUI_MODELS_MODELSORTKEYS_H
+
+#include "blackgui/blackguiexport.h"
+#include "blackmisc/propertyaccessor.h"
+#include "blackmisc/propertyindex.h"
+#include "blackmisc/variant.h"
+
+#include <QString>
+#include <QVector>
+#include <QtConcurrentMap>
+#include <functional>
+
+namespace BlackGui::Models
+{
+    /*!
+     * Sort keys of a model column, extracted once per row instead of for every comparison.
+     *
+     * Numeric, timestamp and string properties are stored as typed keys, rows are sorted
+     * by the keys and ties are resolved by the comparator of the model (tie breakers).
+     * Large containers are sorted in parallel. If only a few rows are out of order,
+     * as after an incremental update of a sorted container, only those rows are sorted
+     * and merged into the others.
+     */
+    class BLACKGUI_EXPORT CModelSortKeys
+    {
+    public:
+        //! Type of the keys
+        enum KeyType
+        {
+            NoKeys, //!< not supported, sort with the comparator
+            NumericKeys,
+            TimestampKeys,
+            StringKeys
+        };
+
+        //! Containers smaller than this are sorted with the comparator only
+        static constexpr int MinRows = 256;
+
+        //! Rows compared as a less than b
+        using RowLess = std::function<bool(int a, int b)>;
+
+        //! Keys of the property for all objects of the container, extracted in parallel
+        //! \param container       the objects
+        //! \param index           sort property
+        //! \param caseInsensitive strings are compared case insensitive, as comparePropertyByIndex normally does
+        //! \remark properties with typed accessors are read directly, others by propertyByIndex
+        //! \threadsafe as propertyByIndex
+        template <class Container>
+        static CModelSortKeys fromContainer(const Container &container, const BlackMisc::CPropertyIndex &index, bool caseInsensitive)
+        {
+            using ObjectType = typename Container::value_type;
+            const int rows = container.size();
+            if (rows < MinRows) { return {}; }
+
+            const BlackMisc::CPropertyAccessor<ObjectType> accessor(index);
+            CModelSortKeys keys;
+            switch (accessor.getKeyType())
+            {
+            case BlackMisc::CPropertyAccessorTable<ObjectType>::StringKey:
+            {
+                const bool fold = caseInsensitive && accessor.getCaseSensitivity() == Qt::CaseInsensitive;
+                keys.m_strings = extract<QString>(container, [&](const ObjectType &object) {
+                    return fold ? accessor.string(object).toCaseFolded() : accessor.string(object);
+                });
+                keys.m_type = StringKeys;
+                break;
+            }
+            case BlackMisc::CPropertyAccessorTable<ObjectType>::NumericKey:
+                keys.m_numbers = extract<double>(container, [&](const ObjectType &object) { return accessor.number(object); });
+                keys.m_type = NumericKeys;
+                break;
+            case BlackMisc::CPropertyAccessorTable<ObjectType>::TimestampKey:
+                keys.m_timestamps = extract<qint64>(container, [&](const ObjectType &object) { return accessor.timestamp(object); });
+                keys.m_type = TimestampKeys;
+                break;
+            default:
+                return CModelSortKeys(extract<BlackMisc::CVariant>(container, [&](const ObjectType &object) { return object.propertyByIndex(index); }), caseInsensitive);
+            }
+            keys.m_size = rows;
+            return keys;
+        }
+
+        //! Default constructor, no keys
+        CModelSortKeys() = default;
+
+        //! Keys from the property values of all rows
+        CModelSortKeys(const QVector<BlackMisc::CVariant> &values, bool caseInsensitive);
+
+        //! Usable keys?
+        bool isValid() const { return m_type != NoKeys; }
+
+        //! Type of the keys
+        KeyType getType() const { return m_type; }
+
+        //! Number of rows
+        int size() const { return m_size; }
+
+        //! Sorted row order
+        //! \param order       ascending or descending
+        //! \param tieLess     comparator of the model, only used for rows with equal keys
+        //! \param changedRows optional, rows which had to be sorted, the others were already in order
+        //! \threadsafe
+        QVector<int> sortedRows(Qt::SortOrder order, const RowLess &tieLess, int *changedRows = nullptr) const;
+
+        //! Ranges [first, second) of the rows for parallel processing
+        static QVector<QPair<int, int>> chunks(int rows);
+
+    private:
+        //! Value of each object of the container, in parallel chunks
+        template <class Value, class Container, class F>
+        static QVector<Value> extract(const Container &container, F &&value)
+        {
+            QVector<Value> values(container.size());
+            Value *data = values.data();
+            QVector<QPair<int, int>> parts = chunks(container.size());
+            QtConcurrent::blockingMap(parts, [&](const QPair<int, int> &chunk) {
+                for (int row = chunk.first; row < chunk.second; ++row) { data[row] = value(container[row]); }
+            });
+            return values;
+        }
+
+        //! Compare the keys of 2 rows, ascending
+        int compareKeys(int a, int b) const;
+
+        //! Full sort of the rows, in parallel for large containers
+        static void parallelSort(QVector<int> &rows, const RowLess &less);
+
+        KeyType m_type = NoKeys;
+        int m_size = 0;
+        QVector<double> m_numbers;
+        QVector<qint64> m_timestamps;
+        QVector<QString> m_strings;
+    };
+} // namespace
+
+#endif // guard
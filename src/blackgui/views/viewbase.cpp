@@ -56,23 +56,14 @@ namespace BlackGui::Views
         presize = presize || (this->isEmpty() && resize && !reallyResize); // we presize if we wanted to resize but actually do not because of condition
         const bool presizeThresholdReached = presize && container.size() > ResizeSubsetThreshold; // only when size making sense
 
-        // when we will not resize, we might presize
-        if (presizeThresholdReached)
-        {
-            const int presizeRandomElements = this->getPresizeRandomElementsSize(container.size());
-            if (presizeRandomElements > 0)
-            {
-                m_model->update(container.sampleElements(presizeRandomElements), false);
-                this->fullResizeToContents();
-            }
-        }
-
+        // the container is shared with the model, not copied
         const int c = m_model->update(container, sort);
 
         // resize after real update according to mode
-        if (presizeThresholdReached) // cppcheck-suppress knownConditionTrueFalse
+        if (presizeThresholdReached)
         {
-            // currently no furhter actions
+            // when we will not resize, we presize by sampled rows
+            this->sampledResizeToContents();
         }
         else if (reallyResize)
         {
@@ -371,14 +362,8 @@ namespace BlackGui::Views
         const int rc = this->rowCount();
         if (rc > ResizeSubsetThreshold)
         {
-            const int presizeRandomElements = this->getPresizeRandomElementsSize(rc);
-            if (presizeRandomElements > 0)
-            {
-                const ContainerType containerBackup(this->container());
-                m_model->update(containerBackup.sampleElements(presizeRandomElements), false);
-                this->fullResizeToContents();
-                m_model->update(containerBackup, false);
-            }
+            // no model updates with a subset, only sampled rows are measured
+            this->sampledResizeToContents();
         }
         else
         {
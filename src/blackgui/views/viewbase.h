@@ -147,9 +147,12 @@ namespace BlackGui
             //! When (row count) to use asynchronous updates
             static constexpr int ASyncRowsCountThreshold = 50;
 
-            //! When to use pre-sizing with random elements
+            //! When to resize columns by sampled rows
             static constexpr int ResizeSubsetThreshold = 250;
 
+            //! Rows measured below the first visible row if the viewport is not yet laid out
+            static constexpr int ResizeSampledVisibleRows = 50;
+
             //! When to use rows resizing (which is slow)
             //! \see rowsResizeModeToContent
             static constexpr int ResizeRowsToContentThreshold = 20;
@@ -378,6 +381,10 @@ namespace BlackGui
             //! Full resizing to content, might be slow
             virtual void fullResizeToContents();
 
+            //! Resize the columns to the contents of sampled rows, also fast for large views
+            //! \remark rows in the viewport and rows spread over the whole view are measured, row heights are kept
+            void sampledResizeToContents();
+
             //! Depending on CViewBaseNonTemplate::ResizeSubsetThreshold presize or fully resize
             virtual void presizeOrFullResizeToContents() = 0;
 
@@ -22,6 +22,7 @@
 #include <QShortcut>
 
 #include <algorithm>
+#include <utility>
 
 using namespace BlackConfig;
 using namespace BlackMisc;
@@ -845,6 +846,43 @@ namespace BlackGui::Views
         **/
     }
 
+    void CViewBaseNonTemplate::sampledResizeToContents()
+    {
+        const QAbstractItemModel *model = this->model();
+        const int rows = this->rowCount();
+        if (!model || rows < 1) { return; }
+
+        // rows in the viewport and rows spread over the view,
+        // unlike resizeColumnsToContents the other rows are not formatted and measured
+        QVector<int> sampleRows;
+        const int firstVisible = qMax(0, this->rowAt(0));
+        int lastVisible = this->rowAt(this->viewport()->height());
+        if (lastVisible < 0) { lastVisible = qMin(rows - 1, firstVisible + ResizeSampledVisibleRows); }
+        for (int row = firstVisible; row <= lastVisible; ++row) { sampleRows.push_back(row); }
+        const int step = qMax(1, rows / qMax(1, this->getPresizeRandomElementsSize(rows)));
+        for (int row = 0; row < rows; row += step) { sampleRows.push_back(row); }
+
+        m_resizeCount++;
+        if (m_forceStretchLastColumnWhenResized)
+        {
+            // toggling forces the stretch, otherwise not working
+            this->horizontalHeader()->setStretchLastSection(false);
+            this->horizontalHeader()->setStretchLastSection(true);
+        }
+
+        const int gridWidth = this->showGrid() ? 1 : 0;
+        for (int column = 0; column < model->columnCount(); ++column)
+        {
+            if (this->isColumnHidden(column)) { continue; }
+            int width = this->horizontalHeader()->sectionSizeHint(column);
+            for (int row : std::as_const(sampleRows))
+            {
+                width = qMax(width, this->sizeHintForIndex(model->index(row, column)).width() + gridWidth);
+            }
+            this->setColumnWidth(column, width);
+        }
+    }
+
     void CViewBaseNonTemplate::customMenuRequested(const QPoint &pos)
     {
         QMenu menu;
@@ -499,6 +499,16 @@ namespace BlackMisc
             //! Get flag indicating this is an interim position update
             bool isInterim() const { return m_isInterim; }
 
+            //! Receive time for the latency trace, -1 if not traced
+            //! \sa Simulation::CLatencyTrace
+            qint64 getTraceReceivedNs() const { return m_traceReceivedNs; }
+
+            //! Set the receive time for the latency trace
+            void setTraceReceivedNs(qint64 receivedNs) { m_traceReceivedNs = receivedNs; }
+
+            //! Traced by the latency trace?
+            bool hasTraceReceivedNs() const { return m_traceReceivedNs >= 0; }
+
             //! Enum to string
             static const QString &isOnGroundToString(IsOnGround onGround);
 
@@ -587,6 +597,7 @@ namespace BlackMisc
             int m_elvInfo = static_cast<int>(CAircraftSituation::NoElevationInfo); //!< where did we gnd.elevation from?
             double m_onGroundFactor = -1; //!< interpolated ground flag, 1..on ground, 0..not on ground, -1 no info
             QString m_onGroundGuessingDetails; //!< only for debugging, not transferred via DBus etc.
+            qint64 m_traceReceivedNs = -1; //!< latency trace, monotonic time of this process, not transferred via DBus etc.
 
             //! Equal double values?
             static bool isDoubleEpsilonEqual(double d1, double d2)
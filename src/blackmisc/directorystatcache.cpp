@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#include "blackmisc/directorystatcache.h"
+#include "blackmisc/fileutils.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QList>
+#include <QPair>
+#include <QReadLocker>
+#include <QVector>
+#include <QWriteLocker>
+#include <QtConcurrentMap>
+
+namespace BlackMisc
+{
+    QSet<QString> CDirectoryStatCache::getExistingFiles(const QSet<QString> &fileNames, const std::atomic_bool &stopped)
+    {
+        QHash<QString, QStringList> filesByDirectory;
+        for (const QString &fileName : fileNames)
+        {
+            if (fileName.isEmpty()) { continue; }
+            filesByDirectory[directoryOf(fileName)].push_back(fileName);
+        }
+
+        QHash<QString, DirectoryEntry> cached;
+        {
+            QReadLocker l(&m_lock);
+            cached = m_directories;
+        }
+
+        // each directory is independent, so they can be checked in parallel
+        const auto checkDirectory = [&](const QString &directory) {
+            CheckedDirectory checked;
+            checked.directory = directory;
+            checked.entry.lastModifiedMs = directoryTimestamp(directory);
+
+            const QStringList files = std::as_const(filesByDirectory).value(directory);
+            const auto it = cached.constFind(directory);
+            if (it != cached.cend() && it->lastModifiedMs == checked.entry.lastModifiedMs)
+            {
+                checked.entry.files = it->files;
+                checked.reused = true;
+            }
+
+            for (const QString &fileName : files)
+            {
+                if (stopped) { break; }
+                if (checked.entry.files.contains(fileName)) { continue; }
+                checked.reused = false;
+                if (checked.entry.lastModifiedMs < 0)
+                {
+                    // directory is gone, no need to stat the files
+                    checked.entry.files.insert(fileName, false);
+                    continue;
+                }
+                const QFileInfo fi(CFileUtils::fixWindowsUncPath(fileName));
+                checked.entry.files.insert(fileName, fi.exists() && fi.isReadable());
+            }
+            return checked;
+        };
+
+        const QList<QString> directories = filesByDirectory.keys();
+        const QList<CheckedDirectory> results = QtConcurrent::blockingMapped<QList<CheckedDirectory>>(directories, checkDirectory);
+
+        QSet<QString> existing;
+        int reused = 0;
+        {
+            QWriteLocker l(&m_lock);
+            for (const CheckedDirectory &checked : results)
+            {
+                if (checked.reused) { reused++; }
+                m_directories.insert(checked.directory, checked.entry);
+            }
+        }
+
+        for (const CheckedDirectory &checked : results)
+        {
+            for (auto it = checked.entry.files.cbegin(); it != checked.entry.files.cend(); ++it)
+            {
+                if (it.value() && fileNames.contains(it.key())) { existing.insert(it.key()); }
+            }
+        }
+
+        m_reusedDirectories = reused;
+        m_checkedDirectories = results.size() - reused;
+        return existing;
+    }
+
+    QHash<QString, qint64> CDirectoryStatCache::getFileTimestamps(const QSet<QString> &fileNames, const std::atomic_bool &stopped)
+    {
+        QHash<QString, QStringList> filesByDirectory;
+        for (const QString &fileName : fileNames)
+        {
+            if (fileName.isEmpty()) { continue; }
+            filesByDirectory[directoryOf(fileName)].push_back(fileName);
+        }
+
+        using FileTimestamps = QVector<QPair<QString, qint64>>;
+        const auto checkDirectory = [&](const QString &directory) {
+            const QStringList files = std::as_const(filesByDirectory).value(directory);
+            const bool exists = directoryTimestamp(directory) >= 0;
+            FileTimestamps timestamps;
+            timestamps.reserve(files.size());
+            for (const QString &fileName : files)
+            {
+                if (stopped) { break; }
+                if (!exists)
+                {
+                    // directory is gone, no need to stat the files
+                    timestamps.push_back({ fileName, -1 });
+                    continue;
+                }
+                const QFileInfo fi(CFileUtils::fixWindowsUncPath(fileName));
+                timestamps.push_back({ fileName, fi.exists() ? fi.lastModified().toMSecsSinceEpoch() : -1 });
+            }
+            return timestamps;
+        };
+
+        const QList<QString> directories = filesByDirectory.keys();
+        const QList<FileTimestamps> results = QtConcurrent::blockingMapped<QList<FileTimestamps>>(directories, checkDirectory);
+
+        QHash<QString, qint64> fileTimestamps;
+        fileTimestamps.reserve(fileNames.size());
+        for (const FileTimestamps &timestamps : results)
+        {
+            for (const auto &timestamp : timestamps) { fileTimestamps.insert(timestamp.first, timestamp.second); }
+        }
+        return fileTimestamps;
+    }
+
+    int CDirectoryStatCache::size() const
+    {
+        QReadLocker l(&m_lock);
+        return m_directories.size();
+    }
+
+    void CDirectoryStatCache::clear()
+    {
+        QWriteLocker l(&m_lock);
+        m_directories.clear();
+    }
+
+    QString CDirectoryStatCache::directoryOf(const QString &fileName)
+    {
+        // no file system access, QFileInfo is lazy
+        return QFileInfo(fileName).absolutePath();
+    }
+
+    qint64 CDirectoryStatCache::directoryTimestamp(const QString &directory)
+    {
+        const QFileInfo fi(CFileUtils::fixWindowsUncPath(directory));
+        if (!fi.exists() || !fi.isDir()) { return -1; }
+        return fi.lastModified().toMSecsSinceEpoch();
+    }
+} // ns
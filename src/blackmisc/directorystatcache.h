@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKMISC_DIRECTORYSTATCACHE_H
+#define BLACKMISC_DIRECTORYSTATCACHE_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QString>
+#include <atomic>
+
+namespace BlackMisc
+{
+    /*!
+     * Caches file existence checks, grouped by directory.
+     * The results of a directory are reused as long as the directory's modification time does not change,
+     * adding, removing or renaming a file changes it.
+     */
+    class BLACKMISC_EXPORT CDirectoryStatCache
+    {
+    public:
+        //! Constructor
+        CDirectoryStatCache() = default;
+
+        //! Those of the given files which exist and are readable
+        //! \remark directories are checked in parallel, unchanged directories are taken from the cache
+        //! \threadsafe
+        QSet<QString> getExistingFiles(const QSet<QString> &fileNames, const std::atomic_bool &stopped);
+
+        //! Modification times of the given files, -1 for missing files
+        //! \remark not cached, editing a file in place does not change its directory, directories are checked in parallel
+        //! \threadsafe
+        static QHash<QString, qint64> getFileTimestamps(const QSet<QString> &fileNames, const std::atomic_bool &stopped);
+
+        //! Directories checked by the last call of getExistingFiles
+        int getCheckedDirectoriesCount() const { return m_checkedDirectories; }
+
+        //! Directories reused from cache by the last call of getExistingFiles
+        int getReusedDirectoriesCount() const { return m_reusedDirectories; }
+
+        //! Number of cached directories
+        //! \threadsafe
+        int size() const;
+
+        //! Clear the cache
+        //! \threadsafe
+        void clear();
+
+        //! Directory of a file, as used as key in the cache
+        static QString directoryOf(const QString &fileName);
+
+    private:
+        //! Cached results of one directory
+        struct DirectoryEntry
+        {
+            qint64 lastModifiedMs = -1; //!< modification time of directory, -1 if not existing
+            QHash<QString, bool> files; //!< file name, exists and is readable
+        };
+
+        //! Result of checking one directory
+        struct CheckedDirectory
+        {
+            QString directory;
+            DirectoryEntry entry;
+            bool reused = false;
+        };
+
+        //! Modification time of the directory, -1 if it does not exist
+        static qint64 directoryTimestamp(const QString &directory);
+
+        mutable QReadWriteLock m_lock; //!< lock for cache
+        QHash<QString, DirectoryEntry> m_directories; //!< directory, results
+        std::atomic_int m_checkedDirectories { 0 };
+        std::atomic_int m_reusedDirectories { 0 };
+    };
+} // ns
+
+#endif // guard
@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#include "blackmisc/geo/geoindex.h"
+#include "blackmisc/math/mathutils.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace BlackMisc::Math;
+
+namespace BlackMisc::Geo
+{
+    namespace
+    {
+        //! As ICoordinateGeodetic::isNull, or not usable at all
+        bool isWithoutPosition(const std::array<double, 3> &v)
+        {
+            if (!std::isfinite(v[0]) || !std::isfinite(v[1]) || !std::isfinite(v[2])) { return true; }
+            return qIsNull(static_cast<float>(v[0])) && qIsNull(static_cast<float>(v[1])) && qIsNull(static_cast<float>(v[2]));
+        }
+
+        double dotProduct(const std::array<double, 3> &v1, const std::array<double, 3> &v2)
+        {
+            return v1[0] * v2[0] + v1[1] * v2[1] + v1[2] * v2[2];
+        }
+
+        double distanceSquared(const std::array<double, 3> &v1, const std::array<double, 3> &v2)
+        {
+            const double dx = v1[0] - v2[0];
+            const double dy = v1[1] - v2[1];
+            const double dz = v1[2] - v2[2];
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+        //! Distances are calculated with floats, a query covers this much more
+        double withSlack(double angleRad) { return angleRad * (1.0 + 1e-5) + 1e-5; }
+    }
+
+    CGeoIndex::CGeoIndex(const QVector<std::array<double, 3>> &normalVectors) : m_normalVectors(normalVectors)
+    {
+        constexpr int cells = LatitudeCells * LongitudeCells;
+        QVector<int> cellOfRow(normalVectors.size(), -1);
+        m_cellBegin.fill(0, cells + 1);
+        for (int row = 0; row < normalVectors.size(); ++row)
+        {
+            const std::array<double, 3> &v = normalVectors[row];
+            if (isWithoutPosition(v))
+            {
+                m_rowsWithoutPosition.push_back(row);
+                continue;
+            }
+            const double latitudeDeg = CMathUtils::rad2deg(std::atan2(v[2], std::hypot(v[0], v[1])));
+            const double longitudeDeg = CMathUtils::rad2deg(std::atan2(v[1], v[0]));
+            const int cell = latitudeCell(latitudeDeg) * LongitudeCells + longitudeCell(longitudeDeg);
+            cellOfRow[row] = cell;
+            m_cellBegin[cell + 1]++;
+        }
+        std::partial_sum(m_cellBegin.cbegin(), m_cellBegin.cend(), m_cellBegin.begin());
+
+        // rows stay ascending within a cell
+        QVector<int> next(m_cellBegin);
+        m_rowsByCell.resize(normalVectors.size() - m_rowsWithoutPosition.size());
+        for (int row = 0; row < cellOfRow.size(); ++row)
+        {
+            if (cellOfRow[row] < 0) { continue; }
+            m_rowsByCell[next[cellOfRow[row]]++] = row;
+        }
+    }
+
+    QVector<int> CGeoIndex::candidatesWithinRange(const std::array<double, 3> &normalVector, double rangeMeters) const
+    {
+        return this->candidatesWithinAngle(normalVector, std::max(0.0, rangeMeters) / EarthRadiusMeters);
+    }
+
+    QVector<int> CGeoIndex::candidatesClosest(int number, const std::array<double, 3> &normalVector) const
+    {
+        if (number < 1) { return {}; }
+
+        // widen the search until the n closest are certainly found,
+        // all rows closer than the angle are candidates
+        double angleRad = CMathUtils::deg2rad(0.5);
+        while (true)
+        {
+            const QVector<int> rows = this->candidatesWithinAngle(normalVector, angleRad);
+            if (angleRad >= M_PI) { return rows; }
+
+            const double chordSquared = 2.0 - 2.0 * std::cos(angleRad);
+            int closer = 0;
+            for (int row : rows)
+            {
+                // rows without position are candidates, but not certainly closer
+                if (isWithoutPosition(m_normalVectors[row])) { continue; }
+                if (distanceSquared(normalVector, m_normalVectors[row]) <= chordSquared) { closer++; }
+            }
+            if (closer >= number) { return rows; }
+            angleRad = std::min(2.0 * angleRad, M_PI);
+        }
+    }
+
+    QVector<int> CGeoIndex::candidatesWithinAngle(const std::array<double, 3> &normalVector, double angleRad) const
+    {
+        const double angle = withSlack(angleRad);
+        if (angle >= M_PI || isWithoutPosition(normalVector))
+        {
+            QVector<int> all(m_normalVectors.size());
+            std::iota(all.begin(), all.end(), 0);
+            return all;
+        }
+
+        // latitude band, a pole inside the range covers all longitudes
+        const double latitude = std::atan2(normalVector[2], std::hypot(normalVector[0], normalVector[1]));
+        const double longitude = std::atan2(normalVector[1], normalVector[0]);
+        const bool coversPole = (latitude + angle >= M_PI_2) || (latitude - angle <= -M_PI_2);
+        const double longitudeRange = coversPole ? M_PI : std::asin(std::min(1.0, std::sin(angle) / std::cos(latitude)));
+
+        const int latitudeFrom = latitudeCell(CMathUtils::rad2deg(latitude - angle));
+        const int latitudeTo = latitudeCell(CMathUtils::rad2deg(latitude + angle));
+        int longitudeFrom = static_cast<int>(std::floor(CMathUtils::rad2deg(longitude - longitudeRange) + 180.0));
+        int longitudeTo = static_cast<int>(std::floor(CMathUtils::rad2deg(longitude + longitudeRange) + 180.0));
+        if (coversPole || longitudeTo - longitudeFrom + 1 >= LongitudeCells)
+        {
+            longitudeFrom = 0;
+            longitudeTo = LongitudeCells - 1;
+        }
+
+        const double minDotProduct = std::cos(angle);
+        QVector<int> rows;
+        for (int latitudeIndex = latitudeFrom; latitudeIndex <= latitudeTo; ++latitudeIndex)
+        {
+            for (int longitudeIndex = longitudeFrom; longitudeIndex <= longitudeTo; ++longitudeIndex)
+            {
+                const int cell = latitudeIndex * LongitudeCells + (longitudeIndex % LongitudeCells + LongitudeCells) % LongitudeCells;
+                for (int i = m_cellBegin[cell]; i < m_cellBegin[cell + 1]; ++i)
+                {
+                    const int row = m_rowsByCell[i];
+                    if (dotProduct(normalVector, m_normalVectors[row]) >= minDotProduct) { rows.push_back(row); }
+                }
+            }
+        }
+        rows += m_rowsWithoutPosition;
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    int CGeoIndex::latitudeCell(double latitudeDeg)
+    {
+        return qBound(0, static_cast<int>(std::floor(latitudeDeg + 90.0)), LatitudeCells - 1);
+    }
+
+    int CGeoIndex::longitudeCell(double longitudeDeg)
+    {
+        const int cell = static_cast<int>(std::floor(longitudeDeg + 180.0));
+        return (cell % LongitudeCells + LongitudeCells) % LongitudeCells;
+    }
+} // namespace
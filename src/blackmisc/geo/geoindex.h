@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKMISC_GEO_GEOINDEX_H
+#define BLACKMISC_GEO_GEOINDEX_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QVector>
+#include <array>
+
+namespace BlackMisc::Geo
+{
+    /*!
+     * Spatial index of the normal vectors of a container, rows are kept in cells of 1deg latitude and longitude.
+     *
+     * Queries return candidate rows: all rows matching the query and some rows close to it,
+     * so the caller checks the candidates with the same distance functions as without index.
+     * Rows without position (null normal vector) are always candidates.
+     */
+    class BLACKMISC_EXPORT CGeoIndex
+    {
+    public:
+        //! Earth radius as used by calculateGreatCircleDistance
+        static constexpr double EarthRadiusMeters = 6371000.8;
+
+        //! Index of the positions of all objects of the container
+        template <class Container>
+        static CGeoIndex fromContainer(const Container &container)
+        {
+            QVector<std::array<double, 3>> normalVectors;
+            normalVectors.reserve(container.size());
+            for (const auto &object : container)
+            {
+                // null objects (e.g. an airport without ICAO code) are always candidates, as distances to them are null
+                normalVectors.push_back(object.isNull() ? std::array<double, 3> { 0, 0, 0 } : object.normalVectorDouble());
+            }
+            return CGeoIndex(normalVectors);
+        }
+
+        //! Default constructor, empty index
+        CGeoIndex() = default;
+
+        //! Index of the normal vectors of all rows
+        explicit CGeoIndex(const QVector<std::array<double, 3>> &normalVectors);
+
+        //! Number of rows
+        int size() const { return m_normalVectors.size(); }
+
+        //! Candidates within range of the position, ascending
+        QVector<int> candidatesWithinRange(const std::array<double, 3> &normalVector, double rangeMeters) const;
+
+        //! Candidates containing the n closest rows to the position, ascending
+        QVector<int> candidatesClosest(int number, const std::array<double, 3> &normalVector) const;
+
+    private:
+        static constexpr int LatitudeCells = 180; //!< 1deg
+        static constexpr int LongitudeCells = 360; //!< 1deg
+
+        //! Rows with normal vector within the angle, ascending
+        QVector<int> candidatesWithinAngle(const std::array<double, 3> &normalVector, double angleRad) const;
+
+        //! Cell of latitude and longitude in degrees
+        static int latitudeCell(double latitudeDeg);
+        static int longitudeCell(double longitudeDeg);
+
+        QVector<std::array<double, 3>> m_normalVectors; //!< by row
+        QVector<int> m_cellBegin; //!< offset of the rows of a cell in m_rowsByCell, one more than cells
+        QVector<int> m_rowsByCell; //!< rows ordered by cell, ascending within a cell
+        QVector<int> m_rowsWithoutPosition; //!< null normal vectors
+    };
+} // namespace
+
+#endif // guard
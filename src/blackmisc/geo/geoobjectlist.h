@@ -7,12 +7,20 @@
 #define BLACKMISC_GEO_GEOOBJECTLIST_H
 
 #include "blackmisc/aviation/altitude.h"
+#include "blackmisc/pq/angle.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/blackmiscexport.h"
 #include "blackmisc/sequence.h"
 #include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/geoindex.h"
+#include "blackmisc/geo/normalvectors.h"
 
 #include <QList>
+#include <QVector>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
 #include <tuple>
 
 namespace BlackMisc::Geo
@@ -30,8 +38,8 @@ namespace BlackMisc::Geo
         //! \param range      within range of other position
         CONTAINER findWithinRange(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const
         {
-            return this->container().findBy([&](const OBJ &geoObj) {
-                return calculateGreatCircleDistance(geoObj, coordinate) <= range;
+            return findByDistance(this->candidatesWithinRange(coordinate, range), coordinate, [&](const PhysicalQuantities::CLength &d) {
+                return d <= range;
             });
         }
 
@@ -40,17 +48,17 @@ namespace BlackMisc::Geo
         //! \param range      outside range of other position
         CONTAINER findOutsideRange(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const
         {
-            return this->container().findBy([&](const OBJ &geoObj) {
-                return calculateGreatCircleDistance(geoObj, coordinate) > range;
+            return findByDistance(this->container(), coordinate, [&](const PhysicalQuantities::CLength &d) {
+                return d > range;
             });
         }
 
         //! Find first in range
         OBJ findFirstWithinRangeOrDefault(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const
         {
-            return this->container().findFirstByOrDefault([&](const OBJ &geoObj) {
-                return calculateGreatCircleDistance(geoObj, coordinate) <= range;
-            });
+            const CONTAINER candidates = this->candidatesWithinRange(coordinate, range);
+            const int i = indexOfFirstByDistance(candidates, coordinate, [&](const PhysicalQuantities::CLength &d) { return d <= range; });
+            return i < 0 ? OBJ() : candidates[i];
         }
 
         //! Elements with geodetic height (only MSL)
@@ -62,19 +70,13 @@ namespace BlackMisc::Geo
         //! Any object in range?
         bool containsObjectInRange(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const
         {
-            return this->container().containsBy([&](const OBJ &geoObj) {
-                const PhysicalQuantities::CLength d = coordinate.calculateGreatCircleDistance(geoObj);
-                return d <= range;
-            });
+            return indexOfFirstByDistance(this->candidatesWithinRange(coordinate, range), coordinate, [&](const PhysicalQuantities::CLength &d) { return d <= range; }) >= 0;
         }
 
         //! Any object in range?
         bool containsObjectOutsideRange(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const
         {
-            return this->container().containsBy([&](const OBJ &geoObj) {
-                const PhysicalQuantities::CLength d = coordinate.calculateGreatCircleDistance(geoObj);
-                return d > range;
-            });
+            return indexOfFirstByDistance(this->container(), coordinate, [&](const PhysicalQuantities::CLength &d) { return d > range; }) >= 0;
         }
 
         //! Any NULL position?
@@ -168,9 +170,18 @@ namespace BlackMisc::Geo
         //! Find 0..n objects closest to the given coordinate.
         CONTAINER findClosest(int number, const ICoordinateGeodetic &coordinate) const
         {
-            CONTAINER closest = this->container().partiallySorted(number, [&](const OBJ &a, const OBJ &b) {
+            const auto closer = [&](const OBJ &a, const OBJ &b) {
                 return calculateEuclideanDistanceSquared(a, coordinate) < calculateEuclideanDistanceSquared(b, coordinate);
-            });
+            };
+            CONTAINER closest;
+            if (const CGeoIndex *index = this->geoIndexFor(coordinate))
+            {
+                closest = this->objectsAt(index->candidatesClosest(number, coordinate.normalVectorDouble())).partiallySorted(number, closer);
+            }
+            else
+            {
+                closest = this->container().partiallySorted(number, closer);
+            }
             closest.truncate(number);
             return closest;
         }
@@ -190,14 +201,16 @@ namespace BlackMisc::Geo
         {
             OBJ closest;
             PhysicalQuantities::CLength distance = PhysicalQuantities::CLength::null();
-            for (const OBJ &obj : this->container())
+            const CONTAINER candidates = this->candidatesWithinRange(coordinate, range);
+            const QVector<PhysicalQuantities::CLength> distances = greatCircleDistances(candidates, coordinate);
+            for (int i = 0; i < distances.size(); ++i)
             {
-                const PhysicalQuantities::CLength d = coordinate.calculateGreatCircleDistance(obj);
+                const PhysicalQuantities::CLength &d = distances[i];
                 if (d > range) { continue; }
                 if (distance.isNull() || distance > d)
                 {
                     distance = d;
-                    closest = obj;
+                    closest = candidates[i];
                 }
             }
             return closest;
@@ -219,11 +232,85 @@ namespace BlackMisc::Geo
             return copy;
         }
 
+        //! Attach a spatial index of the current objects, used by the range and closest queries
+        //! \remark the index is used as long as the objects are not modified, the first modification copies the objects
+        void attachGeoIndex()
+        {
+            m_geoIndex = std::make_shared<const CGeoIndex>(CGeoIndex::fromContainer(this->container()));
+            m_geoIndexedObjects = this->container().toVector();
+        }
+
+        //! Remove the spatial index
+        void detachGeoIndex()
+        {
+            m_geoIndex.reset();
+            m_geoIndexedObjects.clear();
+        }
+
+        //! Spatial index attached and still matching the objects?
+        bool hasGeoIndex() const
+        {
+            // the indexed objects share the data with the container until either is modified
+            return m_geoIndex && !m_geoIndexedObjects.isEmpty() && m_geoIndexedObjects.size() == this->container().size() && m_geoIndexedObjects.cbegin() == this->container().cbegin();
+        }
+
     protected:
         //! Constructor
         IGeoObjectList()
         {}
 
+        //! Great circle distances of all objects to the coordinate, as calculateGreatCircleDistance but in one batch
+        static QVector<PhysicalQuantities::CLength> greatCircleDistances(const CONTAINER &objects, const ICoordinateGeodetic &coordinate)
+        {
+            if (coordinate.isNull()) { return QVector<PhysicalQuantities::CLength>(objects.size(), PhysicalQuantities::CLength::null()); }
+            const QVector<double> meters = calculateGreatCircleDistances(CNormalVectors::fromContainer(objects), coordinate.normalVectorDouble());
+            QVector<PhysicalQuantities::CLength> distances;
+            distances.reserve(meters.size());
+            int i = 0;
+            for (const OBJ &geoObj : objects) { distances.push_back(lengthOf(geoObj, meters[i++])); }
+            return distances;
+        }
+
+        //! Index of the first object whose great circle distance to the coordinate matches the predicate, -1 if none
+        //! emark distances are calculated in chunks, so the search stops soon after the first match
+        template <class Predicate>
+        static int indexOfFirstByDistance(const CONTAINER &objects, const ICoordinateGeodetic &coordinate, Predicate predicate)
+        {
+            if (objects.isEmpty()) { return -1; }
+            if (coordinate.isNull()) { return predicate(PhysicalQuantities::CLength::null()) ? 0 : -1; }
+
+            constexpr int ChunkSize = 64;
+            const std::array<double, 3> position = coordinate.normalVectorDouble();
+            CNormalVectors normalVectors;
+            normalVectors.reserve(ChunkSize);
+            double meters[ChunkSize];
+            for (int from = 0; from < objects.size(); from += ChunkSize)
+            {
+                const int count = std::min(ChunkSize, objects.size() - from);
+                normalVectors.clear();
+                for (int i = from; i < from + count; ++i) { normalVectors.push_back(objects[i].normalVectorDouble()); }
+                calculateGreatCircleDistances(normalVectors.x(), normalVectors.y(), normalVectors.z(), count, position, meters);
+                for (int i = 0; i < count; ++i)
+                {
+                    if (predicate(lengthOf(objects[from + i], meters[i]))) { return from + i; }
+                }
+            }
+            return -1;
+        }
+
+        //! Objects whose great circle distance to the coordinate matches the predicate
+        template <class Predicate>
+        static CONTAINER findByDistance(const CONTAINER &objects, const ICoordinateGeodetic &coordinate, Predicate predicate)
+        {
+            const QVector<PhysicalQuantities::CLength> distances = greatCircleDistances(objects, coordinate);
+            CONTAINER found;
+            for (int i = 0; i < distances.size(); ++i)
+            {
+                if (predicate(distances[i])) { found.push_back(objects[i]); }
+            }
+            return found;
+        }
+
         //! Container
         const CONTAINER &container() const
         {
@@ -235,6 +322,45 @@ namespace BlackMisc::Geo
         {
             return static_cast<CONTAINER &>(*this);
         }
+
+    private:
+        //! Batch distance of the object as length, null as calculateGreatCircleDistance
+        static PhysicalQuantities::CLength lengthOf(const OBJ &geoObj, double meters)
+        {
+            return geoObj.isNull() || std::isnan(meters) ? PhysicalQuantities::CLength::null() : PhysicalQuantities::CLength(meters, PhysicalQuantities::CLengthUnit::m());
+        }
+
+        //! Index usable for a query, otherwise nullptr
+        const CGeoIndex *geoIndexFor(const ICoordinateGeodetic &coordinate) const
+        {
+            if (!this->hasGeoIndex() || coordinate.isNull()) { return nullptr; }
+            return m_geoIndex.get();
+        }
+
+        //! Index usable for a range query, otherwise nullptr
+        const CGeoIndex *geoIndexFor(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const
+        {
+            return range.isNull() ? nullptr : this->geoIndexFor(coordinate);
+        }
+
+        //! Objects which can be within range, all objects without usable index
+        CONTAINER candidatesWithinRange(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const
+        {
+            const CGeoIndex *index = this->geoIndexFor(coordinate, range);
+            if (!index) { return this->container(); }
+            return this->objectsAt(index->candidatesWithinRange(coordinate.normalVectorDouble(), range.value(PhysicalQuantities::CLengthUnit::m())));
+        }
+
+        //! Objects of the rows
+        CONTAINER objectsAt(const QVector<int> &rows) const
+        {
+            CONTAINER objects;
+            for (int row : rows) { objects.push_back(this->container()[row]); }
+            return objects;
+        }
+
+        std::shared_ptr<const CGeoIndex> m_geoIndex; //!< spatial index of m_geoIndexedObjects
+        QVector<OBJ> m_geoIndexedObjects; //!< the indexed objects, shared with the container
     };
 
     //! List of objects with geo coordinates.
@@ -279,19 +405,34 @@ namespace BlackMisc::Geo
         //! Calculate distances, remove if outside range
         void removeIfOutsideRange(const ICoordinateGeodetic &position, const PhysicalQuantities::CLength &maxDistance, bool updateValues)
         {
-            this->container().removeIf([&](OBJ &geoObj) {
-                return updateValues ?
-                           geoObj.calculcateAndUpdateRelativeDistanceAndBearing(position) > maxDistance :
-                           geoObj.calculateGreatCircleDistance(position) > maxDistance;
+            if (updateValues)
+            {
+                this->calculcateAndUpdateRelativeDistanceAndBearing(position);
+                this->container().removeIf([&](const OBJ &geoObj) { return geoObj.getRelativeDistance() > maxDistance; });
+                return;
+            }
+            this->container() = IGeoObjectList<OBJ, CONTAINER>::findByDistance(this->container(), position, [&](const PhysicalQuantities::CLength &d) {
+                return !(d > maxDistance);
             });
         }
 
         //! Calculate distances
         void calculcateAndUpdateRelativeDistanceAndBearing(const ICoordinateGeodetic &position)
         {
+            // distances and bearings of all objects in one batch, as ICoordinateWithRelativePosition::calculcateAndUpdateRelativeDistanceAndBearing
+            if (this->container().isEmpty()) { return; }
+            const CNormalVectors normalVectors = CNormalVectors::fromContainer(this->container());
+            const QVector<double> distances = calculateGreatCircleDistances(normalVectors, position.normalVectorDouble());
+            const QVector<double> bearings = calculateBearings(normalVectors, position.normalVectorDouble());
+            const bool isNullPosition = position.isNull();
+            int i = 0;
             for (OBJ &geoObj : this->container())
             {
-                geoObj.calculcateAndUpdateRelativeDistanceAndBearing(position);
+                const bool isNull = isNullPosition || geoObj.isNull();
+                const double d = distances[i];
+                const double b = bearings[i++];
+                geoObj.setRelativeDistance(isNull || std::isnan(d) ? PhysicalQuantities::CLength::null() : PhysicalQuantities::CLength(d, PhysicalQuantities::CLengthUnit::m()));
+                geoObj.setRelativeBearing(isNull || std::isnan(b) ? PhysicalQuantities::CAngle::null() : PhysicalQuantities::CAngle(b, PhysicalQuantities::CAngleUnit::rad()));
             }
         }
 
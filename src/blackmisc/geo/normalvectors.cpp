@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#include "blackmisc/geo/normalvectors.h"
+
+#include <cmath>
+
+// The loops work on plain arrays without branches, so compilers vectorize them.
+// atan2 is kept in a separate loop, it is only vectorized with a vector math library.
+
+namespace BlackMisc::Geo
+{
+    namespace
+    {
+        constexpr double earthRadiusMeters = 6371000.8; //!< as calculateGreatCircleDistance
+    }
+
+    void CNormalVectors::reserve(int size)
+    {
+        m_x.reserve(size);
+        m_y.reserve(size);
+        m_z.reserve(size);
+    }
+
+    void CNormalVectors::clear()
+    {
+        m_x.resize(0);
+        m_y.resize(0);
+        m_z.resize(0);
+    }
+
+    void CNormalVectors::push_back(const std::array<double, 3> &normalVector)
+    {
+        m_x.push_back(normalVector[0]);
+        m_y.push_back(normalVector[1]);
+        m_z.push_back(normalVector[2]);
+    }
+
+    void calculateGreatCircleDistances(const double *x, const double *y, const double *z, int count, const std::array<double, 3> &position, double *distancesMeters)
+    {
+        if (count < 1) { return; }
+
+        // |v1 x v2| and v1 . v2, then the angle
+        const double px = position[0];
+        const double py = position[1];
+        const double pz = position[2];
+        QVector<double> crossLengths(count);
+        double *cross = crossLengths.data();
+        for (int i = 0; i < count; ++i)
+        {
+            const double cx = y[i] * pz - z[i] * py;
+            const double cy = z[i] * px - x[i] * pz;
+            const double cz = x[i] * py - y[i] * px;
+            cross[i] = std::sqrt(cx * cx + cy * cy + cz * cz);
+            distancesMeters[i] = x[i] * px + y[i] * py + z[i] * pz;
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            distancesMeters[i] = earthRadiusMeters * std::atan2(cross[i], distancesMeters[i]);
+        }
+    }
+
+    void calculateBearings(const double *x, const double *y, const double *z, int count, const std::array<double, 3> &position, double *bearingsRad)
+    {
+        if (count < 1) { return; }
+
+        // c1 = v1 x v2, c2 = v1 x north pole, angle between c1 and c2 signed by v1
+        const double px = position[0];
+        const double py = position[1];
+        const double pz = position[2];
+        QVector<double> sinThetas(count);
+        double *sinTheta = sinThetas.data();
+        for (int i = 0; i < count; ++i)
+        {
+            const double c1x = y[i] * pz - z[i] * py;
+            const double c1y = z[i] * px - x[i] * pz;
+            const double c1z = x[i] * py - y[i] * px;
+            const double c2x = y[i];
+            const double c2y = -x[i];
+            const double crossX = -c1z * c2y;
+            const double crossY = c1z * c2x;
+            const double crossZ = c1x * c2y - c1y * c2x;
+            const double length = std::sqrt(crossX * crossX + crossY * crossY + crossZ * crossZ);
+            const double sign = crossX * x[i] + crossY * y[i] + crossZ * z[i];
+            sinTheta[i] = std::copysign(length, sign);
+            bearingsRad[i] = c1x * c2x + c1y * c2y; // cos theta
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            bearingsRad[i] = std::atan2(sinTheta[i], bearingsRad[i]);
+        }
+    }
+
+    QVector<double> calculateGreatCircleDistances(const CNormalVectors &positions, const std::array<double, 3> &position)
+    {
+        QVector<double> distances(positions.size());
+        calculateGreatCircleDistances(positions.x(), positions.y(), positions.z(), positions.size(), position, distances.data());
+        return distances;
+    }
+
+    QVector<double> calculateBearings(const CNormalVectors &positions, const std::array<double, 3> &position)
+    {
+        QVector<double> bearings(positions.size());
+        calculateBearings(positions.x(), positions.y(), positions.z(), positions.size(), position, bearings.data());
+        return bearings;
+    }
+} // namespace
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKMISC_GEO_NORMALVECTORS_H
+#define BLACKMISC_GEO_NORMALVECTORS_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QVector>
+#include <array>
+
+namespace BlackMisc::Geo
+{
+    /*!
+     * Normal vectors of many positions, stored as separate x, y and z arrays
+     * so distances and bearings of all positions are calculated in one batch.
+     */
+    class BLACKMISC_EXPORT CNormalVectors
+    {
+    public:
+        //! Normal vectors of all objects of the container
+        template <class Container>
+        static CNormalVectors fromContainer(const Container &container)
+        {
+            CNormalVectors vectors;
+            vectors.reserve(container.size());
+            for (const auto &object : container) { vectors.push_back(object.normalVectorDouble()); }
+            return vectors;
+        }
+
+        //! Default constructor, no vectors
+        CNormalVectors() = default;
+
+        //! Reserve space
+        void reserve(int size);
+
+        //! Remove all vectors, keeps the reserved space
+        void clear();
+
+        //! Add a normal vector
+        void push_back(const std::array<double, 3> &normalVector);
+
+        //! Number of vectors
+        int size() const { return m_x.size(); }
+
+        //! No vectors?
+        bool isEmpty() const { return m_x.isEmpty(); }
+
+        //! Vector at position
+        std::array<double, 3> at(int index) const { return { m_x[index], m_y[index], m_z[index] }; }
+
+        //! @{
+        //! Components of all vectors
+        const double *x() const { return m_x.constData(); }
+        const double *y() const { return m_y.constData(); }
+        const double *z() const { return m_z.constData(); }
+        //! @}
+
+    private:
+        QVector<double> m_x;
+        QVector<double> m_y;
+        QVector<double> m_z;
+    };
+
+    //! Great circle distances in meters from the positions to one position, as calculateGreatCircleDistance
+    //! \remark null positions are not checked, this is up to the caller
+    BLACKMISC_EXPORT void calculateGreatCircleDistances(const double *x, const double *y, const double *z, int count, const std::array<double, 3> &position, double *distancesMeters);
+
+    //! Bearings in radians from the positions to one position, as calculateBearing
+    //! \remark null positions are not checked, this is up to the caller
+    BLACKMISC_EXPORT void calculateBearings(const double *x, const double *y, const double *z, int count, const std::array<double, 3> &position, double *bearingsRad);
+
+    //! \copydoc calculateGreatCircleDistances
+    BLACKMISC_EXPORT QVector<double> calculateGreatCircleDistances(const CNormalVectors &positions, const std::array<double, 3> &position);
+
+    //! \copydoc calculateBearings
+    BLACKMISC_EXPORT QVector<double> calculateBearings(const CNormalVectors &positions, const std::array<double, 3> &position);
+} // namespace
+
+#endif // guard
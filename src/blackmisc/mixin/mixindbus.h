@@ -9,6 +9,8 @@
 #include "blackmisc/metaclass.h"
 #include "blackmisc/inheritancetraits.h"
 #include "blackmisc/typetraits.h"
+#include <QByteArray>
+#include <QDataStream>
 #include <QDBusArgument>
 #include <type_traits>
 
@@ -55,6 +57,47 @@ namespace BlackMisc
         class DBusOperators<Derived, LosslessTag>
         {};
 
+        /*!
+         * CRTP class template which will generate marshalling operators sending the whole object as one QByteArray,
+         * written with its QDataStream operators.
+         *
+         * Opt-in for large containers, where marshalling each member of each element through QDBusArgument is slow.
+         * The operators are an exact match for Derived, so they take precedence over those inherited from the container base class.
+         * Both sides have to use the same version, the DBus signature of Derived changes to a byte array.
+         *
+         * \tparam Derived Must have QDataStream streaming operators, e.g. from Mixin::DataStreamOperators.
+         */
+        template <class Derived>
+        class DBusByDataStream
+        {
+        public:
+            //! Unmarshalling operator >>, DBus to object
+            friend const QDBusArgument &operator>>(const QDBusArgument &arg, Derived &obj)
+            {
+                QByteArray bytes;
+                arg.beginStructure();
+                arg >> bytes;
+                arg.endStructure();
+                QDataStream stream(bytes);
+                stream >> obj;
+                return arg;
+            }
+
+            //! Marshalling operator <<, object to DBus
+            friend QDBusArgument &operator<<(QDBusArgument &arg, const Derived &obj)
+            {
+                QByteArray bytes;
+                {
+                    QDataStream stream(&bytes, QIODevice::WriteOnly);
+                    stream << obj;
+                }
+                arg.beginStructure();
+                arg << bytes;
+                arg.endStructure();
+                return arg;
+            }
+        };
+
         /*!
          * CRTP class template from which a derived class can inherit common methods dealing with marshalling instances by metaclass.
          *
@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKMISC_PROPERTYACCESSOR_H
+#define BLACKMISC_PROPERTYACCESSOR_H
+
+#include "blackmisc/propertyindex.h"
+#include "blackmisc/comparefunctions.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+namespace BlackMisc
+{
+    /*!
+     * Table of typed accessors of a value class, one entry per (not nested) property index.
+     *
+     * The accessors are functions generated from the getters of the class, so a property can be
+     * read and compared without the switch statements of propertyByIndex and comparePropertyByIndex
+     * and without a QVariant. A value class provides its table by a static function
+     * \code static const CPropertyAccessorTable<T> &propertyAccessors(); \endcode
+     * An entry has to return and compare the same as propertyByIndex and comparePropertyByIndex.
+     */
+    template <class T>
+    class CPropertyAccessorTable
+    {
+    public:
+        //! Type of the typed value
+        enum KeyType
+        {
+            NoKey, //!< not registered, resolved at runtime
+            StringKey,
+            NumericKey,
+            TimestampKey //!< ms since epoch, invalid is the minimum
+        };
+
+        //! Accessors of one property
+        struct Accessor
+        {
+            KeyType type = NoKey; //!< type of the typed value
+            Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive; //!< how strings are compared
+            QVariant (*value)(const T &) = nullptr; //!< value as by propertyByIndex
+            QString (*string)(const T &) = nullptr; //!< string value
+            double (*number)(const T &) = nullptr; //!< numeric value
+            qint64 (*timestamp)(const T &) = nullptr; //!< timestamp value
+            int (*compare)(const T &, const T &) = nullptr; //!< compare as by comparePropertyByIndex
+        };
+
+        //! String property, getter returning a QString
+        template <auto Getter, Qt::CaseSensitivity Cs = Qt::CaseInsensitive>
+        CPropertyAccessorTable &addString(int index)
+        {
+            Accessor &a = m_accessors[index];
+            a.type = StringKey;
+            a.caseSensitivity = Cs;
+            a.value = [](const T &o) { return QVariant(QString(std::invoke(Getter, o))); };
+            a.string = [](const T &o) { return QString(std::invoke(Getter, o)); };
+            a.compare = [](const T &o1, const T &o2) { return std::invoke(Getter, o1).compare(std::invoke(Getter, o2), Cs); };
+            return *this;
+        }
+
+        //! Numeric property, getter returning an arithmetic type
+        template <auto Getter>
+        CPropertyAccessorTable &addNumber(int index)
+        {
+            Accessor &a = m_accessors[index];
+            a.type = NumericKey;
+            a.value = [](const T &o) { return QVariant::fromValue(std::invoke(Getter, o)); };
+            a.number = [](const T &o) { return static_cast<double>(std::invoke(Getter, o)); };
+            a.compare = [](const T &o1, const T &o2) { return Compare::compare(std::invoke(Getter, o1), std::invoke(Getter, o2)); };
+            return *this;
+        }
+
+        //! Timestamp property, getter returning a QDateTime
+        template <auto Getter>
+        CPropertyAccessorTable &addTimestamp(int index)
+        {
+            Accessor &a = m_accessors[index];
+            a.type = TimestampKey;
+            a.value = [](const T &o) { return QVariant::fromValue(std::invoke(Getter, o)); };
+            a.timestamp = [](const T &o) { return toMSecs(std::invoke(Getter, o)); };
+            a.compare = [](const T &o1, const T &o2) { return Compare::compare(toMSecs(std::invoke(Getter, o1)), toMSecs(std::invoke(Getter, o2))); };
+            return *this;
+        }
+
+        //! Accessor of an index, nullptr if not registered
+        const Accessor *find(int index) const
+        {
+            const auto it = m_accessors.constFind(index);
+            return it == m_accessors.cend() ? nullptr : &it.value();
+        }
+
+    private:
+        static qint64 toMSecs(const QDateTime &ts) { return ts.isValid() ? ts.toMSecsSinceEpoch() : std::numeric_limits<qint64>::min(); }
+
+        QHash<int, Accessor> m_accessors;
+    };
+
+    /*!
+     * Trait which is true if T provides a table of its own property accessors.
+     */
+    template <typename T, typename = std::void_t<>>
+    struct THasPropertyAccessors : public std::false_type
+    {};
+    //! \cond
+    template <typename T>
+    struct THasPropertyAccessors<T, std::void_t<decltype(T::propertyAccessors())>> : public std::is_same<decltype(T::propertyAccessors()), const CPropertyAccessorTable<T> &>
+    {};
+    //! \endcond
+
+    /*!
+     * A CPropertyIndex resolved once against T.
+     *
+     * Registered properties are read and compared by the typed accessors of T,
+     * everything else by propertyByIndex and comparePropertyByIndex.
+     * Cheap to copy, compile once and use for all objects of a container.
+     */
+    template <class T>
+    class CPropertyAccessor
+    {
+    public:
+        //! Type of the typed value
+        using KeyType = typename CPropertyAccessorTable<T>::KeyType;
+
+        //! Default constructor, empty index
+        CPropertyAccessor() = default;
+
+        //! Resolve the index against T
+        explicit CPropertyAccessor(const CPropertyIndex &index) : m_index(index)
+        {
+            if constexpr (THasPropertyAccessors<T>::value)
+            {
+                if (index.isEmpty() || index.isNested()) { return; }
+                const auto *accessor = T::propertyAccessors().find(index.frontCasted<int>());
+                if (accessor) { m_accessor = *accessor; }
+            }
+        }
+
+        //! The index
+        const CPropertyIndex &getIndex() const { return m_index; }
+
+        //! Resolved to typed accessors?
+        bool isCompiled() const { return m_accessor.type != CPropertyAccessorTable<T>::NoKey; }
+
+        //! Type of the typed value, NoKey if not compiled
+        KeyType getKeyType() const { return m_accessor.type; }
+
+        //! How strings are compared
+        Qt::CaseSensitivity getCaseSensitivity() const { return m_accessor.caseSensitivity; }
+
+        //! Value as by propertyByIndex
+        QVariant value(const T &object) const
+        {
+            if (m_accessor.value) { return m_accessor.value(object); }
+            return object.propertyByIndex(m_index);
+        }
+
+        //! Compare as by comparePropertyByIndex
+        int compare(const T &a, const T &b) const
+        {
+            if (m_accessor.compare) { return m_accessor.compare(a, b); }
+            return a.comparePropertyByIndex(m_index, b);
+        }
+
+        //! String value
+        //! \pre getKeyType() is StringKey
+        QString string(const T &object) const { return m_accessor.string(object); }
+
+        //! Numeric value
+        //! \pre getKeyType() is NumericKey
+        double number(const T &object) const { return m_accessor.number(object); }
+
+        //! Timestamp value in ms since epoch
+        //! \pre getKeyType() is TimestampKey
+        qint64 timestamp(const T &object) const { return m_accessor.timestamp(object); }
+
+    private:
+        CPropertyIndex m_index;
+        typename CPropertyAccessorTable<T>::Accessor m_accessor;
+    };
+} // namespace
+
+#endif // guard
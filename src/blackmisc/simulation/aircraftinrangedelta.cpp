@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#include "blackmisc/simulation/aircraftinrangedelta.h"
+#include "blackmisc/stringutils.h"
+
+#include <QHash>
+
+using namespace BlackMisc::Aviation;
+
+BLACK_DEFINE_VALUEOBJECT_MIXINS(BlackMisc::Simulation, CAircraftInRangeDelta)
+
+namespace BlackMisc::Simulation
+{
+    CAircraftInRangeDelta CAircraftInRangeDelta::snapshot(const CSimulatedAircraftList &aircraft, qint64 revision)
+    {
+        CAircraftInRangeDelta delta;
+        delta.m_revision = revision;
+        delta.m_snapshot = true;
+        delta.m_changed = aircraft;
+        return delta;
+    }
+
+    CAircraftInRangeDelta CAircraftInRangeDelta::diff(const CSimulatedAircraftList &oldAircraft, const CSimulatedAircraftList &currentAircraft, qint64 revision)
+    {
+        CAircraftInRangeDelta delta;
+        delta.m_revision = revision;
+
+        QHash<CCallsign, const CSimulatedAircraft *> oldByCallsign;
+        oldByCallsign.reserve(oldAircraft.size());
+        for (const CSimulatedAircraft &aircraft : oldAircraft) { oldByCallsign.insert(aircraft.getCallsign(), &aircraft); }
+
+        for (const CSimulatedAircraft &aircraft : currentAircraft)
+        {
+            const CSimulatedAircraft *old = oldByCallsign.take(aircraft.getCallsign());
+            if (!old || *old != aircraft) { delta.m_changed.push_back(aircraft); }
+        }
+        for (auto it = oldByCallsign.cbegin(); it != oldByCallsign.cend(); ++it) { delta.m_removed.push_back(it.key()); }
+        return delta;
+    }
+
+    void CAircraftInRangeDelta::applyTo(CSimulatedAircraftList &aircraft) const
+    {
+        if (m_snapshot)
+        {
+            aircraft = m_changed;
+            return;
+        }
+        if (!m_removed.isEmpty()) { aircraft.removeByCallsigns(m_removed); }
+        for (const CSimulatedAircraft &changed : m_changed)
+        {
+            aircraft.replaceOrAddObjectByCallsign(changed);
+        }
+    }
+
+    QString CAircraftInRangeDelta::convertToQString(bool i18n) const
+    {
+        Q_UNUSED(i18n)
+        return QStringLiteral("revision: %1 snapshot: %2 changed: %3 removed: %4").arg(m_revision).arg(boolToYesNo(m_snapshot)).arg(m_changed.size()).arg(m_removed.size());
+    }
+} // namespace
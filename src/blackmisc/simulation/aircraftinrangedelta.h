@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_AIRCRAFTINRANGEDELTA_H
+#define BLACKMISC_SIMULATION_AIRCRAFTINRANGEDELTA_H
+
+#include "blackmisc/aviation/callsignset.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
+#include "blackmisc/blackmiscexport.h"
+#include "blackmisc/metaclass.h"
+#include "blackmisc/valueobject.h"
+
+#include <QMetaType>
+#include <QString>
+
+BLACK_DECLARE_VALUEOBJECT_MIXINS(BlackMisc::Simulation, CAircraftInRangeDelta)
+
+namespace BlackMisc::Simulation
+{
+    /*!
+     * Changes of the aircraft in range between two revisions, keyed by callsign.
+     * A snapshot delta contains the complete list and replaces whatever the receiver had.
+     */
+    class BLACKMISC_EXPORT CAircraftInRangeDelta : public CValueObject<CAircraftInRangeDelta>
+    {
+    public:
+        //! Default constructor
+        CAircraftInRangeDelta() = default;
+
+        //! Full snapshot of the given aircraft
+        static CAircraftInRangeDelta snapshot(const CSimulatedAircraftList &aircraft, qint64 revision);
+
+        //! Delta from old to current aircraft
+        static CAircraftInRangeDelta diff(const CSimulatedAircraftList &oldAircraft, const CSimulatedAircraftList &currentAircraft, qint64 revision);
+
+        //! Revision this delta leads to
+        qint64 getRevision() const { return m_revision; }
+
+        //! Full snapshot?
+        bool isSnapshot() const { return m_snapshot; }
+
+        //! Added or changed aircraft, all aircraft for a snapshot
+        const CSimulatedAircraftList &getChangedAircraft() const { return m_changed; }
+
+        //! Callsigns of removed aircraft
+        const Aviation::CCallsignSet &getRemovedCallsigns() const { return m_removed; }
+
+        //! Nothing added, changed or removed
+        bool isEmpty() const { return !m_snapshot && m_changed.isEmpty() && m_removed.isEmpty(); }
+
+        //! Apply this delta to the given list
+        //! \remark for a snapshot the list is replaced
+        void applyTo(CSimulatedAircraftList &aircraft) const;
+
+        //! \copydoc BlackMisc::Mixin::String::toQString
+        QString convertToQString(bool i18n = false) const;
+
+    private:
+        qint64 m_revision = 0;
+        bool m_snapshot = false;
+        CSimulatedAircraftList m_changed;
+        Aviation::CCallsignSet m_removed;
+
+        BLACK_METACLASS(
+            CAircraftInRangeDelta,
+            BLACK_METAMEMBER(revision),
+            BLACK_METAMEMBER(snapshot),
+            BLACK_METAMEMBER(changed),
+            BLACK_METAMEMBER(removed)
+        );
+    };
+} // namespace
+
+Q_DECLARE_METATYPE(BlackMisc::Simulation::CAircraftInRangeDelta)
+
+#endif
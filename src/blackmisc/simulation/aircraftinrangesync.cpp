@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#include "blackmisc/simulation/aircraftinrangesync.h"
+#include "blackmisc/sharedstate/passiveobserver.h"
+
+#include <QTimer>
+
+using namespace BlackMisc::SharedState;
+
+namespace BlackMisc::Simulation
+{
+    CAircraftInRangeJournal::CAircraftInRangeJournal(QObject *parent) : QObject(parent)
+    {}
+
+    void CAircraftInRangeJournal::initialize(IDataLink *dataLink)
+    {
+        dataLink->publish(m_mutator.data());
+    }
+
+    CAircraftInRangeDelta CAircraftInRangeJournal::publish(const CSimulatedAircraftList &aircraft)
+    {
+        QMutexLocker lock(&m_mutex);
+        const CAircraftInRangeDelta delta = CAircraftInRangeDelta::diff(m_aircraft, aircraft, m_revision + 1);
+        if (delta.isEmpty()) { return delta; }
+        m_aircraft = aircraft;
+        m_revision = delta.getRevision();
+        lock.unlock();
+
+        // a local replica may answer synchronously with a snapshot request, so no lock here
+        m_mutator->postEvent(CVariant::from(delta));
+        return delta;
+    }
+
+    qint64 CAircraftInRangeJournal::getRevision() const
+    {
+        QMutexLocker lock(&m_mutex);
+        return m_revision;
+    }
+
+    CVariant CAircraftInRangeJournal::handleRequest(const CVariant &param)
+    {
+        Q_UNUSED(param)
+        QMutexLocker lock(&m_mutex);
+        return CVariant::from(CAircraftInRangeDelta::snapshot(m_aircraft, m_revision));
+    }
+
+    CAircraftInRangeReplica::CAircraftInRangeReplica(QObject *parent) : QObject(parent)
+    {}
+
+    void CAircraftInRangeReplica::initialize(IDataLink *dataLink)
+    {
+        dataLink->subscribe(m_observer.data());
+        m_observer->setEventSubscription(CVariant::from(CAnyMatch()));
+        m_watcher = dataLink->watcher();
+        connect(m_watcher, &CDataLinkConnectionWatcher::connected, this, &CAircraftInRangeReplica::resync);
+        connect(m_watcher, &CDataLinkConnectionWatcher::disconnected, this, &CAircraftInRangeReplica::handleDisconnected);
+        if (m_watcher->isConnected()) { resync(); }
+    }
+
+    CSimulatedAircraftList CAircraftInRangeReplica::getAircraftInRange() const
+    {
+        QMutexLocker lock(&m_mutex);
+        return m_aircraft;
+    }
+
+    qint64 CAircraftInRangeReplica::getRevision() const
+    {
+        QMutexLocker lock(&m_mutex);
+        return m_revision;
+    }
+
+    int CAircraftInRangeReplica::getResyncCount() const
+    {
+        QMutexLocker lock(&m_mutex);
+        return m_resyncs;
+    }
+
+    void CAircraftInRangeReplica::resync()
+    {
+        int resyncId = 0;
+        {
+            QMutexLocker lock(&m_mutex);
+            if (m_resyncPending) { return; }
+            m_resyncPending = true;
+            resyncId = ++m_resyncId;
+        }
+
+        // the reply callback is not called if the request is cancelled or the journal is gone
+        QTimer::singleShot(m_resyncTimeoutMs, this, [this, resyncId] { this->handleResyncTimeout(resyncId); });
+        m_observer->requestAsync({}, [this, resyncId](const CVariant &snapshot) { this->handleSnapshot(resyncId, snapshot); });
+    }
+
+    void CAircraftInRangeReplica::handleSnapshot(int resyncId, const CVariant &param)
+    {
+        QMutexLocker lock(&m_mutex);
+        if (!m_resyncPending || resyncId != m_resyncId) { return; } // timed out or disconnected meanwhile
+        m_resyncPending = false;
+
+        // a failed request, the next delta requests a snapshot again
+        if (!param.canConvert<CAircraftInRangeDelta>()) { return; }
+        const CAircraftInRangeDelta snapshot = param.to<CAircraftInRangeDelta>();
+
+        // deltas received meanwhile are already contained in our copy
+        if (snapshot.getRevision() < m_revision) { return; }
+        snapshot.applyTo(m_aircraft);
+        m_revision = snapshot.getRevision();
+        m_resyncs++;
+        lock.unlock();
+        emit this->aircraftInRangeChanged(snapshot);
+    }
+
+    void CAircraftInRangeReplica::handleResyncTimeout(int resyncId)
+    {
+        // no reply, the next delta requests a snapshot again
+        QMutexLocker lock(&m_mutex);
+        if (m_resyncPending && resyncId == m_resyncId) { m_resyncPending = false; }
+    }
+
+    void CAircraftInRangeReplica::handleDisconnected()
+    {
+        // the journal may be gone, so no further deltas and no pending snapshot,
+        // a revision of -1 makes the readers fall back to asking the journal side directly
+        QMutexLocker lock(&m_mutex);
+        m_revision = -1;
+        m_resyncPending = false;
+    }
+
+    void CAircraftInRangeReplica::handleEvent(const CVariant &param)
+    {
+        const CAircraftInRangeDelta delta = param.to<CAircraftInRangeDelta>();
+        QMutexLocker lock(&m_mutex);
+        if (m_resyncPending) { return; } // snapshot will be newer
+        if (m_revision < 0 || delta.getRevision() != m_revision + 1)
+        {
+            // missed a revision, deltas cannot be applied any more
+            lock.unlock();
+            this->resync();
+            return;
+        }
+        delta.applyTo(m_aircraft);
+        m_revision = delta.getRevision();
+        lock.unlock();
+        emit this->aircraftInRangeChanged(delta);
+    }
+} // namespace
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_AIRCRAFTINRANGESYNC_H
+#define BLACKMISC_SIMULATION_AIRCRAFTINRANGESYNC_H
+
+#include "blackmisc/simulation/aircraftinrangedelta.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
+#include "blackmisc/sharedstate/activemutator.h"
+#include "blackmisc/sharedstate/activeobserver.h"
+#include "blackmisc/sharedstate/datalink.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QObject>
+#include <QMutex>
+#include <QSharedPointer>
+
+namespace BlackMisc::Simulation
+{
+    /*!
+     * Publishes the aircraft in range as deltas keyed by callsign.
+     * Each publication increments the revision, a full snapshot is only sent when a replica asks for it.
+     */
+    class BLACKMISC_EXPORT CAircraftInRangeJournal : public QObject
+    {
+        Q_OBJECT
+        BLACK_SHARED_STATE_CHANNEL("swift.network.aircraftinrange")
+
+    public:
+        //! Constructor
+        CAircraftInRangeJournal(QObject *parent = nullptr);
+
+        //! Publish using the given transport mechanism.
+        void initialize(SharedState::IDataLink *dataLink);
+
+        //! Publish the current aircraft, only the changes to the last published list are sent
+        //! \return the published delta
+        //! \remark to keep the revisions in order, only call from one thread
+        CAircraftInRangeDelta publish(const CSimulatedAircraftList &aircraft);
+
+        //! Current revision
+        qint64 getRevision() const;
+
+    private:
+        CVariant handleRequest(const CVariant &param);
+
+        QSharedPointer<SharedState::CActiveMutator> m_mutator = SharedState::CActiveMutator::create(this, &CAircraftInRangeJournal::handleRequest);
+        mutable QMutex m_mutex;
+        CSimulatedAircraftList m_aircraft; //!< last published
+        qint64 m_revision = 0;
+    };
+
+    /*!
+     * Local copy of the aircraft in range, kept in sync with a CAircraftInRangeJournal by applying its deltas.
+     * A missed revision triggers a resync with a full snapshot.
+     */
+    class BLACKMISC_EXPORT CAircraftInRangeReplica : public QObject
+    {
+        Q_OBJECT
+        BLACK_SHARED_STATE_CHANNEL("swift.network.aircraftinrange")
+
+    public:
+        //! Constructor
+        CAircraftInRangeReplica(QObject *parent = nullptr);
+
+        //! Subscribe using the given transport mechanism.
+        void initialize(SharedState::IDataLink *dataLink);
+
+        //! Current aircraft in range
+        //! \threadsafe
+        CSimulatedAircraftList getAircraftInRange() const;
+
+        //! Revision of the local copy
+        //! \threadsafe
+        qint64 getRevision() const;
+
+        //! Number of full snapshots received
+        //! \threadsafe
+        int getResyncCount() const;
+
+        //! Time after which an unanswered snapshot request is given up
+        void setResyncTimeoutMs(int timeoutMs) { m_resyncTimeoutMs = timeoutMs; }
+
+        //! Request a full snapshot
+        void resync();
+
+    signals:
+        //! Local copy has been changed
+        void aircraftInRangeChanged(const BlackMisc::Simulation::CAircraftInRangeDelta &delta);
+
+    private:
+        void handleEvent(const CVariant &param);
+        void handleSnapshot(int resyncId, const CVariant &param);
+        void handleResyncTimeout(int resyncId);
+        void handleDisconnected();
+
+        QSharedPointer<SharedState::CActiveObserver> m_observer = SharedState::CActiveObserver::create(this, &CAircraftInRangeReplica::handleEvent);
+        SharedState::CDataLinkConnectionWatcher *m_watcher = nullptr;
+        mutable QMutex m_mutex;
+        CSimulatedAircraftList m_aircraft;
+        qint64 m_revision = -1; //!< -1 means not yet synchronized
+        bool m_resyncPending = false;
+        int m_resyncId = 0; //!< id of the last snapshot request
+        int m_resyncs = 0;
+        int m_resyncTimeoutMs = 10 * 1000;
+    };
+} // namespace
+
+#endif
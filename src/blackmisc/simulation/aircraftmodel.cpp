@@ -369,6 +369,26 @@ namespace BlackMisc::Simulation
         return 0;
     }
 
+    const CPropertyAccessorTable<CAircraftModel> &CAircraftModel::propertyAccessors()
+    {
+        // same values and comparisons as propertyByIndex and comparePropertyByIndex
+        static const CPropertyAccessorTable<CAircraftModel> table = [] {
+            CPropertyAccessorTable<CAircraftModel> t;
+            t.addString<&CAircraftModel::getModelString>(IndexModelString)
+                .addString<&CAircraftModel::getModelStringAlias>(IndexModelStringAlias)
+                .addString<&CAircraftModel::getName>(IndexName)
+                .addString<&CAircraftModel::getDescription>(IndexDescription)
+                .addString<&CAircraftModel::getFileName>(IndexFileName)
+                .addString<&CAircraftModel::getIconFile>(IndexIconPath)
+                .addString<&CAircraftModel::getSupportedParts, Qt::CaseSensitive>(IndexSupportedParts)
+                .addNumber<&CAircraftModel::hasQueriedModelString>(IndexHasQueriedModelString)
+                .addNumber<&CAircraftModel::getDbKey>(IndexDbIntegerKey)
+                .addTimestamp<&CAircraftModel::getFileTimestamp>(IndexFileTimestamp);
+            return t;
+        }();
+        return table;
+    }
+
     bool CAircraftModel::setAircraftIcaoCode(const CAircraftIcaoCode &aircraftIcaoCode)
     {
         if (m_aircraftIcao == aircraftIcaoCode) { return false; }
@@ -22,6 +22,7 @@
 #include "blackmisc/metaclass.h"
 #include "blackmisc/orderable.h"
 #include "blackmisc/pixmap.h"
+#include "blackmisc/propertyaccessor.h"
 #include "blackmisc/propertyindexref.h"
 #include "blackmisc/blackmiscexport.h"
 
@@ -160,6 +161,10 @@ namespace BlackMisc
             //! \copydoc BlackMisc::Mixin::Index::comparePropertyByIndex
             int comparePropertyByIndex(CPropertyIndexRef index, const CAircraftModel &compareValue) const;
 
+            //! Typed accessors of the properties used in model views and sorting
+            //! \sa BlackMisc::CPropertyAccessor
+            static const CPropertyAccessorTable<CAircraftModel> &propertyAccessors();
+
             //! \copydoc BlackMisc::Mixin::String::toQString
             QString convertToQString(bool i18n = false) const;
 
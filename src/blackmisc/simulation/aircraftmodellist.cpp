@@ -9,6 +9,7 @@
 #include "blackmisc/iterator.h"
 #include "blackmisc/range.h"
 #include "blackmisc/fileutils.h"
+#include "blackmisc/directorystatcache.h"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/directoryutils.h"
 #include "blackmisc/statusmessage.h"
@@ -1480,7 +1481,7 @@ namespace BlackMisc::Simulation
         return msgs;
     }
 
-    CStatusMessageList CAircraftModelList::validateFiles(CAircraftModelList &validModels, CAircraftModelList &invalidModels, bool ignoreEmptyFileNames, int stopAtFailedFiles, std::atomic_bool &wasStopped, const QString &simRootDirectory, bool alreadySortedByFn) const
+    CStatusMessageList CAircraftModelList::validateFiles(CAircraftModelList &validModels, CAircraftModelList &invalidModels, bool ignoreEmptyFileNames, int stopAtFailedFiles, std::atomic_bool &wasStopped, const QString &simRootDirectory, bool alreadySortedByFn, CDirectoryStatCache *statCache) const
     {
         wasStopped = false;
 
@@ -1500,6 +1501,11 @@ namespace BlackMisc::Simulation
             if (uncMsgs.hasErrorMessages()) { return uncMsgs; }
         }
 
+        // stat all files upfront, grouped by directory and in parallel
+        CDirectoryStatCache localStatCache;
+        CDirectoryStatCache &stats = statCache ? *statCache : localStatCache;
+        const QSet<QString> existingFiles = stats.getExistingFiles(sorted.getAllFileNames(), wasStopped);
+
         const bool caseSensitive = CFileUtils::isFileNameCaseSensitive();
         const QString simRootDir = CFileUtils::normalizeFilePathToQtStandard(
             CFileUtils::stripLeadingSlashOrDriveLetter(
@@ -1531,7 +1537,7 @@ namespace BlackMisc::Simulation
                     break;
                 }
 
-                if (workingFiles.contains(fn) || model.hasExistingCorrespondingFile())
+                if (workingFiles.contains(fn) || existingFiles.contains(fn))
                 {
                     if (!simRootDirectory.isEmpty() && !fn.contains(simRootDir))
                     {
@@ -36,6 +36,8 @@ BLACK_DECLARE_SEQUENCE_MIXINS(BlackMisc::Simulation, CAircraftModel, CAircraftMo
 
 namespace BlackMisc
 {
+    class CDirectoryStatCache;
+
     namespace Aviation
     {
         class CCallsign;
@@ -54,7 +56,8 @@ namespace BlackMisc
             public Db::IDatastoreObjectList<CAircraftModel, CAircraftModelList, int>,
             public IOrderableList<CAircraftModel, CAircraftModelList>,
             public Aviation::ICallsignObjectList<CAircraftModel, CAircraftModelList>,
-            public Mixin::MetaType<CAircraftModelList>
+            public Mixin::MetaType<CAircraftModelList>,
+            public Mixin::DBusByDataStream<CAircraftModelList>
         {
         public:
             BLACKMISC_DECLARE_USING_MIXIN_METATYPE(CAircraftModelList)
@@ -514,7 +517,8 @@ namespace BlackMisc
             CStatusMessageList validateDistributors(const CDistributorList &distributors, CAircraftModelList &validModels, CAircraftModelList &invalidModels) const;
 
             //! Validate files (file exists etc.)
-            CStatusMessageList validateFiles(CAircraftModelList &validModels, CAircraftModelList &invalidModels, bool ignoreEmptyFileNames, int stopAtFailedFiles, std::atomic_bool &wasStopped, const QString &simRootDirectory, bool alreadySortedByFn = false) const;
+            //! \remark file existence is checked per directory in parallel, pass a statCache to reuse the results of unchanged directories in later calls
+            CStatusMessageList validateFiles(CAircraftModelList &validModels, CAircraftModelList &invalidModels, bool ignoreEmptyFileNames, int stopAtFailedFiles, std::atomic_bool &wasStopped, const QString &simRootDirectory, bool alreadySortedByFn = false, CDirectoryStatCache *statCache = nullptr) const;
 
             //! To compact JSON format
             QJsonObject toMemoizedJson() const;
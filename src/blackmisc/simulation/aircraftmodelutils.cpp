@@ -135,7 +135,7 @@ namespace BlackMisc::Simulation
         return ok ? dir.absoluteFilePath(fn) : "";
     }
 
-    CStatusMessageList CAircraftModelUtilities::validateModelFiles(const CSimulatorInfo &simulator, const CAircraftModelList &models, CAircraftModelList &validModels, CAircraftModelList &invalidModels, bool ignoreEmpty, int stopAtFailedFiles, std::atomic_bool &wasStopped, const QString &simulatorDir)
+    CStatusMessageList CAircraftModelUtilities::validateModelFiles(const CSimulatorInfo &simulator, const CAircraftModelList &models, CAircraftModelList &validModels, CAircraftModelList &invalidModels, bool ignoreEmpty, int stopAtFailedFiles, std::atomic_bool &wasStopped, const QString &simulatorDir, CDirectoryStatCache *statCache)
     {
         // some generic tests
         CLogCategoryList cats = { CLogCategories::matching() };
@@ -166,7 +166,7 @@ namespace BlackMisc::Simulation
         CStatusMessageList specificTests;
         if (simulator.isMicrosoftOrPrepare3DSimulator() || models.isLikelyFsFamilyModelList())
         {
-            const CStatusMessageList specificTests1 = FsCommon::CFsCommonUtil::validateAircraftConfigFiles(models, validModels, invalidModels, ignoreEmpty, stopAtFailedFiles, wasStopped);
+            const CStatusMessageList specificTests1 = FsCommon::CFsCommonUtil::validateAircraftConfigFiles(models, validModels, invalidModels, ignoreEmpty, stopAtFailedFiles, wasStopped, statCache);
             specificTests.push_back(specificTests1);
 
             if (simulator.isP3D())
@@ -182,11 +182,11 @@ namespace BlackMisc::Simulation
         }
         else if (simulator.isXPlane() || models.isLikelyXPlaneModelList())
         {
-            specificTests = models.validateFiles(validModels, invalidModels, ignoreEmpty, stopAtFailedFiles, wasStopped, simulatorDir);
+            specificTests = models.validateFiles(validModels, invalidModels, ignoreEmpty, stopAtFailedFiles, wasStopped, simulatorDir, false, statCache);
         }
         else
         {
-            specificTests = models.validateFiles(validModels, invalidModels, ignoreEmpty, stopAtFailedFiles, wasStopped, {});
+            specificTests = models.validateFiles(validModels, invalidModels, ignoreEmpty, stopAtFailedFiles, wasStopped, {}, false, statCache);
         }
 
         msgs.push_back(specificTests);
@@ -9,6 +9,8 @@
 #include "blackmisc/logmessage.h"
 
 #include <QDateTime>
+#include <QSet>
+#include <QHash>
 
 using namespace BlackMisc::Network;
 using namespace BlackMisc::Simulation::Data;
@@ -52,6 +54,12 @@ namespace BlackMisc::Simulation
         return m_simulator;
     }
 
+    QString CBackgroundValidation::getCurrentSimulatorDirectory() const
+    {
+        QReadLocker l(&m_lock);
+        return m_simDirectory;
+    }
+
     bool CBackgroundValidation::triggerValidation(const CSimulatorInfo &simulator, const QString &simDirectory)
     {
         const QPointer<CBackgroundValidation> myself(this);
@@ -127,28 +135,53 @@ namespace BlackMisc::Simulation
 
             onlyErrorsAndWarnings = setup.onlyShowVerificationWarningsAndErrors();
             const CAircraftModelList models = m_modelSets.getCachedModels(simulator);
-            const qint64 now = QDateTime::currentMSecsSinceEpoch();
+            const QString simDirectory = this->getCurrentSimulatorDirectory();
             validated = true;
 
+            // only new or changed models are validated again
+            CAircraftModelList unchangedModels;
+            QHash<QString, qint64> fileTimestamps;
+            const CAircraftModelList changedModels = this->splitUnchangedModels(simulator, simDirectory, models, unchangedModels, fileTimestamps);
+
             if (models.isEmpty())
             {
                 msgs.push_back(CStatusMessage(this, CStatusMessage::SeverityWarning, QStringLiteral("No models in set for  '%1'").arg(simulator.toQString(true))));
             }
+            else if (changedModels.isEmpty())
+            {
+                valid = unchangedModels;
+                msgs.push_back(CStatusMessage(this, CStatusMessage::SeverityInfo, QStringLiteral("All %1 models unchanged since last validation").arg(unchangedModels.size())));
+            }
             else
             {
-                msgs = CAircraftModelUtilities::validateModelFiles(simulator, models, valid, invalid, false, 25, m_wasStopped, m_simDirectory);
+                msgs = CAircraftModelUtilities::validateModelFiles(simulator, changedModels, valid, invalid, false, 25, m_wasStopped, simDirectory, &m_statCache);
+                if (!unchangedModels.isEmpty())
+                {
+                    valid.push_back(unchangedModels);
+                    msgs.push_back(CStatusMessage(this, CStatusMessage::SeverityInfo, QStringLiteral("%1 unchanged models taken from last validation, validated %2 models").arg(unchangedModels.size()).arg(changedModels.size())));
+                }
             }
 
+            const qint64 now = QDateTime::currentMSecsSinceEpoch();
             const qint64 deltaTimeMs = now - started;
             msgs.push_back(CStatusMessage(this, CStatusMessage::SeverityInfo, QStringLiteral("Validated in %1ms").arg(deltaTimeMs)));
             msgs.sortBySeverityHighestFirst();
             msgs.freezeOrder();
 
+            // files of valid models, as they were before validating
+            QHash<QString, qint64> validFileTimestamps;
+            for (const CAircraftModel &model : std::as_const(valid))
+            {
+                if (model.hasFileName()) { validFileTimestamps.insert(model.getFileName(), fileTimestamps.value(model.getFileName(), -1)); }
+            }
+
             QWriteLocker l(&m_lock);
             m_lastResultValid = valid;
+            m_lastResultFileTimestamps = validFileTimestamps;
             m_lastResultInvalid = invalid;
             m_lastResultWasStopped = m_wasStopped;
             m_lastResultSimulator = simulator;
+            m_lastResultSimDirectory = simDirectory;
             m_lastResultMsgs = msgs;
             m_checkedSimulatorMsgs.insert(simulator, msgs);
         }
@@ -173,4 +206,56 @@ namespace BlackMisc::Simulation
             if (e || !isTimerBased) { emit this->validated(simulator, valid, invalid, m_wasStopped, msgs); }
         }
     }
+
+    CAircraftModelList CBackgroundValidation::splitUnchangedModels(const CSimulatorInfo &simulator, const QString &simDirectory, const CAircraftModelList &models, CAircraftModelList &unchangedModels, QHash<QString, qint64> &fileTimestamps) const
+    {
+        // modification times before validating, so a file edited meanwhile is validated again next time
+        // several models share one aircraft.cfg, each file is checked once
+        QSet<QString> fileNames;
+        for (const CAircraftModel &model : models)
+        {
+            if (model.hasFileName()) { fileNames.insert(model.getFileName()); }
+        }
+        fileTimestamps = CDirectoryStatCache::getFileTimestamps(fileNames, m_wasStopped);
+
+        CAircraftModelList lastValid;
+        QHash<QString, qint64> lastFileTimestamps;
+        {
+            QReadLocker l(&m_lock);
+            if (m_lastResultWasStopped || m_lastResultSimulator != simulator || m_lastResultSimDirectory != simDirectory) { return models; }
+            lastValid = m_lastResultValid;
+            lastFileTimestamps = m_lastResultFileTimestamps;
+        }
+        return splitUnchangedModels(models, lastValid, lastFileTimestamps, fileTimestamps, unchangedModels);
+    }
+
+    CAircraftModelList CBackgroundValidation::splitUnchangedModels(const CAircraftModelList &models, const CAircraftModelList &lastValidModels,
+                                                                   const QHash<QString, qint64> &lastFileTimestamps, const QHash<QString, qint64> &fileTimestamps,
+                                                                   CAircraftModelList &unchangedModels)
+    {
+        if (lastValidModels.isEmpty()) { return models; }
+
+        QHash<QString, QString> lastValidFileNames; // model string, file name
+        for (const CAircraftModel &model : lastValidModels)
+        {
+            lastValidFileNames.insert(model.getModelString(), model.getFileName());
+        }
+
+        // the file itself must be unchanged, an in-place edit of an aircraft.cfg does not change its directory
+        CAircraftModelList changedModels;
+        for (const CAircraftModel &model : models)
+        {
+            bool unchanged = false;
+            const auto it = lastValidFileNames.constFind(model.getModelString());
+            if (it != lastValidFileNames.cend() && model.hasFileName() && *it == model.getFileName())
+            {
+                const qint64 timestamp = fileTimestamps.value(model.getFileName(), -1);
+                unchanged = timestamp >= 0 && timestamp == lastFileTimestamps.value(model.getFileName(), -1);
+            }
+
+            if (unchanged) { unchangedModels.push_back(model); }
+            else { changedModels.push_back(model); }
+        }
+        return changedModels;
+    }
 } // ns
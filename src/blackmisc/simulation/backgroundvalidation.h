@@ -12,8 +12,10 @@
 #include "blackmisc/settingscache.h"
 #include "blackmisc/worker.h"
 #include "blackmisc/statusmessagelist.h"
+#include "blackmisc/directorystatcache.h"
 #include "blackmisc/blackmiscexport.h"
 
+#include <QHash>
 #include <QMap>
 #include <QReadWriteLock>
 #include <atomic>
@@ -21,6 +23,7 @@
 namespace BlackMisc::Simulation
 {
     //! Validate model files from the sets and check if the model still exists
+    //! \remark validation is incremental, valid models with an unchanged model file are taken from the last result
     class BLACKMISC_EXPORT CBackgroundValidation : public CContinuousWorker
     {
         Q_OBJECT
@@ -52,6 +55,10 @@ namespace BlackMisc::Simulation
         //! \threadsafe
         BlackMisc::Simulation::CSimulatorInfo getCurrentSimulator() const;
 
+        //! Corresponding simulator directory
+        //! \threadsafe
+        QString getCurrentSimulatorDirectory() const;
+
         //! Trigger a validation, returns false if "work in progress"
         //! \threadsafe
         bool triggerValidation(const CSimulatorInfo &simulator, const QString &simDirectory);
@@ -61,6 +68,16 @@ namespace BlackMisc::Simulation
         //! \threadsafe
         bool requestLastValidationResults();
 
+        //! Models which need to be validated (again), valid models with an unchanged model file go to unchangedModels
+        //! \param models models of the set
+        //! \param lastValidModels valid models of the last validation
+        //! \param lastFileTimestamps modification times of the files of the last valid models, when validated
+        //! \param fileTimestamps modification times of the model files now
+        //! \param unchangedModels valid models which need no validation
+        static CAircraftModelList splitUnchangedModels(const CAircraftModelList &models, const CAircraftModelList &lastValidModels,
+                                                       const QHash<QString, qint64> &lastFileTimestamps, const QHash<QString, qint64> &fileTimestamps,
+                                                       CAircraftModelList &unchangedModels);
+
     signals:
         //! Validating
         void validating(bool running);
@@ -81,8 +98,10 @@ namespace BlackMisc::Simulation
 
         // last result values, mostly needed when running in the distributed swift system and we want to get the values
         CAircraftModelList m_lastResultValid;
+        QHash<QString, qint64> m_lastResultFileTimestamps; //!< files of valid models, modification time when validated
         CAircraftModelList m_lastResultInvalid;
         CSimulatorInfo m_lastResultSimulator;
+        QString m_lastResultSimDirectory;
         CStatusMessageList m_lastResultMsgs;
         bool m_lastResultWasStopped = false;
         std::atomic_int m_timerBasedRuns { 0 };
@@ -93,8 +112,14 @@ namespace BlackMisc::Simulation
         // Set/caches as member as we are in own thread, central instance will not work
         Data::CModelSetCaches m_modelSets { false, this };
 
+        CDirectoryStatCache m_statCache; //!< file checks of previous runs
+
         //! Do the validation checks
         void doWork();
+
+        //! Models which need to be validated (again), compared with the last result
+        //! \remark fileTimestamps returns the modification times of all model files
+        CAircraftModelList splitUnchangedModels(const CSimulatorInfo &simulator, const QString &simDirectory, const CAircraftModelList &models, CAircraftModelList &unchangedModels, QHash<QString, qint64> &fileTimestamps) const;
     };
 } // ns
 #endif // guard
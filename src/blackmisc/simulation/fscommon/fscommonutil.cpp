@@ -24,6 +24,7 @@
 #include <QDomNodeList>
 #include <QSettings>
 #include <QStringBuilder>
+#include <QtConcurrentMap>
 
 using namespace BlackConfig;
 
@@ -104,13 +105,13 @@ namespace BlackMisc::Simulation::FsCommon
         return copied;
     }
 
-    CStatusMessageList CFsCommonUtil::validateAircraftConfigFiles(const CAircraftModelList &models, CAircraftModelList &validModels, CAircraftModelList &invalidModels, bool ignoreEmptyFileNames, int stopAtFailedFiles, std::atomic_bool &wasStopped)
+    CStatusMessageList CFsCommonUtil::validateAircraftConfigFiles(const CAircraftModelList &models, CAircraftModelList &validModels, CAircraftModelList &invalidModels, bool ignoreEmptyFileNames, int stopAtFailedFiles, std::atomic_bool &wasStopped, CDirectoryStatCache *statCache)
     {
         CStatusMessage m;
         CAircraftModelList sorted(models);
         sorted.sortByFileName();
         wasStopped = false;
-        CStatusMessageList msgs = sorted.validateFiles(validModels, invalidModels, ignoreEmptyFileNames, stopAtFailedFiles, wasStopped, QString(), true);
+        CStatusMessageList msgs = sorted.validateFiles(validModels, invalidModels, ignoreEmptyFileNames, stopAtFailedFiles, wasStopped, QString(), true, statCache);
         if (wasStopped || validModels.isEmpty()) { return msgs; }
 
         const CAircraftModelList nonFsModels = validModels.findNonFsFamilyModels();
@@ -128,16 +129,30 @@ namespace BlackMisc::Simulation::FsCommon
             msgs.push_back(m);
         }
 
-        // all those files should work
-        int removedCfgEntries = 0;
-        const QSet<QString> fileNames = validModels.getAllFileNames();
-        for (const QString &fileName : fileNames)
+        // all those files should work, they are independent and can be parsed in parallel
+        struct ParsedFile
         {
+            QString fileName;
+            QSet<QString> titles;
+            CStatusMessageList msgs;
+        };
+
+        const QList<QString> fileNames = validModels.getAllFileNames().values();
+        const QList<ParsedFile> parsedFiles = QtConcurrent::blockingMapped<QList<ParsedFile>>(fileNames, [&wasStopped](const QString &fileName) {
+            ParsedFile parsed;
+            parsed.fileName = fileName;
+            if (wasStopped) { return parsed; } // allow to break from "outside"
             bool ok = false;
+            parsed.titles = CAircraftCfgParser::performParsingOfSingleFile(fileName, ok, parsed.msgs).getTitleSetUpperCase();
+            return parsed;
+        });
+
+        int removedCfgEntries = 0;
+        for (const ParsedFile &parsed : parsedFiles)
+        {
             if (wasStopped) { break; } // allow to break from "outside"
-            const CAircraftCfgEntriesList entries = CAircraftCfgParser::performParsingOfSingleFile(fileName, ok, msgs);
-            const QSet<QString> removeModelStrings = entries.getTitleSetUpperCase();
-            const CAircraftModelList removedModels = validModels.removeIfFileButNotInSet(fileName, removeModelStrings);
+            msgs.push_back(parsed.msgs);
+            const CAircraftModelList removedModels = validModels.removeIfFileButNotInSet(parsed.fileName, parsed.titles);
             for (const CAircraftModel &removedModel : removedModels)
             {
                 removedCfgEntries++;
@@ -36,8 +36,8 @@ namespace BlackMisc::Simulation::FsCommon
         static int copyFsxTerrainProbeFiles(const QString &simObjectDir, CStatusMessageList &messages);
 
         //! Validate aircraft.cfg entries (sometimes also sim.cfg)
-        //! \remark only for FSX/P3D/FS9 models
-        static CStatusMessageList validateAircraftConfigFiles(const CAircraftModelList &models, CAircraftModelList &validModels, CAircraftModelList &invalidModels, bool ignoreEmptyFileNames, int stopAtFailedFiles, std::atomic_bool &wasStopped);
+        //! \remark only for FSX/P3D/FS9 models, the files are parsed in parallel
+        static CStatusMessageList validateAircraftConfigFiles(const CAircraftModelList &models, CAircraftModelList &validModels, CAircraftModelList &invalidModels, bool ignoreEmptyFileNames, int stopAtFailedFiles, std::atomic_bool &wasStopped, CDirectoryStatCache *statCache = nullptr);
 
         //! Validate if known SimObjects path are used
         //! \remark only for P3D
@@ -0,0 +1,540 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#include "blackmisc/simulation/interpolationbinarylog.h"
+#include "blackmisc/simulation/interpolationlogger.h"
+#include "blackmisc/simulation/lastsentfingerprints.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/pq/units.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/logcategories.h"
+#include "blackmisc/logmessage.h"
+#include "blackmisc/stringutils.h"
+#include "blackmisc/swiftdirectories.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringBuilder>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc::Simulation
+{
+    namespace
+    {
+        using Record = CInterpolationBinaryLog::Record;
+
+        constexpr char Magic[8] = { 'S', 'W', 'I', 'F', 'T', 'I', 'P', 'L' };
+        constexpr quint32 Version = 1;
+
+        //! Ring buffer of one thread, single writer (interpolating thread), single reader (log writer)
+        struct ThreadBuffer
+        {
+            std::array<Record, CInterpolationBinaryLog::RecordsPerThread> records {};
+            std::atomic<quint64> written { 0 }; //!< records appended so far
+            std::atomic<quint64> read { 0 }; //!< records drained so far
+            std::atomic_bool inUse { true }; //!< false when the thread has finished, the buffer can be reused
+        };
+
+        //! All buffers, never deleted as threads may still append on shutdown
+        struct Registry
+        {
+            QMutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        };
+
+        Registry &registry()
+        {
+            static Registry *r = new Registry();
+            return *r;
+        }
+
+        //! Releases the buffer when the thread finishes
+        struct ThreadBufferHolder
+        {
+            ThreadBuffer *buffer = nullptr;
+            ~ThreadBufferHolder()
+            {
+                if (buffer) { buffer->inUse.store(false, std::memory_order_release); }
+            }
+        };
+
+        thread_local ThreadBufferHolder t_buffer;
+
+        std::atomic_bool g_recording { false };
+        std::atomic<qint64> g_written { 0 };
+        std::atomic<qint64> g_dropped { 0 };
+
+        ThreadBuffer *threadBuffer()
+        {
+            if (t_buffer.buffer) { return t_buffer.buffer; }
+
+            Registry &r = registry();
+            QMutexLocker l(&r.mutex);
+            for (const std::unique_ptr<ThreadBuffer> &b : r.buffers)
+            {
+                bool expected = false;
+                if (b->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    t_buffer.buffer = b.get();
+                    return t_buffer.buffer;
+                }
+            }
+            auto b = std::make_unique<ThreadBuffer>();
+            t_buffer.buffer = b.get();
+            r.buffers.push_back(std::move(b));
+            return t_buffer.buffer;
+        }
+
+        //! Value or NaN if null
+        template <class PQ, class MU>
+        double valueOrNaN(const PQ &pq, const MU &unit)
+        {
+            return pq.isNull() ? std::numeric_limits<double>::quiet_NaN() : pq.value(unit);
+        }
+
+        void copyCallsign(const CCallsign &callsign, Record &record)
+        {
+            const QString &cs = callsign.asString();
+            const int size = std::min(static_cast<int>(sizeof(record.callsign)) - 1, static_cast<int>(cs.size()));
+            for (int i = 0; i < size; ++i) { record.callsign[i] = cs.at(i).toLatin1(); }
+            record.callsign[size] = 0;
+        }
+
+        quint8 altitudeCorrection(const QString &correction)
+        {
+            for (int c = CAircraftSituation::NoCorrection; c <= CAircraftSituation::UnknownCorrection; ++c)
+            {
+                if (CAircraftSituation::altitudeCorrectionToString(static_cast<CAircraftSituation::AltitudeCorrection>(c)) == correction) { return static_cast<quint8>(c); }
+            }
+            return static_cast<quint8>(CAircraftSituation::UnknownCorrection);
+        }
+
+        QString number(double v, int digits)
+        {
+            return std::isnan(v) ? QString() : QString::number(v, 'f', digits);
+        }
+    } // namespace
+
+    QString CInterpolationBinaryLog::Record::getCallsign() const
+    {
+        return QString::fromLatin1(callsign, static_cast<int>(qstrnlen(callsign, sizeof(callsign))));
+    }
+
+    CInterpolationBinaryLog::Record CInterpolationBinaryLog::fromSituationLog(const SituationLog &log)
+    {
+        static const CLengthUnit ft = CLengthUnit::ft();
+        static const CAngleUnit deg = CAngleUnit::deg();
+
+        Record r {};
+        r.type = SituationRecord;
+        r.tsCurrent = log.tsCurrent;
+        r.tsInterpolated = log.tsInterpolated;
+        r.tsOldest = log.oldestInterpolationSituation().getAdjustedMSecsSinceEpoch();
+        r.tsNewest = log.newestInterpolationSituation().getAdjustedMSecsSinceEpoch();
+
+        const CAircraftSituation &s = log.situationCurrent;
+        r.latitudeDeg = s.latitude().value(deg);
+        r.longitudeDeg = s.longitude().value(deg);
+        r.altitudeFt = valueOrNaN(s.getAltitude(), ft);
+        r.groundElevationFt = valueOrNaN(s.getGroundElevation(), ft);
+        r.cgFt = valueOrNaN(log.cgAboveGround, ft);
+        r.sceneryOffsetFt = valueOrNaN(log.sceneryOffset, ft);
+        r.headingDeg = static_cast<float>(s.getHeading().value(deg));
+        r.pitchDeg = static_cast<float>(s.getPitch().value(deg));
+        r.bankDeg = static_cast<float>(s.getBank().value(deg));
+        r.groundSpeedKts = static_cast<float>(s.getGroundSpeed().value(CSpeedUnit::kts()));
+        r.groundFactor = static_cast<float>(log.groundFactor);
+        r.simTimeFraction = static_cast<float>(log.simTimeFraction);
+        r.deltaSampleTimesMs = static_cast<float>(log.deltaSampleTimesMs);
+
+        r.partsBits = log.useParts && !log.parts.isNull() ? CLastSentFingerprints::partsBits(log.parts) : 0;
+        r.networkCount = log.noNetworkSituations;
+        r.invalidSituations = log.noInvalidSituations;
+        r.interpolator = static_cast<quint8>(log.interpolator.toLatin1());
+        r.flags = static_cast<quint8>((log.useParts ? UseParts : 0) | (log.vtolAircraft ? VtolAircraft : 0) | (log.interpolantRecalc ? InterpolantRecalculated : 0));
+        r.altCorrection = altitudeCorrection(log.altCorrection);
+        copyCallsign(log.callsign, r);
+        return r;
+    }
+
+    CInterpolationBinaryLog::Record CInterpolationBinaryLog::fromPartsLog(const PartsLog &log)
+    {
+        Record r {};
+        r.type = PartsRecord;
+        r.tsCurrent = log.tsCurrent;
+        r.tsInterpolated = log.parts.getAdjustedMSecsSinceEpoch();
+        r.tsOldest = r.tsNewest = -1;
+        r.latitudeDeg = r.longitudeDeg = r.altitudeFt = std::numeric_limits<double>::quiet_NaN();
+        r.groundElevationFt = r.cgFt = r.sceneryOffsetFt = std::numeric_limits<double>::quiet_NaN();
+        r.partsBits = log.empty ? 0 : CLastSentFingerprints::partsBits(log.parts);
+        r.networkCount = log.noNetworkParts;
+        r.flags = log.empty ? EmptyParts : 0;
+        copyCallsign(log.callsign, r);
+        return r;
+    }
+
+    void CInterpolationBinaryLog::append(const Record &record)
+    {
+        if (!CInterpolationBinaryLog::isRecording()) { return; }
+
+        ThreadBuffer *b = threadBuffer();
+        const quint64 w = b->written.load(std::memory_order_relaxed);
+        if (w - b->read.load(std::memory_order_acquire) >= RecordsPerThread)
+        {
+            // the writer is behind, never overwrite what it may be reading
+            g_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        b->records[w % RecordsPerThread] = record;
+        b->written.store(w + 1, std::memory_order_release);
+    }
+
+    bool CInterpolationBinaryLog::isRecording()
+    {
+        return g_recording.load(std::memory_order_relaxed);
+    }
+
+    qint64 CInterpolationBinaryLog::getWrittenCount()
+    {
+        return g_written.load(std::memory_order_relaxed);
+    }
+
+    qint64 CInterpolationBinaryLog::getDroppedCount()
+    {
+        return g_dropped.load(std::memory_order_relaxed);
+    }
+
+    QString CInterpolationBinaryLog::getStatistics()
+    {
+        return QStringLiteral("binary log %1, written %2 records, dropped %3")
+            .arg(isRecording() ? QStringLiteral("recording") : QStringLiteral("stopped"))
+            .arg(getWrittenCount())
+            .arg(getDroppedCount());
+    }
+
+    int CInterpolationBinaryLog::drain(QByteArray &records)
+    {
+        int drained = 0;
+        Registry &r = registry();
+        QMutexLocker l(&r.mutex);
+        for (const std::unique_ptr<ThreadBuffer> &b : r.buffers)
+        {
+            const quint64 end = b->written.load(std::memory_order_acquire);
+            quint64 begin = b->read.load(std::memory_order_relaxed);
+            while (begin < end)
+            {
+                // at most 2 contiguous parts of the ring
+                const quint64 index = begin % RecordsPerThread;
+                const quint64 count = std::min(end - begin, RecordsPerThread - index);
+                records.append(reinterpret_cast<const char *>(&b->records[index]), static_cast<int>(count * sizeof(Record)));
+                begin += count;
+                drained += static_cast<int>(count);
+            }
+            b->read.store(end, std::memory_order_release);
+        }
+        return drained;
+    }
+
+    void CInterpolationBinaryLog::setRecording(bool recording)
+    {
+        g_recording.store(recording, std::memory_order_relaxed);
+    }
+
+    void CInterpolationBinaryLog::addWritten(int records)
+    {
+        g_written.fetch_add(records, std::memory_order_relaxed);
+    }
+
+    CStatusMessage CInterpolationBinaryLog::readFile(const QString &fileName, QVector<Record> &records)
+    {
+        static const CInterpolationBinaryLog *const logger = nullptr;
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) { return CStatusMessage(logger).error(u"Cannot open binary log '%1'") << fileName; }
+
+        QDataStream ds(&file);
+        ds.setByteOrder(QDataStream::LittleEndian);
+        char magic[sizeof(Magic)] {};
+        quint32 version = 0;
+        quint32 recordSize = 0;
+        ds.readRawData(magic, sizeof(magic));
+        ds >> version >> recordSize;
+        if (ds.status() != QDataStream::Ok || std::memcmp(magic, Magic, sizeof(Magic)) != 0) { return CStatusMessage(logger).error(u"'%1' is no binary interpolation log") << fileName; }
+        if (version != Version || recordSize != sizeof(Record)) { return CStatusMessage(logger).error(u"'%1' has version %2 and record size %3, expected %4 and %5") << fileName << version << recordSize << Version << static_cast<int>(sizeof(Record)); }
+
+        int blocks = 0;
+        while (!ds.atEnd())
+        {
+            quint32 size = 0;
+            ds >> size;
+            QByteArray compressed(static_cast<int>(size), Qt::Uninitialized);
+            if (ds.status() != QDataStream::Ok || ds.readRawData(compressed.data(), compressed.size()) != compressed.size())
+            {
+                // written until the client stopped, keep what was complete
+                return CStatusMessage(logger).warning(u"Binary log '%1' truncated after %2 records") << fileName << records.size();
+            }
+
+            const QByteArray raw = qUncompress(compressed);
+            if (raw.isEmpty() || raw.size() % static_cast<int>(sizeof(Record)) != 0) { return CStatusMessage(logger).error(u"Corrupt block %1 in binary log '%2'") << blocks << fileName; }
+
+            const int n = raw.size() / static_cast<int>(sizeof(Record));
+            const int offset = records.size();
+            records.resize(offset + n);
+            std::memcpy(records.data() + offset, raw.constData(), static_cast<size_t>(raw.size()));
+            blocks++;
+        }
+        return CStatusMessage(logger).info(u"Read %1 records in %2 blocks from '%3'") << records.size() << blocks << fileName;
+    }
+
+    QString CInterpolationBinaryLog::toCsv(const QVector<Record> &records, const QString &separator)
+    {
+        static const QStringList header {
+            "type", "callsign", "interpolator", "ts current", "ts interpolated", "ts oldest", "ts newest",
+            "lat", "lng", "alt ft", "elv ft", "cg ft", "offset ft", "heading", "pitch", "bank", "gs kts",
+            "gnd factor", "fraction", "sample dt ms", "network", "invalid", "parts", "vtol", "recalc", "alt correction", "parts bits", "parts details"
+        };
+
+        QString csv = header.join(separator) % u"\n";
+        csv.reserve(records.size() * 200);
+        for (const Record &r : records)
+        {
+            const bool situation = r.type == SituationRecord;
+            const QStringList values {
+                situation ? QStringLiteral("situation") : QStringLiteral("parts"),
+                r.getCallsign(),
+                situation ? QString(QChar::fromLatin1(static_cast<char>(r.interpolator))) : QString(),
+                QString::number(r.tsCurrent),
+                QString::number(r.tsInterpolated),
+                situation ? QString::number(r.tsOldest) : QString(),
+                situation ? QString::number(r.tsNewest) : QString(),
+                number(r.latitudeDeg, 8), number(r.longitudeDeg, 8), number(r.altitudeFt, 1),
+                number(r.groundElevationFt, 1), number(r.cgFt, 1), number(r.sceneryOffsetFt, 1),
+                situation ? QString::number(r.headingDeg, 'f', 2) : QString(),
+                situation ? QString::number(r.pitchDeg, 'f', 2) : QString(),
+                situation ? QString::number(r.bankDeg, 'f', 2) : QString(),
+                situation ? QString::number(r.groundSpeedKts, 'f', 1) : QString(),
+                situation ? QString::number(r.groundFactor, 'f', 2) : QString(),
+                situation ? QString::number(r.simTimeFraction, 'f', 3) : QString(),
+                situation ? QString::number(r.deltaSampleTimesMs, 'f', 0) : QString(),
+                QString::number(r.networkCount),
+                QString::number(r.invalidSituations),
+                QString::number((r.flags & UseParts) ? 1 : 0),
+                QString::number((r.flags & VtolAircraft) ? 1 : 0),
+                QString::number((r.flags & InterpolantRecalculated) ? 1 : 0),
+                situation ? CAircraftSituation::altitudeCorrectionToString(static_cast<CAircraftSituation::AltitudeCorrection>(r.altCorrection)) : QString(),
+                QStringLiteral("0x") % QString::number(r.partsBits, 16),
+                (r.flags & EmptyParts) ? QStringLiteral("empty") : partsBitsToString(r.partsBits)
+            };
+            csv += values.join(separator) % u"\n";
+        }
+        return csv;
+    }
+
+    QString CInterpolationBinaryLog::toHtml(const QVector<Record> &records)
+    {
+        static const QString situationHeader = QStringLiteral(
+            u"<thead><tr>"
+            u"<th title=\"changed situation\">cs.</th><th>Int</th>"
+            u"<th title=\"recalculated interpolant\">recalc</th>"
+            u"<th>CS</th><th>VTOL</th><th>timestamp</th><th>since</th>"
+            u"<th>ts old</th><th>ts new</th>"
+            u"<th>Interpolation ts.</th><th>Sample &Delta;t</th><th>fraction</th>"
+            u"<th>lat.cur</th><th>lng.cur</th><th>alt.cur</th><th>elv.cur</th><th>alt.cor.</th>"
+            u"<th>PBH</th><th>GS</th>"
+            u"<th>gnd.factor</th><th>CG</th><th>offset</th>"
+            u"<th>parts</th><th title=\"changed parts\">cp.</th><th>parts details</th>"
+            u"</tr></thead>\n");
+
+        static const QString partsHeader = QStringLiteral(
+            u"<thead><tr>"
+            u"<th>CS</th><th>timestamp</th>"
+            u"<th>c.</th>"
+            u"<th>parts</th>"
+            u"</tr></thead>\n");
+
+        QString situationRows;
+        QString partsRows;
+        qint64 firstTs = -1;
+        QHash<QString, qint64> newPosTs;
+        QHash<QString, quint64> lastSituationParts;
+        QHash<QString, quint64> lastParts;
+        for (const Record &r : records)
+        {
+            const QString cs = r.getCallsign();
+            if (r.type == PartsRecord)
+            {
+                const bool changedParts = lastParts.value(cs, 0) != r.partsBits;
+                lastParts.insert(cs, r.partsBits);
+                partsRows +=
+                    u"<tr><td>" % cs % u"</td>" %
+                    u"<td>" % CInterpolationLogger::msSinceEpochToTime(r.tsCurrent) % u"</td>" %
+                    (changedParts ? u"<td class=\"changed\">*</td>" : u"<td></td>") %
+                    u"<td>" % ((r.flags & EmptyParts) ? QStringLiteral("empty") : partsBitsToString(r.partsBits)) % u"</td></tr>\n";
+                continue;
+            }
+
+            if (firstTs < 0) { firstTs = r.tsCurrent; }
+            const bool changedNewPosition = newPosTs.value(cs, -1) != r.tsNewest;
+            const bool changedParts = lastSituationParts.value(cs, 0) != r.partsBits;
+            newPosTs.insert(cs, r.tsNewest);
+            lastSituationParts.insert(cs, r.partsBits);
+            const bool useParts = r.flags & UseParts;
+
+            situationRows +=
+                u"<tr>" %
+                (changedNewPosition ? QStringLiteral("<td class=\"changed\">*</td>") : QStringLiteral("<td></td>")) %
+                u"<td>" % QChar::fromLatin1(static_cast<char>(r.interpolator)) % u"</td>" %
+                u"<td>" % boolToYesNo(r.flags & InterpolantRecalculated) % u"</td>" %
+                u"<td>" % cs % u"</td>" %
+                u"<td>" % boolToYesNo(r.flags & VtolAircraft) % u"</td>" %
+                u"<td>" % CInterpolationLogger::msSinceEpochToTime(r.tsCurrent) % u"</td>" %
+                u"<td>" % QString::number(r.tsCurrent - firstTs) % u"</td>" %
+                u"<td class=\"old\">" % CInterpolationLogger::msSinceEpochToTime(r.tsOldest) % u"</td>" %
+                u"<td class=\"new\">" % CInterpolationLogger::msSinceEpochToTime(r.tsNewest) % u"</td>" %
+                u"<td>" % CInterpolationLogger::msSinceEpochToTime(r.tsInterpolated) % u"</td>" %
+                u"<td>" % QString::number(r.deltaSampleTimesMs) % u"ms</td>" %
+                u"<td>" % QString::number(r.simTimeFraction) % u"</td>" %
+                u"<td class=\"cur\">" % number(r.latitudeDeg, 6) % u"</td>" %
+                u"<td class=\"cur\">" % number(r.longitudeDeg, 6) % u"</td>" %
+                u"<td class=\"cur\">" % number(r.altitudeFt, 1) % u"</td>" %
+                u"<td class=\"cur\">" % number(r.groundElevationFt, 1) % u"</td>" %
+                u"<td>" % CAircraftSituation::altitudeCorrectionToString(static_cast<CAircraftSituation::AltitudeCorrection>(r.altCorrection)) % u"</td>" %
+                u"<td>" % QString::number(r.pitchDeg, 'f', 1) % u"/" % QString::number(r.bankDeg, 'f', 1) % u"/" % QString::number(r.headingDeg, 'f', 1) % u"</td>" %
+                u"<td>" % QString::number(r.groundSpeedKts, 'f', 0) % u"</td>" %
+                u"<td>" % QString::number(r.groundFactor) % u"</td>" %
+                u"<td>" % number(r.cgFt, 0) % u"</td>" %
+                u"<td>" % number(r.sceneryOffsetFt, 1) % u"</td>" %
+                u"<td>" % boolToYesNo(useParts) % u"</td>" %
+                (changedParts ? u"<td class=\"changed\">*</td>" : u"<td></td>") %
+                u"<td>" % (useParts ? partsBitsToString(r.partsBits) : QString()) % u"</td>" %
+                u"</tr>\n";
+        }
+
+        QString html;
+        if (!situationRows.isEmpty()) { html += u"<table class=\"small\">\n" % situationHeader % u"<tbody>\n" % situationRows % u"</tbody>\n</table>\n"; }
+        if (!partsRows.isEmpty()) { html += u"<table class=\"small\">\n" % partsHeader % u"<tbody>\n" % partsRows % u"</tbody>\n</table>\n"; }
+        return html;
+    }
+
+    QString CInterpolationBinaryLog::partsBitsToString(quint64 bits)
+    {
+        // same order as CLastSentFingerprints::partsBits
+        static const std::array<const char *, 12> names { "lights null", "strobe", "landing", "taxi", "beacon", "nav", "logo", "recognition", "cabin", "gear", "spoilers", "on ground" };
+        QStringList on;
+        for (size_t b = 0; b < names.size(); ++b)
+        {
+            if (bits & (Q_UINT64_C(1) << b)) { on << QString::fromLatin1(names[b]); }
+        }
+
+        int bit = static_cast<int>(names.size());
+        const int flaps = static_cast<int>((bits >> bit) & 0xff);
+        bit += 8;
+        const int engines = static_cast<int>((bits >> bit) & 0x3f);
+        bit += 6;
+        QString enginesOn;
+        for (int e = 0; e < engines && bit < 64; ++e, ++bit) { enginesOn += (bits & (Q_UINT64_C(1) << bit)) ? u'1' : u'0'; }
+
+        on << QStringLiteral("flaps %1%").arg(flaps);
+        if (engines > 0) { on << QStringLiteral("engines %1").arg(enginesOn); }
+        return on.join(", ");
+    }
+
+    const QString &CInterpolationBinaryLog::filePattern()
+    {
+        static const QString p("*interpolation.ipl");
+        return p;
+    }
+
+    const QStringList &CInterpolationBinaryLog::getLogCategories()
+    {
+        static const QStringList cats { CLogCategories::interpolator() };
+        return cats;
+    }
+
+    CInterpolationBinaryLogWriter::CInterpolationBinaryLogWriter(QObject *owner, const QString &fileName) : CContinuousWorker(owner, "Binary interpolation log")
+    {
+        if (fileName.isEmpty())
+        {
+            QString file = CInterpolationBinaryLog::filePattern();
+            file.remove('*');
+            m_fileName = CFileUtils::appendFilePaths(CSwiftDirectories::logDirectory(), QStringLiteral("%1 %2").arg(QDateTime::currentDateTimeUtc().toString("yyyyMMddhhmmss"), file));
+        }
+        else { m_fileName = fileName; }
+
+        bool expected = false;
+        if (!g_recording.compare_exchange_strong(expected, true))
+        {
+            CLogMessage(this).warning(u"Binary interpolation log already recording, not writing '%1'") << m_fileName;
+            return;
+        }
+
+        m_file.setFileName(m_fileName);
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            CInterpolationBinaryLog::setRecording(false);
+            CLogMessage(this).error(u"Cannot open binary interpolation log '%1'") << m_fileName;
+            return;
+        }
+
+        QDataStream ds(&m_file);
+        ds.setByteOrder(QDataStream::LittleEndian);
+        ds.writeRawData(Magic, sizeof(Magic));
+        ds << Version << static_cast<quint32>(sizeof(Record));
+
+        // records of a previous recording are not part of this file
+        QByteArray discard;
+        CInterpolationBinaryLog::drain(discard);
+
+        m_valid = true;
+        connect(&m_updateTimer, &QTimer::timeout, this, &CInterpolationBinaryLogWriter::flush);
+        m_updateTimer.setInterval(250);
+    }
+
+    const QStringList &CInterpolationBinaryLogWriter::getLogCategories()
+    {
+        return CInterpolationBinaryLog::getLogCategories();
+    }
+
+    void CInterpolationBinaryLogWriter::initialize()
+    {
+        if (m_valid) { m_updateTimer.start(); }
+    }
+
+    void CInterpolationBinaryLogWriter::cleanup()
+    {
+        if (!m_valid) { return; }
+        CInterpolationBinaryLog::setRecording(false);
+        this->flush();
+        m_file.close();
+        m_valid = false;
+        CLogMessage(this).info(u"Written binary interpolation log '%1', %2") << m_fileName << CInterpolationBinaryLog::getStatistics();
+    }
+
+    void CInterpolationBinaryLogWriter::flush()
+    {
+        if (!m_valid) { return; }
+        const int records = CInterpolationBinaryLog::drain(m_buffer);
+        if (records < 1) { return; }
+
+        const QByteArray compressed = qCompress(m_buffer);
+        m_buffer.clear();
+
+        QDataStream ds(&m_file);
+        ds.setByteOrder(QDataStream::LittleEndian);
+        ds << static_cast<quint32>(compressed.size());
+        ds.writeRawData(compressed.constData(), compressed.size());
+        CInterpolationBinaryLog::addWritten(records);
+    }
+} // namespace
@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_INTERPOLATIONBINARYLOG_H
+#define BLACKMISC_SIMULATION_INTERPOLATIONBINARYLOG_H
+
+#include "blackmisc/worker.h"
+#include "blackmisc/statusmessage.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+#include <type_traits>
+
+namespace BlackMisc::Simulation
+{
+    struct SituationLog;
+    struct PartsLog;
+
+    /*!
+     * Compact binary log of interpolation and parts steps, meant to log all aircraft for a whole session.
+     *
+     * Steps are converted to fixed size records and appended to a ring buffer of the interpolating thread
+     * without locking. While recording, CInterpolationBinaryLogWriter drains the buffers in the background
+     * and appends compressed blocks to a file. Records not drained before the buffer is full are dropped and counted.
+     * Files are converted to CSV or HTML by samples_interpolationlog.
+     *
+     * File: "SWIFTIPL", quint32 version and quint32 record size, then blocks of a quint32 size and the qCompress'ed records.
+     * Header and sizes are little endian, records are raw bytes of the writing machine.
+     */
+    class BLACKMISC_EXPORT CInterpolationBinaryLog
+    {
+    public:
+        //! Record types
+        enum RecordType : quint8
+        {
+            SituationRecord,
+            PartsRecord
+        };
+
+        //! Record flags
+        enum RecordFlag : quint8
+        {
+            UseParts = 1 << 0, //!< aircraft supports parts
+            VtolAircraft = 1 << 1, //!< VTOL aircraft
+            InterpolantRecalculated = 1 << 2, //!< interpolant recalculated
+            EmptyParts = 1 << 3 //!< no parts available
+        };
+
+        //! One step, situations use all values, parts only the times, parts bits and counts
+        struct Record
+        {
+            qint64 tsCurrent; //!< current time
+            qint64 tsInterpolated; //!< interpolated time, for parts the parts timestamp
+            qint64 tsOldest; //!< oldest situation used (adjusted)
+            qint64 tsNewest; //!< latest situation used (adjusted)
+            double latitudeDeg; //!< interpolated latitude
+            double longitudeDeg; //!< interpolated longitude
+            double altitudeFt; //!< interpolated altitude
+            double groundElevationFt; //!< NaN without elevation
+            double cgFt; //!< NaN without CG
+            double sceneryOffsetFt; //!< NaN without offset
+            float headingDeg; //!< interpolated heading
+            float pitchDeg; //!< interpolated pitch
+            float bankDeg; //!< interpolated bank
+            float groundSpeedKts; //!< interpolated ground speed
+            float groundFactor; //!< interpolated ground factor
+            float simTimeFraction; //!< time fraction, expected 0..1
+            float deltaSampleTimesMs; //!< delta time between samples
+            quint64 partsBits; //!< parts as CLastSentFingerprints::partsBits
+            qint32 networkCount; //!< network situations or parts available
+            qint32 invalidSituations; //!< invalid situations
+            quint8 type; //!< RecordType
+            quint8 interpolator; //!< 'l' linear, 's' spline
+            quint8 flags; //!< RecordFlag
+            quint8 altCorrection; //!< Aviation::CAircraftSituation::AltitudeCorrection
+            char callsign[12]; //!< Latin-1, 0 terminated if shorter
+
+            //! Callsign as string
+            QString getCallsign() const;
+        };
+        static_assert(std::is_trivially_copyable_v<Record>, "Records are copied as bytes");
+
+        //! Records per thread buffered until written
+        static constexpr int RecordsPerThread = 16384;
+
+        //! Record of an interpolation step
+        static Record fromSituationLog(const SituationLog &log);
+
+        //! Record of a parts step
+        static Record fromPartsLog(const PartsLog &log);
+
+        //! Append a record, ignored when not recording
+        //! \threadsafe lock free
+        static void append(const Record &record);
+
+        //! Recording?
+        //! \threadsafe
+        static bool isRecording();
+
+        //! Records written to the file so far
+        //! \threadsafe
+        static qint64 getWrittenCount();
+
+        //! Records dropped as the buffer of a thread was full
+        //! \threadsafe
+        static qint64 getDroppedCount();
+
+        //! Records written and dropped
+        //! \threadsafe
+        static QString getStatistics();
+
+        //! Move all buffered records to the byte array
+        //! \remark only called by the writer
+        static int drain(QByteArray &records);
+
+        //! Read a log file
+        static CStatusMessage readFile(const QString &fileName, QVector<Record> &records);
+
+        //! Records as CSV, one line per record
+        static QString toCsv(const QVector<Record> &records, const QString &separator = ";");
+
+        //! Records as HTML tables, situations and parts
+        static QString toHtml(const QVector<Record> &records);
+
+        //! Parts bits as string
+        static QString partsBitsToString(quint64 bits);
+
+        //! File pattern of the logs
+        static const QString &filePattern();
+
+        //! Log categories
+        static const QStringList &getLogCategories();
+
+    private:
+        friend class CInterpolationBinaryLogWriter;
+
+        //! Set by the writer
+        static void setRecording(bool recording);
+
+        //! Written records
+        static void addWritten(int records);
+    };
+
+    /*!
+     * Background writer of CInterpolationBinaryLog, only one writer records at a time
+     */
+    class BLACKMISC_EXPORT CInterpolationBinaryLogWriter : public CContinuousWorker
+    {
+        Q_OBJECT
+
+    public:
+        //! Constructor, opens the file, default in the log directory
+        CInterpolationBinaryLogWriter(QObject *owner, const QString &fileName = {});
+
+        //! Opened file and no other writer?
+        bool isValid() const { return m_valid; }
+
+        //! File written
+        const QString &getFileName() const { return m_fileName; }
+
+        //! Log categories
+        static const QStringList &getLogCategories();
+
+    protected:
+        //! \copydoc CContinuousWorker::initialize
+        virtual void initialize() override;
+
+        //! \copydoc CContinuousWorker::cleanup
+        virtual void cleanup() override;
+
+    private:
+        //! Write buffered records as one block
+        void flush();
+
+        QString m_fileName;
+        QFile m_file { this };
+        QByteArray m_buffer;
+        bool m_valid = false;
+    };
+} // namespace
+
+#endif // guard
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
 
 #include "blackmisc/simulation/interpolationlogger.h"
+#include "blackmisc/simulation/interpolationbinarylog.h"
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/aviation/heading.h"
 #include "blackmisc/geo/kmlutils.h"
@@ -33,6 +34,11 @@ namespace BlackMisc::Simulation
         this->setObjectName("CInterpolationLogger");
     }
 
+    CInterpolationLogger::~CInterpolationLogger()
+    {
+        this->stopBinaryLog();
+    }
+
     const QStringList &CInterpolationLogger::getLogCategories()
     {
         static const QStringList cats { CLogCategories::interpolator() };
@@ -152,6 +158,12 @@ namespace BlackMisc::Simulation
 
     void CInterpolationLogger::logInterpolation(const SituationLog &log)
     {
+        if (CInterpolationBinaryLog::isRecording())
+        {
+            CInterpolationBinaryLog::append(CInterpolationBinaryLog::fromSituationLog(log));
+            return;
+        }
+
         QWriteLocker l(&m_lockSituations);
         m_situationLogs.push_back(log);
         if (m_situationLogs.size() > m_maxSituations)
@@ -162,6 +174,12 @@ namespace BlackMisc::Simulation
 
     void CInterpolationLogger::logParts(const PartsLog &log)
     {
+        if (CInterpolationBinaryLog::isRecording())
+        {
+            CInterpolationBinaryLog::append(CInterpolationBinaryLog::fromPartsLog(log));
+            return;
+        }
+
         QWriteLocker l(&m_lockParts);
         m_partsLogs.push_back(log);
     }
@@ -172,6 +190,35 @@ namespace BlackMisc::Simulation
         m_maxSituations = max;
     }
 
+    CStatusMessage CInterpolationLogger::startBinaryLog(const QString &fileName)
+    {
+        if (m_binaryLogWriter) { return CStatusMessage(this).warning(u"Binary log already written to '%1'") << m_binaryLogWriter->getFileName(); }
+        if (CInterpolationBinaryLog::isRecording()) { return CStatusMessage(this).warning(u"Binary log already recording"); }
+
+        auto *writer = new CInterpolationBinaryLogWriter(this, fileName);
+        if (!writer->isValid())
+        {
+            const QString fn = writer->getFileName();
+            writer->deleteLater();
+            return CStatusMessage(this).error(u"Cannot write binary log '%1'") << fn;
+        }
+        writer->start(QThread::LowPriority);
+        m_binaryLogWriter = writer;
+        return CStatusMessage(this).info(u"Writing binary log '%1'") << writer->getFileName();
+    }
+
+    void CInterpolationLogger::stopBinaryLog()
+    {
+        if (!m_binaryLogWriter) { return; }
+        m_binaryLogWriter->quitAndWait(); // deletes itself
+        m_binaryLogWriter.clear();
+    }
+
+    bool CInterpolationLogger::isBinaryLogging() const
+    {
+        return m_binaryLogWriter && CInterpolationBinaryLog::isRecording();
+    }
+
     QList<SituationLog> CInterpolationLogger::getSituationsLog() const
     {
         QReadLocker l(&m_lockSituations);
@@ -14,6 +14,7 @@
 #include "blackmisc/logcategories.h"
 
 #include <QObject>
+#include <QPointer>
 #include <QStringList>
 #include <QtGlobal>
 
@@ -22,6 +23,8 @@ namespace BlackMisc
     class CWorker;
     namespace Simulation
     {
+        class CInterpolationBinaryLogWriter;
+
         //! Log entry for situation interpolation
         struct BLACKMISC_EXPORT SituationLog
         {
@@ -99,6 +102,9 @@ namespace BlackMisc
             //! Constructor
             CInterpolationLogger(QObject *parent = nullptr);
 
+            //! Destructor, stops the binary log
+            virtual ~CInterpolationLogger() override;
+
             //! Log categories
             static const QStringList &getLogCategories();
 
@@ -127,6 +133,16 @@ namespace BlackMisc
             //! Max.situations logged
             void setMaxSituations(int max);
 
+            //! Start logging to a binary file instead of memory, default file in the log directory
+            //! \remark all interpolators log to this file, see CInterpolationBinaryLog
+            CStatusMessage startBinaryLog(const QString &fileName = {});
+
+            //! Stop the binary log, remaining records are written
+            void stopBinaryLog();
+
+            //! Binary log started by this logger?
+            bool isBinaryLogging() const;
+
             //! All situation logs
             //! \threadsafe
             QList<SituationLog> getSituationsLog() const;
@@ -215,6 +231,7 @@ namespace BlackMisc
             //! Status of file operation
             static CStatusMessage logStatusFileWriting(bool success, const QString &fileName);
 
+            QPointer<CInterpolationBinaryLogWriter> m_binaryLogWriter; //!< writing the binary log
             mutable QReadWriteLock m_lockSituations; //!< lock logging situations
             mutable QReadWriteLock m_lockParts; //!< lock logging parts
             int m_maxSituations = 2500; //!< max.number of situations
@@ -257,6 +257,51 @@ namespace BlackMisc::Simulation
         return rt;
     }
 
+    bool CInterpolationAndRenderingSetupGlobal::setUpdateTiers(const CLength &nearDistance, const CLength &farDistance, int midFrames, int farFrames)
+    {
+        const CLength nearD = nearDistance.isNull() ? m_updateTierNearDistance : nearDistance;
+        const CLength farD = farDistance.isNull() || farDistance < nearD ? nearD : farDistance;
+        const int midF = qMax(1, midFrames);
+        const int farF = qMax(midF, farFrames);
+        if (nearD == m_updateTierNearDistance && farD == m_updateTierFarDistance && midF == m_updateTierMidFrames && farF == m_updateTierFarFrames) { return false; }
+        m_updateTierNearDistance = nearD;
+        m_updateTierFarDistance = farD;
+        m_updateTierMidFrames = midF;
+        m_updateTierFarFrames = farF;
+        return true;
+    }
+
+    int CInterpolationAndRenderingSetupGlobal::getUpdateTierFrames(const CLength &distance) const
+    {
+        if (!this->isUsingUpdateTiers() || distance.isNull()) { return 1; }
+        if (distance < m_updateTierNearDistance) { return 1; }
+        if (distance < m_updateTierFarDistance) { return m_updateTierMidFrames; }
+        return m_updateTierFarFrames;
+    }
+
+    QString CInterpolationAndRenderingSetupGlobal::getUpdateTiersText() const
+    {
+        if (!this->isUsingUpdateTiers()) { return QStringLiteral("every frame"); }
+        return QStringLiteral("<%1 every frame, <%2 every %3 frames, beyond every %4 frames")
+            .arg(m_updateTierNearDistance.valueRoundedWithUnit(CLengthUnit::NM(), 0), m_updateTierFarDistance.valueRoundedWithUnit(CLengthUnit::NM(), 0))
+            .arg(m_updateTierMidFrames)
+            .arg(m_updateTierFarFrames);
+    }
+
+    bool CInterpolationAndRenderingSetupGlobal::setFrameBudgetMs(int budgetMs)
+    {
+        const int b = qMax(0, budgetMs);
+        if (b == m_frameBudgetMs) { return false; }
+        m_frameBudgetMs = b;
+        return true;
+    }
+
+    QString CInterpolationAndRenderingSetupGlobal::getFrameBudgetText() const
+    {
+        if (!this->isUsingFrameBudget()) { return QStringLiteral("no budget"); }
+        return QStringLiteral("%1ms").arg(m_frameBudgetMs);
+    }
+
     void CInterpolationAndRenderingSetupGlobal::setBaseValues(const CInterpolationAndRenderingSetupBase &baseValues)
     {
         m_logInterpolation = baseValues.logInterpolation();
@@ -274,7 +319,9 @@ namespace BlackMisc::Simulation
         Q_UNUSED(i18n)
         return CInterpolationAndRenderingSetupBase::convertToQString(i18n) %
                QStringLiteral(" max.aircraft:") % QString::number(m_maxRenderedAircraft) %
-               QStringLiteral(" max.distance:") % m_maxRenderedDistance.valueRoundedWithUnit(CLengthUnit::NM(), 2);
+               QStringLiteral(" max.distance:") % m_maxRenderedDistance.valueRoundedWithUnit(CLengthUnit::NM(), 2) %
+               QStringLiteral(" update tiers:") % this->getUpdateTiersText() %
+               QStringLiteral(" frame budget:") % this->getFrameBudgetText();
     }
 
     QVariant CInterpolationAndRenderingSetupGlobal::propertyByIndex(CPropertyIndexRef index) const
@@ -285,6 +332,11 @@ namespace BlackMisc::Simulation
         {
         case IndexMaxRenderedAircraft: return QVariant::fromValue(m_maxRenderedAircraft);
         case IndexMaxRenderedDistance: return QVariant::fromValue(m_maxRenderedDistance);
+        case IndexUpdateTierNearDistance: return QVariant::fromValue(m_updateTierNearDistance);
+        case IndexUpdateTierFarDistance: return QVariant::fromValue(m_updateTierFarDistance);
+        case IndexUpdateTierMidFrames: return QVariant::fromValue(m_updateTierMidFrames);
+        case IndexUpdateTierFarFrames: return QVariant::fromValue(m_updateTierFarFrames);
+        case IndexFrameBudgetMs: return QVariant::fromValue(m_frameBudgetMs);
         default: break;
         }
         if (CInterpolationAndRenderingSetupBase::canHandleIndex(i)) { return CInterpolationAndRenderingSetupBase::propertyByIndex(index); }
@@ -303,6 +355,11 @@ namespace BlackMisc::Simulation
         {
         case IndexMaxRenderedAircraft: m_maxRenderedAircraft = variant.toInt(); return;
         case IndexMaxRenderedDistance: m_maxRenderedDistance = variant.value<CLength>(); return;
+        case IndexUpdateTierNearDistance: m_updateTierNearDistance = variant.value<CLength>(); return;
+        case IndexUpdateTierFarDistance: m_updateTierFarDistance = variant.value<CLength>(); return;
+        case IndexUpdateTierMidFrames: m_updateTierMidFrames = qMax(1, variant.toInt()); return;
+        case IndexUpdateTierFarFrames: m_updateTierFarFrames = qMax(1, variant.toInt()); return;
+        case IndexFrameBudgetMs: m_frameBudgetMs = qMax(0, variant.toInt()); return;
         default: break;
         }
         if (CInterpolationAndRenderingSetupBase::canHandleIndex(i))
@@ -149,7 +149,12 @@ namespace BlackMisc
             enum ColumnIndex
             {
                 IndexMaxRenderedAircraft = CInterpolationAndRenderingSetupBase::IndexFixSceneryOffset + 1,
-                IndexMaxRenderedDistance
+                IndexMaxRenderedDistance,
+                IndexUpdateTierNearDistance,
+                IndexUpdateTierFarDistance,
+                IndexUpdateTierMidFrames,
+                IndexUpdateTierFarFrames,
+                IndexFrameBudgetMs
             };
 
             //! Constructor.
@@ -194,6 +199,43 @@ namespace BlackMisc
             //! Text describing the restrictions
             QString getRenderRestrictionText() const;
 
+            //! Aircraft closer than this are updated every frame
+            const PhysicalQuantities::CLength &getUpdateTierNearDistance() const { return m_updateTierNearDistance; }
+
+            //! Aircraft beyond this are updated every getUpdateTierFarFrames frames
+            const PhysicalQuantities::CLength &getUpdateTierFarDistance() const { return m_updateTierFarDistance; }
+
+            //! Aircraft between near and far distance are updated every n-th frame
+            int getUpdateTierMidFrames() const { return m_updateTierMidFrames; }
+
+            //! Aircraft beyond far distance are updated every n-th frame
+            int getUpdateTierFarFrames() const { return m_updateTierFarFrames; }
+
+            //! Set the distance based update tiers
+            //! \remark 1 frame means every frame, so 1/1 disables the tiers
+            bool setUpdateTiers(const PhysicalQuantities::CLength &nearDistance, const PhysicalQuantities::CLength &farDistance, int midFrames, int farFrames);
+
+            //! Are aircraft updated less often by distance?
+            bool isUsingUpdateTiers() const { return m_updateTierMidFrames > 1 || m_updateTierFarFrames > 1; }
+
+            //! Update every n-th frame for given distance
+            int getUpdateTierFrames(const PhysicalQuantities::CLength &distance) const;
+
+            //! Text describing the update tiers
+            QString getUpdateTiersText() const;
+
+            //! Time budget in ms for updating the remote aircraft in one frame, 0 means no budget
+            int getFrameBudgetMs() const { return m_frameBudgetMs; }
+
+            //! Set the frame budget, values below 1 disable the budget
+            bool setFrameBudgetMs(int budgetMs);
+
+            //! Remote aircraft updates limited by a frame budget?
+            bool isUsingFrameBudget() const { return m_frameBudgetMs > 0; }
+
+            //! Text describing the frame budget
+            QString getFrameBudgetText() const;
+
             //! Set all base values
             void setBaseValues(const CInterpolationAndRenderingSetupBase &baseValues);
 
@@ -209,6 +251,11 @@ namespace BlackMisc
         private:
             int m_maxRenderedAircraft = InfiniteAircraft(); //!< max.rendered aircraft
             PhysicalQuantities::CLength m_maxRenderedDistance { 0, nullptr }; //!< max.distance for rendering
+            PhysicalQuantities::CLength m_updateTierNearDistance { 10.0, PhysicalQuantities::CLengthUnit::NM() }; //!< updated every frame below
+            PhysicalQuantities::CLength m_updateTierFarDistance { 30.0, PhysicalQuantities::CLengthUnit::NM() }; //!< updated every m_updateTierFarFrames beyond
+            int m_updateTierMidFrames = 1; //!< update every n-th frame between near and far
+            int m_updateTierFarFrames = 1; //!< update every n-th frame beyond far
+            int m_frameBudgetMs = 0; //!< budget for the remote aircraft of one frame
 
             BLACK_METACLASS(
                 CInterpolationAndRenderingSetupGlobal,
@@ -221,7 +268,12 @@ namespace BlackMisc
                 BLACK_METAMEMBER(interpolatorMode),
                 BLACK_METAMEMBER(pitchOnGround),
                 BLACK_METAMEMBER(maxRenderedAircraft),
-                BLACK_METAMEMBER(maxRenderedDistance)
+                BLACK_METAMEMBER(maxRenderedDistance),
+                BLACK_METAMEMBER(updateTierNearDistance),
+                BLACK_METAMEMBER(updateTierFarDistance),
+                BLACK_METAMEMBER(updateTierMidFrames),
+                BLACK_METAMEMBER(updateTierFarFrames),
+                BLACK_METAMEMBER(frameBudgetMs)
             );
         };
 
@@ -234,7 +286,7 @@ namespace BlackMisc
             //! Properties by index
             enum ColumnIndex
             {
-                IndexCallsign = CInterpolationAndRenderingSetupGlobal::IndexMaxRenderedDistance + 1
+                IndexCallsign = CInterpolationAndRenderingSetupGlobal::IndexFrameBudgetMs + 1
             };
 
             //! Constructor
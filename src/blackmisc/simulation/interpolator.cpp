@@ -3,9 +3,11 @@
 
 #include "blackmisc/simulation/interpolator.h"
 #include "blackconfig/buildconfig.h"
+#include "blackmisc/simulation/interpolationbinarylog.h"
 #include "blackmisc/simulation/interpolationlogger.h"
 #include "blackmisc/simulation/interpolatorlinear.h"
 #include "blackmisc/simulation/interpolatorspline.h"
+#include "blackmisc/simulation/latencytrace.h"
 #include "blackmisc/aviation/aircraftsituationchange.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/network/fsdsetup.h"
@@ -216,6 +218,7 @@ namespace BlackMisc::Simulation
     CInterpolationResult CInterpolator<Derived>::getInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber)
     {
         CInterpolationResult result;
+        const qint64 traceStartNs = CLatencyTrace::isEnabled() ? CLatencyTrace::nowNs() : -1;
         do
         {
             // make sure we can also interpolate parts only (needed in unit tests)
@@ -224,8 +227,9 @@ namespace BlackMisc::Simulation
             Q_ASSERT_X(!m_currentInterpolationStatus.isInterpolated(), Q_FUNC_INFO, "Expect reset status");
             if (!m_unitTest && !init) { break; } // failure in real scenarios, unit tests move on
             Q_ASSERT_X(m_currentTimeMsSinceEpoch > 0, Q_FUNC_INFO, "No valid timestamp, interpolator initialized?");
-            const CAircraftSituation interpolatedSituation = this->getInterpolatedSituation();
+            CAircraftSituation interpolatedSituation = this->getInterpolatedSituation();
             const CAircraftParts interpolatedParts = this->getInterpolatedOrGuessedParts(aircraftNumber);
+            this->traceInterpolation(interpolatedSituation, traceStartNs);
             result.setValues(interpolatedSituation, interpolatedParts);
         }
         while (false);
@@ -234,6 +238,28 @@ namespace BlackMisc::Simulation
         return result;
     }
 
+    template <typename Derived>
+    void CInterpolator<Derived>::traceInterpolation(CAircraftSituation &situation, qint64 startNs)
+    {
+        // the interpolated situation is a copy of the last one, so it always gets a new stamp or none
+        if (startNs < 0 || m_currentSituations.isEmpty())
+        {
+            situation.setTraceReceivedNs(-1);
+            return;
+        }
+
+        // only the first interpolation using the latest situation is traced
+        const qint64 receivedNs = m_currentSituations.front().getTraceReceivedNs();
+        if (receivedNs < 0 || receivedNs == m_lastTracedReceivedNs)
+        {
+            situation.setTraceReceivedNs(-1);
+            return;
+        }
+        m_lastTracedReceivedNs = receivedNs;
+        situation.setTraceReceivedNs(receivedNs);
+        CLatencyTrace::record(CLatencyTrace::Interpolation, m_callsign, receivedNs, startNs, CLatencyTrace::nowNs());
+    }
+
     template <typename Derived>
     CAircraftSituation CInterpolator<Derived>::getInterpolatedSituation()
     {
@@ -385,9 +411,13 @@ namespace BlackMisc::Simulation
             log.altCorrection = CAircraftSituation::altitudeCorrectionToString(altCorrection);
             log.situationCurrent = currentSituation;
             log.interpolantRecalc = interpolant.isRecalculated();
-            log.change = m_pastSituationsChange;
-            log.usedSetup = m_currentSetup;
-            log.elevationInfo = this->getElevationsFoundMissedInfo();
+            if (!CInterpolationBinaryLog::isRecording())
+            {
+                // not part of the binary records
+                log.change = m_pastSituationsChange;
+                log.usedSetup = m_currentSetup;
+                log.elevationInfo = this->getElevationsFoundMissedInfo();
+            }
             log.cgAboveGround = currentSituation.getCG();
             log.sceneryOffset = m_currentSceneryOffset;
             log.noInvalidSituations = m_invalidSituations;
@@ -258,6 +258,10 @@ namespace BlackMisc
             //! Current interpolated situation
             Aviation::CAircraftSituation getInterpolatedSituation();
 
+            //! Stamp and trace the first interpolated situation using the latest traced network situation
+            //! \sa CLatencyTrace
+            void traceInterpolation(Aviation::CAircraftSituation &situation, qint64 startNs);
+
             //! Parts before given offset time
             Aviation::CAircraftParts getInterpolatedParts();
 
@@ -298,6 +302,7 @@ namespace BlackMisc
             qint64 m_situationsLastModified { -1 }; //!< when situations were last modified
             qint64 m_situationsLastModifiedUsed { -1 }; //!< interpolant based on situations last updated
             int m_interpolatedSituationsCounter { 0 }; //!< counter for each interpolated situations: used for statistics, every n-th interpolation ....
+            qint64 m_lastTracedReceivedNs { -1 }; //!< latency trace, receive time of the last traced situation
 
             bool m_unitTest = false; //!< mark as unit test
 
@@ -79,22 +79,6 @@ namespace BlackMisc::Simulation
             solveTridiagonal(a, b);
             return b;
         }
-
-        //! \private Cubic interpolation.
-        double evalSplineInterval(double x, double x0, double x1, double y0, double y1, double k0, double k1)
-        {
-            const double t = (x - x0) / (x1 - x0);
-            const double a = k0 * (x1 - x0) - (y1 - y0);
-            const double b = -k1 * (x1 - x0) + (y1 - y0);
-            const double y = (1 - t) * y0 + t * y1 + t * (1 - t) * (a * (1 - t) + b * t);
-
-            if (CBuildConfig::isLocalDeveloperDebugBuild())
-            {
-                BLACK_VERIFY_X(t >= 0, Q_FUNC_INFO, "Expect t >= 0");
-                BLACK_VERIFY_X(t <= 1.0, Q_FUNC_INFO, "Expect t <= 1");
-            }
-            return y;
-        }
     }
 
     bool CInterpolatorSpline::fillSituationsArray()
@@ -179,14 +163,24 @@ namespace BlackMisc::Simulation
     {
         // recalculate derivatives only if they changed
         // m_situationsLastModified updated in initIniterpolationStepData
-        const bool recalculate = (m_currentTimeMsSinceEpoch >= m_nextSampleAdjustedTime) || // new step
-                                 (m_situationsLastModified > m_situationsLastModifiedUsed); // modified
+        // situations are also modified by elevation and parts updates of older situations,
+        // for those the current segment can be kept until a new situation arrives, unless forcing full interpolation
+        const bool newStep = m_currentTimeMsSinceEpoch >= m_nextSampleAdjustedTime;
+        const bool modified = m_situationsLastModified > m_situationsLastModifiedUsed;
+        const bool recalculate = newStep || (modified && (m_currentSetup.isForcingFullInterpolation() || this->isLatestSituationChanged()));
+        m_situationsLastModifiedUsed = m_situationsLastModified;
 
         if (recalculate)
         {
             // with the latest updates of T243 the order and the offsets are supposed to be correct
             // so even mixing fast/slow updates shall work
-            m_situationsLastModifiedUsed = m_situationsLastModified;
+            if (!m_currentSituations.isEmpty())
+            {
+                const CAircraftSituation &latest = m_currentSituations.front();
+                m_latestAdjustedTimeUsed = latest.getAdjustedMSecsSinceEpoch();
+                m_latestGroundFactorUsed = latest.getOnGroundFactor();
+                m_latestGroundElevationUsed = latest.getGroundElevation();
+            }
             const bool fillStatus = this->fillSituationsArray();
             if (!fillStatus)
             {
@@ -276,6 +270,15 @@ namespace BlackMisc::Simulation
         return m_interpolant;
     }
 
+    bool CInterpolatorSpline::isLatestSituationChanged() const
+    {
+        if (m_currentSituations.isEmpty()) { return m_latestAdjustedTimeUsed >= 0; }
+        const CAircraftSituation &latest = m_currentSituations.front();
+        return latest.getAdjustedMSecsSinceEpoch() != m_latestAdjustedTimeUsed ||
+               latest.getOnGroundFactor() != m_latestGroundFactorUsed ||
+               latest.getGroundElevation() != m_latestGroundElevationUsed;
+    }
+
     bool CInterpolatorSpline::updateElevations(bool canSkip)
     {
         bool updated = false;
@@ -313,6 +316,31 @@ namespace BlackMisc::Simulation
     {
         m_pbh = pbh;
         m_situationsAvailable = pa.size();
+
+        // coefficients once per interpolant, so a frame only evaluates the polynomials
+        m_validPa = CAircraftSituation::isValidVector(m_pa.x) && CAircraftSituation::isValidVector(m_pa.y) && CAircraftSituation::isValidVector(m_pa.z);
+        m_x = this->segment(m_pa.x, m_pa.dx);
+        m_y = this->segment(m_pa.y, m_pa.dy);
+        m_z = this->segment(m_pa.z, m_pa.dz);
+        m_a = this->segment(m_pa.a, m_pa.da);
+        m_gnd = this->segment(m_pa.gnd, m_pa.dgnd);
+    }
+
+    CInterpolatorSpline::CInterpolant::Segment CInterpolatorSpline::CInterpolant::segment(const std::array<double, 3> &y, const std::array<double, 3> &dy) const
+    {
+        // cubic interpolation between the last two knots
+        const double h = m_pa.t[2] - m_pa.t[1];
+        Segment s;
+        s.y0 = y[1];
+        s.y1 = y[2];
+        s.a = dy[1] * h - (y[2] - y[1]);
+        s.b = -dy[2] * h + (y[2] - y[1]);
+        return s;
+    }
+
+    double CInterpolatorSpline::CInterpolant::Segment::value(double t) const
+    {
+        return (1 - t) * y0 + t * y1 + t * (1 - t) * (a * (1 - t) + b * t);
     }
 
     CAircraftSituation CInterpolatorSpline::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &currentSituation, bool interpolateGndFactor) const
@@ -329,11 +357,18 @@ namespace BlackMisc::Simulation
         }
         if (!valid) { return CAircraftSituation::null(); }
 
-        const double newX = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.x[1], m_pa.x[2], m_pa.dx[1], m_pa.dx[2]);
-        const double newY = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.y[1], m_pa.y[2], m_pa.dy[1], m_pa.dy[2]);
-        const double newZ = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.z[1], m_pa.z[2], m_pa.dz[1], m_pa.dz[2]);
+        const double t = (m_currentTimeMsSinceEpoc - t1) / (t2 - t1);
+        if (CBuildConfig::isLocalDeveloperDebugBuild())
+        {
+            BLACK_VERIFY_X(t >= 0, Q_FUNC_INFO, "Expect t >= 0");
+            BLACK_VERIFY_X(t <= 1.0, Q_FUNC_INFO, "Expect t <= 1");
+        }
+
+        const double newX = m_x.value(t);
+        const double newY = m_y.value(t);
+        const double newZ = m_z.value(t);
 
-        valid = CAircraftSituation::isValidVector(m_pa.x) && CAircraftSituation::isValidVector(m_pa.y) && CAircraftSituation::isValidVector(m_pa.z);
+        valid = m_validPa;
         if (!valid && CBuildConfig::isLocalDeveloperDebugBuild())
         {
             BLACK_VERIFY_X(CAircraftSituation::isValidVector(m_pa.x), Q_FUNC_INFO, "invalid X"); // all x values
@@ -354,7 +389,7 @@ namespace BlackMisc::Simulation
         }
         if (!valid) { return CAircraftSituation::null(); }
 
-        const double newA = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.a[1], m_pa.a[2], m_pa.da[1], m_pa.da[2]);
+        const double newA = m_a.value(t);
         const CAltitude alt(newA, m_altitudeUnit);
 
         newSituation.setPosition(currentPosition);
@@ -378,7 +413,7 @@ namespace BlackMisc::Simulation
                     newSituation.setOnGround(true);
                     break;
                 }
-                const double newGnd = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, gnd1, gnd2, m_pa.dgnd[1], m_pa.dgnd[2]);
+                const double newGnd = m_gnd.value(t);
                 newSituation.setOnGroundFactor(newGnd);
                 newSituation.setOnGroundFromGroundFactorFromInterpolation(groundInterpolationFactor());
             }
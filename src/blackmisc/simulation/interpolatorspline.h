@@ -81,9 +81,31 @@ namespace BlackMisc::Simulation
             const PosArray &getPa() const { return m_pa; }
 
         private:
+            //! Cubic segment between the last two knots of one channel
+            //! \remark y(t) = (1-t) * y0 + t * y1 + t * (1-t) * (a * (1-t) + b * t), with t 0..1
+            struct Segment
+            {
+                double y0 = 0.0;
+                double y1 = 0.0;
+                double a = 0.0;
+                double b = 0.0;
+
+                //! Value at t
+                double value(double t) const;
+            };
+
+            //! Segment from the knots and derivatives of one channel
+            Segment segment(const std::array<double, 3> &y, const std::array<double, 3> &dy) const;
+
             PosArray m_pa; //!< current positions array, latest values last
             PhysicalQuantities::CLengthUnit m_altitudeUnit;
             qint64 m_currentTimeMsSinceEpoc { -1 };
+            bool m_validPa = true; //!< all positions in m_pa are valid vectors
+            Segment m_x; //!< normal vector x
+            Segment m_y; //!< normal vector y
+            Segment m_z; //!< normal vector z
+            Segment m_a; //!< altitude
+            Segment m_gnd; //!< ground factor
         };
 
         //! Strategy used by CInterpolator::getInterpolatedSituation
@@ -102,10 +124,16 @@ namespace BlackMisc::Simulation
         //! Fill the situations array
         bool fillSituationsArray();
 
+        //! Has the latest situation changed since the interpolant was calculated?
+        bool isLatestSituationChanged() const;
+
         qint64 m_prevSampleAdjustedTime = 0; //!< previous sample time + offset
         qint64 m_nextSampleAdjustedTime = 0; //!< previous sample time + offset
         qint64 m_prevSampleTime = 0; //!< previous sample "real time"
         qint64 m_nextSampleTime = 0; //!< next sample "real time"
+        qint64 m_latestAdjustedTimeUsed = -1; //!< latest situation used for the interpolant
+        double m_latestGroundFactorUsed = -1.0; //!< ground factor of latest situation used for the interpolant
+        Aviation::CAltitude m_latestGroundElevationUsed; //!< ground elevation of latest situation used for the interpolant, null if none
         std::array<Aviation::CAircraftSituation, 3> m_s; //!< used situations
         CInterpolant m_interpolant;
     };
@@ -0,0 +1,279 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#include "blackmisc/simulation/lastsentfingerprints.h"
+#include "blackmisc/aviation/aircraftengine.h"
+#include "blackmisc/aviation/aircraftlights.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/pq/units.h"
+
+#include <QStringBuilder>
+#include <cmath>
+#include <limits>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc::Simulation
+{
+    namespace
+    {
+        //! \private mean earth radius, scales the normal vector so the position tolerance is in meters
+        constexpr double EarthRadiusM = 6371008.8;
+
+        //! \private quantised value of null values
+        constexpr qint64 NullValue = std::numeric_limits<qint64>::min();
+    }
+
+    bool CLastSentFingerprints::isEqualLastSent(const CAircraftSituation &situation) const
+    {
+        if (situation.isNull()) { return false; }
+        const int s = this->slot(situation.getCallsign());
+        if (s < 0) { return false; }
+        const Fingerprint &last = m_fingerprints[static_cast<size_t>(s)];
+        if (!(last.flags & HasSituation)) { return false; }
+
+        return isEqualSituation(this->situationFingerprint(situation), last);
+    }
+
+    bool CLastSentFingerprints::isEqualLastSent(const CAircraftParts &parts, const CCallsign &callsign) const
+    {
+        if (callsign.isEmpty()) { return false; }
+        const int s = this->slot(callsign);
+        if (s < 0) { return false; }
+        const Fingerprint &last = m_fingerprints[static_cast<size_t>(s)];
+        return (last.flags & HasParts) && last.parts == partsBits(parts);
+    }
+
+    void CLastSentFingerprints::rememberLastSent(const CAircraftSituation &situation)
+    {
+        if (!situation.hasCallsign()) { return; }
+        setSituation(this->fingerprint(situation.getCallsign()), this->situationFingerprint(situation));
+    }
+
+    void CLastSentFingerprints::rememberLastSent(const CAircraftParts &parts, const CCallsign &callsign)
+    {
+        if (callsign.isEmpty()) { return; }
+        Fingerprint &fp = this->fingerprint(callsign);
+        fp.parts = partsBits(parts);
+        fp.flags |= HasParts;
+    }
+
+    bool CLastSentFingerprints::rememberLastSentIfChanged(const CAircraftSituation &situation, bool force)
+    {
+        if (!situation.hasCallsign()) { return true; }
+        const Fingerprint sent = this->situationFingerprint(situation);
+        Fingerprint &fp = this->fingerprint(situation.getCallsign());
+        if (!force && !situation.isNull() && (fp.flags & HasSituation) && isEqualSituation(sent, fp)) { return false; }
+        setSituation(fp, sent);
+        return true;
+    }
+
+    bool CLastSentFingerprints::rememberLastSentIfChanged(const CAircraftParts &parts, const CCallsign &callsign, bool force)
+    {
+        if (callsign.isEmpty()) { return true; }
+        const quint64 bits = partsBits(parts);
+        Fingerprint &fp = this->fingerprint(callsign);
+        if (!force && (fp.flags & HasParts) && fp.parts == bits) { return false; }
+        fp.parts = bits;
+        fp.flags |= HasParts;
+        return true;
+    }
+
+    void CLastSentFingerprints::forgetLastSentSituation(const CCallsign &callsign)
+    {
+        const int s = this->slot(callsign);
+        if (s < 0) { return; }
+        Fingerprint &fp = m_fingerprints[static_cast<size_t>(s)];
+        fp.flags = static_cast<quint8>(fp.flags & HasParts);
+    }
+
+    void CLastSentFingerprints::forgetLastSentParts(const CCallsign &callsign)
+    {
+        const int s = this->slot(callsign);
+        if (s < 0) { return; }
+        m_fingerprints[static_cast<size_t>(s)].flags &= static_cast<quint8>(~HasParts);
+    }
+
+    bool CLastSentFingerprints::isLastSentMoving(const CCallsign &callsign) const
+    {
+        const int s = this->slot(callsign);
+        return s >= 0 && (m_fingerprints[static_cast<size_t>(s)].flags & Moving);
+    }
+
+    bool CLastSentFingerprints::isLastSentMovingNearGround(const CCallsign &callsign) const
+    {
+        const int s = this->slot(callsign);
+        if (s < 0) { return false; }
+        const quint8 flags = m_fingerprints[static_cast<size_t>(s)].flags;
+        return (flags & HasSituation) && (flags & Moving) && !(flags & CanLikelySkipNearGround);
+    }
+
+    CCallsignSet CLastSentFingerprints::getLastSentCanLikelySkipNearGroundInterpolation() const
+    {
+        CCallsignSet callsigns;
+        for (auto it = m_slots.cbegin(); it != m_slots.cend(); ++it)
+        {
+            const Fingerprint &fp = m_fingerprints[static_cast<size_t>(it.value())];
+            if ((fp.flags & HasSituation) && (fp.flags & CanLikelySkipNearGround)) { callsigns.push_back(it.key()); }
+        }
+        return callsigns;
+    }
+
+    void CLastSentFingerprints::remove(const CCallsign &callsign)
+    {
+        const auto it = m_slots.find(callsign);
+        if (it == m_slots.end()) { return; }
+        const int s = it.value();
+        m_slots.erase(it);
+        if (m_slots.isEmpty())
+        {
+            this->clear();
+            return;
+        }
+        m_fingerprints[static_cast<size_t>(s)] = Fingerprint();
+        m_freeSlots.push_back(s);
+    }
+
+    void CLastSentFingerprints::clear()
+    {
+        m_slots.clear();
+        m_fingerprints.clear();
+        m_freeSlots.clear();
+    }
+
+    int CLastSentFingerprints::getMemoryBytes() const
+    {
+        // hash nodes are approximated by key and value
+        const size_t bytes = m_fingerprints.capacity() * sizeof(Fingerprint) +
+                             static_cast<size_t>(m_slots.size()) * (sizeof(CCallsign) + sizeof(int)) +
+                             static_cast<size_t>(m_freeSlots.capacity()) * sizeof(int);
+        return static_cast<int>(bytes);
+    }
+
+    bool CLastSentFingerprints::setTolerances(const CLength &position, const CLength &altitude, const CAngle &angle)
+    {
+        const CLength p = (position.isNull() || !position.isPositiveWithEpsilonConsidered()) ? m_positionTolerance : position;
+        const CLength a = (altitude.isNull() || !altitude.isPositiveWithEpsilonConsidered()) ? m_altitudeTolerance : altitude;
+        const CAngle g = (angle.isNull() || !angle.isPositiveWithEpsilonConsidered()) ? m_angleTolerance : angle;
+        if (p == m_positionTolerance && a == m_altitudeTolerance && g == m_angleTolerance) { return false; }
+
+        m_positionTolerance = p;
+        m_altitudeTolerance = a;
+        m_angleTolerance = g;
+        m_positionToleranceM = p.value(CLengthUnit::m());
+        m_altitudeToleranceM = a.value(CLengthUnit::m());
+        m_angleToleranceDeg = g.value(CAngleUnit::deg());
+        this->clear(); // quantised with the old tolerances
+        return true;
+    }
+
+    QString CLastSentFingerprints::toQString() const
+    {
+        return u"tolerances position: " % m_positionTolerance.valueRoundedWithUnit(CLengthUnit::m(), 3) %
+               u" altitude: " % m_altitudeTolerance.valueRoundedWithUnit(CLengthUnit::m(), 3) %
+               u" angle: " % m_angleTolerance.valueRoundedWithUnit(CAngleUnit::deg(), 3) %
+               u" | aircraft: " % QString::number(this->size()) %
+               u" | bytes: " % QString::number(this->getMemoryBytes());
+    }
+
+    quint64 CLastSentFingerprints::partsBits(const CAircraftParts &parts)
+    {
+        const CAircraftLights lights = parts.getLights();
+        quint64 bits = 0;
+        int bit = 0;
+        const auto add = [&](bool on) {
+            if (on) { bits |= (Q_UINT64_C(1) << bit); }
+            bit++;
+        };
+
+        add(lights.isNull());
+        add(lights.isStrobeOn());
+        add(lights.isLandingOn());
+        add(lights.isTaxiOn());
+        add(lights.isBeaconOn());
+        add(lights.isNavOn());
+        add(lights.isLogoOn());
+        add(lights.isRecognitionOn());
+        add(lights.isCabinOn());
+        add(parts.isGearDown());
+        add(parts.isSpoilersOut());
+        add(parts.isOnGround());
+
+        // 8 bits flaps, 6 bits engine count, then one bit per engine
+        bits |= static_cast<quint64>(qBound(0, parts.getFlapsPercent(), 255)) << bit;
+        bit += 8;
+        const CAircraftEngineList engines = parts.getEngines();
+        bits |= static_cast<quint64>(qBound(0, engines.size(), 63)) << bit;
+        bit += 6;
+        for (const CAircraftEngine &engine : engines)
+        {
+            if (bit >= 64) { break; }
+            add(engine.isOn());
+        }
+        return bits;
+    }
+
+    CLastSentFingerprints::Fingerprint CLastSentFingerprints::situationFingerprint(const CAircraftSituation &situation) const
+    {
+        Fingerprint fp;
+        const std::array<double, 3> v = situation.normalVectorDouble();
+        for (size_t i = 0; i < 3; ++i) { fp.position[i] = quantise(v[i] * EarthRadiusM, m_positionToleranceM); }
+
+        const std::array<const CAngle *, 3> angles { { &situation.getPitch(), &situation.getBank(), &situation.getHeading() } };
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const CAngle &angle = *angles[i];
+            fp.pbh[i] = angle.isNull() ? std::numeric_limits<qint32>::min() : static_cast<qint32>(quantise(CAngle::normalizeDegrees360(angle.value(CAngleUnit::deg())), m_angleToleranceDeg));
+        }
+
+        fp.altitude = situation.getAltitude().isNull() ? NullValue : quantise(situation.getAltitude().value(CLengthUnit::m()), m_altitudeToleranceM);
+        fp.elevation = situation.hasGroundElevation() ? quantise(situation.getGroundElevation().value(CLengthUnit::m()), m_altitudeToleranceM) : NullValue;
+
+        fp.flags = HasSituation;
+        if (situation.isMoving()) { fp.flags |= Moving; }
+        if (situation.canLikelySkipNearGroundInterpolation()) { fp.flags |= CanLikelySkipNearGround; }
+        return fp;
+    }
+
+    bool CLastSentFingerprints::isEqualSituation(const Fingerprint &fp1, const Fingerprint &fp2)
+    {
+        return fp1.position == fp2.position && fp1.pbh == fp2.pbh && fp1.altitude == fp2.altitude && fp1.elevation == fp2.elevation;
+    }
+
+    void CLastSentFingerprints::setSituation(Fingerprint &fp, const Fingerprint &sent)
+    {
+        fp.position = sent.position;
+        fp.pbh = sent.pbh;
+        fp.altitude = sent.altitude;
+        fp.elevation = sent.elevation;
+        fp.flags = static_cast<quint8>((fp.flags & HasParts) | sent.flags);
+    }
+
+    CLastSentFingerprints::Fingerprint &CLastSentFingerprints::fingerprint(const CCallsign &callsign)
+    {
+        const auto it = m_slots.constFind(callsign);
+        if (it != m_slots.cend()) { return m_fingerprints[static_cast<size_t>(it.value())]; }
+
+        int s = -1;
+        if (m_freeSlots.isEmpty())
+        {
+            s = static_cast<int>(m_fingerprints.size());
+            m_fingerprints.emplace_back();
+        }
+        else
+        {
+            s = m_freeSlots.takeLast();
+        }
+        m_slots.insert(callsign, s);
+        return m_fingerprints[static_cast<size_t>(s)];
+    }
+
+    qint64 CLastSentFingerprints::quantise(double value, double tolerance)
+    {
+        // bucketing, not a difference check: equal values are in the same bucket of tolerance width
+        if (!std::isfinite(value)) { return NullValue; }
+        return std::llround(value / tolerance);
+    }
+} // ns
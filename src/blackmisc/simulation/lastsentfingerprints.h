@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_LASTSENTFINGERPRINTS_H
+#define BLACKMISC_SIMULATION_LASTSENTFINGERPRINTS_H
+
+#include "blackmisc/aviation/aircraftparts.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/callsignset.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <vector>
+
+namespace BlackMisc::Simulation
+{
+    /*!
+     * Compact fingerprints of the situations and parts last sent to a simulator.
+     *
+     * Instead of a copy of the last sent situation and parts per callsign, position, PBH, altitude
+     * and ground elevation are quantised by configurable tolerances and the parts are packed into bits.
+     * Quantising is bucketing: values rounding to the same multiple of the tolerance are equal,
+     * a difference of a tolerance or more is always a change, a smaller difference across a bucket edge is one too.
+     * Each callsign gets a slot in a flat array, slots of removed callsigns are reused.
+     */
+    class BLACKMISC_EXPORT CLastSentFingerprints
+    {
+    public:
+        //! Constructor
+        CLastSentFingerprints() = default;
+
+        //! Situation equal to the last sent situation within the tolerances?
+        bool isEqualLastSent(const Aviation::CAircraftSituation &situation) const;
+
+        //! Parts equal to the last sent parts?
+        bool isEqualLastSent(const Aviation::CAircraftParts &parts, const Aviation::CCallsign &callsign) const;
+
+        //! Remember as last sent
+        void rememberLastSent(const Aviation::CAircraftSituation &situation);
+
+        //! Remember as last sent
+        void rememberLastSent(const Aviation::CAircraftParts &parts, const Aviation::CCallsign &callsign);
+
+        //! Remember as last sent if not equal to the last sent situation, or if forced
+        //! \return true if remembered, so the situation is to be sent
+        //! \remark one lookup and one fingerprint, instead of isEqualLastSent followed by rememberLastSent
+        bool rememberLastSentIfChanged(const Aviation::CAircraftSituation &situation, bool force = false);
+
+        //! Remember as last sent if not equal to the last sent parts, or if forced
+        //! \return true if remembered, so the parts are to be sent
+        bool rememberLastSentIfChanged(const Aviation::CAircraftParts &parts, const Aviation::CCallsign &callsign, bool force = false);
+
+        //! Forget the last sent situation, like when sending failed, so the next situation is not equal
+        void forgetLastSentSituation(const Aviation::CCallsign &callsign);
+
+        //! Forget the last sent parts, like when sending failed, so the next parts are not equal
+        void forgetLastSentParts(const Aviation::CCallsign &callsign);
+
+        //! Was the last sent situation moving?
+        //! \sa Aviation::CAircraftSituation::isMoving
+        bool isLastSentMoving(const Aviation::CCallsign &callsign) const;
+
+        //! Was the last sent situation moving near ground, like taxiing, take off or landing?
+        bool isLastSentMovingNearGround(const Aviation::CCallsign &callsign) const;
+
+        //! Callsigns whose last sent situation can likely skip near ground interpolation
+        //! \sa Aviation::CAircraftSituation::canLikelySkipNearGroundInterpolation
+        Aviation::CCallsignSet getLastSentCanLikelySkipNearGroundInterpolation() const;
+
+        //! Remove callsign, its slot will be reused
+        void remove(const Aviation::CCallsign &callsign);
+
+        //! Remove all callsigns
+        void clear();
+
+        //! Number of callsigns
+        int size() const { return m_slots.size(); }
+
+        //! Number of slots, including the free ones
+        int getSlotCount() const { return static_cast<int>(m_fingerprints.size()); }
+
+        //! Approximate memory used by the fingerprints in bytes
+        int getMemoryBytes() const;
+
+        //! @{
+        //! Tolerances, the widths of the quantisation buckets
+        const PhysicalQuantities::CLength &getPositionTolerance() const { return m_positionTolerance; }
+        const PhysicalQuantities::CLength &getAltitudeTolerance() const { return m_altitudeTolerance; }
+        const PhysicalQuantities::CAngle &getAngleTolerance() const { return m_angleTolerance; }
+        //! @}
+
+        //! Set the tolerances, null or non positive values keep the current tolerance
+        //! \remark changed tolerances drop all fingerprints, the next values are sent in any case
+        bool setTolerances(const PhysicalQuantities::CLength &position, const PhysicalQuantities::CLength &altitude, const PhysicalQuantities::CAngle &angle);
+
+        //! Tolerances and size as string
+        QString toQString() const;
+
+        //! Parts packed into bits, timestamps and parts details are ignored as in Aviation::CAircraftParts::equalValues
+        static quint64 partsBits(const Aviation::CAircraftParts &parts);
+
+    private:
+        //! Quantised values of one aircraft
+        struct Fingerprint
+        {
+            std::array<qint64, 3> position {}; //!< normal vector scaled to earth radius
+            std::array<qint32, 3> pbh {};
+            qint64 altitude = 0;
+            qint64 elevation = 0;
+            quint64 parts = 0;
+            quint8 flags = 0;
+        };
+
+        //! Fingerprint flags
+        enum FingerprintFlag : quint8
+        {
+            HasSituation = 1 << 0,
+            HasParts = 1 << 1,
+            Moving = 1 << 2,
+            CanLikelySkipNearGround = 1 << 3
+        };
+
+        //! Quantised situation, flags only for situation values
+        Fingerprint situationFingerprint(const Aviation::CAircraftSituation &situation) const;
+
+        //! Situation values of both fingerprints equal?
+        static bool isEqualSituation(const Fingerprint &fp1, const Fingerprint &fp2);
+
+        //! Store the situation values, the parts are kept
+        static void setSituation(Fingerprint &fp, const Fingerprint &sent);
+
+        //! Slot of callsign, -1 if none
+        int slot(const Aviation::CCallsign &callsign) const { return m_slots.value(callsign, -1); }
+
+        //! Slot of callsign, created if needed
+        Fingerprint &fingerprint(const Aviation::CCallsign &callsign);
+
+        //! Quantise a value to its bucket of tolerance width, null values are mapped to an own value
+        static qint64 quantise(double value, double tolerance);
+
+        PhysicalQuantities::CLength m_positionTolerance { 0.01, PhysicalQuantities::CLengthUnit::m() };
+        PhysicalQuantities::CLength m_altitudeTolerance { 0.01, PhysicalQuantities::CLengthUnit::m() };
+        PhysicalQuantities::CAngle m_angleTolerance { 0.01, PhysicalQuantities::CAngleUnit::deg() };
+        double m_positionToleranceM = 0.01; //!< cached tolerance in SI unit
+        double m_altitudeToleranceM = 0.01; //!< cached tolerance in SI unit
+        double m_angleToleranceDeg = 0.01; //!< cached tolerance in degrees
+        QHash<Aviation::CCallsign, int> m_slots; //!< callsign, index in m_fingerprints
+        std::vector<Fingerprint> m_fingerprints; //!< flat array indexed by slot
+        QVector<int> m_freeSlots; //!< slots of removed callsigns
+    };
+} // ns
+
+#endif // guard
@@ -0,0 +1,305 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#include "blackmisc/simulation/latencytrace.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/logcategories.h"
+#include "blackmisc/swiftdirectories.h"
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringBuilder>
+#include <QThread>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc::Simulation
+{
+    namespace
+    {
+        //! Ring buffer of one thread, single writer
+        struct ThreadBuffer
+        {
+            std::array<CLatencyTrace::Event, CLatencyTrace::EventsPerThread> events {};
+            std::atomic<quint64> written { 0 }; //!< events written so far
+            std::atomic_bool inUse { true }; //!< false when the thread has finished, the buffer can be reused
+            int index = 0;
+            QString threadName;
+        };
+
+        //! All buffers, never deleted as threads may still write on shutdown
+        struct Registry
+        {
+            QMutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        };
+
+        Registry &registry()
+        {
+            static Registry *r = new Registry();
+            return *r;
+        }
+
+        //! Releases the buffer when the thread finishes
+        struct ThreadBufferHolder
+        {
+            ThreadBuffer *buffer = nullptr;
+            ~ThreadBufferHolder()
+            {
+                if (buffer) { buffer->inUse.store(false, std::memory_order_release); }
+            }
+        };
+
+        thread_local ThreadBufferHolder t_buffer;
+
+        std::atomic_bool g_enabled { false };
+        std::atomic<qint64> g_clearedNs { 0 };
+
+        ThreadBuffer *threadBuffer()
+        {
+            if (t_buffer.buffer) { return t_buffer.buffer; }
+
+            const QThread *thread = QThread::currentThread();
+            const QString name = thread ? thread->objectName() : QString();
+
+            Registry &r = registry();
+            QMutexLocker l(&r.mutex);
+            for (const std::unique_ptr<ThreadBuffer> &b : r.buffers)
+            {
+                bool expected = false;
+                if (b->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    b->threadName = name;
+                    t_buffer.buffer = b.get();
+                    return t_buffer.buffer;
+                }
+            }
+            auto b = std::make_unique<ThreadBuffer>();
+            b->index = static_cast<int>(r.buffers.size());
+            b->threadName = name;
+            t_buffer.buffer = b.get();
+            r.buffers.push_back(std::move(b));
+            return t_buffer.buffer;
+        }
+
+        //! Percentile of sorted values
+        qint64 percentile(const std::vector<qint64> &sorted, int p)
+        {
+            if (sorted.empty()) { return 0; }
+            const size_t i = std::min(sorted.size() - 1, sorted.size() * static_cast<size_t>(p) / 100);
+            return sorted[i];
+        }
+
+        QString ms(qint64 ns)
+        {
+            return QString::number(ns / 1.0e6, 'f', 2) % u"ms";
+        }
+    } // namespace
+
+    bool CLatencyTrace::isEnabled()
+    {
+        return g_enabled.load(std::memory_order_relaxed);
+    }
+
+    void CLatencyTrace::setEnabled(bool enabled)
+    {
+        g_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    qint64 CLatencyTrace::nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void CLatencyTrace::record(Stage stage, const CCallsign &callsign, qint64 receivedNs, qint64 startNs, qint64 endNs)
+    {
+        if (receivedNs < 0 || !CLatencyTrace::isEnabled()) { return; }
+
+        ThreadBuffer *b = threadBuffer();
+        const quint64 w = b->written.load(std::memory_order_relaxed);
+        Event &e = b->events[w % EventsPerThread];
+        e.receivedNs = receivedNs;
+        e.startNs = startNs;
+        e.endNs = endNs;
+        e.stage = stage;
+        e.thread = b->index;
+
+        // no allocation, callsigns are Latin-1 anyway
+        const QString &cs = callsign.asString();
+        const int size = std::min(static_cast<int>(sizeof(e.callsign)) - 1, static_cast<int>(cs.size()));
+        for (int i = 0; i < size; ++i) { e.callsign[i] = cs.at(i).toLatin1(); }
+        e.callsign[size] = 0;
+
+        b->written.store(w + 1, std::memory_order_release);
+    }
+
+    QVector<CLatencyTrace::Event> CLatencyTrace::getEvents()
+    {
+        const qint64 clearedNs = g_clearedNs.load(std::memory_order_relaxed);
+        QVector<Event> events;
+
+        Registry &r = registry();
+        QMutexLocker l(&r.mutex);
+        for (const std::unique_ptr<ThreadBuffer> &b : r.buffers)
+        {
+            const quint64 end = b->written.load(std::memory_order_acquire);
+            const quint64 begin = end > EventsPerThread ? end - EventsPerThread : 0;
+            QVector<Event> copied;
+            copied.reserve(static_cast<int>(end - begin));
+            for (quint64 i = begin; i < end; ++i) { copied.push_back(b->events[i % EventsPerThread]); }
+
+            // events overwritten by the writer meanwhile are dropped
+            const quint64 after = b->written.load(std::memory_order_acquire);
+            const quint64 valid = after > EventsPerThread ? after - EventsPerThread : 0;
+            const int skip = valid > begin ? static_cast<int>(std::min(valid - begin, end - begin)) : 0;
+            for (int i = skip; i < copied.size(); ++i)
+            {
+                if (copied[i].startNs >= clearedNs) { events.push_back(copied[i]); }
+            }
+        }
+        l.unlock();
+
+        std::sort(events.begin(), events.end(), [](const Event &a, const Event &b) { return a.startNs < b.startNs; });
+        return events;
+    }
+
+    void CLatencyTrace::clear()
+    {
+        g_clearedNs.store(CLatencyTrace::nowNs(), std::memory_order_relaxed);
+    }
+
+    QString CLatencyTrace::toChromeTraceJson(const QVector<Event> &events)
+    {
+        QJsonArray traceEvents;
+
+        // thread names
+        {
+            Registry &r = registry();
+            QMutexLocker l(&r.mutex);
+            for (const std::unique_ptr<ThreadBuffer> &b : r.buffers)
+            {
+                const QString name = b->threadName.isEmpty() ? QStringLiteral("thread %1").arg(b->index) : b->threadName;
+                traceEvents.append(QJsonObject {
+                    { "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", b->index }, { "args", QJsonObject { { "name", name } } } });
+            }
+        }
+
+        for (const Event &e : events)
+        {
+            const Stage stage = static_cast<Stage>(e.stage);
+            const double tsUs = e.startNs / 1000.0;
+            traceEvents.append(QJsonObject {
+                { "name", stageName(stage) },
+                { "cat", "latency" },
+                { "ph", "X" },
+                { "pid", 1 },
+                { "tid", e.thread },
+                { "ts", tsUs },
+                { "dur", std::max(e.getDurationNs(), 1000LL) / 1000.0 },
+                { "args", QJsonObject { { "callsign", e.getCallsign() }, { "sinceReceivedMs", e.getSinceReceivedNs() / 1.0e6 } } } });
+
+            // one flow per position, from receive to the simulator
+            const char *ph = stage == FsdReceived ? "s" : (stage == SimulatorSend ? "f" : "t");
+            QJsonObject flow {
+                { "name", "position" }, { "cat", "latency" }, { "ph", ph }, { "pid", 1 }, { "tid", e.thread }, { "ts", tsUs }, { "id", e.getPositionId() } };
+            if (stage == SimulatorSend) { flow.insert("bp", "e"); }
+            traceEvents.append(flow);
+        }
+
+        const QJsonObject trace { { "traceEvents", traceEvents }, { "displayTimeUnit", "ms" } };
+        return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+    }
+
+    CStatusMessage CLatencyTrace::writeChromeTrace(const QString &fileName)
+    {
+        const QVector<Event> events = CLatencyTrace::getEvents();
+        if (events.isEmpty()) { return CStatusMessage(static_cast<CLatencyTrace *>(nullptr)).warning(u"No latency trace events"); }
+
+        const QString fn = !fileName.isEmpty() ? fileName :
+                                                 CFileUtils::appendFilePaths(CSwiftDirectories::logDirectory(), QStringLiteral("%1 latencytrace.json").arg(QDateTime::currentDateTimeUtc().toString("yyyyMMddhhmmss")));
+        const bool s = CFileUtils::writeStringToFile(CLatencyTrace::toChromeTraceJson(events), fn);
+        return s ?
+                   CStatusMessage(static_cast<CLatencyTrace *>(nullptr)).info(u"Written %1 latency trace events to '%2'") << events.size() << fn :
+                   CStatusMessage(static_cast<CLatencyTrace *>(nullptr)).error(u"Failed to write latency trace '%1'") << fn;
+    }
+
+    QString CLatencyTrace::getHistogram(const QVector<Event> &events, const QString &separator)
+    {
+        std::array<std::vector<qint64>, StageCount> since;
+        std::array<std::vector<qint64>, StageCount> durations;
+        for (const Event &e : events)
+        {
+            if (e.stage < 0 || e.stage >= StageCount) { continue; }
+            since[e.stage].push_back(e.getSinceReceivedNs());
+            durations[e.stage].push_back(e.getDurationNs());
+        }
+
+        // since receive in buckets, ms
+        static constexpr std::array<qint64, 4> limitsMs { 1, 10, 100, 1000 };
+        QStringList lines;
+        for (int s = 0; s < StageCount; ++s)
+        {
+            std::vector<qint64> &sr = since[s];
+            std::vector<qint64> &dur = durations[s];
+            if (sr.empty()) { continue; }
+            std::sort(sr.begin(), sr.end());
+            std::sort(dur.begin(), dur.end());
+
+            std::array<int, limitsMs.size() + 1> buckets {};
+            for (qint64 ns : sr)
+            {
+                size_t b = 0;
+                while (b < limitsMs.size() && ns >= limitsMs[b] * 1000000) { ++b; }
+                buckets[b]++;
+            }
+            QString histogram;
+            for (size_t b = 0; b < buckets.size(); ++b)
+            {
+                histogram += (b < limitsMs.size() ? QStringLiteral(" <%1ms: %2").arg(limitsMs[b]) : QStringLiteral(" >=%1ms: %2").arg(limitsMs.back())).arg(buckets[b]);
+            }
+
+            lines << QString(stageName(static_cast<Stage>(s)) % u": " % QString::number(sr.size()) %
+                             u" since received p50/p90/p99/max " % ms(percentile(sr, 50)) % u"/" % ms(percentile(sr, 90)) % u"/" % ms(percentile(sr, 99)) % u"/" % ms(sr.back()) %
+                             u" stage p50/p99 " % ms(percentile(dur, 50)) % u"/" % ms(percentile(dur, 99)) % u"," % histogram);
+        }
+        if (lines.isEmpty()) { return QStringLiteral("No latency trace events"); }
+        return lines.join(separator);
+    }
+
+    const QString &CLatencyTrace::stageName(Stage stage)
+    {
+        static const QString fsd("FSD received");
+        static const QString airspace("airspace monitor");
+        static const QString provider("provider store");
+        static const QString interpolation("interpolation");
+        static const QString send("simulator send");
+        static const QString unknown("unknown");
+
+        switch (stage)
+        {
+        case FsdReceived: return fsd;
+        case AirspaceMonitor: return airspace;
+        case ProviderStore: return provider;
+        case Interpolation: return interpolation;
+        case SimulatorSend: return send;
+        default: break;
+        }
+        return unknown;
+    }
+
+    const QStringList &CLatencyTrace::getLogCategories()
+    {
+        static const QStringList cats { CLogCategories::interpolator() };
+        return cats;
+    }
+} // namespace
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_LATENCYTRACE_H
+#define BLACKMISC_SIMULATION_LATENCYTRACE_H
+
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/statusmessage.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QString>
+#include <QStringBuilder>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+
+namespace BlackMisc::Simulation
+{
+    /*!
+     * Latency trace of remote aircraft positions from the FSD socket to the simulator.
+     *
+     * The FSD client stamps each position with its receive time (CAircraftSituation::getTraceReceivedNs),
+     * the stamp travels with the situation through airspace monitor, provider and interpolator to the driver.
+     * Each stage records its duration and the time since receive in a ring buffer of the calling thread,
+     * writing does not lock. When disabled, positions are not stamped and no stage records anything.
+     */
+    class BLACKMISC_EXPORT CLatencyTrace
+    {
+    public:
+        //! Stages of a position
+        enum Stage
+        {
+            FsdReceived, //!< parsed by the FSD client
+            AirspaceMonitor, //!< handled by the airspace monitor
+            ProviderStore, //!< stored in the remote aircraft provider
+            Interpolation, //!< first interpolation using the position
+            SimulatorSend, //!< first interpolated situation sent by the driver
+            StageCount
+        };
+
+        //! One stage of a traced position
+        struct Event
+        {
+            qint64 receivedNs = -1; //!< receive time of the position
+            qint64 startNs = -1; //!< stage started
+            qint64 endNs = -1; //!< stage finished
+            int stage = FsdReceived; //!< Stage
+            int thread = 0; //!< index of the ring buffer
+            char callsign[16] {}; //!< Latin-1, no allocation when recording
+
+            //! Callsign as string
+            QString getCallsign() const { return QString::fromLatin1(callsign); }
+
+            //! Time spent in the stage
+            qint64 getDurationNs() const { return endNs - startNs; }
+
+            //! Time from receive until the stage finished
+            qint64 getSinceReceivedNs() const { return endNs - receivedNs; }
+
+            //! Identifies the position, all positions of one socket read share the receive time
+            QString getPositionId() const { return this->getCallsign() % u"_" % QString::number(receivedNs, 16); }
+        };
+
+        //! Events kept per thread, older events are overwritten
+        static constexpr int EventsPerThread = 4096;
+
+        //! Tracing enabled?
+        static bool isEnabled();
+
+        //! Enable or disable tracing at runtime
+        static void setEnabled(bool enabled);
+
+        //! Monotonic time in ns used for all stamps
+        static qint64 nowNs();
+
+        //! Record a stage, ignored when disabled or not stamped
+        static void record(Stage stage, const Aviation::CCallsign &callsign, qint64 receivedNs, qint64 startNs, qint64 endNs);
+
+        //! Events of all threads, sorted by start time
+        //! \remark entries overwritten while reading are dropped
+        static QVector<Event> getEvents();
+
+        //! Discard all events recorded so far
+        static void clear();
+
+        //! Events as Chrome trace event JSON, positions are connected by flow events
+        //! \remark can be opened in chrome://tracing or Perfetto
+        static QString toChromeTraceJson(const QVector<Event> &events);
+
+        //! Write the current events as Chrome trace event JSON, default file in the log directory
+        static CStatusMessage writeChromeTrace(const QString &fileName = {});
+
+        //! Latencies per stage as percentiles and histogram
+        static QString getHistogram(const QVector<Event> &events, const QString &separator = "\n");
+
+        //! Latencies of the current events
+        static QString getHistogram() { return getHistogram(getEvents()); }
+
+        //! Name of the stage
+        static const QString &stageName(Stage stage);
+
+        //! Log categories
+        static const QStringList &getLogCategories();
+    };
+
+    /*!
+     * Records the time spent in a scope for a traced situation
+     */
+    class CLatencyTraceScope
+    {
+    public:
+        //! Constructor, starts timing if the situation is traced
+        CLatencyTraceScope(CLatencyTrace::Stage stage, const Aviation::CAircraftSituation &situation) : m_situation(situation), m_stage(stage)
+        {
+            if (situation.hasTraceReceivedNs() && CLatencyTrace::isEnabled()) { m_startNs = CLatencyTrace::nowNs(); }
+        }
+
+        //! Destructor, records the stage
+        ~CLatencyTraceScope()
+        {
+            if (m_startNs < 0) { return; }
+            CLatencyTrace::record(m_stage, m_situation.getCallsign(), m_situation.getTraceReceivedNs(), m_startNs, CLatencyTrace::nowNs());
+        }
+
+        //! Not copyable
+        CLatencyTraceScope(const CLatencyTraceScope &) = delete;
+
+        //! Not copyable
+        CLatencyTraceScope &operator=(const CLatencyTraceScope &) = delete;
+
+    private:
+        const Aviation::CAircraftSituation &m_situation;
+        CLatencyTrace::Stage m_stage;
+        qint64 m_startNs = -1;
+    };
+} // namespace
+
+#endif // guard
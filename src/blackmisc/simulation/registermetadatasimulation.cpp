@@ -4,6 +4,7 @@
 #include "blackmisc/simulation/registermetadatasimulation.h"
 
 // Simulation headers
+#include "blackmisc/simulation/aircraftinrangedelta.h"
 #include "blackmisc/simulation/aircraftmatchersetup.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/airspaceaircraftsnapshot.h"
@@ -42,6 +43,7 @@ namespace BlackMisc::Simulation
     {
         CAircraftCfgEntries::registerMetadata();
         CAircraftCfgEntriesList::registerMetadata();
+        CAircraftInRangeDelta::registerMetadata();
         CAircraftModel::registerMetadata();
         CAircraftModelList::registerMetadata();
         CAirspaceAircraftSnapshot::registerMetadata();
@@ -3,6 +3,7 @@
 
 #include "blackmisc/simulation/remoteaircraftprovider.h"
 #include "blackmisc/simulation/matchingutils.h"
+#include "blackmisc/simulation/latencytrace.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/json.h"
 #include "blackmisc/verify.h"
@@ -255,6 +256,7 @@ namespace BlackMisc::Simulation
 
     CAircraftSituation CRemoteAircraftProvider::storeAircraftSituation(const CAircraftSituation &situation, bool allowTestAltitudeOffset)
     {
+        const CLatencyTraceScope trace(CLatencyTrace::ProviderStore, situation);
         const CCallsign cs = situation.getCallsign();
         if (cs.isEmpty()) { return situation; }
 
@@ -37,7 +37,8 @@ namespace BlackMisc
             public CSequence<CSimulatedAircraft>,
             public Aviation::ICallsignObjectList<CSimulatedAircraft, CSimulatedAircraftList>,
             public Geo::IGeoObjectWithRelativePositionList<CSimulatedAircraft, CSimulatedAircraftList>,
-            public Mixin::MetaType<CSimulatedAircraftList>
+            public Mixin::MetaType<CSimulatedAircraftList>,
+            public Mixin::DBusByDataStream<CSimulatedAircraftList>
         {
         public:
             BLACKMISC_DECLARE_USING_MIXIN_METATYPE(CSimulatedAircraftList)
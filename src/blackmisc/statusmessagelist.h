@@ -29,7 +29,8 @@ namespace BlackMisc
         public CSequence<CStatusMessage>,
         public ITimestampObjectList<CStatusMessage, CStatusMessageList>,
         public IOrderableList<CStatusMessage, CStatusMessageList>,
-        public Mixin::MetaType<CStatusMessageList>
+        public Mixin::MetaType<CStatusMessageList>,
+        public Mixin::DBusByDataStream<CStatusMessageList>
     {
     public:
         BLACKMISC_DECLARE_USING_MIXIN_METATYPE(CStatusMessageList)
@@ -7,7 +7,6 @@
 #include "blackmisc/atomicfile.h"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/identifier.h"
-#include "blackmisc/lockfree.h"
 #include "blackmisc/logcategories.h"
 #include "blackmisc/logmessage.h"
 
@@ -23,8 +22,10 @@
 #include <QList>
 #include <QMetaMethod>
 #include <QMutexLocker>
+#include <QReadLocker>
 #include <QStandardPaths>
 #include <QThread>
+#include <QWriteLocker>
 #include <Qt>
 #include <atomic>
 #include <exception>
@@ -600,7 +601,7 @@ namespace BlackMisc
         const QString m_key;
         const QString m_name;
         const QString m_nameWithKey = m_name.isEmpty() ? m_key : QStringLiteral("%1 (%2)").arg(m_name, m_key);
-        LockFree<CVariant> m_value;
+        CVariant m_value; //!< written by the owner thread only, guarded by CValuePage::m_valuesLock
         std::atomic<qint64> m_timestamp { 0 };
         const int m_metaType = QMetaType::UnknownType;
         const Validator m_validator;
@@ -630,12 +631,14 @@ namespace BlackMisc
         Q_UNUSED(unused)
 
         auto &element = *(m_elements[key] = ElementPtr(new Element(key, name, metaType, validator, defaultValue)));
-        std::forward_as_tuple(element.m_value.uniqueWrite(), element.m_timestamp, element.m_saved) = m_cache->getValue(key);
+        CVariant value;
+        std::forward_as_tuple(value, element.m_timestamp, element.m_saved) = m_cache->getValue(key);
+        writeValue(element, value);
 
-        auto status = validate(element, element.m_value.read(), CStatusMessage::SeverityDebug);
+        auto status = validate(element, element.m_value, CStatusMessage::SeverityDebug);
         if (!status.isEmpty()) // intentionally kept !empty here, debug message supposed to write default value
         {
-            element.m_value.uniqueWrite() = defaultValue;
+            writeValue(element, defaultValue);
 
             if (status.getSeverity() == CStatusMessage::SeverityDebug)
             {
@@ -667,8 +670,8 @@ namespace BlackMisc
 
     bool CValuePage::isValid(const Element &element, int typeId) const
     {
-        auto reader = element.m_value.read();
-        return reader->isValid() && reader->userType() == typeId;
+        QReadLocker lock(&m_valuesLock);
+        return element.m_value.isValid() && element.m_value.userType() == typeId;
     }
 
     const CVariant &CValuePage::getValue(const Element &element) const
@@ -676,13 +679,17 @@ namespace BlackMisc
         Q_ASSERT_X(!element.m_key.isEmpty(), Q_FUNC_INFO, "Empty key suggests an attempt to use value before objectName available for %%OwnerName%%");
         Q_ASSERT(QThread::currentThread() == thread());
 
-        return element.m_value.read();
+        // only the owner thread writes, so it can read without locking
+        return element.m_value;
     }
 
     CVariant CValuePage::getValueCopy(const Element &element) const
     {
         Q_ASSERT_X(!element.m_key.isEmpty(), Q_FUNC_INFO, "Empty key suggests an attempt to use value before objectName available for %%OwnerName%%");
-        return element.m_value.read();
+        if (QThread::currentThread() == thread()) { return element.m_value; }
+
+        QReadLocker lock(&m_valuesLock);
+        return element.m_value;
     }
 
     CStatusMessage CValuePage::setValue(Element &element, CVariant value, qint64 timestamp, bool save)
@@ -691,9 +698,9 @@ namespace BlackMisc
         Q_ASSERT(QThread::currentThread() == thread());
 
         if (timestamp == 0) { timestamp = QDateTime::currentMSecsSinceEpoch(); }
-        if (!value.isValid()) { value = element.m_value.read(); }
+        if (!value.isValid()) { value = element.m_value; }
 
-        bool changed = element.m_timestamp != timestamp || element.m_value.read() != value;
+        bool changed = element.m_timestamp != timestamp || element.m_value != value;
         if (!changed && !save)
         {
             return CStatusMessage(this).info(u"Value '%1' not set, same timestamp and value") << element.m_nameWithKey;
@@ -718,7 +725,7 @@ namespace BlackMisc
                 element.m_saved = save;
 
                 element.m_timestamp = timestamp;
-                element.m_value.uniqueWrite() = value;
+                writeValue(element, value);
                 emit valuesWantToCache({ { { element.m_key, value } }, timestamp, save });
             }
             // All good info
@@ -766,7 +773,7 @@ namespace BlackMisc
                 auto error = validate(*element, it.value(), CStatusMessage::SeverityError);
                 if (error.isSuccess())
                 {
-                    element->m_value.uniqueWrite() = it.value();
+                    writeValue(*element, it.value());
                     element->m_timestamp = it.timestamp();
                     element->m_saved = values.isSaved();
                     if (element->m_notifySlot.first && (!element->m_notifySlot.second || !notifySlots.containsBy([&](auto slot) { return slot->second == element->m_notifySlot.second; })))
@@ -811,10 +818,10 @@ namespace BlackMisc
         if (m_batchMode <= 0 && !m_batchedValues.isEmpty())
         {
             qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
-            forEachIntersection(m_elements, m_batchedValues, [timestamp](const QString &, const ElementPtr &element, CVariantMap::const_iterator it) {
+            forEachIntersection(m_elements, m_batchedValues, [this, timestamp](const QString &, const ElementPtr &element, CVariantMap::const_iterator it) {
                 Q_ASSERT(isSafeToIncrement(element->m_pendingChanges));
                 element->m_pendingChanges++;
-                element->m_value.uniqueWrite() = it.value();
+                writeValue(*element, it.value());
                 element->m_timestamp = timestamp;
                 element->m_saved = false;
             });
@@ -822,6 +829,12 @@ namespace BlackMisc
         }
     }
 
+    void CValuePage::writeValue(Element &element, const CVariant &value)
+    {
+        QWriteLocker lock(&m_valuesLock);
+        element.m_value = value;
+    }
+
     CStatusMessage CValuePage::validate(const Element &element, const CVariant &value, CStatusMessage::StatusSeverity invalidSeverity) const
     {
         QString reason;
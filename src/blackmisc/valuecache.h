@@ -391,7 +391,12 @@ namespace BlackMisc
 
         //! Get a copy of the current value.
         //! \threadsafe
-        T get() const { return isValid() ? getVariantCopy().template value<T>() : T {}; }
+        T get() const
+        {
+            // one read, so the value can not change between checking and copying it
+            const QVariant copy = getVariantCopy();
+            return copy.userType() == qMetaTypeId<T>() ? copy.template value<T>() : T {};
+        }
 
         //! Write a new value. Must be called from the thread in which the owner lives.
         CStatusMessage set(const T &value, qint64 timestamp = 0) { return m_page->setValue(*m_element, CVariant::from(value), timestamp); }
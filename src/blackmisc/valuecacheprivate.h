@@ -10,6 +10,7 @@
 #include "blackmisc/statusmessage.h"
 #include <QObject>
 #include <QMutex>
+#include <QReadWriteLock>
 #include <QMap>
 
 namespace BlackMisc
@@ -140,7 +141,11 @@ namespace BlackMisc
             int m_batchMode = 0;
             CVariantMap m_batchedValues;
 
+            //! Only the owner thread writes values, other threads share the lock for reading, so readers never wait for each other.
+            mutable QReadWriteLock m_valuesLock;
+
             CValuePage(QObject *parent, CValueCache *cache);
+            void writeValue(Element &element, const CVariant &value);
             CStatusMessage validate(const Element &element, const CVariant &value, CStatusMessage::StatusSeverity invalidSeverity) const;
         };
 
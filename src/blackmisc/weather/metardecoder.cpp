@@ -24,6 +24,7 @@
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QStringList>
+#include <QtConcurrentMap>
 #include <QtGlobal>
 
 using namespace BlackMisc::PhysicalQuantities;
@@ -55,11 +56,56 @@ namespace BlackMisc::Weather
         virtual bool isMandatory() const = 0;
 
     public:
-        //! Parse METAR string
-        bool parse(QString &metarString, CMetar &metar)
+        //! Compile the expression used by parse, anchored at the cursor instead of the string start
+        void compile()
+        {
+            QString pattern = getRegExp().pattern();
+            if (pattern.startsWith('^')) { pattern.remove(0, 1); }
+            m_cursorRegExp.setPattern(pattern);
+            m_cursorRegExp.optimize();
+            Q_ASSERT(m_cursorRegExp.isValid());
+        }
+
+        //! Parse METAR string at the cursor, the cursor is moved behind the matched part
+        //! \threadsafe after compile
+        bool parse(const QString &metarString, int &cursor, CMetar &metar) const
         {
             bool isValid = false;
-            const QRegularExpression re(getRegExp());
+            do
+            {
+                const QRegularExpressionMatch match = m_cursorRegExp.match(metarString, cursor, QRegularExpression::NormalMatch, QRegularExpression::AnchoredMatchOption);
+                if (match.hasMatch())
+                {
+                    // If invalid data, we return straight away
+                    if (!validateAndSet(match, metar)) { return false; }
+
+                    // Nothing consumed, a repeatable part would match forever
+                    isValid = true;
+                    if (match.capturedEnd(0) <= cursor) { break; }
+                    cursor = match.capturedEnd(0);
+                }
+                else
+                {
+                    // No (more) match found.
+                    if (!isMandatory()) { isValid = true; }
+                    break;
+                }
+            }
+            while (isRepeatable());
+
+            if (!isValid)
+            {
+                CLogMessage(static_cast<CMetarDecoder *>(nullptr)).debug() << "Failed to match" << getDecoderType() << "in remaining METAR:" << metarString.mid(cursor);
+            }
+            return isValid;
+        }
+
+        //! Parse METAR string by removing the matched part from the string
+        //! \remark former algorithm, only used by CMetarDecoder::decodeByRewriting
+        bool parseByRewriting(QString &metarString, CMetar &metar) const
+        {
+            bool isValid = false;
+            const QRegularExpression &re = getRegExp();
             Q_ASSERT(re.isValid());
             // Loop stop condition:
             // - Invalid data
@@ -87,13 +133,11 @@ namespace BlackMisc::Weather
                 }
             }
             while (isRepeatable());
-
-            if (!isValid)
-            {
-                CLogMessage(static_cast<CMetarDecoder *>(nullptr)).debug() << "Failed to match" << getDecoderType() << "in remaining METAR:" << metarString;
-            }
             return isValid;
         }
+
+    private:
+        QRegularExpression m_cursorRegExp; //!< getRegExp without the leading ^
     };
 
     //! METAR report type
@@ -957,12 +1001,14 @@ namespace BlackMisc::Weather
 
     CMetar CMetarDecoder::decode(const QString &metarString) const
     {
+        // one pass over the string, each part continues where the previous one stopped
         CMetar metar;
-        QString metarStringCopy = metarString.simplified();
+        const QString simplified = metarString.simplified();
+        int cursor = 0;
 
         for (const auto &decoder : m_decoders)
         {
-            if (!decoder->parse(metarStringCopy, metar))
+            if (!decoder->parse(simplified, cursor, metar))
             {
                 const QString type = decoder->getDecoderType();
                 CLogMessage(this).debug() << "Invalid METAR:" << metarString << type;
@@ -974,6 +1020,45 @@ namespace BlackMisc::Weather
         return metar;
     }
 
+    CMetarList CMetarDecoder::decode(const QStringList &metarStrings, int *o_invalid) const
+    {
+        // the decoder parts are stateless, lines are decoded independently
+        QList<CMetar> decoded;
+        if (metarStrings.size() < ParallelDecodeThreshold)
+        {
+            decoded.reserve(metarStrings.size());
+            for (const QString &metarString : metarStrings) { decoded.push_back(this->decode(metarString)); }
+        }
+        else
+        {
+            decoded = QtConcurrent::blockingMapped<QList<CMetar>>(metarStrings, [this](const QString &metarString) { return this->decode(metarString); });
+        }
+
+        CMetarList metars;
+        int invalid = 0;
+        for (const CMetar &metar : decoded)
+        {
+            if (metar == CMetar()) { invalid++; }
+            else { metars.push_back(metar); }
+        }
+        if (o_invalid) { *o_invalid = invalid; }
+        return metars;
+    }
+
+    CMetar CMetarDecoder::decodeByRewriting(const QString &metarString) const
+    {
+        CMetar metar;
+        QString metarStringCopy = metarString.simplified();
+
+        for (const auto &decoder : m_decoders)
+        {
+            if (!decoder->parseByRewriting(metarStringCopy, metar)) { return CMetar(); }
+        }
+
+        metar.setMessage(metarString);
+        return metar;
+    }
+
     void CMetarDecoder::allocateDecoders()
     {
         m_decoders.clear();
@@ -992,6 +1077,7 @@ namespace BlackMisc::Weather
         m_decoders.push_back(std::make_unique<CMetarDecoderPressure>());
         m_decoders.push_back(std::make_unique<CMetarDecoderRecentWeather>());
         m_decoders.push_back(std::make_unique<CMetarDecoderWindShear>());
+        for (const auto &decoder : m_decoders) { decoder->compile(); }
     }
 
 } // namespace
@@ -8,12 +8,19 @@
 
 #include "blackmisc/blackmiscexport.h"
 #include "blackmisc/weather/metar.h"
+#include "blackmisc/weather/metarlist.h"
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <memory>
 #include <vector>
 
+namespace BlackMiscTest
+{
+    class CTestWeather;
+}
+
 namespace BlackMisc::Weather
 {
     class IMetarDecoderPart;
@@ -22,6 +29,7 @@ namespace BlackMisc::Weather
     class BLACKMISC_EXPORT CMetarDecoder : public QObject
     {
         Q_OBJECT
+        friend class BlackMiscTest::CTestWeather;
 
     public:
         //! Default constructor
@@ -31,9 +39,21 @@ namespace BlackMisc::Weather
         virtual ~CMetarDecoder() override;
 
         //! Decode metar
+        //! \threadsafe
         CMetar decode(const QString &metarString) const;
 
+        //! Decode many METARs, like a bulk download, in parallel if there are enough
+        //! \param o_invalid optionally returns the number of METARs which could not be decoded
+        CMetarList decode(const QStringList &metarStrings, int *o_invalid = nullptr) const;
+
+        //! Below this number of METARs the bulk decode is done in the calling thread
+        static constexpr int ParallelDecodeThreshold = 256;
+
     private:
+        //! Decode by removing each decoded part from the string, the algorithm used before the single pass decode
+        //! \remark only kept as reference for BlackMiscTest::CTestWeather
+        CMetar decodeByRewriting(const QString &metarString) const;
+
         void allocateDecoders();
         std::vector<std::unique_ptr<IMetarDecoderPart>> m_decoders;
     };
@@ -547,27 +547,57 @@ namespace BlackSimPlugin::Emulated
     {
         const qint64 now = QDateTime::currentMSecsSinceEpoch();
         const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(now);
-        int aircraftNumber = 0;
 
+        QVector<InterpolationRequest> requests;
+        requests.reserve(m_renderedAircraft.size());
         for (const CSimulatedAircraft &aircraft : m_renderedAircraft)
         {
             const CCallsign callsign = aircraft.getCallsign();
-            if (!m_interpolators.contains(callsign)) { continue; }
-            const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
-            CInterpolatorMulti *im = m_interpolators[callsign];
-            Q_ASSERT_X(im, Q_FUNC_INFO, "interpolator missing");
-            const CInterpolationResult result = im->getInterpolation(now, setup, aircraftNumber++);
+            const auto it = m_interpolators.constFind(callsign);
+            if (it == m_interpolators.cend()) { continue; }
+            Q_ASSERT_X(it->hasInterpolator(), Q_FUNC_INFO, "interpolator missing");
+            if (!this->isUpdateDueByDistance(callsign, updateAllAircraft)) { continue; }
+            requests.push_back({ callsign, it->interpolator() });
+        }
+
+        QVector<bool> deferred;
+        const QVector<CInterpolationResult> results = this->interpolateRemoteAircraft(requests, now, updateAllAircraft, nullptr, &deferred);
+        for (int i = 0; i < results.size(); ++i)
+        {
+            if (deferred[i]) { continue; }
+            const CInterpolationResult &result = results[i];
             const CAircraftSituation s = result;
             const CAircraftParts p = result;
             m_countInterpolatedParts++;
             m_countInterpolatedSituations++;
-            Q_UNUSED(s)
-            Q_UNUSED(p)
+
+            // same change detection as a real driver, nothing is sent though
+            if (this->rememberLastSentIfChanged(s, updateAllAircraft)) { m_countSentSituations++; }
+            if (this->rememberLastSentIfChanged(p, s.getCallsign(), updateAllAircraft)) { m_countSentParts++; }
         }
 
         this->finishUpdateRemoteAircraftAndSetStatistics(now);
     }
 
+    QString CSimulatorEmulated::getStatisticsSimulatorSpecific() const
+    {
+        return QStringLiteral("Sent situations: %1/%2 parts: %3/%4 | %5")
+            .arg(m_countSentSituations)
+            .arg(m_countInterpolatedSituations)
+            .arg(m_countSentParts)
+            .arg(m_countInterpolatedParts)
+            .arg(m_lastSentFingerprints.toQString());
+    }
+
+    void CSimulatorEmulated::resetAircraftStatistics()
+    {
+        m_countInterpolatedSituations = 0;
+        m_countInterpolatedParts = 0;
+        m_countSentSituations = 0;
+        m_countSentParts = 0;
+        ISimulator::resetAircraftStatistics();
+    }
+
     bool CSimulatorEmulated::requestWeather()
     {
         if (!m_isWeatherActivated) { return false; }
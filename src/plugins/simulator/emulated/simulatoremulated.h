@@ -68,6 +68,8 @@ namespace BlackSimPlugin::Emulated
         virtual bool testSendSituationAndParts(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::Aviation::CAircraftSituation &situation, const BlackMisc::Aviation::CAircraftParts &parts) override;
         virtual bool requestElevation(const BlackMisc::Geo::ICoordinateGeodetic &reference, const BlackMisc::Aviation::CCallsign &callsign) override;
         virtual void injectWeatherGrid(const BlackMisc::Weather::CWeatherGrid &weatherGrid) override;
+        virtual QString getStatisticsSimulatorSpecific() const override;
+        virtual void resetAircraftStatistics() override;
 
         // ----- functions just logged -------
         virtual bool logicallyAddRemoteAircraft(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft) override;
@@ -170,6 +172,8 @@ namespace BlackSimPlugin::Emulated
         bool m_timeSyncronized = false;
         int m_countInterpolatedSituations = 0;
         int m_countInterpolatedParts = 0;
+        int m_countSentSituations = 0; //!< situations differing from the last sent ones
+        int m_countSentParts = 0; //!< parts differing from the last sent ones
         QTimer m_interpolatorFetchTimer; //!< fetch data from interpolator
         BlackMisc::PhysicalQuantities::CTime m_offsetTime;
         BlackMisc::Simulation::CSimulatedAircraft m_myAircraft; //!< represents own aircraft of simulator
@@ -643,9 +643,10 @@ namespace BlackSimPlugin::Flightgear
         PlanesSurfaces planesSurfaces;
         PlanesTransponders planesTransponders;
 
-        int aircraftNumber = 0;
         const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
         const CCallsignSet callsignsInRange = this->getAircraftInRangeCallsigns();
+        QVector<const CFlightgearMPAircraft *> aircraftToUpdate;
+        QVector<InterpolationRequest> requests;
         for (const CFlightgearMPAircraft &flightgearAircraft : std::as_const(m_flightgearAircraftObjects))
         {
             const CCallsign callsign(flightgearAircraft.getCallsign());
@@ -666,19 +667,29 @@ namespace BlackSimPlugin::Flightgear
             planesTransponders.idents.push_back(transponderMode == CTransponder::StateIdent);
             planesTransponders.modeCs.push_back(transponderMode == CTransponder::ModeC);
 
-            // setup
-            const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+            // far away aircraft are not updated every frame
+            if (!this->isUpdateDueByDistance(callsign, updateAllAircraft)) { continue; }
 
-            // interpolated situation/parts
-            const CInterpolationResult result = flightgearAircraft.getInterpolation(currentTimestamp, setup, aircraftNumber++);
+            aircraftToUpdate.push_back(&flightgearAircraft);
+            requests.push_back({ callsign, flightgearAircraft.getInterpolator() });
+        }
+
+        // interpolated situations/parts of all aircraft, aircraft deferred by the frame budget are updated first in the next frame
+        QVector<bool> deferred;
+        const QVector<CInterpolationResult> results = this->interpolateRemoteAircraft(requests, currentTimestamp, updateAllAircraft, nullptr, &deferred);
+        for (int i = 0; i < results.size(); ++i)
+        {
+            if (deferred[i]) { continue; }
+            const CFlightgearMPAircraft &flightgearAircraft = *aircraftToUpdate[i];
+            const CCallsign callsign(flightgearAircraft.getCallsign());
+            const CInterpolationResult &result = results[i];
             if (result.getInterpolationStatus().hasValidSituation())
             {
                 const CAircraftSituation interpolatedSituation(result);
 
                 // update situation
-                if (updateAllAircraft || !this->isEqualLastSent(interpolatedSituation))
+                if (this->rememberLastSentIfChanged(interpolatedSituation, updateAllAircraft))
                 {
-                    this->rememberLastSent(interpolatedSituation);
                     planesPositions.push_back(interpolatedSituation);
                 }
             }
@@ -690,9 +701,8 @@ namespace BlackSimPlugin::Flightgear
             const CAircraftParts parts(result);
             if (result.getPartsStatus().isSupportingParts() || parts.getPartsDetails() == CAircraftParts::GuessedParts)
             {
-                if (updateAllAircraft || !this->isEqualLastSent(parts, callsign))
+                if (this->rememberLastSentIfChanged(parts, callsign, updateAllAircraft))
                 {
-                    this->rememberLastSent(parts, callsign);
                     planesSurfaces.push_back(flightgearAircraft.getCallsign(), parts);
                 }
             }
@@ -730,7 +740,7 @@ namespace BlackSimPlugin::Flightgear
         // - we could use the elevation cache and CG cache to decide if we need to request
         // - if an aircraft is on ground but not moving, we do not need to request elevation if we already have it (it will not change
         CCallsignSet callsigns = m_flightgearAircraftObjects.getAllCallsigns();
-        const CCallsignSet remove = this->getLastSentCanLikelySkipNearGroundInterpolation().getCallsigns();
+        const CCallsignSet remove = this->getLastSentCanLikelySkipNearGroundInterpolation();
         callsigns.remove(remove);
         if (!callsigns.isEmpty()) { this->requestRemoteAircraftDataFromFlightgear(callsigns); }
     }
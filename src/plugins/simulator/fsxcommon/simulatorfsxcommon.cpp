@@ -859,8 +859,7 @@ namespace BlackSimPlugin::FsxCommon
 
         // Near ground we use faster updates
         const CCallsign cs(simObject.getCallsign());
-        CAircraftSituation lastSituation = m_lastSentSituations[cs];
-        const bool moving = lastSituation.isMoving();
+        const bool moving = m_lastSentFingerprints.isLastSentMoving(cs);
         const bool onGround = remoteAircraftData.isOnGround();
 
         // CElevationPlane: deg, deg, feet
@@ -876,6 +875,7 @@ namespace BlackSimPlugin::FsxCommon
         if (log)
         {
             // update lat/lng/alt with real data from sim
+            CAircraftSituation lastSituation = this->getAircraftInRangeForCallsign(cs).getSituation();
             const CAltitude alt(remoteAircraftData.altitudeFt, CAltitude::MeanSeaLevel, CAltitude::TrueAltitude, CLengthUnit::ft());
             lastSituation.setPosition(elevation);
             lastSituation.setAltitude(alt);
@@ -1946,9 +1946,10 @@ namespace BlackSimPlugin::FsxCommon
         // interpolation for all remote aircraft
         const QList<CSimConnectObject> simObjects(m_simConnectObjects.values());
 
-        int simObjectNumber = 0;
         const bool traceSendId = this->isTracingSendId();
         const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
+        QVector<const CSimConnectObject *> simObjectsToUpdate;
+        QVector<InterpolationRequest> requests;
         for (const CSimConnectObject &simObject : simObjects)
         {
             // happening if aircraft is not yet added to simulator or to be deleted
@@ -1961,21 +1962,35 @@ namespace BlackSimPlugin::FsxCommon
             BLACK_VERIFY_X(hasCs, Q_FUNC_INFO, "missing callsign");
             BLACK_AUDIT_X(hasValidIds, Q_FUNC_INFO, "Missing ids");
             if (!hasCs || !hasValidIds) { continue; } // not supposed to happen
+            if (!this->isUpdateDueByDistance(callsign, updateAllAircraft)) { continue; } // far away, not every frame
+
+            simObjectsToUpdate.push_back(&simObject);
+            requests.push_back({ callsign, simObject.getInterpolator() });
+        }
+
+        // Interpolated situations of all aircraft
+        // the index is passed as aircraft number to equally distributed steps like guessing parts
+        // aircraft deferred by the frame budget are updated first in the next frame
+        QVector<CInterpolationAndRenderingSetupPerCallsign> setups;
+        QVector<bool> deferred;
+        const QVector<CInterpolationResult> results = this->interpolateRemoteAircraft(requests, currentTimestamp, updateAllAircraft, &setups, &deferred);
+        for (int simObjectNumber = 0; simObjectNumber < results.size(); ++simObjectNumber)
+        {
+            if (deferred[simObjectNumber]) { continue; }
+            const CSimConnectObject &simObject = *simObjectsToUpdate[simObjectNumber];
             const DWORD objectId = simObject.getObjectId();
 
             // setup
-            const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+            const CInterpolationAndRenderingSetupPerCallsign &setup = setups[simObjectNumber];
             const bool sendGround = setup.isSendingGndFlagToSimulator();
 
-            // Interpolated situation
-            // simObjectNumber is passed to equally distributed steps like guessing parts
             const bool slowUpdate = (((m_statsUpdateAircraftRuns + simObjectNumber) % 40) == 0);
-            const CInterpolationResult result = simObject.getInterpolation(currentTimestamp, setup, simObjectNumber++);
+            const CInterpolationResult &result = results[simObjectNumber];
             const bool forceUpdate = slowUpdate || updateAllAircraft || setup.isForcingFullInterpolation();
             if (result.getInterpolationStatus().hasValidSituation())
             {
                 // update situation
-                if (forceUpdate || !this->isEqualLastSent(result.getInterpolatedSituation()))
+                if (this->rememberLastSentIfChanged(result.getInterpolatedSituation(), forceUpdate))
                 {
                     // adjust altitude to compensate for FS2020 temperature effect
                     CAircraftSituation situation = result;
@@ -1989,9 +2004,9 @@ namespace BlackSimPlugin::FsxCommon
                             m_hSimConnect, CSimConnectDefinitions::DataRemoteAircraftSetPosition,
                             static_cast<SIMCONNECT_OBJECT_ID>(objectId), 0, 0, sizeof(SIMCONNECT_DATA_INITPOSITION), &position),
                         traceSendId, simObject, "Failed to set position", Q_FUNC_INFO, "SimConnect_SetDataOnSimObject");
-                    if (isOk(hr))
+                    if (!isOk(hr))
                     {
-                        this->rememberLastSent(result); // remember situation
+                        m_lastSentFingerprints.forgetLastSentSituation(simObject.getCallsign()); // send again next time
                     }
                 }
             }
@@ -2021,10 +2036,11 @@ namespace BlackSimPlugin::FsxCommon
         if (parts.getPartsDetails() != CAircraftParts::GuessedParts && !result.getPartsStatus().isSupportingParts()) { return false; }
 
         const CCallsign cs = simObject.getCallsign();
-        if (!forcedUpdate && (result.getPartsStatus().isReusedParts() || this->isEqualLastSent(parts, cs))) { return true; }
+        if (!forcedUpdate && result.getPartsStatus().isReusedParts()) { return true; }
+        if (!this->rememberLastSentIfChanged(parts, cs, forcedUpdate)) { return true; }
 
         const bool ok = this->sendRemoteAircraftPartsToSimulator(simObject, parts);
-        if (ok) { this->rememberLastSent(parts, cs); }
+        if (!ok) { m_lastSentFingerprints.forgetLastSentParts(cs); } // send again next time
         return ok;
     }
 
@@ -192,7 +192,7 @@ namespace BlackSimPlugin::P3D
         **/
 
         // Observer is P3D only, not FSX
-        const CAircraftSituation situation = m_lastSentSituations[callsign];
+        const CAircraftSituation situation = this->getAircraftInRangeForCallsign(callsign).getSituation();
         if (situation.isNull()) { return false; }
         SIMCONNECT_DATA_OBSERVER obs;
         SIMCONNECT_DATA_PBH pbh;
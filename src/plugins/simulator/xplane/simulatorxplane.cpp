@@ -1048,9 +1048,10 @@ namespace BlackSimPlugin::XPlane
         PlanesSurfaces planesSurfaces;
         PlanesTransponders planesTransponders;
 
-        int aircraftNumber = 0;
         const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
         const CCallsignSet callsignsInRange = this->getAircraftInRangeCallsigns();
+        QVector<const CXPlaneMPAircraft *> aircraftToUpdate;
+        QVector<InterpolationRequest> requests;
         for (const CXPlaneMPAircraft &xplaneAircraft : std::as_const(m_xplaneAircraftObjects))
         {
             const CCallsign callsign(xplaneAircraft.getCallsign());
@@ -1071,11 +1072,22 @@ namespace BlackSimPlugin::XPlane
             planesTransponders.idents.push_back(transponderMode == CTransponder::StateIdent);
             planesTransponders.modeCs.push_back(transponderMode == CTransponder::ModeC);
 
-            // setup
-            const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+            // far away aircraft are not updated every frame
+            if (!this->isUpdateDueByDistance(callsign, updateAllAircraft)) { continue; }
 
-            // interpolated situation/parts
-            const CInterpolationResult result = xplaneAircraft.getInterpolation(currentTimestamp, setup, aircraftNumber++);
+            aircraftToUpdate.push_back(&xplaneAircraft);
+            requests.push_back({ callsign, xplaneAircraft.getInterpolator() });
+        }
+
+        // interpolated situations/parts of all aircraft, aircraft deferred by the frame budget are updated first in the next frame
+        QVector<bool> deferred;
+        const QVector<CInterpolationResult> results = this->interpolateRemoteAircraft(requests, currentTimestamp, updateAllAircraft, nullptr, &deferred);
+        for (int i = 0; i < results.size(); ++i)
+        {
+            if (deferred[i]) { continue; }
+            const CXPlaneMPAircraft &xplaneAircraft = *aircraftToUpdate[i];
+            const CCallsign callsign(xplaneAircraft.getCallsign());
+            const CInterpolationResult &result = results[i];
             if (result.getInterpolationStatus().hasValidSituation())
             {
                 CAircraftSituation interpolatedSituation(result);
@@ -1087,9 +1099,8 @@ namespace BlackSimPlugin::XPlane
                 interpolatedSituation.setAltitude({ alt, interpolatedSituation.getAltitude().getReferenceDatum() });
 
                 // update situation
-                if (updateAllAircraft || !this->isEqualLastSent(interpolatedSituation))
+                if (this->rememberLastSentIfChanged(interpolatedSituation, updateAllAircraft))
                 {
-                    this->rememberLastSent(interpolatedSituation);
                     planesPositions.push_back(interpolatedSituation);
                 }
             }
@@ -1101,9 +1112,8 @@ namespace BlackSimPlugin::XPlane
             const CAircraftParts parts(result);
             if (result.getPartsStatus().isSupportingParts() || parts.getPartsDetails() == CAircraftParts::GuessedParts)
             {
-                if (updateAllAircraft || !this->isEqualLastSent(parts, callsign))
+                if (this->rememberLastSentIfChanged(parts, callsign, updateAllAircraft))
                 {
-                    this->rememberLastSent(parts, callsign);
                     planesSurfaces.push_back(xplaneAircraft.getCallsign(), parts);
                 }
             }
@@ -1141,7 +1151,7 @@ namespace BlackSimPlugin::XPlane
         // - we could use the elevation cache and CG cache to decide if we need to request
         // - if an aircraft is on ground but not moving, we do not need to request elevation if we already have it (it will not change
         CCallsignSet callsigns = m_xplaneAircraftObjects.getAllCallsigns();
-        const CCallsignSet remove = this->getLastSentCanLikelySkipNearGroundInterpolation().getCallsigns();
+        const CCallsignSet remove = this->getLastSentCanLikelySkipNearGroundInterpolation();
         callsigns.remove(remove);
         if (!callsigns.isEmpty()) { this->requestRemoteAircraftDataFromXPlane(callsigns); }
     }
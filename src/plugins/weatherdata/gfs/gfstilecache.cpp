@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#include "gfstilecache.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/swiftdirectories.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStringBuilder>
+#include <algorithm>
+
+using namespace BlackMisc;
+
+namespace BlackWxPlugin::Gfs
+{
+    //! \cond PRIVATE
+    //! Tile file: magic, version and the qCompress'ed points
+    constexpr char GfsTileMagic[] = "SWIFTGFS";
+    constexpr quint32 GfsTileVersion = 1;
+    //! \endcond
+
+    QDataStream &operator<<(QDataStream &stream, const GfsGridPoint &point)
+    {
+        stream << point.latitude << point.longitude << point.pressureAtMsl << point.surfaceRain << point.surfaceSnow << point.surfacePrecipitationRate;
+        stream << static_cast<quint8>(point.cloudLayers.size());
+        for (const GfsCloudLayer &cloud : point.cloudLayers)
+        {
+            stream << cloud.bottomLevelPressure << cloud.topLevelPressure << cloud.totalCoverage << cloud.topLevelTemperature;
+        }
+        stream << static_cast<quint8>(point.isobaricLayers.size());
+        for (const GfsIsobaricLayer &isobaric : point.isobaricLayers)
+        {
+            stream << isobaric.level << isobaric.temperature << isobaric.relativeHumidity << isobaric.windU << isobaric.windV;
+        }
+        return stream;
+    }
+
+    QDataStream &operator>>(QDataStream &stream, GfsGridPoint &point)
+    {
+        quint8 clouds = 0;
+        quint8 isobarics = 0;
+        stream >> point.latitude >> point.longitude >> point.pressureAtMsl >> point.surfaceRain >> point.surfaceSnow >> point.surfacePrecipitationRate;
+        stream >> clouds;
+        point.cloudLayers.resize(clouds);
+        for (GfsCloudLayer &cloud : point.cloudLayers)
+        {
+            stream >> cloud.bottomLevelPressure >> cloud.topLevelPressure >> cloud.totalCoverage >> cloud.topLevelTemperature;
+        }
+        stream >> isobarics;
+        point.isobaricLayers.resize(isobarics);
+        for (GfsIsobaricLayer &isobaric : point.isobaricLayers)
+        {
+            stream >> isobaric.level >> isobaric.temperature >> isobaric.relativeHumidity >> isobaric.windU >> isobaric.windV;
+        }
+        return stream;
+    }
+
+    CGfsTileCache::CGfsTileCache(const QString &directory) : m_directory(directory)
+    {}
+
+    QString CGfsTileCache::defaultDirectory()
+    {
+        static const QString dir = CFileUtils::appendFilePaths(CSwiftDirectories::normalizedApplicationDataDirectory(), "weather/gfs");
+        return dir;
+    }
+
+    QString CGfsTileCache::getFileName(const QString &runKey, const GfsTile &tile) const
+    {
+        return CFileUtils::appendFilePaths(m_directory, runKey % QStringLiteral("_%1_%2.gfs").arg(tile.south).arg(tile.west));
+    }
+
+    bool CGfsTileCache::contains(const QString &runKey, const GfsTile &tile) const
+    {
+        return QFile::exists(this->getFileName(runKey, tile));
+    }
+
+    bool CGfsTileCache::writeTile(const QString &runKey, const GfsTile &tile, const QVector<GfsGridPoint> &points) const
+    {
+        QByteArray data;
+        {
+            QDataStream stream(&data, QIODevice::WriteOnly);
+            stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+            stream << static_cast<qint32>(points.size());
+            for (const GfsGridPoint &point : points) { stream << point; }
+        }
+
+        QDir().mkpath(m_directory);
+        QSaveFile file(this->getFileName(runKey, tile));
+        if (!file.open(QIODevice::WriteOnly)) { return false; }
+        QDataStream stream(&file);
+        stream.writeRawData(GfsTileMagic, sizeof(GfsTileMagic) - 1);
+        stream << GfsTileVersion << qCompress(data);
+        return stream.status() == QDataStream::Ok && file.commit();
+    }
+
+    bool CGfsTileCache::readTile(const QString &runKey, const GfsTile &tile, QVector<GfsGridPoint> &points) const
+    {
+        QFile file(this->getFileName(runKey, tile));
+        if (!file.open(QIODevice::ReadOnly)) { return false; }
+        QDataStream fileStream(&file);
+        char magic[sizeof(GfsTileMagic) - 1];
+        quint32 version = 0;
+        QByteArray compressed;
+        if (fileStream.readRawData(magic, sizeof(magic)) != static_cast<int>(sizeof(magic))) { return false; }
+        if (!std::equal(std::begin(magic), std::end(magic), GfsTileMagic)) { return false; }
+        fileStream >> version >> compressed;
+        if (fileStream.status() != QDataStream::Ok || version != GfsTileVersion) { return false; }
+
+        const QByteArray data = qUncompress(compressed);
+        QDataStream stream(data);
+        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        qint32 size = 0;
+        stream >> size;
+        if (size < 0 || size > data.size()) { return false; }
+        points.resize(size);
+        for (GfsGridPoint &point : points) { stream >> point; }
+        return stream.status() == QDataStream::Ok;
+    }
+
+    int CGfsTileCache::removeExpiredTiles(const QString &runKey) const
+    {
+        const QString runPrefix = runKey + QLatin1Char('_');
+        const QDir dir(m_directory);
+        const QStringList files = dir.entryList({ "*.gfs" }, QDir::Files);
+        int removed = 0;
+        for (const QString &file : files)
+        {
+            if (file.startsWith(runPrefix)) { continue; }
+            if (QFile::remove(dir.absoluteFilePath(file))) { removed++; }
+        }
+        return removed;
+    }
+} // ns
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKWXPLUGIN_GFS_GFSTILECACHE_H
+#define BLACKWXPLUGIN_GFS_GFSTILECACHE_H
+
+#include "weatherdatagfsexport.h"
+#include <QDataStream>
+#include <QString>
+#include <QVector>
+
+namespace BlackWxPlugin::Gfs
+{
+    //! Decoded values of one isobaric level
+    struct GfsIsobaricLayer
+    {
+        float level = 0.0f;
+        float temperature = 0.0f;
+        float relativeHumidity = 0.0f;
+        float windU = 0.0f;
+        float windV = 0.0f;
+    };
+
+    //! Decoded values of one cloud layer
+    struct GfsCloudLayer
+    {
+        float bottomLevelPressure = 0.0f;
+        float topLevelPressure = 0.0f;
+        float totalCoverage = 0.0f;
+        float topLevelTemperature = 0.0f;
+    };
+
+    //! Decoded values of one GFS cell, as stored in the tile cache
+    struct GfsGridPoint
+    {
+        float latitude = 0.0f;
+        float longitude = 0.0f; //!< 0..360
+        float pressureAtMsl = 0.0f;
+        float surfaceRain = 0.0f;
+        float surfaceSnow = 0.0f;
+        float surfacePrecipitationRate = 0.0f;
+        QVector<GfsCloudLayer> cloudLayers; //!< valid layers only
+        QVector<GfsIsobaricLayer> isobaricLayers; //!< ascending pressure
+    };
+
+    //! @{
+    //! Stream a grid point, single precision
+    WEATHERDATAGFS_EXPORT QDataStream &operator<<(QDataStream &stream, const GfsGridPoint &point);
+    WEATHERDATAGFS_EXPORT QDataStream &operator>>(QDataStream &stream, GfsGridPoint &point);
+    //! @}
+
+    //! A cached tile, corner in degrees, west in 0..360
+    struct GfsTile
+    {
+        int south = 0; //!< southern latitude
+        int west = 0; //!< western longitude
+
+        //! Equal tiles
+        bool operator==(const GfsTile &other) const { return south == other.south && west == other.west; }
+    };
+
+    /*!
+     * Decoded GFS cells on disk, one file per model run, forecast hour and tile.
+     * A tile expires with its forecast hour.
+     */
+    class WEATHERDATAGFS_EXPORT CGfsTileCache
+    {
+    public:
+        //! Edge length of a tile in degrees
+        static constexpr int TileSizeDeg = 10;
+
+        //! Constructor
+        explicit CGfsTileCache(const QString &directory = defaultDirectory());
+
+        //! Default directory in the application data directory
+        static QString defaultDirectory();
+
+        //! Directory of the tiles
+        const QString &getDirectory() const { return m_directory; }
+
+        //! File of a tile
+        QString getFileName(const QString &runKey, const GfsTile &tile) const;
+
+        //! Tile of the run cached?
+        bool contains(const QString &runKey, const GfsTile &tile) const;
+
+        //! Write the points of a tile
+        bool writeTile(const QString &runKey, const GfsTile &tile, const QVector<GfsGridPoint> &points) const;
+
+        //! Read the points of a tile
+        bool readTile(const QString &runKey, const GfsTile &tile, QVector<GfsGridPoint> &points) const;
+
+        //! Remove the tiles of other runs and forecast hours
+        //! \return number of removed tiles
+        int removeExpiredTiles(const QString &runKey) const;
+
+    private:
+        QString m_directory;
+    };
+} // ns
+
+#endif // guard
@@ -13,8 +13,17 @@
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QEventLoop>
+#include <QFile>
+#include <QSet>
 #include <QStringBuilder>
+#include <QtConcurrentMap>
+#include <QtMath>
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
 
 using namespace BlackConfig;
 using namespace BlackMisc;
@@ -75,42 +84,66 @@ namespace BlackWxPlugin::Gfs
         QString unit;
     };
 
-    struct GfsIsobaricLayer
+    //! One decoded GRIB field, values only at the selected cells of the weather grid
+    struct GfsField
     {
-        float temperature = 0.0;
-        float relativeHumidity = 0.0;
-        float windU = 0.0;
-        float windV = 0.0;
+        Grib2ParameterCode code = UNKNOWN;
+        g2int productDefinitionTemplate = 0; //!< 0: template 4.0, 8: template 4.8
+        g2int surfaceType = 0; //!< type of first fixed surface
+        float level = 0.0; //!< isobaric level or Grib2CloudLevel
+        QVector<float> values; //!< same index as the selected cells
     };
 
-    inline bool operator==(const GfsIsobaricLayer &lhs, const GfsIsobaricLayer &rhs)
+    //! Fields of one isobaric level, index in the field list or -1
+    struct GfsIsobaricFields
     {
-        return qFuzzyCompare(lhs.temperature, rhs.temperature) &&
-               qFuzzyCompare(lhs.relativeHumidity, rhs.relativeHumidity) &&
-               qFuzzyCompare(lhs.windU, rhs.windU) &&
-               qFuzzyCompare(lhs.windV, rhs.windV);
-    }
+        int temperature = -1;
+        int relativeHumidity = -1;
+        int windU = -1;
+        int windV = -1;
+    };
 
-    struct GfsCloudLayer
+    //! Fields of one cloud level, index in the field list or -1
+    struct GfsCloudFields
     {
-        float bottomLevelPressure = 0.0;
-        float topLevelPressure = 0.0;
-        float totalCoverage = 0.0;
-        float topLevelTemperature = 0.0;
-    };
+        int bottomLevelPressure = -1;
+        int topLevelPressure = -1;
+        int totalCoverage = -1;
+        int topLevelTemperature = -1;
 
-    struct GfsGridPoint
-    {
-        float latitude = 0.0;
-        float longitude = 0.0;
-        int fieldPosition = 0;
-        QHash<int, GfsCloudLayer> cloudLayers;
-        QHash<float, GfsIsobaricLayer> isobaricLayers;
-        float surfaceRain = 0;
-        float surfaceSnow = 0;
-        float surfacePrecipitationRate = 0;
-        float pressureAtMsl = 0.0;
+        //! Any level or temperature field? Otherwise the layer only exists with coverage
+        bool hasLevelOrTemperature() const { return bottomLevelPressure >= 0 || topLevelPressure >= 0 || topLevelTemperature >= 0; }
     };
+
+    //! Edge length of a tile in degrees
+    constexpr int TileSizeDeg = CGfsTileCache::TileSizeDeg;
+
+    //! Normal vector of a position
+    std::array<double, 3> gfsNormalVector(double latitudeDeg, double longitudeDeg)
+    {
+        const double lat = qDegreesToRadians(latitudeDeg);
+        const double lon = qDegreesToRadians(longitudeDeg);
+        return std::array<double, 3> { { std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon), std::sin(lat) } };
+    }
+
+    //! Angle between two normal vectors, same distance as calculateGreatCircleDistance, without the CLength objects
+    double gfsAngularDistance(const std::array<double, 3> &v1, const std::array<double, 3> &v2)
+    {
+        const double cross = std::hypot(v1[1] * v2[2] - v1[2] * v2[1], v1[2] * v2[0] - v1[0] * v2[2], v1[0] * v2[1] - v1[1] * v2[0]);
+        const double dot = v1[0] * v2[0] + v1[1] * v2[1] + v1[2] * v2[2];
+        return std::atan2(cross, dot);
+    }
+
+    //! Range in radians
+    double gfsRangeRad(const CLength &range)
+    {
+        constexpr double earthRadiusMeters = 6371000.8;
+        return range.value(CLengthUnit::m()) / earthRadiusMeters;
+    }
+
+    //! Too many points lead to extreme memory consumption and CPU usage
+    //! we stop here, no use case so far in swift where we need that
+    constexpr int GfsMaxGridPoints = 200;
     //! \endcond
 
     const CWeatherDataGfs::Grib2ParameterTable CWeatherDataGfs::m_grib2ParameterTable {
@@ -143,12 +176,30 @@ namespace BlackWxPlugin::Gfs
 
     void CWeatherDataGfs::fetchWeatherData(const CWeatherGrid &initialGrid, const CLength &range)
     {
-        if (!sApp || sApp->isShuttingDown()) { return; }
+        if (sApp && sApp->isShuttingDown()) { return; }
+        if (m_fetching)
+        {
+            // answered when the running fetch has finished
+            CLogMessage(this).debug() << "GFS data still being fetched, request queued";
+            m_queuedRequests.enqueue({ {}, initialGrid, range });
+            return;
+        }
+
         m_grid = initialGrid;
         m_maxRange = range;
+
+        // with a range only the tiles around the grid points are needed, cached on disk
+        if (m_maxRange != CLength())
+        {
+            this->fetchTiles();
+            return;
+        }
+
+        if (!sApp) { return; }
+        m_fetching = true;
         if (m_gribData.isEmpty())
         {
-            const QUrl url = getDownloadUrl().toQUrl();
+            const QUrl url = getDownloadUrl(getCurrentRun()).toQUrl();
             CLogMessage(this).debug() << "Started to download GFS data from" << url.toString();
             QNetworkRequest request(url);
             sApp->getFromNetwork(request, { this, &CWeatherDataGfs::parseGfsFile });
@@ -166,12 +217,20 @@ namespace BlackWxPlugin::Gfs
 
     void CWeatherDataGfs::fetchWeatherDataFromFile(const QString &filePath, const CWeatherGrid &grid, const CLength &range)
     {
+        if (m_fetching)
+        {
+            // answered when the running fetch has finished
+            m_queuedRequests.enqueue({ filePath, grid, range });
+            return;
+        }
+
         m_grid = grid;
         m_maxRange = range;
 
         QFile file(filePath);
         if (!file.exists() || !file.open(QIODevice::ReadOnly)) { return; }
         m_gribData = file.readAll();
+        m_fetching = true;
 
         Q_ASSERT_X(!m_parseGribFileWorker, Q_FUNC_INFO, "Worker already running");
         m_parseGribFileWorker = CWorker::fromTask(this, "parseGribFile", [this]() {
@@ -200,10 +259,29 @@ namespace BlackWxPlugin::Gfs
         }
         else
         {
+            m_fetching = false;
             emit fetchingFinished();
+
+            // receivers read the data of the finished request before the next one starts
+            if (!m_queuedRequests.isEmpty())
+            {
+                QPointer<CWeatherDataGfs> myself(this);
+                QTimer::singleShot(0, this, [=] {
+                    if (!myself) { return; }
+                    myself->fetchNextQueuedRequest();
+                });
+            }
         }
     }
 
+    void CWeatherDataGfs::fetchNextQueuedRequest()
+    {
+        if (m_fetching || m_queuedRequests.isEmpty()) { return; }
+        const FetchRequest request = m_queuedRequests.dequeue();
+        if (request.filePath.isEmpty()) { this->fetchWeatherData(request.grid, request.range); }
+        else { this->fetchWeatherDataFromFile(request.filePath, request.grid, request.range); }
+    }
+
     void CWeatherDataGfs::parseGfsFile(QNetworkReply *nwReplyPtr)
     {
         // wrap pointer, make sure any exit cleans up reply
@@ -218,7 +296,51 @@ namespace BlackWxPlugin::Gfs
         m_parseGribFileWorker->then(this, &CWeatherDataGfs::fetchingWeatherDataFinished);
     }
 
-    CUrl CWeatherDataGfs::getDownloadUrl() const
+    void CWeatherDataGfs::setTileCacheDirectory(const QString &directory)
+    {
+        Q_ASSERT_X(!m_fetching, Q_FUNC_INFO, "Tiles being fetched");
+        m_tileCache = CGfsTileCache(directory);
+    }
+
+    QString CWeatherDataGfs::getCurrentRunKey()
+    {
+        return getCurrentRun().getKey();
+    }
+
+    QString CWeatherDataGfs::getRunKey(const QDateTime &cycle, int forecastHour)
+    {
+        return cycle.toString("yyyyMMddHH") % QStringLiteral("_f%1").arg(forecastHour, 3, 10, QLatin1Char('0'));
+    }
+
+    CWeatherDataGfs::GfsRun CWeatherDataGfs::getCurrentRun()
+    {
+        static const std::array<int, 4> cycles = { { 0, 6, 12, 18 } };
+        const QDateTime now = QDateTime::currentDateTimeUtc();
+
+        // GFS data is published after 5 yours.
+        const QDateTime cnow = now.addSecs(-5 * 60 * 60);
+
+        int hourLastPublishedCycle = 0;
+        for (const auto &cycle : cycles)
+        {
+            if (cnow.time().hour() > cycle) { hourLastPublishedCycle = cycle; }
+        }
+
+        // Forecast is published in 3 hours steps.
+        // Round down to a multiple of 3
+        int forecast = now.time().hour() - hourLastPublishedCycle;
+        if (forecast < 0) { forecast += 24; }
+
+        // The 0 hour forecast, does not contain all required parameters. Hence use 1 hour forecast instead.
+        if (forecast == 0) { forecast = 1; }
+
+        GfsRun run;
+        run.cycle = QDateTime(cnow.date(), QTime(hourLastPublishedCycle, 0), Qt::UTC);
+        run.forecastHour = forecast;
+        return run;
+    }
+
+    CUrl CWeatherDataGfs::getDownloadUrl(const GfsRun &run, const GfsTile *tile) const
     {
         CUrl downloadUrl = sApp->getGlobalSetup().getNcepGlobalForecastSystemUrl25();
 
@@ -260,28 +382,9 @@ namespace BlackWxPlugin::Gfs
             "CSNOW"
         };
 
-        static const std::array<int, 4> cycles = { { 0, 6, 12, 18 } };
-        const QDateTime now = QDateTime::currentDateTimeUtc();
-
-        // GFS data is published after 5 yours.
-        const QDateTime cnow = now.addSecs(-5 * 60 * 60);
-
-        int hourLastPublishedCycle = 0;
-        for (const auto &cycle : cycles)
-        {
-            if (cnow.time().hour() > cycle) { hourLastPublishedCycle = cycle; }
-        }
-
-        // Forecast is published in 3 hours steps.
-        // Round down to a multiple of 3
-        int forecast = now.time().hour() - hourLastPublishedCycle;
-        if (forecast < 0) { forecast += 24; }
-
-        // The 0 hour forecast, does not contain all required parameters. Hence use 1 hour forecast instead.
-        if (forecast == 0) { forecast = 1; }
-
-        const QString filename = u"gfs." % QStringLiteral("t%1z").arg(hourLastPublishedCycle, 2, 10, QLatin1Char('0')) % u".pgrb2.0p25." % QStringLiteral("f%2").arg(forecast, 3, 10, QLatin1Char('0'));
-        const QString directory = u"/gfs." % cnow.toString("yyyyMMdd") % u"/" % QStringLiteral("%1").arg(hourLastPublishedCycle, 2, 10, QLatin1Char('0')) % u"/atmos";
+        const int cycleHour = run.cycle.time().hour();
+        const QString filename = u"gfs." % QStringLiteral("t%1z").arg(cycleHour, 2, 10, QLatin1Char('0')) % u".pgrb2.0p25." % QStringLiteral("f%2").arg(run.forecastHour, 3, 10, QLatin1Char('0'));
+        const QString directory = u"/gfs." % run.cycle.toString("yyyyMMdd") % u"/" % QStringLiteral("%1").arg(cycleHour, 2, 10, QLatin1Char('0')) % u"/atmos";
 
         downloadUrl.appendQuery("file", filename);
         for (const auto &level : grib2Levels)
@@ -292,15 +395,138 @@ namespace BlackWxPlugin::Gfs
         {
             downloadUrl.appendQuery("var_" + variable, "on");
         }
-        downloadUrl.appendQuery("leftlon", "0");
-        downloadUrl.appendQuery("rightlon", "360");
-        downloadUrl.appendQuery("toplat", "90");
-        downloadUrl.appendQuery("bottomlat", "-90");
+        if (tile)
+        {
+            downloadUrl.appendQuery("subregion", "");
+            downloadUrl.appendQuery("leftlon", QString::number(tile->west));
+            downloadUrl.appendQuery("rightlon", QString::number(tile->west + TileSizeDeg));
+            downloadUrl.appendQuery("toplat", QString::number(tile->south + TileSizeDeg));
+            downloadUrl.appendQuery("bottomlat", QString::number(tile->south));
+        }
+        else
+        {
+            downloadUrl.appendQuery("leftlon", "0");
+            downloadUrl.appendQuery("rightlon", "360");
+            downloadUrl.appendQuery("toplat", "90");
+            downloadUrl.appendQuery("bottomlat", "-90");
+        }
         downloadUrl.appendQuery("dir", directory);
         return downloadUrl;
     }
 
-    bool CWeatherDataGfs::parseGfsFileImpl(const QByteArray &gribData)
+    QVector<GfsTile> CWeatherDataGfs::getRequiredTiles() const
+    {
+        constexpr int rows = 180 / TileSizeDeg;
+        constexpr int columns = 360 / TileSizeDeg;
+        const double rangeRad = gfsRangeRad(m_maxRange);
+        const double rangeDeg = qRadiansToDegrees(rangeRad);
+
+        QVector<GfsTile> tiles;
+        for (const CGridPoint &fixedGridPoint : std::as_const(m_grid))
+        {
+            if (fixedGridPoint.getPosition().isNull()) { continue; }
+            const double pointLatitude = fixedGridPoint.getPosition().latitude().value(CAngleUnit::deg());
+            const double pointLongitude = std::fmod(fixedGridPoint.getPosition().longitude().value(CAngleUnit::deg()) + 360.0, 360.0);
+
+            // a cell on the northern edge belongs to the tile below, there is no tile north of 90
+            const int rowFirst = qBound(0, static_cast<int>(std::floor((pointLatitude - rangeDeg + 90.0) / TileSizeDeg)), rows - 1);
+            const int rowLast = qBound(0, static_cast<int>(std::floor((pointLatitude + rangeDeg + 90.0) / TileSizeDeg)), rows - 1);
+
+            // columns, the half width of a spherical cap, all around near the poles
+            int columnFirst = 0;
+            int columnLast = columns - 1;
+            const double capLatitude = qDegreesToRadians(std::abs(pointLatitude));
+            if (capLatitude + rangeRad < M_PI_2)
+            {
+                const double halfWidthDeg = qRadiansToDegrees(std::asin(qMin(1.0, std::sin(rangeRad) / std::cos(capLatitude))));
+                columnFirst = static_cast<int>(std::floor((pointLongitude - halfWidthDeg) / TileSizeDeg));
+                columnLast = static_cast<int>(std::floor((pointLongitude + halfWidthDeg) / TileSizeDeg));
+                if (columnLast - columnFirst >= columns)
+                {
+                    columnFirst = 0;
+                    columnLast = columns - 1;
+                }
+            }
+
+            for (int row = rowFirst; row <= rowLast; row++)
+            {
+                for (int column = columnFirst; column <= columnLast; column++)
+                {
+                    GfsTile tile;
+                    tile.south = row * TileSizeDeg - 90;
+                    tile.west = ((column % columns + columns) % columns) * TileSizeDeg;
+                    if (!tiles.contains(tile)) { tiles.push_back(tile); }
+                }
+            }
+        }
+        return tiles;
+    }
+
+    void CWeatherDataGfs::fetchTiles()
+    {
+        Q_ASSERT_X(!m_fetching, Q_FUNC_INFO, "GFS data still being fetched");
+        m_tileRun = getCurrentRun();
+        m_tiles = getRequiredTiles();
+        m_downloadedTiles.clear();
+
+        // only the missing tiles from the network
+        const QString runKey = m_tileRun.getKey();
+        QVector<GfsTile> missingTiles;
+        for (const GfsTile &tile : std::as_const(m_tiles))
+        {
+            if (!m_tileCache.contains(runKey, tile)) { missingTiles.push_back(tile); }
+        }
+        CLogMessage(this).debug() << "GFS tiles" << m_tiles.size() << "cached" << (m_tiles.size() - missingTiles.size());
+
+        if (missingTiles.isEmpty())
+        {
+            m_fetching = true;
+            this->parseTiles();
+            return;
+        }
+        if (!sApp) { return; }
+
+        m_fetching = true;
+        m_pendingTileDownloads = missingTiles.size();
+        for (const GfsTile &tile : std::as_const(missingTiles))
+        {
+            const QString fileName = m_tileCache.getFileName(runKey, tile);
+            const QUrl url = getDownloadUrl(m_tileRun, &tile).toQUrl();
+            CLogMessage(this).debug() << "Started to download GFS tile from" << url.toString();
+            const std::function<void(QNetworkReply *)> callback = [=](QNetworkReply *nwReply) { this->tileDownloaded(fileName, nwReply); };
+            sApp->getFromNetwork(QNetworkRequest(url), { this, callback });
+        }
+    }
+
+    void CWeatherDataGfs::tileDownloaded(const QString &fileName, QNetworkReply *nwReplyPtr)
+    {
+        // wrap pointer, make sure any exit cleans up reply
+        // required to use delete later as object is created in a different thread
+        QScopedPointer<QNetworkReply, QScopedPointerDeleteLater> nwReply(nwReplyPtr);
+
+        if (nwReply->error() == QNetworkReply::NoError) { m_downloadedTiles.insert(fileName, nwReply->readAll()); }
+        else { CLogMessage(this).warning(u"Downloading GFS tile failed: %1") << nwReply->errorString(); }
+
+        m_pendingTileDownloads--;
+        if (m_pendingTileDownloads > 0) { return; }
+        if (!sApp || sApp->isShuttingDown()) { return; }
+        this->parseTiles();
+    }
+
+    void CWeatherDataGfs::parseTiles()
+    {
+        Q_ASSERT_X(!m_parseGribFileWorker, Q_FUNC_INFO, "Worker already running");
+        const GfsRun run = m_tileRun;
+        const QVector<GfsTile> tiles = m_tiles;
+        const QHash<QString, QByteArray> downloadedTiles = m_downloadedTiles;
+        m_downloadedTiles.clear();
+        m_parseGribFileWorker = CWorker::fromTask(this, "parseGribFile", [=]() {
+            parseTilesImpl(run, tiles, downloadedTiles);
+        });
+        m_parseGribFileWorker->then(this, &CWeatherDataGfs::fetchingWeatherDataFinished);
+    }
+
+    bool CWeatherDataGfs::parseTilesImpl(const GfsRun &run, const QVector<GfsTile> &tiles, const QHash<QString, QByteArray> &downloadedTiles)
     {
         if (!m_lockData.tryLockForWrite(1000))
         {
@@ -310,14 +536,117 @@ namespace BlackWxPlugin::Gfs
 
         m_lockData.unlock();
         QWriteLocker lock(&m_lockData);
+        m_weatherGrid.clear();
+
+        // a tile expires with its forecast hour
+        const QString runKey = run.getKey();
+        m_tileCache.removeExpiredTiles(runKey);
+
+        // normal vectors of the requested points
+        const double rangeRad = gfsRangeRad(m_maxRange);
+        QVector<std::array<double, 3>> requested;
+        for (const CGridPoint &fixedGridPoint : std::as_const(m_grid))
+        {
+            if (fixedGridPoint.getPosition().isNull()) { continue; }
+            requested.push_back(gfsNormalVector(fixedGridPoint.getPosition().latitude().value(CAngleUnit::deg()), fixedGridPoint.getPosition().longitude().value(CAngleUnit::deg())));
+        }
+
+        // cells in range, the cells on the edges are part of two tiles
+        QVector<GfsGridPoint> selected;
+        QSet<QPair<int, int>> selectedCells;
+        for (const GfsTile &tile : tiles)
+        {
+            if (QThread::currentThread()->isInterruptionRequested()) { return false; }
+
+            const QString fileName = m_tileCache.getFileName(runKey, tile);
+            QVector<GfsGridPoint> points;
+            if (downloadedTiles.contains(fileName))
+            {
+                m_gfsAllCells = true;
+                const bool decoded = this->decodeGfsFile(downloadedTiles.value(fileName), points);
+                m_gfsAllCells = false;
+                if (!decoded) { return false; }
+                if (!points.isEmpty() && !m_tileCache.writeTile(runKey, tile, points))
+                {
+                    CLogMessage(this).warning(u"Cannot write GFS tile '%1'") << fileName;
+                }
+            }
+            else if (!m_tileCache.readTile(runKey, tile, points))
+            {
+                CLogMessage(this).warning(u"Cannot read GFS tile '%1'") << fileName;
+                QFile::remove(fileName);
+                continue;
+            }
+
+            for (const GfsGridPoint &point : std::as_const(points))
+            {
+                const std::array<double, 3> v2 = gfsNormalVector(point.latitude, point.longitude);
+                const bool inRange = std::any_of(requested.cbegin(), requested.cend(), [&](const std::array<double, 3> &v1) { return gfsAngularDistance(v1, v2) < rangeRad; });
+                if (!inRange) { continue; }
+
+                const QPair<int, int> cell(qRound(point.latitude * 100.0f), qRound(std::fmod(point.longitude + 360.0f, 360.0f) * 100.0f));
+                if (selectedCells.contains(cell)) { continue; }
+                selectedCells.insert(cell);
+                selected.push_back(point);
+            }
+        }
+
+        // same order as the cells of a GRIB field: North -> South, West -> East
+        std::sort(selected.begin(), selected.end(), [](const GfsGridPoint &a, const GfsGridPoint &b) {
+            return a.latitude != b.latitude ? a.latitude > b.latitude : a.longitude < b.longitude;
+        });
+        if (selected.size() > GfsMaxGridPoints)
+        {
+            BLACK_VERIFY_X(!CBuildConfig::isLocalDeveloperDebugBuild(), Q_FUNC_INFO, "Too many grid points");
+            CLogMessage(this).warning(u"Too many weather grid points: %1") << selected.size();
+            selected.resize(GfsMaxGridPoints);
+        }
+
+        CLogMessage(this).debug() << "Obtained" << selected.size() << "grid points from" << tiles.size() << "GFS tiles," << downloadedTiles.size() << "downloaded.";
+        m_weatherGrid.reserve(selected.size());
+        for (const GfsGridPoint &point : std::as_const(selected))
+        {
+            m_weatherGrid.push_back(this->toWeatherGridPoint(point));
+        }
+        return true;
+    }
+
+    bool CWeatherDataGfs::parseGfsFileImpl(const QByteArray &gribData)
+    {
+        if (!m_lockData.tryLockForWrite(1000))
+        {
+            CLogMessage(this).warning(u"Cannot log CWeatherDataGfs data");
+            return false;
+        }
 
-        m_gfsWeatherGrid.clear();
+        m_lockData.unlock();
+        QWriteLocker lock(&m_lockData);
         m_weatherGrid.clear();
 
+        QVector<GfsGridPoint> points;
+        if (!this->decodeGfsFile(gribData, points)) { return false; }
+
+        m_weatherGrid.reserve(points.size());
+        for (const GfsGridPoint &point : std::as_const(points))
+        {
+            if (QThread::currentThread()->isInterruptionRequested()) { return false; }
+            m_weatherGrid.push_back(this->toWeatherGridPoint(point));
+        }
+        return true;
+    }
+
+    bool CWeatherDataGfs::decodeGfsFile(const QByteArray &gribData, QVector<GfsGridPoint> &points)
+    {
+        m_gfsLatitudes.clear();
+        m_gfsLongitudes.clear();
+        m_gfsFieldPositions.clear();
+        m_gfsGridDefined = false;
+
         // Messages should be 76. This is a combination
         // of requested values (e.g. temperature, clouds etc) at specific layers (2 mbar, 10 mbar, surface).
         constexpr int maxMessages = 76;
-        int messageNo = 0;
+        auto constData = reinterpret_cast<unsigned char *>(const_cast<char *>(gribData.data()));
+        QVector<g2int> messageOffsets;
         g2int iseek = 0;
         for (;;)
         {
@@ -326,136 +655,267 @@ namespace BlackWxPlugin::Gfs
             // Search next grib field
             g2int lskip = 0;
             g2int lgrib = 0;
-            auto constData = reinterpret_cast<unsigned char *>(const_cast<char *>(gribData.data()));
             findNextGribMessage(constData, gribData.size(), iseek, &lskip, &lgrib);
             if (lgrib == 0) { break; }
-
-            unsigned char *readPtr = constData + lskip;
+            messageOffsets.push_back(lskip);
             iseek = lskip + lgrib;
-
-            g2int sec0[3];
-            g2int sec1[13];
-            g2int numlocal = 0;
-            g2int numfields = 0;
-            g2_info(readPtr, sec0, sec1, &numfields, &numlocal);
-
-            for (int n = 0; n < numfields; n++)
-            {
-                g2int unpack = 1;
-                g2int expand = 1;
-                gribfield *gfld = nullptr;
-                g2_getfld(readPtr, n + 1, unpack, expand, &gfld);
-                if (gfld->idsectlen < 12)
-                {
-                    CLogMessage(this).warning(u"Identification section: wrong length!");
-                    continue;
-                }
-
-                if (gfld->igdtnum != 0) { CLogMessage(this).warning(u"Can handle only grid definition template number = 0"); }
-
-                int nscan = gfld->igdtmpl[18];
-                int npnts = gfld->ngrdpts;
-                int nx = gfld->igdtmpl[7];
-                int ny = gfld->igdtmpl[8];
-                if (nscan != 0) { CLogMessage(this).error(u"Can only handle scanning mode NS:WE."); }
-                if (npnts != nx * ny) { CLogMessage(this).error(u"Cannot handle non-regular grid."); }
-
-                if (m_gfsWeatherGrid.isEmpty()) { createWeatherGrid(gfld); }
-
-                if (gfld->ipdtnum == 0) { handleProductDefinitionTemplate40(gfld); }
-                else if (gfld->ipdtnum == 8) { handleProductDefinitionTemplate48(gfld); }
-                else
-                {
-                    CLogMessage(this).warning(u"Cannot handle product definition template %1") << gfld->ipdtnum;
-                    continue;
-                }
-
-                g2_free(gfld);
-            }
-            messageNo++;
         }
 
         // validate
+        const int messageNo = messageOffsets.size();
         if (messageNo > maxMessages && CBuildConfig::isLocalDeveloperDebugBuild())
         {
             // as discussed this means a format change
             BLACK_VERIFY_X(false, Q_FUNC_INFO, "Format change in GRIB, too many messages");
         }
+        if (messageOffsets.isEmpty()) { return true; }
+
+        // The first message defines the grid, and initializes the static values of g2clib.
+        // The messages are independent, unpacking them is the expensive part, so the others are decoded in parallel.
+        QVector<GfsField> fields = decodeGribMessage(constData + messageOffsets.front());
+        m_gfsGridDefined = true;
+        QThread *workerThread = QThread::currentThread();
+        const QList<QVector<GfsField>> decoded = QtConcurrent::blockingMapped<QList<QVector<GfsField>>>(messageOffsets.mid(1), [this, constData, workerThread](g2int offset) {
+            if (workerThread->isInterruptionRequested()) { return QVector<GfsField>(); }
+            return this->decodeGribMessage(constData + offset);
+        });
+        if (workerThread->isInterruptionRequested()) { return false; }
+        for (const QVector<GfsField> &messageFields : decoded) { fields += messageFields; }
 
-        const int weatherGridPointsNo = m_gfsWeatherGrid.size();
         CLogMessage(this).debug() << "Parsed" << messageNo << "GRIB messages.";
-        CLogMessage(this).debug() << "Obtained" << weatherGridPointsNo << "grid points.";
+        CLogMessage(this).debug() << "Obtained" << m_gfsFieldPositions.size() << "grid points.";
 
-        constexpr int maxPoints = 200;
-        for (const GfsGridPoint &gfsGridPoint : std::as_const(m_gfsWeatherGrid))
+        return createGfsGridPoints(fields, points);
+    }
+
+    QVector<GfsField> CWeatherDataGfs::decodeGribMessage(unsigned char *readPtr)
+    {
+        QVector<GfsField> fields;
+        g2int sec0[3];
+        g2int sec1[13];
+        g2int numlocal = 0;
+        g2int numfields = 0;
+        g2_info(readPtr, sec0, sec1, &numfields, &numlocal);
+
+        for (int n = 0; n < numfields; n++)
         {
-            if (QThread::currentThread()->isInterruptionRequested()) { return false; }
+            g2int unpack = 1;
+            g2int expand = 1;
+            gribfield *gfld = nullptr;
+            g2_getfld(readPtr, n + 1, unpack, expand, &gfld);
+            if (!gfld) { continue; }
+            if (gfld->idsectlen < 12)
+            {
+                CLogMessage(this).warning(u"Identification section: wrong length!");
+                g2_free(gfld);
+                continue;
+            }
+
+            if (gfld->igdtnum != 0) { CLogMessage(this).warning(u"Can handle only grid definition template number = 0"); }
 
-            CTemperatureLayerList temperatureLayers;
-            CWindLayerList windLayers;
-            for (const GfsIsobaricLayer &isobaricLayer : gfsGridPoint.isobaricLayers)
+            int nscan = gfld->igdtmpl[18];
+            int npnts = gfld->ngrdpts;
+            int nx = gfld->igdtmpl[7];
+            int ny = gfld->igdtmpl[8];
+            if (nscan != 0) { CLogMessage(this).error(u"Can only handle scanning mode NS:WE."); }
+            if (npnts != nx * ny) { CLogMessage(this).error(u"Cannot handle non-regular grid."); }
+
+            // only with the first field of the first message, all messages use the same grid
+            if (!m_gfsGridDefined)
             {
-                float level = gfsGridPoint.isobaricLayers.key(isobaricLayer);
-                double altitudeFt = calculateAltitudeFt(gfsGridPoint.pressureAtMsl, level, isobaricLayer.temperature);
+                m_gfsGridDefined = true;
+                createWeatherGrid(gfld);
+            }
 
-                CAltitude altitude(altitudeFt, CAltitude::MeanSeaLevel, CLengthUnit::ft());
+            GfsField field;
+            bool handled = false;
+            if (gfld->ipdtnum == 0) { handled = handleProductDefinitionTemplate40(gfld, field); }
+            else if (gfld->ipdtnum == 8) { handled = handleProductDefinitionTemplate48(gfld, field); }
+            else { CLogMessage(this).warning(u"Cannot handle product definition template %1") << gfld->ipdtnum; }
 
-                auto temperature = CTemperature { isobaricLayer.temperature, CTemperatureUnit::K() };
-                auto dewPoint = calculateDewPoint(temperature, isobaricLayer.relativeHumidity);
+            if (handled && gfld->fld)
+            {
+                // extract the selected cells
+                field.values.resize(m_gfsFieldPositions.size());
+                for (int i = 0; i < m_gfsFieldPositions.size(); ++i)
+                {
+                    const int fieldPosition = m_gfsFieldPositions[i];
+                    field.values[i] = fieldPosition < npnts ? gfld->fld[fieldPosition] : 0.0f;
+                }
+                fields.push_back(field);
+            }
+            g2_free(gfld);
+        }
+        return fields;
+    }
 
-                CTemperatureLayer temperatureLayer(altitude, temperature, dewPoint, isobaricLayer.relativeHumidity);
-                temperatureLayers.push_back(temperatureLayer);
+    bool CWeatherDataGfs::createGfsGridPoints(const QVector<GfsField> &fields, QVector<GfsGridPoint> &points)
+    {
+        static const QHash<int, int> grib2CloudLevelHash = {
+            { LowCloudBottomLevel, LowCloud },
+            { LowCloudTopLevel, LowCloud },
+            { LowCloudLayer, LowCloud },
+            { MiddleCloudBottomLevel, MiddleCloud },
+            { MiddleCloudTopLevel, MiddleCloud },
+            { MiddleCloudLayer, MiddleCloud },
+            { HighCloudBottomLevel, HighCloud },
+            { HighCloudTopLevel, HighCloud },
+            { HighCloudLayer, HighCloud },
+        };
 
-                double windDirection = -1 * CMathUtils::rad2deg(std::atan2(-isobaricLayer.windU, isobaricLayer.windV));
-                windDirection += 180.0;
-                if (windDirection < 0.0) { windDirection += 360.0; }
-                if (windDirection >= 360.0) { windDirection -= 360.0; }
-                double windSpeed = std::hypot(isobaricLayer.windU, isobaricLayer.windV);
-                CWindLayer windLayer(altitude, CAngle(windDirection, CAngleUnit::deg()), CSpeed(windSpeed, CSpeedUnit::m_s()), {});
-                windLayers.push_back(windLayer);
+        // which field holds which value, a later field replaces an earlier one
+        std::map<float, GfsIsobaricFields> isobaricFields;
+        std::array<GfsCloudFields, 3> cloudFields;
+        int pressureAtMslField = -1;
+        int surfaceRainField = -1;
+        int surfaceSnowField = -1;
+        int precipitationRateField = -1;
+        for (int f = 0; f < fields.size(); ++f)
+        {
+            const GfsField &field = fields[f];
+            if (field.productDefinitionTemplate == 0)
+            {
+                switch (field.code)
+                {
+                case TMP:
+                    if (field.level > 0) { isobaricFields[field.level].temperature = f; }
+                    break;
+                case RH: isobaricFields[field.level].relativeHumidity = f; break;
+                case UGRD: isobaricFields[field.level].windU = f; break;
+                case VGRD: isobaricFields[field.level].windV = f; break;
+                case PRMSL: pressureAtMslField = f; break;
+                default: break;
+                }
+                continue;
             }
 
-            CCloudLayerList cloudLayers;
-            for (const GfsCloudLayer &gfsCloudLayer : std::as_const(gfsGridPoint.cloudLayers))
+            GfsCloudFields &cloud = cloudFields[static_cast<size_t>(grib2CloudLevelHash.value(field.surfaceType))];
+            switch (field.code)
             {
-                if (std::isnan(gfsCloudLayer.bottomLevelPressure) || std::isnan(gfsCloudLayer.topLevelPressure) || std::isnan(gfsCloudLayer.topLevelTemperature)) { continue; }
-
-                CCloudLayer cloudLayer;
-                double bottomLevelFt = calculateAltitudeFt(gfsGridPoint.pressureAtMsl, gfsCloudLayer.bottomLevelPressure, gfsCloudLayer.topLevelTemperature);
-                double topLevelFt = calculateAltitudeFt(gfsGridPoint.pressureAtMsl, gfsCloudLayer.topLevelPressure, gfsCloudLayer.topLevelTemperature);
-                cloudLayer.setBase(CAltitude(bottomLevelFt, CAltitude::MeanSeaLevel, CLengthUnit::ft()));
-                cloudLayer.setTop(CAltitude(topLevelFt, CAltitude::MeanSeaLevel, CLengthUnit::ft()));
-                cloudLayer.setCoveragePercent(qRound(gfsCloudLayer.totalCoverage));
-                if (gfsGridPoint.surfaceSnow > 0.0) { cloudLayer.setPrecipitation(CCloudLayer::Snow); }
-                if (gfsGridPoint.surfaceRain > 0.0) { cloudLayer.setPrecipitation(CCloudLayer::Rain); }
-
-                // Precipitation rate is in kg m-2 s-1, which is equal to mm/s
-                // Multiply with 3600 to convert to mm/h
-                cloudLayer.setPrecipitationRate(gfsGridPoint.surfacePrecipitationRate * 3600.0);
-                cloudLayer.setClouds(CCloudLayer::CloudsUnknown);
-                cloudLayers.push_back(cloudLayer);
+            case TCDC: cloud.totalCoverage = f; break;
+            case PRES:
+                if (field.surfaceType == LowCloudBottomLevel || field.surfaceType == MiddleCloudBottomLevel || field.surfaceType == HighCloudBottomLevel) { cloud.bottomLevelPressure = f; }
+                else if (field.surfaceType == LowCloudTopLevel || field.surfaceType == MiddleCloudTopLevel || field.surfaceType == HighCloudTopLevel) { cloud.topLevelPressure = f; }
+                break;
+            case TMP:
+                if (field.surfaceType == LowCloudTopLevel || field.surfaceType == MiddleCloudTopLevel || field.surfaceType == HighCloudTopLevel) { cloud.topLevelTemperature = f; }
+                break;
+            case PRATE: precipitationRateField = f; break;
+            case CRAIN: surfaceRainField = f; break;
+            case CSNOW: surfaceSnowField = f; break;
+            default: break;
             }
+        }
+
+        // one pass over the cells, reading all fields
+        const auto value = [&fields](int field, int cell) { return field < 0 ? 0.0f : fields[field].values[cell]; };
+        const auto cloudLevelPressure = [&](int field, int cell) {
+            // A value of 9.999e20 is undefined. Check that the pressure value is below
+            constexpr g2float minimumLevel = 1000.0;
+            const g2float fieldValue = value(field, cell);
+            return (field < 0 || (fieldValue < 9.998e20f && fieldValue > minimumLevel)) ? fieldValue : std::numeric_limits<float>::quiet_NaN();
+        };
+        const auto cloudTemperature = [&](int field, int cell) {
+            const g2float fieldValue = value(field, cell);
+            return (field < 0 || fieldValue < 9.998e20f) ? fieldValue : std::numeric_limits<float>::quiet_NaN();
+        };
+
+        points.reserve(m_gfsFieldPositions.size());
+        for (int cell = 0; cell < m_gfsFieldPositions.size(); ++cell)
+        {
+            if (QThread::currentThread()->isInterruptionRequested()) { return false; }
 
-            auto pressureAtMsl = PhysicalQuantities::CPressure { gfsGridPoint.pressureAtMsl, PhysicalQuantities::CPressureUnit::Pa() };
+            GfsGridPoint point;
+            point.latitude = m_gfsLatitudes[cell];
+            point.longitude = m_gfsLongitudes[cell];
+            point.pressureAtMsl = value(pressureAtMslField, cell);
+            point.surfaceRain = value(surfaceRainField, cell);
+            point.surfaceSnow = value(surfaceSnowField, cell);
+            point.surfacePrecipitationRate = value(precipitationRateField, cell);
 
-            const CLatitude latitude(gfsGridPoint.latitude, CAngleUnit::deg());
-            const CLongitude longitude(gfsGridPoint.longitude, CAngleUnit::deg());
-            const auto position = CCoordinateGeodetic { latitude, longitude };
-            const CGridPoint gridPoint({}, position, cloudLayers, temperatureLayers, {}, windLayers, pressureAtMsl);
-            m_weatherGrid.push_back(gridPoint);
-            if (m_weatherGrid.size() >= maxPoints)
+            point.isobaricLayers.reserve(static_cast<int>(isobaricFields.size()));
+            for (const auto &[level, isobaric] : isobaricFields)
             {
-                // too many points lead to extreme memory consumption and CPU usage
-                // we stop here, no use case so far in swift where we need that
-                BLACK_VERIFY_X(!CBuildConfig::isLocalDeveloperDebugBuild(), Q_FUNC_INFO, "Too many grid points");
-                CLogMessage(this).warning(u"Too many weather grid points: %1") << m_weatherGrid.size();
-                break;
+                GfsIsobaricLayer layer;
+                layer.level = level;
+                layer.temperature = value(isobaric.temperature, cell);
+                layer.relativeHumidity = value(isobaric.relativeHumidity, cell);
+                layer.windU = value(isobaric.windU, cell);
+                layer.windV = value(isobaric.windV, cell);
+                point.isobaricLayers.push_back(layer);
             }
+
+            for (const GfsCloudFields &cloud : cloudFields)
+            {
+                GfsCloudLayer layer;
+                layer.totalCoverage = qMax(0.0f, value(cloud.totalCoverage, cell));
+                if (!cloud.hasLevelOrTemperature() && layer.totalCoverage <= 0.0f) { continue; }
+
+                layer.bottomLevelPressure = cloudLevelPressure(cloud.bottomLevelPressure, cell);
+                layer.topLevelPressure = cloudLevelPressure(cloud.topLevelPressure, cell);
+                layer.topLevelTemperature = cloudTemperature(cloud.topLevelTemperature, cell);
+                if (std::isnan(layer.bottomLevelPressure) || std::isnan(layer.topLevelPressure) || std::isnan(layer.topLevelTemperature)) { continue; }
+                point.cloudLayers.push_back(layer);
+            }
+            points.push_back(point);
         }
 
         return true;
     }
 
+    CGridPoint CWeatherDataGfs::toWeatherGridPoint(const GfsGridPoint &point)
+    {
+        const float pressureAtMslPa = point.pressureAtMsl;
+        CTemperatureLayerList temperatureLayers;
+        CWindLayerList windLayers;
+        for (const GfsIsobaricLayer &isobaric : point.isobaricLayers)
+        {
+            double altitudeFt = calculateAltitudeFt(pressureAtMslPa, isobaric.level, isobaric.temperature);
+
+            CAltitude altitude(altitudeFt, CAltitude::MeanSeaLevel, CLengthUnit::ft());
+
+            auto temperature = CTemperature { isobaric.temperature, CTemperatureUnit::K() };
+            auto dewPoint = calculateDewPoint(temperature, isobaric.relativeHumidity);
+
+            CTemperatureLayer temperatureLayer(altitude, temperature, dewPoint, isobaric.relativeHumidity);
+            temperatureLayers.push_back(temperatureLayer);
+
+            double windDirection = -1 * CMathUtils::rad2deg(std::atan2(-isobaric.windU, isobaric.windV));
+            windDirection += 180.0;
+            if (windDirection < 0.0) { windDirection += 360.0; }
+            if (windDirection >= 360.0) { windDirection -= 360.0; }
+            double windSpeed = std::hypot(isobaric.windU, isobaric.windV);
+            CWindLayer windLayer(altitude, CAngle(windDirection, CAngleUnit::deg()), CSpeed(windSpeed, CSpeedUnit::m_s()), {});
+            windLayers.push_back(windLayer);
+        }
+
+        CCloudLayerList cloudLayers;
+        for (const GfsCloudLayer &cloud : point.cloudLayers)
+        {
+            CCloudLayer cloudLayer;
+            double bottomLevelFt = calculateAltitudeFt(pressureAtMslPa, cloud.bottomLevelPressure, cloud.topLevelTemperature);
+            double topLevelFt = calculateAltitudeFt(pressureAtMslPa, cloud.topLevelPressure, cloud.topLevelTemperature);
+            cloudLayer.setBase(CAltitude(bottomLevelFt, CAltitude::MeanSeaLevel, CLengthUnit::ft()));
+            cloudLayer.setTop(CAltitude(topLevelFt, CAltitude::MeanSeaLevel, CLengthUnit::ft()));
+            cloudLayer.setCoveragePercent(qRound(cloud.totalCoverage));
+            if (point.surfaceSnow > 0.0) { cloudLayer.setPrecipitation(CCloudLayer::Snow); }
+            if (point.surfaceRain > 0.0) { cloudLayer.setPrecipitation(CCloudLayer::Rain); }
+
+            // Precipitation rate is in kg m-2 s-1, which is equal to mm/s
+            // Multiply with 3600 to convert to mm/h
+            cloudLayer.setPrecipitationRate(point.surfacePrecipitationRate * 3600.0);
+            cloudLayer.setClouds(CCloudLayer::CloudsUnknown);
+            cloudLayers.push_back(cloudLayer);
+        }
+
+        auto pressureAtMsl = PhysicalQuantities::CPressure { pressureAtMslPa, PhysicalQuantities::CPressureUnit::Pa() };
+
+        const CLatitude latitude(point.latitude, CAngleUnit::deg());
+        const CLongitude longitude(point.longitude, CAngleUnit::deg());
+        const auto position = CCoordinateGeodetic { latitude, longitude };
+        return CGridPoint({}, position, cloudLayers, temperatureLayers, {}, windLayers, pressureAtMsl);
+    }
+
     void CWeatherDataGfs::findNextGribMessage(unsigned char *buffer, g2int size, g2int iseek, g2int *lskip, g2int *lgrib)
     {
         *lgrib = 0;
@@ -588,54 +1048,102 @@ namespace BlackWxPlugin::Gfs
         }
         dy = fabs(dy);
 
-        if (nx > 0 && ny > 0)
+        if (nx < 1 || ny < 1) { return; }
+
+        // Cells near the requested grid points: the lat/lon index window around each point is
+        // checked instead of all cells. Longitudes wrap around for a global grid.
+        const bool global = nx * dx > 359.0f;
+        QVector<int> fieldPositions;
+        if (m_gfsAllCells || m_maxRange == CLength())
+        {
+            fieldPositions.resize(npnts);
+            std::iota(fieldPositions.begin(), fieldPositions.end(), 0);
+        }
+        else
         {
-            for (int iy = 0; iy < ny; iy++)
+            const double rangeRad = gfsRangeRad(m_maxRange);
+            const double rangeDeg = qRadiansToDegrees(rangeRad);
+
+            for (const CGridPoint &fixedGridPoint : std::as_const(m_grid))
             {
-                int i = nx * iy;
-                for (int ix = 0; ix < nx; ix++)
+                if (fixedGridPoint.getPosition().isNull())
                 {
-                    GfsGridPoint gridPoint;
-                    gridPoint.latitude = latitude1 - iy * dy;
-                    gridPoint.longitude = longitude1 + ix * dx;
-                    if (gridPoint.longitude >= 360.0f) { gridPoint.longitude -= 360.0f; }
-                    if (gridPoint.longitude < 0.0f) { gridPoint.longitude += 360.0f; }
-                    gridPoint.fieldPosition = ix + i;
-                    const CCoordinateGeodetic gridPointPosition(gridPoint.latitude, gridPoint.longitude, 0);
-                    if (m_maxRange == CLength())
+                    BLACK_VERIFY_X(!CBuildConfig::isLocalDeveloperDebugBuild(), Q_FUNC_INFO, "Suspicious value, why is that?");
+                    continue;
+                }
+                const double pointLatitude = fixedGridPoint.getPosition().latitude().value(CAngleUnit::deg());
+                const double pointLongitude = fixedGridPoint.getPosition().longitude().value(CAngleUnit::deg());
+                const std::array<double, 3> v1 = gfsNormalVector(pointLatitude, pointLongitude);
+
+                // rows, one cell margin
+                const int iyFirst = dy > 0 ? qMax(0, static_cast<int>(std::floor((latitude1 - pointLatitude - rangeDeg) / dy)) - 1) : 0;
+                const int iyLast = dy > 0 ? qMin(ny - 1, static_cast<int>(std::ceil((latitude1 - pointLatitude + rangeDeg) / dy)) + 1) : ny - 1;
+
+                // columns, the half width of a spherical cap, all around near the poles
+                int ixFirst = 0;
+                int ixLast = nx - 1;
+                const double capLatitude = qDegreesToRadians(std::abs(pointLatitude));
+                if (dx > 0 && capLatitude + rangeRad < M_PI_2)
+                {
+                    const double halfWidthDeg = qRadiansToDegrees(std::asin(qMin(1.0, std::sin(rangeRad) / std::cos(capLatitude))));
+                    const double column = std::fmod(pointLongitude - longitude1 + 720.0, 360.0) / dx;
+                    ixFirst = static_cast<int>(std::floor(column - halfWidthDeg / dx)) - 1;
+                    ixLast = static_cast<int>(std::ceil(column + halfWidthDeg / dx)) + 1;
+                    if (ixLast - ixFirst >= nx)
                     {
-                        m_gfsWeatherGrid.append(gridPoint);
+                        ixFirst = 0;
+                        ixLast = nx - 1;
                     }
-                    else
+                }
+
+                for (int iy = iyFirst; iy <= iyLast; iy++)
+                {
+                    const double cellLatitude = latitude1 - iy * dy;
+                    for (int column = ixFirst; column <= ixLast; column++)
                     {
-                        for (const CGridPoint &fixedGridPoint : std::as_const(m_grid))
-                        {
-                            const CLength distance = calculateGreatCircleDistance(gridPointPosition, fixedGridPoint.getPosition());
-                            if (distance.isNull())
-                            {
-                                BLACK_VERIFY_X(!CBuildConfig::isLocalDeveloperDebugBuild(), Q_FUNC_INFO, "Suspicious value, why is that?");
-                            }
-                            else
-                            {
-                                if (distance < m_maxRange)
-                                {
-                                    m_gfsWeatherGrid.append(gridPoint);
-                                    break;
-                                }
-                            }
-                        }
+                        const int ix = global ? (column % nx + nx) % nx : column;
+                        if (ix < 0 || ix >= nx) { continue; }
+
+                        const std::array<double, 3> v2 = gfsNormalVector(cellLatitude, longitude1 + ix * dx);
+                        if (gfsAngularDistance(v1, v2) < rangeRad) { fieldPositions.push_back(ix + nx * iy); }
                     }
-                } // for
-            } // for
-        } // if
+                }
+            }
+
+            // cells near several points only once, in the order of the GRIB field
+            std::sort(fieldPositions.begin(), fieldPositions.end());
+            fieldPositions.erase(std::unique(fieldPositions.begin(), fieldPositions.end()), fieldPositions.end());
+        }
+
+        // a tile is selected later, all points of it are cached
+        if (!m_gfsAllCells && fieldPositions.size() > GfsMaxGridPoints)
+        {
+            BLACK_VERIFY_X(!CBuildConfig::isLocalDeveloperDebugBuild(), Q_FUNC_INFO, "Too many grid points");
+            CLogMessage(this).warning(u"Too many weather grid points: %1") << fieldPositions.size();
+            fieldPositions.resize(GfsMaxGridPoints);
+        }
+
+        m_gfsFieldPositions = fieldPositions;
+        m_gfsLatitudes.resize(fieldPositions.size());
+        m_gfsLongitudes.resize(fieldPositions.size());
+        for (int i = 0; i < fieldPositions.size(); ++i)
+        {
+            const int iy = fieldPositions[i] / nx;
+            const int ix = fieldPositions[i] % nx;
+            float longitude = longitude1 + ix * dx;
+            if (longitude >= 360.0f) { longitude -= 360.0f; }
+            if (longitude < 0.0f) { longitude += 360.0f; }
+            m_gfsLatitudes[i] = latitude1 - iy * dy;
+            m_gfsLongitudes[i] = longitude;
+        }
     }
 
-    void CWeatherDataGfs::handleProductDefinitionTemplate40(const gribfield *gfld)
+    bool CWeatherDataGfs::handleProductDefinitionTemplate40(const gribfield *gfld, GfsField &field) const
     {
         if (gfld->ipdtlen != 15)
         {
             CLogMessage(this).warning(u"Template 4.0 has wrong length");
-            return;
+            return false;
         }
 
         // https://www.nco.ncep.noaa.gov/pmb/docs/grib2/grib2_doc/grib2_temp4-0.shtml
@@ -649,7 +1157,7 @@ namespace BlackWxPlugin::Gfs
         if (!m_grib2ParameterTable.contains(key))
         {
             CLogMessage(this).warning(u"Unknown GRIB2 parameter: %1 - %2") << parameterCategory << parameterNumber;
-            return;
+            return false;
         }
 
         float level = 0.0;
@@ -659,32 +1167,38 @@ namespace BlackWxPlugin::Gfs
         case GroundOrWaterSurface: level = 0.0; break;
         case IsobaricSurface: level = valueFirstFixedSurface; break;
         case MeanSeaLevel: level = 0.0; break;
-        default: CLogMessage(this).warning(u"Unexpected first fixed surface type: %1") << typeFirstFixedSurface; return;
+        default: CLogMessage(this).warning(u"Unexpected first fixed surface type: %1") << typeFirstFixedSurface; return false;
         }
 
-        auto parameterValue = m_grib2ParameterTable[key];
+        const Grib2ParameterValue parameterValue = m_grib2ParameterTable.value(key);
         switch (parameterValue.code)
         {
-        case TMP: setTemperature(gfld->fld, level); break;
-        case RH: setHumidity(gfld->fld, level); break;
-        case UGRD: setWindU(gfld->fld, level); break;
-        case VGRD: setWindV(gfld->fld, level); break;
-        case PRMSL: setPressureAtMsl(gfld->fld); break;
-        case PRES: /* Do nothing */ break;
-        case TCDC: /* Do nothing */ break;
-        case PRATE: /* Do nothing */ break;
-        case CSNOW: break;
-        case CRAIN: break;
-        default: CLogMessage(this).error(u"Unexpected parameterValue in Template 4.0: %1 (%2)") << parameterValue.code << parameterValue.name; return;
+        case TMP:
+        case RH:
+        case UGRD:
+        case VGRD:
+        case PRMSL: break;
+        case PRES: /* Do nothing */ return false;
+        case TCDC: /* Do nothing */ return false;
+        case PRATE: /* Do nothing */ return false;
+        case CSNOW: return false;
+        case CRAIN: return false;
+        default: CLogMessage(this).error(u"Unexpected parameterValue in Template 4.0: %1 (%2)") << parameterValue.code << parameterValue.name; return false;
         }
+
+        field.code = parameterValue.code;
+        field.productDefinitionTemplate = 0;
+        field.surfaceType = typeFirstFixedSurface;
+        field.level = level;
+        return true;
     }
 
-    void CWeatherDataGfs::handleProductDefinitionTemplate48(const gribfield *gfld)
+    bool CWeatherDataGfs::handleProductDefinitionTemplate48(const gribfield *gfld, GfsField &field) const
     {
         if (gfld->ipdtlen != 29)
         {
             CLogMessage(this).warning(u"Template 4.8 has wrong length.");
-            return;
+            return false;
         }
 
         g2int parameterCategory = gfld->ipdtmpl[0];
@@ -696,153 +1210,25 @@ namespace BlackWxPlugin::Gfs
         if (!m_grib2ParameterTable.contains(key))
         {
             CLogMessage(this).warning(u"Unknown GRIB2 parameter: %1 - %2") << parameterCategory << parameterNumber;
-            return;
+            return false;
         }
 
-        static const QHash<int, int> grib2CloudLevelHash = {
-            { LowCloudBottomLevel, LowCloud },
-            { LowCloudTopLevel, LowCloud },
-            { LowCloudLayer, LowCloud },
-            { MiddleCloudBottomLevel, MiddleCloud },
-            { MiddleCloudTopLevel, MiddleCloud },
-            { MiddleCloudLayer, MiddleCloud },
-            { HighCloudBottomLevel, HighCloud },
-            { HighCloudTopLevel, HighCloud },
-            { HighCloudLayer, HighCloud },
-        };
-
-        auto parameterValue = m_grib2ParameterTable[key];
+        const Grib2ParameterValue parameterValue = m_grib2ParameterTable.value(key);
         switch (parameterValue.code)
         {
-        case TCDC: setCloudCoverage(gfld->fld, grib2CloudLevelHash.value(typeFirstFixedSurface)); break;
-        case PRES: setCloudLevel(gfld->fld, typeFirstFixedSurface, grib2CloudLevelHash.value(typeFirstFixedSurface)); break;
-        case PRATE: setPrecipitationRate(gfld->fld); break;
-        case CRAIN: setSurfaceRain(gfld->fld); break;
-        case CSNOW: setSurfaceSnow(gfld->fld); break;
-        case TMP: setCloudTemperature(gfld->fld, typeFirstFixedSurface, grib2CloudLevelHash.value(typeFirstFixedSurface)); break;
-        default: CLogMessage(this).warning(u"Unexpected parameterValue in Template 4.8: %1 (%2)") << parameterValue.code << parameterValue.name; return;
-        }
-    }
-
-    void CWeatherDataGfs::setTemperature(const g2float *fld, float level)
-    {
-        for (auto &gridPoint : m_gfsWeatherGrid)
-        {
-            if (level > 0) { gridPoint.isobaricLayers[level].temperature = fld[gridPoint.fieldPosition]; }
-        }
-    }
-
-    void CWeatherDataGfs::setHumidity(const g2float *fld, float level)
-    {
-        for (auto &gridPoint : m_gfsWeatherGrid)
-        {
-            gridPoint.isobaricLayers[level].relativeHumidity = fld[gridPoint.fieldPosition];
-        }
-    }
-
-    void CWeatherDataGfs::setWindV(const g2float *fld, float level)
-    {
-        for (auto &gridPoint : m_gfsWeatherGrid)
-        {
-            gridPoint.isobaricLayers[level].windV = fld[gridPoint.fieldPosition];
-        }
-    }
-
-    void CWeatherDataGfs::setWindU(const g2float *fld, float level)
-    {
-        for (auto &gridPoint : m_gfsWeatherGrid)
-        {
-            gridPoint.isobaricLayers[level].windU = fld[gridPoint.fieldPosition];
-        }
-    }
-
-    void CWeatherDataGfs::setCloudCoverage(const g2float *fld, int level)
-    {
-        for (auto &gridPoint : m_gfsWeatherGrid)
-        {
-            if (fld[gridPoint.fieldPosition] > 0.0f) { gridPoint.cloudLayers[level].totalCoverage = fld[gridPoint.fieldPosition]; }
-        }
-    }
-
-    void CWeatherDataGfs::setCloudLevel(const g2float *fld, int surfaceType, int level)
-    {
-        for (auto &gridPoint : m_gfsWeatherGrid)
-        {
-            static const g2float minimumLevel = 1000.0;
-            float levelPressure = std::numeric_limits<float>::quiet_NaN();
-            g2float fieldValue = fld[gridPoint.fieldPosition];
-            // A value of 9.999e20 is undefined. Check that the pressure value is below
-            if (fieldValue < 9.998e20f && fieldValue > minimumLevel) { levelPressure = fld[gridPoint.fieldPosition]; }
-            switch (surfaceType)
-            {
-            case LowCloudBottomLevel:
-            case MiddleCloudBottomLevel:
-            case HighCloudBottomLevel:
-                gridPoint.cloudLayers[level].bottomLevelPressure = levelPressure;
-                break;
-            case LowCloudTopLevel:
-            case MiddleCloudTopLevel:
-            case HighCloudTopLevel:
-                gridPoint.cloudLayers[level].topLevelPressure = levelPressure;
-                break;
-            default:
-                Q_ASSERT(false);
-                break;
-            }
-        }
-    }
-
-    void CWeatherDataGfs::setCloudTemperature(const g2float *fld, int surfaceType, int level)
-    {
-        for (auto &gridPoint : m_gfsWeatherGrid)
-        {
-            float temperature = std::numeric_limits<float>::quiet_NaN();
-            g2float fieldValue = fld[gridPoint.fieldPosition];
-            if (fieldValue < 9.998e20f) { temperature = fld[gridPoint.fieldPosition]; }
-            switch (surfaceType)
-            {
-            case LowCloudTopLevel:
-            case MiddleCloudTopLevel:
-            case HighCloudTopLevel:
-                gridPoint.cloudLayers[level].topLevelTemperature = temperature;
-                break;
-            default:
-                Q_ASSERT(false);
-                break;
-            }
-        }
-    }
-
-    void CWeatherDataGfs::setPressureAtMsl(const g2float *fld)
-    {
-        for (auto &gridPoint : m_gfsWeatherGrid)
-        {
-            gridPoint.pressureAtMsl = fld[gridPoint.fieldPosition];
+        case TCDC:
+        case PRES:
+        case PRATE:
+        case CRAIN:
+        case CSNOW:
+        case TMP: break;
+        default: CLogMessage(this).warning(u"Unexpected parameterValue in Template 4.8: %1 (%2)") << parameterValue.code << parameterValue.name; return false;
         }
-    }
 
-    void CWeatherDataGfs::setSurfaceRain(const g2float *fld)
-    {
-        for (auto &gridPoint : m_gfsWeatherGrid)
-        {
-            gridPoint.surfaceRain = fld[gridPoint.fieldPosition];
-        }
-    }
-
-    void CWeatherDataGfs::setSurfaceSnow(const g2float *fld)
-    {
-        for (auto &gridPoint : m_gfsWeatherGrid)
-        {
-            gridPoint.surfaceSnow = fld[gridPoint.fieldPosition];
-        }
-    }
-
-    void CWeatherDataGfs::setPrecipitationRate(const g2float *fld)
-    {
-        for (auto &gridPoint : m_gfsWeatherGrid)
-        {
-            gridPoint.surfacePrecipitationRate = fld[gridPoint.fieldPosition];
-        }
+        field.code = parameterValue.code;
+        field.productDefinitionTemplate = 8;
+        field.surfaceType = typeFirstFixedSurface;
+        return true;
     }
 
     CTemperature CWeatherDataGfs::calculateDewPoint(const CTemperature &temperature, double relativeHumidity)
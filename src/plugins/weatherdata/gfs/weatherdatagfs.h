@@ -7,6 +7,8 @@
 #define BLACKWXPLUGIN_GFS_H
 
 #include "g2clib/grib2.h"
+#include "gfstilecache.h"
+#include "weatherdatagfsexport.h"
 #include "blackmisc/network/url.h"
 #include "blackmisc/weather/gridpoint.h"
 #include "blackmisc/worker.h"
@@ -19,6 +21,8 @@
 #include <QNetworkReply>
 #include <QNetworkAccessManager>
 #include <QPointer>
+#include <QDateTime>
+#include <QQueue>
 #include <array>
 
 namespace BlackMisc::PhysicalQuantities
@@ -29,12 +33,12 @@ namespace BlackWxPlugin::Gfs
 {
     struct Grib2ParameterKey;
     struct Grib2ParameterValue;
-    struct GfsGridPoint;
+    struct GfsField;
 
     /*!
      * GFS implemenation
      */
-    class CWeatherDataGfs : public BlackCore::IWeatherData
+    class WEATHERDATAGFS_EXPORT CWeatherDataGfs : public BlackCore::IWeatherData
     {
         Q_OBJECT
 
@@ -57,29 +61,90 @@ namespace BlackWxPlugin::Gfs
         //! \copydoc BlackCore::IWeatherData::getWeatherData()
         virtual BlackMisc::Weather::CWeatherGrid getWeatherData() const override;
 
+        //! Tile cache
+        const CGfsTileCache &getTileCache() const { return m_tileCache; }
+
+        //! Use another directory for the tile cache
+        void setTileCacheDirectory(const QString &directory);
+
+        //! Key of the latest published model run and forecast hour, tiles of other keys are expired
+        static QString getCurrentRunKey();
+
+        //! Key of a model run and forecast hour, like "2024051206_f003"
+        static QString getRunKey(const QDateTime &cycle, int forecastHour);
+
     private:
+        //! GFS run, the cycle and the forecast hour
+        struct GfsRun
+        {
+            QDateTime cycle; //!< cycle, UTC
+            int forecastHour = 1; //!< forecast hour
+
+            //! Key of the model run and forecast hour
+            //! \sa CWeatherDataGfs::getRunKey
+            QString getKey() const { return getRunKey(cycle, forecastHour); }
+        };
+
+        //! Request received while fetching
+        struct FetchRequest
+        {
+            QString filePath; //!< empty for the network
+            BlackMisc::Weather::CWeatherGrid grid;
+            BlackMisc::PhysicalQuantities::CLength range;
+        };
+
         //! Asyncronous fetching finished
         //! \threadsafe
         void fetchingWeatherDataFinished();
 
+        //! Start the oldest request received while fetching
+        void fetchNextQueuedRequest();
+
         void parseGfsFile(QNetworkReply *nwReplyPtr);
-        BlackMisc::Network::CUrl getDownloadUrl() const;
+
+        //! Latest published run
+        static GfsRun getCurrentRun();
+
+        //! Download URL of a run, whole world without tile
+        BlackMisc::Network::CUrl getDownloadUrl(const GfsRun &run, const GfsTile *tile = nullptr) const;
+
+        //! Tiles covering the requested grid points and range
+        QVector<GfsTile> getRequiredTiles() const;
+
+        //! Download the tiles missing in the cache, then parse all tiles
+        void fetchTiles();
+
+        //! One tile downloaded
+        void tileDownloaded(const QString &fileName, QNetworkReply *nwReplyPtr);
+
+        //! Start parsing the tiles in background
+        void parseTiles();
+
+        //! Decode the downloaded tiles into the cache and build the weather grid from the cached tiles
+        bool parseTilesImpl(const GfsRun &run, const QVector<GfsTile> &tiles, const QHash<QString, QByteArray> &downloadedTiles);
+
         bool parseGfsFileImpl(const QByteArray &gribData);
+
+        //! Decode all GRIB messages into grid points
+        bool decodeGfsFile(const QByteArray &gribData, QVector<GfsGridPoint> &points);
+
         void findNextGribMessage(unsigned char *buffer, g2int size, g2int iseek, g2int *lskip, g2int *lgrib);
+
+        //! Select the cells in range of the requested grid points, all cells of a tile
         void createWeatherGrid(const gribfield *gfld);
-        void handleProductDefinitionTemplate40(const gribfield *gfld);
-        void handleProductDefinitionTemplate48(const gribfield *gfld);
-        void setTemperature(const g2float *fld, float level);
-        void setHumidity(const g2float *fld, float level);
-        void setWindV(const g2float *fld, float level);
-        void setWindU(const g2float *fld, float level);
-        void setCloudCoverage(const g2float *fld, int level);
-        void setCloudLevel(const g2float *fld, int surfaceType, int level);
-        void setCloudTemperature(const g2float *fld, int surfaceType, int level);
-        void setPressureAtMsl(const g2float *fld);
-        void setSurfaceRain(const g2float *fld);
-        void setSurfaceSnow(const g2float *fld);
-        void setPrecipitationRate(const g2float *fld);
+
+        //! Unpack all fields of a GRIB message and extract the selected cells
+        //! \remark thread safe once the grid is defined
+        QVector<GfsField> decodeGribMessage(unsigned char *readPtr);
+
+        bool handleProductDefinitionTemplate40(const gribfield *gfld, GfsField &field) const;
+        bool handleProductDefinitionTemplate48(const gribfield *gfld, GfsField &field) const;
+
+        //! Grid points from all fields in one pass over the selected cells
+        bool createGfsGridPoints(const QVector<GfsField> &fields, QVector<GfsGridPoint> &points);
+
+        //! Weather grid point from a decoded GFS point
+        BlackMisc::Weather::CGridPoint toWeatherGridPoint(const GfsGridPoint &point);
 
         BlackMisc::PhysicalQuantities::CTemperature calculateDewPoint(const BlackMisc::PhysicalQuantities::CTemperature &temperature, double relativeHumidity);
 
@@ -89,7 +154,23 @@ namespace BlackWxPlugin::Gfs
         mutable QReadWriteLock m_lockData;
         QByteArray m_gribData;
 
-        QVector<GfsGridPoint> m_gfsWeatherGrid;
+        // selected GFS cells, same index as the values of the fields
+        QVector<float> m_gfsLatitudes;
+        QVector<float> m_gfsLongitudes;
+        QVector<int> m_gfsFieldPositions; //!< index in a GRIB field
+        bool m_gfsGridDefined = false;
+        bool m_gfsAllCells = false; //!< select all cells, decoding a tile
+
+        bool m_fetching = false; //!< fetching until fetchingFinished is emitted
+        QQueue<FetchRequest> m_queuedRequests; //!< received while fetching
+
+        // tile cache
+        CGfsTileCache m_tileCache;
+        GfsRun m_tileRun; //!< run of the requested tiles
+        QVector<GfsTile> m_tiles; //!< tiles of the request
+        QHash<QString, QByteArray> m_downloadedTiles; //!< downloaded tiles by file name
+        int m_pendingTileDownloads = 0;
+
         BlackMisc::Weather::CWeatherGrid m_weatherGrid;
 
         QPointer<BlackMisc::CWorker> m_parseGribFileWorker; //!< worker will destroy itself, so weak pointer
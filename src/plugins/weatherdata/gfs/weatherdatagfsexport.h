@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \file
+
+#ifndef BLACKWXPLUGIN_GFS_WEATHERDATAGFSEXPORT_H
+#define BLACKWXPLUGIN_GFS_WEATHERDATAGFSEXPORT_H
+
+#include <QtGlobal>
+
+/*!
+ * \def WEATHERDATAGFS_EXPORT
+ * GFS weather data export macro
+ */
+
+#ifndef WITH_STATIC
+#    if defined(BUILD_WEATHERDATAGFS_LIB)
+#        define WEATHERDATAGFS_EXPORT Q_DECL_EXPORT
+#    else
+#        define WEATHERDATAGFS_EXPORT Q_DECL_IMPORT
+#    endif
+#else
+#    define WEATHERDATAGFS_EXPORT
+#endif
+
+#endif // guard
@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+
+/*!
+ * \file
+ * \ingroup testblackfsd
+ */
+
+#include "../trafficpipeline/trafficpipeline.h"
+#include "blackcore/application.h"
+#include "blackcore/db/databasereaderconfig.h"
+#include "blackcore/webreaderflags.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/registermetadata.h"
+#include "blackmisc/swiftdirectories.h"
+#include "test.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSet>
+#include <QTest>
+#include <QTextStream>
+#include <QTime>
+#include <QtDebug>
+#include <vector>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+using namespace BlackCore;
+using namespace BlackCore::Db;
+
+namespace BlackFsdTest
+{
+    /*!
+     * Replays a recorded FSD log through the traffic pipeline
+     *
+     * The log has the format of the raw FSD message log, only received lines are replayed.
+     * Environment variables:
+     * - SWIFT_FSDREPLAY_FILE log file, default is fsdreplay.log in the test files
+     * - SWIFT_FSDREPLAY_SPEED 1 replays in real time, 0 (default) as fast as possible
+     * - SWIFT_FSDREPLAY_MIN_LINES_PER_SEC fails if the throughput is lower, default no limit
+     * - SWIFT_FSDREPLAY_TIMEOUT_MS time to wait for all aircraft after the replay
+     */
+    class CTestFsdReplay : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Read the log
+        void initTestCase();
+
+        //! Replay the log, report latencies and resources
+        void replay();
+
+    private:
+        //! One received line
+        struct ReplayLine
+        {
+            qint64 offsetMs = 0; //!< since the first line
+            QString line;
+        };
+
+        //! Environment variable as double
+        static double envDouble(const char *name, double defaultValue);
+
+        //! Model set from the FsInn packets, so all aircraft can be matched
+        CAircraftModelList modelSetFromLines() const;
+
+        std::vector<ReplayLine> m_lines;
+        QSet<QString> m_callsigns; //!< callsigns with pilot data updates
+    };
+
+    void CTestFsdReplay::initTestCase()
+    {
+        BlackMisc::registerMetadata();
+
+        const QString file = qEnvironmentVariableIsSet("SWIFT_FSDREPLAY_FILE") ?
+                                 qEnvironmentVariable("SWIFT_FSDREPLAY_FILE") :
+                                 CFileUtils::appendFilePaths(CSwiftDirectories::testFilesDirectory(), "fsdreplay.log");
+        QFile f(file);
+        QVERIFY2(f.open(QIODevice::ReadOnly | QIODevice::Text), qPrintable("Cannot open " + file));
+
+        // "hh:mm:ss.zzz FSD Recv=>line"
+        static const QString recv("FSD Recv=>");
+        QTextStream stream(&f);
+        qint64 firstMs = -1;
+        qint64 lastMs = 0;
+        qint64 dayOffsetMs = 0;
+        while (!stream.atEnd())
+        {
+            const QString raw = stream.readLine().trimmed();
+            const int i = raw.indexOf(recv);
+            if (i < 0) { continue; }
+
+            const QTime time = QTime::fromString(raw.left(i).trimmed(), "hh:mm:ss.zzz");
+            const QString line = raw.mid(i + recv.size());
+            if (!time.isValid() || line.isEmpty()) { continue; }
+
+            qint64 ms = time.msecsSinceStartOfDay() + dayOffsetMs;
+            if (ms + 12 * 3600 * 1000 < lastMs)
+            {
+                // recorded across midnight
+                dayOffsetMs += 24 * 3600 * 1000;
+                ms += 24 * 3600 * 1000;
+            }
+            if (firstMs < 0) { firstMs = ms; }
+            lastMs = ms;
+            m_lines.push_back({ ms - firstMs, line });
+
+            const QString cs = CTrafficPipeline::pilotDataUpdateCallsign(line);
+            if (!cs.isEmpty()) { m_callsigns.insert(cs); }
+        }
+        QVERIFY2(!m_lines.empty(), "No received lines");
+        QVERIFY2(!m_callsigns.isEmpty(), "No pilot data updates");
+    }
+
+    void CTestFsdReplay::replay()
+    {
+        const double speed = envDouble("SWIFT_FSDREPLAY_SPEED", 0);
+        const double minLinesPerSec = envDouble("SWIFT_FSDREPLAY_MIN_LINES_PER_SEC", 0);
+        const int timeoutMs = qRound(envDouble("SWIFT_FSDREPLAY_TIMEOUT_MS", 30000));
+
+        CTrafficPipeline pipeline(this->modelSetFromLines());
+        QVERIFY2(pipeline.connectToLoopback(5000), "Cannot connect to loopback server");
+
+        QElapsedTimer timer;
+        timer.start();
+        int count = 0;
+        for (const ReplayLine &line : std::as_const(m_lines))
+        {
+            if (speed > 0)
+            {
+                const qint64 dueMs = qRound64(line.offsetMs / speed);
+                const qint64 waitMs = dueMs - timer.elapsed();
+                if (waitMs > 0) { QTest::qWait(static_cast<int>(waitMs)); }
+            }
+            else if (++count % 25 == 0)
+            {
+                QCoreApplication::processEvents();
+            }
+            pipeline.sendLine(line.line);
+        }
+        const qint64 sendMs = qMax(1LL, timer.elapsed());
+
+        const bool all = pipeline.waitForAircraft(m_callsigns.size(), timeoutMs);
+        const qint64 totalMs = qMax(1LL, timer.elapsed());
+        pipeline.disconnectFromLoopback();
+
+        const double linesPerSec = pipeline.getSentLines() * 1000.0 / totalMs;
+        qDebug().noquote() << "replayed" << pipeline.getSentLines() << "lines in" << sendMs << "ms, all aircraft after" << totalMs << "ms,"
+                           << qRound(linesPerSec) << "lines/s, speed" << (speed > 0 ? QString::number(speed) + "x" : QStringLiteral("max"));
+        qDebug().noquote() << pipeline.getReport();
+
+        QVERIFY2(all, qPrintable(QStringLiteral("Expect %1 aircraft in range and matched, got %2 and %3").arg(m_callsigns.size()).arg(pipeline.getAircraftInRangeCount()).arg(pipeline.getMatchedCount())));
+        QVERIFY2(pipeline.getHistogram(CTrafficPipeline::StageFsd).count() > 0, "Expect FSD latencies");
+        QVERIFY2(pipeline.getHistogram(CTrafficPipeline::StageServerToAirspace).count() > 0, "Expect server to airspace latencies");
+        QVERIFY2(pipeline.getHistogram(CTrafficPipeline::StageMatching).count() >= m_callsigns.size(), "Expect matching for all aircraft");
+        if (minLinesPerSec > 0) { QVERIFY2(linesPerSec >= minLinesPerSec, "Throughput below SWIFT_FSDREPLAY_MIN_LINES_PER_SEC"); }
+    }
+
+    double CTestFsdReplay::envDouble(const char *name, double defaultValue)
+    {
+        bool ok = false;
+        const double v = qEnvironmentVariable(name).toDouble(&ok);
+        return ok ? v : defaultValue;
+    }
+
+    CAircraftModelList CTestFsdReplay::modelSetFromLines() const
+    {
+        // #SBcallsign:receiver:FSIPI:0:airline:aircraft:...:model
+        CAircraftModelList models;
+        QSet<QString> modelStrings;
+        for (const ReplayLine &line : m_lines)
+        {
+            if (!line.line.startsWith(QLatin1String("#SB"))) { continue; }
+            const QStringList tokens = line.line.split(':');
+            if (tokens.size() < 12 || tokens[2] != QLatin1String("FSIPI")) { continue; }
+
+            const QString airline = tokens[4];
+            const QString aircraft = tokens[5];
+            const QString modelString = tokens[11].isEmpty() ? aircraft + " " + airline : tokens[11];
+            if (aircraft.isEmpty() || modelStrings.contains(modelString)) { continue; }
+            modelStrings.insert(modelString);
+
+            models.push_back(CTrafficPipeline::createModel(modelString, aircraft, airline));
+        }
+        return models;
+    }
+} // ns
+
+//! main
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    BLACKTEST_INIT(BlackFsdTest::CTestFsdReplay)
+    CApplication a(CApplicationInfo::UnitTest);
+    const bool setup = a.parseCommandLineArgsAndLoadSetup();
+    if (!setup) { qWarning() << "No setup loaded"; }
+    int r = EXIT_FAILURE;
+    if (a.start())
+    {
+        // the airspace monitor needs the web data services, no readers are started
+        a.initAndStartWebDataServices(CWebReaderFlags::None, CDatabaseReaderConfigList::forPilotClient());
+        r = QTest::qExec(&to, args);
+    }
+    a.gracefulShutdown();
+    return r;
+}
+
+#include "testfsdreplay.moc"
+
+//! \endcond
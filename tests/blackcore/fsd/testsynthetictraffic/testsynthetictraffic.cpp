@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+
+/*!
+ * \file
+ * \ingroup testblackfsd
+ */
+
+#include "../trafficpipeline/synthetictraffic.h"
+#include "../trafficpipeline/trafficpipeline.h"
+#include "blackcore/application.h"
+#include "blackcore/db/databasereaderconfig.h"
+#include "blackcore/webreaderflags.h"
+#include "blackmisc/registermetadata.h"
+#include "test.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTest>
+#include <QtDebug>
+
+using namespace BlackMisc;
+using namespace BlackCore;
+using namespace BlackCore::Db;
+
+namespace BlackFsdTest
+{
+    /*!
+     * Synthetic traffic through the traffic pipeline
+     *
+     * A small count by default, so the test is quick in a normal test run.
+     * For the scale sweep run it like SWIFT_SYNTHETIC_AIRCRAFT=100,500,1000,2000.
+     *
+     * Environment variables:
+     * - SWIFT_SYNTHETIC_AIRCRAFT comma separated aircraft counts, default 20
+     * - SWIFT_SYNTHETIC_DURATION_MS traffic after all aircraft are matched, default 5000
+     * - SWIFT_SYNTHETIC_TIMEOUT_MS time to wait for all aircraft, default 60000
+     * - SWIFT_SYNTHETIC_SEED seed of the traffic, default 1
+     */
+    class CTestSyntheticTraffic : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Init
+        void initTestCase();
+
+        //! Aircraft counts
+        void scale_data();
+
+        //! Run traffic, report latencies and the frame budget
+        void scale();
+
+        //! Summary of all counts
+        void cleanupTestCase();
+
+    private:
+        //! Environment variable as int
+        static int envInt(const char *name, int defaultValue);
+
+        QStringList m_summary;
+    };
+
+    void CTestSyntheticTraffic::initTestCase()
+    {
+        BlackMisc::registerMetadata();
+    }
+
+    void CTestSyntheticTraffic::scale_data()
+    {
+        QTest::addColumn<int>("aircraft");
+        const QString counts = qEnvironmentVariable("SWIFT_SYNTHETIC_AIRCRAFT", "20");
+        for (const QString &count : counts.split(',', Qt::SkipEmptyParts))
+        {
+            bool ok = false;
+            const int aircraft = count.trimmed().toInt(&ok);
+            if (!ok || aircraft < 1) { continue; }
+            QTest::newRow(qPrintable(QStringLiteral("%1 aircraft").arg(aircraft))) << aircraft;
+        }
+    }
+
+    void CTestSyntheticTraffic::scale()
+    {
+        QFETCH(int, aircraft);
+        const int durationMs = envInt("SWIFT_SYNTHETIC_DURATION_MS", 5000);
+        const int timeoutMs = envInt("SWIFT_SYNTHETIC_TIMEOUT_MS", 60000);
+
+        CSyntheticTrafficSetup setup;
+        setup.aircraftCount = aircraft;
+        setup.seed = static_cast<quint32>(envInt("SWIFT_SYNTHETIC_SEED", 1));
+
+        CTrafficPipeline pipeline(CSyntheticTraffic::getModelSet());
+        QVERIFY2(pipeline.connectToLoopback(5000), "Cannot connect to loopback server");
+        CSyntheticTraffic traffic(setup, &pipeline);
+
+        QElapsedTimer timer;
+        timer.start();
+        traffic.start();
+        const bool all = pipeline.waitForAircraft(aircraft, timeoutMs);
+        const qint64 allMs = timer.elapsed();
+        if (all) { QTest::qWait(durationMs); }
+        traffic.stop();
+        pipeline.disconnectFromLoopback();
+
+        // one frame should fit into 60 fps
+        const CLatencyHistogram &frames = pipeline.getHistogram(CTrafficPipeline::StageFrame);
+        const CLatencyHistogram &serverToAirspace = pipeline.getHistogram(CTrafficPipeline::StageServerToAirspace);
+        const bool frameBudget = frames.percentileUs(99) <= 16667;
+        qDebug().noquote() << traffic.getReport();
+        qDebug().noquote() << pipeline.getReport();
+        m_summary << QStringLiteral("%1 aircraft: all matched after %2ms, server to airspace p99 <%3us, frame p99 <%4us max %5us%6")
+                         .arg(aircraft)
+                         .arg(all ? QString::number(allMs) : QStringLiteral("timeout"))
+                         .arg(serverToAirspace.percentileUs(99))
+                         .arg(frames.percentileUs(99))
+                         .arg(qRound(frames.maxUs()))
+                         .arg(frameBudget ? QString() : QStringLiteral(" (frame budget exceeded)"));
+
+        QVERIFY2(all, qPrintable(QStringLiteral("Expect %1 aircraft in range and matched, got %2 and %3").arg(aircraft).arg(pipeline.getAircraftInRangeCount()).arg(pipeline.getMatchedCount())));
+        QVERIFY2(traffic.getAnsweredQueries() > 0, "Expect queries of the client");
+        QVERIFY2(pipeline.getStoredParts() > 0, "Expect aircraft config");
+        QVERIFY2(serverToAirspace.count() > 0, "Expect server to airspace latencies");
+    }
+
+    void CTestSyntheticTraffic::cleanupTestCase()
+    {
+        for (const QString &line : std::as_const(m_summary)) { qDebug().noquote() << line; }
+    }
+
+    int CTestSyntheticTraffic::envInt(const char *name, int defaultValue)
+    {
+        bool ok = false;
+        const int v = qEnvironmentVariableIntValue(name, &ok);
+        return ok ? v : defaultValue;
+    }
+} // ns
+
+//! main
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    BLACKTEST_INIT(BlackFsdTest::CTestSyntheticTraffic)
+    CApplication a(CApplicationInfo::UnitTest);
+    const bool setup = a.parseCommandLineArgsAndLoadSetup();
+    if (!setup) { qWarning() << "No setup loaded"; }
+    int r = EXIT_FAILURE;
+    if (a.start())
+    {
+        // the airspace monitor needs the web data services, no readers are started
+        a.initAndStartWebDataServices(CWebReaderFlags::None, CDatabaseReaderConfigList::forPilotClient());
+        r = QTest::qExec(&to, args);
+    }
+    a.gracefulShutdown();
+    return r;
+}
+
+#include "testsynthetictraffic.moc"
+
+//! \endcond
@@ -0,0 +1,348 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+
+#include "synthetictraffic.h"
+#include "trafficpipeline.h"
+#include "blackcore/fsd/clientquery.h"
+#include "blackcore/fsd/clientresponse.h"
+#include "blackcore/fsd/enums.h"
+#include "blackcore/fsd/messagebase.h"
+#include "blackcore/fsd/pilotdataupdate.h"
+#include "blackcore/fsd/planeinformation.h"
+#include "blackcore/fsd/planeinformationfsinn.h"
+#include "blackcore/fsd/visualpilotdataperiodic.h"
+#include "blackcore/fsd/visualpilotdataupdate.h"
+#include "blackmisc/aviation/aircraftenginelist.h"
+#include "blackmisc/aviation/aircraftlights.h"
+#include "blackmisc/aviation/transponder.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringBuilder>
+#include <QStringList>
+#include <QtMath>
+#include <cmath>
+#include <random>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+using namespace BlackCore::Fsd;
+
+namespace BlackFsdTest
+{
+    namespace
+    {
+        //! \private aircraft type flown by the virtual pilots
+        struct AircraftType
+        {
+            const char *aircraft;
+            const char *airline;
+            const char *combined;
+        };
+
+        //! \private all types, the model string is "aircraft airline"
+        const std::array<AircraftType, 12> &aircraftTypes()
+        {
+            static const std::array<AircraftType, 12> types { { { "A320", "DLH", "L2J" },
+                                                                { "A321", "DLH", "L2J" },
+                                                                { "A319", "EWG", "L2J" },
+                                                                { "B738", "RYR", "L2J" },
+                                                                { "A20N", "EZY", "L2J" },
+                                                                { "B77W", "UAE", "L2J" },
+                                                                { "B744", "BAW", "L4J" },
+                                                                { "A388", "UAE", "L4J" },
+                                                                { "E190", "KLM", "L2J" },
+                                                                { "CRJ9", "DLH", "L2J" },
+                                                                { "B789", "AAL", "L2J" },
+                                                                { "C172", "", "L1P" } } };
+            return types;
+        }
+
+        //! \private model string of a type
+        QString modelString(const AircraftType &type)
+        {
+            const QString aircraft = QString::fromLatin1(type.aircraft);
+            return type.airline[0] ? QString(aircraft % u" " % QString::fromLatin1(type.airline)) : aircraft;
+        }
+
+        //! \private FSD string without the line delimiter
+        template <class T>
+        QString fsdLine(const T &message)
+        {
+            QString line = messageToFSDString(message);
+            line.chop(2);
+            return line;
+        }
+
+        //! \private feet per minute per knot on a 3 degree slope
+        constexpr double FpmPerKtsSlope = 5.3;
+
+        //! \private cruise altitude
+        constexpr double CruiseFt = 38000;
+    }
+
+    CSyntheticTraffic::CSyntheticTraffic(const CSyntheticTrafficSetup &setup, CTrafficPipeline *pipeline, QObject *parent)
+        : QObject(parent), m_setup(setup), m_pipeline(pipeline)
+    {
+        Q_ASSERT_X(pipeline, Q_FUNC_INFO, "Missing pipeline");
+        std::mt19937 rng(setup.seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        const int types = static_cast<int>(aircraftTypes().size());
+        const double cosLat = std::cos(qDegreesToRadians(setup.latitudeDeg));
+
+        m_pilots.reserve(static_cast<size_t>(qMax(0, setup.aircraftCount)));
+        for (int i = 0; i < setup.aircraftCount; ++i)
+        {
+            VirtualPilot pilot;
+            pilot.type = i % types;
+            const AircraftType &type = aircraftTypes()[static_cast<size_t>(pilot.type)];
+            pilot.callsign = (type.airline[0] ? QString::fromLatin1(type.airline) : QStringLiteral("DE")) % QString::number(100 + i);
+            pilot.transponderCode = QString::number(01000 + i % 06000, 8).toInt();
+            pilot.onGround = uniform(rng) < setup.onGroundRatio;
+
+            // denser near the airport
+            const double u = uniform(rng);
+            const double distanceNM = pilot.onGround ? 2.0 * u : 2.0 + (setup.radiusNM - 2.0) * u * u;
+            const double bearingRad = qDegreesToRadians(360.0 * uniform(rng));
+            pilot.latitudeDeg = setup.latitudeDeg + distanceNM / 60.0 * std::cos(bearingRad);
+            pilot.longitudeDeg = setup.longitudeDeg + distanceNM / 60.0 * std::sin(bearingRad) / cosLat;
+
+            if (pilot.onGround)
+            {
+                pilot.altitudeFt = setup.elevationFt;
+                pilot.headingDeg = 360.0 * uniform(rng);
+                pilot.groundSpeedKts = uniform(rng) < 0.5 ? 0.0 : 15.0;
+            }
+            else
+            {
+                // inbound on the slope or outbound climbing
+                const bool inbound = uniform(rng) < 0.5;
+                const double bearingDeg = qRadiansToDegrees(bearingRad);
+                pilot.headingDeg = std::fmod((inbound ? bearingDeg + 180.0 : bearingDeg) + 40.0 * (uniform(rng) - 0.5) + 360.0, 360.0);
+                pilot.altitudeFt = setup.elevationFt + qMin(CruiseFt, distanceNM * 318.0) + 500.0 * uniform(rng);
+                pilot.groundSpeedKts = qMin(460.0, 160.0 + distanceNM * 6.0);
+                pilot.verticalSpeedFpm = pilot.altitudeFt >= CruiseFt ? 0.0 : (inbound ? -1.0 : 1.0) * pilot.groundSpeedKts * FpmPerKtsSlope;
+            }
+
+            // not all pilots in the same ms
+            pilot.nextPositionMs = static_cast<qint64>(uniform(rng) * setup.positionIntervalMs);
+            pilot.nextVisualMs = static_cast<qint64>(uniform(rng) * setup.visualIntervalMs);
+            pilot.nextPartsMs = pilot.nextPositionMs + static_cast<qint64>(uniform(rng) * setup.partsIntervalMs);
+
+            m_pilotIndex.insert(pilot.callsign, i);
+            m_pilots.push_back(pilot);
+        }
+
+        m_timer.setInterval(20);
+        m_timer.setObjectName("CSyntheticTraffic::m_timer");
+        connect(&m_timer, &QTimer::timeout, this, &CSyntheticTraffic::tick);
+        connect(m_pipeline, &CTrafficPipeline::clientLineReceived, this, &CSyntheticTraffic::onClientLine);
+    }
+
+    void CSyntheticTraffic::start()
+    {
+        m_clock.start();
+        m_lastTickMs = 0;
+        m_timer.start();
+    }
+
+    void CSyntheticTraffic::stop()
+    {
+        m_timer.stop();
+    }
+
+    CAircraftModelList CSyntheticTraffic::getModelSet()
+    {
+        CAircraftModelList models;
+        for (const AircraftType &type : aircraftTypes())
+        {
+            models.push_back(CTrafficPipeline::createModel(modelString(type), type.aircraft, type.airline));
+        }
+        return models;
+    }
+
+    QString CSyntheticTraffic::getReport() const
+    {
+        return u"aircraft: " % QString::number(m_pilots.size()) %
+               u" lines: " % QString::number(m_sentLines) %
+               u" @: " % QString::number(m_packets[PacketPilotData]) %
+               u" ^: " % QString::number(m_packets[PacketVisual]) %
+               u" #SL: " % QString::number(m_packets[PacketVisualPeriodic]) %
+               u" ACC: " % QString::number(m_packets[PacketAircraftConfig]) %
+               u" PI: " % QString::number(m_packets[PacketPlaneInfo]) %
+               u" FSIPI: " % QString::number(m_packets[PacketFsinn]) %
+               u" $CR: " % QString::number(m_packets[PacketClientResponse]) %
+               u" answered queries: " % QString::number(m_answeredQueries) %
+               u" generator cpu: " % QString::number(m_cpuNs / 1000000.0, 'f', 1) % u"ms";
+    }
+
+    void CSyntheticTraffic::tick()
+    {
+        const qint64 cpu = CTrafficPipeline::threadCpuNs();
+        const qint64 nowMs = m_clock.elapsed();
+        const double seconds = (nowMs - m_lastTickMs) / 1000.0;
+        m_lastTickMs = nowMs;
+
+        for (VirtualPilot &pilot : m_pilots)
+        {
+            this->move(pilot, seconds);
+            if (nowMs >= pilot.nextPositionMs)
+            {
+                pilot.nextPositionMs += m_setup.positionIntervalMs;
+                this->sendPilotDataUpdate(pilot);
+
+                // like a client announcing itself once it is online
+                if (!pilot.announced && m_setup.announcePlaneInfo)
+                {
+                    pilot.announced = true;
+                    const QString own = CTrafficPipeline::ownCallsign().asString();
+                    this->sendPlaneInformation(pilot, own);
+                    this->sendPlaneInformationFsinn(pilot, own);
+                }
+            }
+            if (nowMs >= pilot.nextVisualMs)
+            {
+                pilot.nextVisualMs += m_setup.visualIntervalMs;
+                if (this->distanceNM(pilot) <= m_setup.visualRangeNM) { this->sendVisualPilotDataUpdate(pilot); }
+            }
+            if (nowMs >= pilot.nextPartsMs)
+            {
+                pilot.nextPartsMs += m_setup.partsIntervalMs;
+                this->sendAircraftConfig(pilot, QStringLiteral("@94836"));
+            }
+        }
+
+        if (cpu >= 0) { m_cpuNs += CTrafficPipeline::threadCpuNs() - cpu; }
+    }
+
+    void CSyntheticTraffic::onClientLine(const QString &line)
+    {
+        // #SBown:callsign:PIR, #SBown:callsign:FSIPIR:..., $CQown:callsign:CAPS, ...
+        const bool planeInfo = line.startsWith(QLatin1String("#SB"));
+        if (!planeInfo && !line.startsWith(QLatin1String("$CQ"))) { return; }
+        const QStringList tokens = line.mid(3).split(':');
+        if (tokens.size() < 3) { return; }
+        const auto it = m_pilotIndex.constFind(tokens[1]);
+        if (it == m_pilotIndex.cend()) { return; }
+
+        const qint64 cpu = CTrafficPipeline::threadCpuNs();
+        const VirtualPilot &pilot = m_pilots[static_cast<size_t>(it.value())];
+        const QString &requester = tokens[0];
+        const QString &query = tokens[2];
+        bool answered = true;
+        if (planeInfo && query == QLatin1String("PIR")) { this->sendPlaneInformation(pilot, requester); }
+        else if (planeInfo && query == QLatin1String("FSIPIR")) { this->sendPlaneInformationFsinn(pilot, requester); }
+        else if (!planeInfo && query == QLatin1String("ACC")) { this->sendAircraftConfig(pilot, requester); }
+        else if (!planeInfo && query == QLatin1String("CAPS"))
+        {
+            static const QStringList caps { "ATCINFO=1", "MODELDESC=1", "ACCONFIG=1", "VISUPDATE=1" };
+            this->send(fsdLine(ClientResponse(pilot.callsign, requester, ClientQueryType::Capabilities, caps)), PacketClientResponse);
+        }
+        else if (!planeInfo && query == QLatin1String("RN"))
+        {
+            this->send(fsdLine(ClientResponse(pilot.callsign, requester, ClientQueryType::RealName, { u"Virtual Pilot " % pilot.callsign, QString(), QStringLiteral("1") })), PacketClientResponse);
+        }
+        else { answered = false; }
+
+        if (answered) { m_answeredQueries++; }
+        if (cpu >= 0) { m_cpuNs += CTrafficPipeline::threadCpuNs() - cpu; }
+    }
+
+    void CSyntheticTraffic::move(VirtualPilot &pilot, double seconds) const
+    {
+        const double movedNM = pilot.groundSpeedKts * seconds / 3600.0;
+        const double headingRad = qDegreesToRadians(pilot.headingDeg);
+        pilot.latitudeDeg += movedNM / 60.0 * std::cos(headingRad);
+        pilot.longitudeDeg += movedNM / 60.0 * std::sin(headingRad) / std::cos(qDegreesToRadians(pilot.latitudeDeg));
+
+        const double distanceNM = this->distanceNM(pilot);
+        if (pilot.onGround)
+        {
+            // taxi around the airport
+            if (distanceNM > 2.0) { pilot.headingDeg = std::fmod(pilot.headingDeg + 180.0, 360.0); }
+            return;
+        }
+
+        pilot.altitudeFt = qMin(CruiseFt, pilot.altitudeFt + pilot.verticalSpeedFpm * seconds / 60.0);
+        if (pilot.altitudeFt >= CruiseFt) { pilot.verticalSpeedFpm = 0; }
+        const bool goAround = pilot.verticalSpeedFpm < 0 && (distanceNM < 2.0 || pilot.altitudeFt < m_setup.elevationFt + 500.0);
+        const bool leaving = distanceNM > m_setup.radiusNM;
+        if (goAround || leaving)
+        {
+            // turn around, so the traffic stays in the area
+            pilot.headingDeg = std::fmod(pilot.headingDeg + 180.0, 360.0);
+            pilot.verticalSpeedFpm = (goAround ? 1.0 : -1.0) * pilot.groundSpeedKts * FpmPerKtsSlope;
+        }
+    }
+
+    double CSyntheticTraffic::distanceNM(const VirtualPilot &pilot) const
+    {
+        const double dLatNM = (pilot.latitudeDeg - m_setup.latitudeDeg) * 60.0;
+        const double dLngNM = (pilot.longitudeDeg - m_setup.longitudeDeg) * 60.0 * std::cos(qDegreesToRadians(m_setup.latitudeDeg));
+        return std::hypot(dLatNM, dLngNM);
+    }
+
+    CAircraftParts CSyntheticTraffic::parts(const VirtualPilot &pilot) const
+    {
+        const double distanceNM = this->distanceNM(pilot);
+        const bool moving = pilot.groundSpeedKts > 0;
+        const bool low = pilot.altitudeFt < 10000;
+        const bool approach = !pilot.onGround && distanceNM < 10.0;
+        const int flaps = pilot.onGround ? (moving ? 20 : 0) : (approach ? 60 : (distanceNM < 20.0 ? 20 : 0));
+        const CAircraftLights lights(!pilot.onGround, low && !pilot.onGround, pilot.onGround && moving, true, true, low);
+        return CAircraftParts(lights, pilot.onGround || approach, flaps, false, CAircraftEngineList({ true, true }), pilot.onGround);
+    }
+
+    void CSyntheticTraffic::sendPilotDataUpdate(const VirtualPilot &pilot)
+    {
+        const int altitude = qRound(pilot.altitudeFt);
+        const double pitch = pilot.verticalSpeedFpm > 0 ? 6.0 : (pilot.verticalSpeedFpm < 0 ? -1.0 : 1.0);
+        const PilotDataUpdate update(CTransponder::ModeC, pilot.callsign, pilot.transponderCode, PilotRating::Student,
+                                     pilot.latitudeDeg, pilot.longitudeDeg, altitude, altitude, qRound(pilot.groundSpeedKts),
+                                     pitch, 0.0, pilot.headingDeg, pilot.onGround);
+        this->send(fsdLine(update), PacketPilotData);
+    }
+
+    void CSyntheticTraffic::sendVisualPilotDataUpdate(VirtualPilot &pilot)
+    {
+        // velocities in m/s, x east, y up, z north
+        const double gsMps = pilot.groundSpeedKts * 0.514444;
+        const double headingRad = qDegreesToRadians(pilot.headingDeg);
+        const VisualPilotDataUpdate update(pilot.callsign, pilot.latitudeDeg, pilot.longitudeDeg, pilot.altitudeFt, pilot.altitudeFt - m_setup.elevationFt,
+                                           0.0, 0.0, pilot.headingDeg, gsMps * std::sin(headingRad), pilot.verticalSpeedFpm * 0.00508, gsMps * std::cos(headingRad),
+                                           0.0, 0.0, 0.0);
+        if (pilot.visualCount++ % 25 == 0) { this->send(fsdLine(update.toPeriodic()), PacketVisualPeriodic); }
+        else { this->send(fsdLine(update), PacketVisual); }
+    }
+
+    void CSyntheticTraffic::sendAircraftConfig(const VirtualPilot &pilot, const QString &receiver)
+    {
+        // always full data, clients send incremental configs in between
+        const QString json = QJsonDocument(QJsonObject { { "config", this->parts(pilot).toFullJson() } }).toJson(QJsonDocument::Compact);
+        this->send(fsdLine(ClientQuery(pilot.callsign, receiver, ClientQueryType::AircraftConfig, { json })), PacketAircraftConfig);
+    }
+
+    void CSyntheticTraffic::sendPlaneInformation(const VirtualPilot &pilot, const QString &receiver)
+    {
+        const AircraftType &type = aircraftTypes()[static_cast<size_t>(pilot.type)];
+        this->send(fsdLine(PlaneInformation(pilot.callsign, receiver, type.aircraft, type.airline, QString())), PacketPlaneInfo);
+    }
+
+    void CSyntheticTraffic::sendPlaneInformationFsinn(const VirtualPilot &pilot, const QString &receiver)
+    {
+        const AircraftType &type = aircraftTypes()[static_cast<size_t>(pilot.type)];
+        this->send(fsdLine(PlaneInformationFsinn(pilot.callsign, receiver, type.airline, type.aircraft, type.combined, modelString(type))), PacketFsinn);
+    }
+
+    void CSyntheticTraffic::send(const QString &fsdString, int packet)
+    {
+        if (fsdString.isEmpty()) { return; }
+        m_pipeline->sendLine(fsdString);
+        m_packets[static_cast<size_t>(packet)]++;
+        m_sentLines++;
+    }
+} // ns
+
+//! \endcond
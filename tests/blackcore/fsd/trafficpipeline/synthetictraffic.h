@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+
+/*!
+ * \file
+ * \ingroup testblackfsd
+ */
+
+#ifndef BLACKFSDTEST_SYNTHETICTRAFFIC_H
+#define BLACKFSDTEST_SYNTHETICTRAFFIC_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/aviation/aircraftparts.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <array>
+#include <vector>
+
+namespace BlackFsdTest
+{
+    class CTrafficPipeline;
+
+    //! Setup of the synthetic traffic, times in ms
+    struct CSyntheticTrafficSetup
+    {
+        int aircraftCount = 100; //!< virtual pilots
+        double latitudeDeg = 50.0333; //!< airport, default EDDF
+        double longitudeDeg = 8.5706; //!< airport, default EDDF
+        int elevationFt = 364; //!< airport elevation
+        double radiusNM = 60; //!< aircraft are spread in this radius, denser near the airport
+        double onGroundRatio = 0.2; //!< ratio of aircraft on ground within 2NM
+        double visualRangeNM = 5; //!< aircraft closer to the airport also send visual updates
+        int positionIntervalMs = 5000; //!< '@' pilot data updates
+        int visualIntervalMs = 200; //!< '^' visual updates, every 25th as '#SL' like the FSD client
+        int partsIntervalMs = 10000; //!< '$CQ' ACC aircraft config
+        bool announcePlaneInfo = true; //!< send ICAO and FsInn plane info after the first position, not only on request
+        quint32 seed = 1; //!< same seed, same traffic
+    };
+
+    /*!
+     * Synthetic FSD traffic of virtual pilots around an airport, sent by the server of a CTrafficPipeline.
+     *
+     * The lines are serialised with the FSD message classes. Plane info, FsInn, capabilities, real name
+     * and aircraft config queries of the client are answered. Movement is deterministic for a seed.
+     */
+    class CSyntheticTraffic : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        //! Constructor
+        CSyntheticTraffic(const CSyntheticTrafficSetup &setup, CTrafficPipeline *pipeline, QObject *parent = nullptr);
+
+        //! Start sending
+        void start();
+
+        //! Stop sending
+        void stop();
+
+        //! Model set with all aircraft types of the virtual pilots
+        static BlackMisc::Simulation::CAircraftModelList getModelSet();
+
+        //! Lines sent
+        qint64 getSentLines() const { return m_sentLines; }
+
+        //! Queries answered
+        qint64 getAnsweredQueries() const { return m_answeredQueries; }
+
+        //! Lines per packet type and generator CPU time
+        QString getReport() const;
+
+    private:
+        //! One virtual pilot
+        struct VirtualPilot
+        {
+            QString callsign;
+            int type = 0; //!< index in the types
+            double latitudeDeg = 0;
+            double longitudeDeg = 0;
+            double altitudeFt = 0;
+            double headingDeg = 0;
+            double groundSpeedKts = 0;
+            double verticalSpeedFpm = 0;
+            bool onGround = false;
+            bool announced = false;
+            int transponderCode = 2000;
+            int visualCount = 0;
+            qint64 nextPositionMs = 0;
+            qint64 nextVisualMs = 0;
+            qint64 nextPartsMs = 0;
+        };
+
+        //! Send due updates
+        void tick();
+
+        //! Answer a query of the client
+        void onClientLine(const QString &line);
+
+        //! Move the pilot
+        void move(VirtualPilot &pilot, double seconds) const;
+
+        //! Distance to the airport in NM
+        double distanceNM(const VirtualPilot &pilot) const;
+
+        //! Parts for the phase of flight
+        BlackMisc::Aviation::CAircraftParts parts(const VirtualPilot &pilot) const;
+
+        //! @{
+        //! Send a packet
+        void sendPilotDataUpdate(const VirtualPilot &pilot);
+        void sendVisualPilotDataUpdate(VirtualPilot &pilot);
+        void sendAircraftConfig(const VirtualPilot &pilot, const QString &receiver);
+        void sendPlaneInformation(const VirtualPilot &pilot, const QString &receiver);
+        void sendPlaneInformationFsinn(const VirtualPilot &pilot, const QString &receiver);
+        void send(const QString &fsdString, int packet);
+        //! @}
+
+        //! Packet types for the statistics
+        enum Packet
+        {
+            PacketPilotData,
+            PacketVisual,
+            PacketVisualPeriodic,
+            PacketAircraftConfig,
+            PacketPlaneInfo,
+            PacketFsinn,
+            PacketClientResponse,
+            PacketCount
+        };
+
+        CSyntheticTrafficSetup m_setup;
+        CTrafficPipeline *m_pipeline = nullptr;
+        std::vector<VirtualPilot> m_pilots;
+        QHash<QString, int> m_pilotIndex; //!< callsign, index in m_pilots
+        QTimer m_timer;
+        QElapsedTimer m_clock;
+        qint64 m_lastTickMs = 0;
+        qint64 m_sentLines = 0;
+        qint64 m_answeredQueries = 0;
+        qint64 m_cpuNs = 0;
+        std::array<qint64, PacketCount> m_packets {};
+    };
+} // ns
+
+#endif // guard
+
+//! \endcond
@@ -0,0 +1,514 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+
+#include "trafficpipeline.h"
+#include "blackcore/fsd/fsdclient.h"
+#include "blackcore/aircraftmatcher.h"
+#include "blackcore/airspacemonitor.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/interpolationrenderingsetup.h"
+#include "blackmisc/simulation/ownaircraftproviderdummy.h"
+#include "blackmisc/simulation/simulatorinfo.h"
+#include "blackmisc/simulation/matchinglog.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/aircraftparts.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/aviation/livery.h"
+#include "blackmisc/aviation/transponder.h"
+#include "blackmisc/identifier.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/network/ecosystem.h"
+#include "blackmisc/network/fsdsetup.h"
+#include "blackmisc/network/loginmode.h"
+#include "blackmisc/network/server.h"
+#include "blackmisc/network/user.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QHostAddress>
+#include <QMutexLocker>
+#include <QStringBuilder>
+#include <QTest>
+#include <QtGlobal>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+
+#ifdef Q_OS_UNIX
+#    include <sys/resource.h>
+#    include <time.h>
+#endif
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::Network;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+using namespace BlackCore;
+using namespace BlackCore::Fsd;
+
+namespace
+{
+    //! \private allocations of the process
+    std::atomic<qint64> g_allocations { 0 };
+
+    //! \private allocations of the thread
+    thread_local qint64 t_allocations = 0;
+
+    //! \private counting allocation
+    void *countedAlloc(std::size_t size)
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        t_allocations++;
+        if (void *p = std::malloc(size ? size : 1)) { return p; }
+        throw std::bad_alloc();
+    }
+}
+
+//! \private replaced for the allocation counts, aligned and nothrow variants forward to those
+void *operator new(std::size_t size) { return countedAlloc(size); }
+
+//! \private replaced for the allocation counts
+void *operator new[](std::size_t size) { return countedAlloc(size); }
+
+//! \private replaced for the allocation counts
+void operator delete(void *p) noexcept { std::free(p); }
+
+//! \private replaced for the allocation counts
+void operator delete[](void *p) noexcept { std::free(p); }
+
+//! \private replaced for the allocation counts
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+//! \private replaced for the allocation counts
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+namespace BlackFsdTest
+{
+    void CLatencyHistogram::add(qint64 ns)
+    {
+        ns = qMax(0LL, ns);
+        const qint64 us = ns / 1000;
+        int bucket = 0;
+        while (bucket < Buckets - 1 && (Q_INT64_C(1) << bucket) <= us) { bucket++; }
+        m_buckets[static_cast<size_t>(bucket)]++;
+        m_count++;
+        m_sumNs += ns;
+        m_maxNs = qMax(m_maxNs, ns);
+    }
+
+    qint64 CLatencyHistogram::percentileUs(double percent) const
+    {
+        if (m_count < 1) { return 0; }
+        const qint64 rank = qMax(1LL, static_cast<qint64>(std::ceil(m_count * percent / 100.0)));
+        qint64 sum = 0;
+        for (int bucket = 0; bucket < Buckets; ++bucket)
+        {
+            sum += m_buckets[static_cast<size_t>(bucket)];
+            if (sum >= rank) { return Q_INT64_C(1) << bucket; }
+        }
+        return Q_INT64_C(1) << (Buckets - 1);
+    }
+
+    QString CLatencyHistogram::toQString() const
+    {
+        QString buckets;
+        for (int bucket = 0; bucket < Buckets; ++bucket)
+        {
+            const qint64 c = m_buckets[static_cast<size_t>(bucket)];
+            if (c < 1) { continue; }
+            buckets += u" <" % QString::number(Q_INT64_C(1) << bucket) % u"us:" % QString::number(c);
+        }
+        return u"n: " % QString::number(m_count) %
+               u" mean: " % QString::number(this->meanUs(), 'f', 1) %
+               u"us p50: <" % QString::number(this->percentileUs(50)) %
+               u"us p99: <" % QString::number(this->percentileUs(99)) %
+               u"us max: " % QString::number(this->maxUs(), 'f', 1) % u"us |" % buckets;
+    }
+
+    CFsdLoopbackServer::CFsdLoopbackServer(QObject *parent) : QObject(parent)
+    {
+        connect(&m_server, &QTcpServer::newConnection, this, &CFsdLoopbackServer::onNewConnection);
+    }
+
+    bool CFsdLoopbackServer::listen()
+    {
+        if (m_server.isListening()) { return true; }
+        return m_server.listen(QHostAddress::LocalHost, 0);
+    }
+
+    void CFsdLoopbackServer::writeLine(const QString &line)
+    {
+        if (!m_client) { return; }
+        const QByteArray data = line.toLatin1() + "\r\n";
+        m_bytesWritten += m_client->write(data);
+    }
+
+    void CFsdLoopbackServer::onNewConnection()
+    {
+        QTcpSocket *socket = m_server.nextPendingConnection();
+        if (!socket) { return; }
+        if (m_client)
+        {
+            // one client only
+            socket->abort();
+            socket->deleteLater();
+            return;
+        }
+        socket->setParent(this);
+        m_client = socket;
+        connect(socket, &QTcpSocket::readyRead, this, &CFsdLoopbackServer::onReadyRead);
+        emit this->clientConnected();
+    }
+
+    void CFsdLoopbackServer::onReadyRead()
+    {
+        if (!m_client) { return; }
+        const QByteArray data = m_client->readAll();
+        m_bytesRead += data.size();
+        m_readBuffer += data;
+
+        int from = 0;
+        for (int to = m_readBuffer.indexOf('\n'); to >= 0; to = m_readBuffer.indexOf('\n', from))
+        {
+            const QByteArray line = m_readBuffer.mid(from, to - from).trimmed();
+            from = to + 1;
+            if (!line.isEmpty()) { emit this->lineReceived(QString::fromLatin1(line)); }
+        }
+        m_readBuffer.remove(0, from);
+    }
+
+    CTrafficPipeline::CTrafficPipeline(const CAircraftModelList &modelSet, QObject *parent) : QObject(parent)
+    {
+        m_clock.start();
+        m_startThreadCpuNs = threadCpuNs();
+        m_startProcessCpuNs = processCpuNs();
+        m_startThreadAllocations = threadAllocations();
+
+        COwnAircraftProviderDummy *ownAircraft = COwnAircraftProviderDummy::instance();
+        ownAircraft->updateOwnCallsign(ownCallsign());
+        CAircraftSituation ownSituation(ownCallsign(), CCoordinateGeodetic(50.0333, 8.5706, 364));
+        ownSituation.setHeading(CHeading(250, CHeading::True, CAngleUnit::deg()));
+        ownSituation.setGroundSpeed(CSpeed(0, CSpeedUnit::kts()));
+        ownAircraft->updateOwnSituation(ownSituation);
+
+        m_matcher = new CAircraftMatcher(this);
+        m_matcher->setModelSet(modelSet, CSimulatorInfo::xplane(), true);
+
+        // order as in the network context, the FSD client needs the airspace monitor as provider
+        m_fsdClient = new CFSDClient(nullptr, ownAircraft, nullptr, this);
+        m_airspace = new CAirspaceMonitor(ownAircraft, m_matcher, m_fsdClient, this);
+        m_fsdClient->setClientProvider(m_airspace);
+        m_fsdClient->setRemoteAircraftProvider(m_airspace);
+        m_fsdClient->start();
+
+        // stamped in the FSD thread, before the airspace monitor gets the queued signal
+        // visual updates are parsed, but not handled by the FSD client, so only pilot data updates are stamped
+        connect(m_fsdClient, &CFSDClient::pilotDataUpdateReceived, m_fsdClient, [=](const CAircraftSituation &situation, const CTransponder &) { this->onFsdPositionReceived(situation.getCallsign()); }, Qt::DirectConnection);
+
+        connect(m_airspace, &CAirspaceMonitor::addedAircraftSituation, this, &CTrafficPipeline::onAddedAircraftSituation);
+        connect(m_airspace, &CAirspaceMonitor::addedAircraftParts, this, [=] { m_storedParts++; });
+        connect(m_airspace, &CAirspaceMonitor::readyForModelMatching, this, &CTrafficPipeline::onReadyForModelMatching);
+        connect(m_airspace, &CAirspaceMonitor::removedAircraft, this, &CTrafficPipeline::onRemovedAircraft);
+
+        m_frameTimer.setInterval(1000 / 60);
+        m_frameTimer.setObjectName("CTrafficPipeline::m_frameTimer");
+        connect(&m_frameTimer, &QTimer::timeout, this, &CTrafficPipeline::updateRemoteAircraft);
+    }
+
+    CTrafficPipeline::~CTrafficPipeline()
+    {
+        this->disconnectFromLoopback();
+        if (m_fsdClient)
+        {
+            m_fsdClient->gracefulShutdown();
+            m_fsdClient->setClientProvider(nullptr);
+            m_fsdClient->deleteLater();
+            m_fsdClient = nullptr;
+        }
+    }
+
+    bool CTrafficPipeline::connectToLoopback(int timeoutMs)
+    {
+        if (!m_server.listen()) { return false; }
+
+        const CServer server("Loopback", "Local FSD replay server", "127.0.0.1", m_server.port(),
+                             CUser("1234567", "Replay User", "", "123456"),
+                             CFsdSetup(), CEcosystem(CEcosystem::swiftTest()), CServer::FSDServer);
+        m_fsdClient->setLoginMode(CLoginMode::Pilot);
+        m_fsdClient->setCallsign(ownCallsign());
+        m_fsdClient->setClientName("swift replay");
+        m_fsdClient->setVersion(1, 0);
+        m_fsdClient->setClientCapabilities(Capabilities::AircraftInfo | Capabilities::FastPos | Capabilities::VisPos | Capabilities::AircraftConfig);
+        m_fsdClient->setServer(server);
+        m_fsdClient->setSimType(CSimulatorInfo::xplane());
+        m_fsdClient->setPilotRating(PilotRating::Student);
+        m_fsdClient->connectToServer();
+
+        QElapsedTimer timer;
+        timer.start();
+        while (!(m_server.hasClient() && m_fsdClient->isConnected()) && timer.elapsed() < timeoutMs)
+        {
+            QTest::qWait(10);
+        }
+        if (!m_server.hasClient() || !m_fsdClient->isConnected()) { return false; }
+
+        connect(&m_server, &CFsdLoopbackServer::lineReceived, this, &CTrafficPipeline::clientLineReceived, Qt::UniqueConnection);
+        m_frameTimer.start();
+        return true;
+    }
+
+    void CTrafficPipeline::disconnectFromLoopback()
+    {
+        m_frameTimer.stop();
+        if (m_fsdClient && m_fsdClient->isConnected()) { m_fsdClient->disconnectFromServer(); }
+    }
+
+    void CTrafficPipeline::sendLine(const QString &line)
+    {
+        const qint64 cpu = threadCpuNs();
+        const QString cs = pilotDataUpdateCallsign(line);
+        if (!cs.isEmpty())
+        {
+            QMutexLocker l(&m_mutex);
+            m_sentNs[CCallsign(cs)].enqueue(m_clock.nsecsElapsed());
+        }
+        m_server.writeLine(line);
+        m_sentLines++;
+        m_serverCpuNs += threadCpuNs() - cpu;
+    }
+
+    bool CTrafficPipeline::waitForAircraft(int aircraftCount, int timeoutMs)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (timer.elapsed() < timeoutMs)
+        {
+            if (this->getAircraftInRangeCount() >= aircraftCount && this->getMatchedCount() >= aircraftCount) { return true; }
+            QTest::qWait(10);
+        }
+        return false;
+    }
+
+    int CTrafficPipeline::getAircraftInRangeCount() const
+    {
+        return m_airspace->getAircraftInRangeCount();
+    }
+
+    QString CTrafficPipeline::getReport() const
+    {
+        const qint64 mainCpuNs = threadCpuNs() - m_startThreadCpuNs;
+        const qint64 mainAllocations = threadAllocations() - m_startThreadAllocations;
+        const auto ms = [](qint64 ns) { return ns < 0 ? QStringLiteral("n/a") : QString::number(ns / 1000000.0, 'f', 1) % u"ms"; };
+
+        QString report;
+        {
+            QMutexLocker l(&m_mutex);
+            for (int stage = 0; stage < StageCount; ++stage)
+            {
+                report += stageName(static_cast<Stage>(stage)) % u": " % m_histograms[static_cast<size_t>(stage)].toQString() % u"\n";
+            }
+        }
+
+        // the airspace monitor shares the thread with server, matching and frames
+        report += u"cpu fsd thread: " % ms(m_fsdThreadCpuNs.load()) %
+                  u" server: " % ms(m_serverCpuNs) %
+                  u" matching: " % ms(m_matchingCpuNs) %
+                  u" frames: " % ms(m_frameCpuNs) %
+                  u" airspace and event loop: " % ms(mainCpuNs < 0 ? -1 : mainCpuNs - m_serverCpuNs - m_matchingCpuNs - m_frameCpuNs) %
+                  u" process: " % ms(processCpuNs() < 0 ? -1 : processCpuNs() - m_startProcessCpuNs) % u"\n";
+        report += u"allocations fsd thread: " % QString::number(m_fsdThreadAllocations.load()) %
+                  u" matching: " % QString::number(m_matchingAllocations) %
+                  u" frames: " % QString::number(m_frameAllocations) %
+                  u" pipeline thread: " % QString::number(mainAllocations) %
+                  u" process: " % QString::number(processAllocations()) % u"\n";
+        report += u"lines: " % QString::number(m_sentLines) %
+                  u" stored situations: " % QString::number(m_storedSituations) %
+                  u" parts: " % QString::number(m_storedParts) %
+                  u" in range: " % QString::number(this->getAircraftInRangeCount()) %
+                  u" matched: " % QString::number(this->getMatchedCount()) %
+                  u" frames: " % QString::number(m_frames) %
+                  u" sent situations: " % QString::number(m_sentSituations) % u"/" % QString::number(m_interpolatedSituations) %
+                  u" parts: " % QString::number(m_sentParts) % u"/" % QString::number(m_interpolatedSituations) %
+                  u" bytes server: " % QString::number(m_server.getBytesWritten()) % u"/" % QString::number(m_server.getBytesRead()) %
+                  u" peak RSS: " % QString::number(peakRssKb()) % u"KB";
+        return report;
+    }
+
+    const QString &CTrafficPipeline::stageName(Stage stage)
+    {
+        static const QString fsd("fsd");
+        static const QString airspace("airspace");
+        static const QString serverToAirspace("server to airspace");
+        static const QString matching("matching");
+        static const QString frame("frame");
+        static const QString unknown("unknown");
+
+        switch (stage)
+        {
+        case StageFsd: return fsd;
+        case StageAirspace: return airspace;
+        case StageServerToAirspace: return serverToAirspace;
+        case StageMatching: return matching;
+        case StageFrame: return frame;
+        default: break;
+        }
+        return unknown;
+    }
+
+    const CCallsign &CTrafficPipeline::ownCallsign()
+    {
+        static const CCallsign cs("REPLAY");
+        return cs;
+    }
+
+    qint64 CTrafficPipeline::threadCpuNs()
+    {
+#ifdef Q_OS_UNIX
+        timespec ts {};
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) { return static_cast<qint64>(ts.tv_sec) * 1000000000 + ts.tv_nsec; }
+#endif
+        return -1;
+    }
+
+    qint64 CTrafficPipeline::processCpuNs()
+    {
+        const std::clock_t c = std::clock();
+        if (c == static_cast<std::clock_t>(-1)) { return -1; }
+        return static_cast<qint64>(static_cast<double>(c) * 1e9 / CLOCKS_PER_SEC);
+    }
+
+    qint64 CTrafficPipeline::peakRssKb()
+    {
+#ifdef Q_OS_UNIX
+        rusage usage {};
+        if (getrusage(RUSAGE_SELF, &usage) != 0) { return -1; }
+#    ifdef Q_OS_MACOS
+        return static_cast<qint64>(usage.ru_maxrss) / 1024; // bytes
+#    else
+        return static_cast<qint64>(usage.ru_maxrss);
+#    endif
+#else
+        return -1;
+#endif
+    }
+
+    qint64 CTrafficPipeline::threadAllocations()
+    {
+        return t_allocations;
+    }
+
+    qint64 CTrafficPipeline::processAllocations()
+    {
+        return g_allocations.load(std::memory_order_relaxed);
+    }
+
+    QString CTrafficPipeline::pilotDataUpdateCallsign(const QString &line)
+    {
+        // @N:callsign:...
+        if (!line.startsWith('@')) { return {}; }
+        const int from = line.indexOf(':') + 1;
+        const int to = line.indexOf(':', from);
+        return from > 0 && to > from ? line.mid(from, to - from) : QString();
+    }
+
+    CAircraftModel CTrafficPipeline::createModel(const QString &modelString, const QString &aircraftIcao, const QString &airlineIcao)
+    {
+        const CAirlineIcaoCode airline(airlineIcao);
+        const CLivery livery = airlineIcao.isEmpty() ? CLivery() : CLivery(CLivery::getStandardCode(airline), airline, "pipeline");
+        return CAircraftModel(modelString, CAircraftModel::TypeOwnSimulatorModel, CSimulatorInfo::xplane(), modelString, "pipeline", CAircraftIcaoCode(aircraftIcao), livery);
+    }
+
+    void CTrafficPipeline::onFsdPositionReceived(const CCallsign &callsign)
+    {
+        const qint64 now = m_clock.nsecsElapsed();
+        m_fsdThreadCpuNs = threadCpuNs();
+        m_fsdThreadAllocations = threadAllocations();
+
+        QMutexLocker l(&m_mutex);
+        const auto it = m_sentNs.find(callsign);
+        if (it == m_sentNs.end() || it->isEmpty()) { return; }
+        const qint64 sent = it->dequeue();
+        m_histograms[StageFsd].add(now - sent);
+        m_receivedNs[callsign] = { sent, now };
+    }
+
+    void CTrafficPipeline::onAddedAircraftSituation(const CAircraftSituation &situation)
+    {
+        const qint64 now = m_clock.nsecsElapsed();
+        m_storedSituations++;
+
+        std::pair<qint64, qint64> stamps;
+        {
+            QMutexLocker l(&m_mutex);
+            const auto it = m_receivedNs.find(situation.getCallsign());
+            if (it == m_receivedNs.end()) { return; }
+            stamps = it.value();
+            m_receivedNs.erase(it); // latest stamp only, older situations were already coalesced
+        }
+        m_histograms[StageAirspace].add(now - stamps.second);
+        m_histograms[StageServerToAirspace].add(now - stamps.first);
+    }
+
+    void CTrafficPipeline::onReadyForModelMatching(const CSimulatedAircraft &aircraft)
+    {
+        const CCallsign callsign = aircraft.getCallsign();
+        if (m_interpolators.contains(callsign)) { return; }
+
+        const qint64 cpu = threadCpuNs();
+        const qint64 allocations = threadAllocations();
+        const qint64 start = m_clock.nsecsElapsed();
+        const CAircraftModel model = m_matcher->getClosestMatch(aircraft, MatchingLogNothing, nullptr, false);
+        m_airspace->updateAircraftModel(callsign, model, CIdentifier(QStringLiteral("CTrafficPipeline"), this));
+        m_histograms[StageMatching].add(m_clock.nsecsElapsed() - start);
+        m_matchingCpuNs += threadCpuNs() - cpu;
+        m_matchingAllocations += threadAllocations() - allocations;
+
+        m_interpolators.insert(callsign, CInterpolatorMultiWrapper(callsign, nullptr, nullptr, m_airspace));
+    }
+
+    void CTrafficPipeline::onRemovedAircraft(const CCallsign &callsign)
+    {
+        m_interpolators.remove(callsign);
+        m_lastSentFingerprints.remove(callsign);
+    }
+
+    void CTrafficPipeline::updateRemoteAircraft()
+    {
+        if (m_interpolators.isEmpty()) { return; }
+
+        const qint64 cpu = threadCpuNs();
+        const qint64 allocations = threadAllocations();
+        const qint64 start = m_clock.nsecsElapsed();
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+
+        int aircraftNumber = 0;
+        for (auto it = m_interpolators.begin(); it != m_interpolators.end(); ++it)
+        {
+            const CInterpolationResult result = it->interpolator()->getInterpolation(now, setup, aircraftNumber++);
+            const CAircraftSituation &s = result.getInterpolatedSituation();
+            const CAircraftParts &p = result.getInterpolatedParts();
+            m_interpolatedSituations++;
+            if (s.isNull()) { continue; }
+            if (m_lastSentFingerprints.rememberLastSentIfChanged(s)) { m_sentSituations++; }
+            if (m_lastSentFingerprints.rememberLastSentIfChanged(p, s.getCallsign())) { m_sentParts++; }
+        }
+
+        m_frames++;
+        m_histograms[StageFrame].add(m_clock.nsecsElapsed() - start);
+        m_frameCpuNs += threadCpuNs() - cpu;
+        m_frameAllocations += threadAllocations() - allocations;
+    }
+} // ns
+
+//! \endcond
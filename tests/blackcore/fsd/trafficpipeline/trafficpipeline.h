@@ -0,0 +1,276 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+
+/*!
+ * \file
+ * \ingroup testblackfsd
+ */
+
+#ifndef BLACKFSDTEST_TRAFFICPIPELINE_H
+#define BLACKFSDTEST_TRAFFICPIPELINE_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/interpolatormulti.h"
+#include "blackmisc/simulation/lastsentfingerprints.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/callsign.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QString>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <array>
+#include <atomic>
+
+namespace BlackCore
+{
+    class CAircraftMatcher;
+    class CAirspaceMonitor;
+    namespace Fsd
+    {
+        class CFSDClient;
+    }
+}
+
+namespace BlackFsdTest
+{
+    //! Latency histogram, bucket n counts values below 2^n microseconds
+    class CLatencyHistogram
+    {
+    public:
+        //! Add a value
+        void add(qint64 ns);
+
+        //! Number of values
+        qint64 count() const { return m_count; }
+
+        //! Mean in microseconds
+        double meanUs() const { return m_count > 0 ? m_sumNs / 1000.0 / m_count : 0.0; }
+
+        //! Max in microseconds
+        double maxUs() const { return m_maxNs / 1000.0; }
+
+        //! Upper bound of the bucket containing the percentile, in microseconds
+        qint64 percentileUs(double percent) const;
+
+        //! Count, mean, percentiles and the non empty buckets
+        QString toQString() const;
+
+    private:
+        static constexpr int Buckets = 40;
+        std::array<qint64, Buckets> m_buckets {};
+        qint64 m_count = 0;
+        qint64 m_sumNs = 0;
+        qint64 m_maxNs = 0;
+    };
+
+    //! Local FSD stand-in, writes lines to the one connected client and splits what the client sends into lines
+    class CFsdLoopbackServer : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        //! Constructor
+        explicit CFsdLoopbackServer(QObject *parent = nullptr);
+
+        //! Listen on a free local port
+        bool listen();
+
+        //! Port listening on
+        quint16 port() const { return m_server.serverPort(); }
+
+        //! Client connected?
+        bool hasClient() const { return m_client; }
+
+        //! Write one FSD line, the line delimiter is added
+        void writeLine(const QString &line);
+
+        //! Bytes written and read
+        //! @{
+        qint64 getBytesWritten() const { return m_bytesWritten; }
+        qint64 getBytesRead() const { return m_bytesRead; }
+        //! @}
+
+    signals:
+        //! Client connected
+        void clientConnected();
+
+        //! Line sent by the client, without delimiter
+        void lineReceived(const QString &line);
+
+    private:
+        //! New connection
+        void onNewConnection();
+
+        //! Read from client
+        void onReadyRead();
+
+        QTcpServer m_server;
+        QPointer<QTcpSocket> m_client;
+        QByteArray m_readBuffer;
+        qint64 m_bytesWritten = 0;
+        qint64 m_bytesRead = 0;
+    };
+
+    /*!
+     * FSD client, airspace monitor, aircraft matcher and an emulated simulator in one process.
+     *
+     * The FSD client runs in its own thread and connects to a CFsdLoopbackServer, all other stages run
+     * in the thread of the pipeline as in the pilot client. The simulator stage interpolates all matched
+     * aircraft every frame and compares the results with the last sent values like the emulated driver.
+     */
+    class CTrafficPipeline : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        //! Measured stages
+        enum Stage
+        {
+            StageFsd, //!< server write to FSD client signal
+            StageAirspace, //!< FSD client signal to situation stored in airspace monitor
+            StageServerToAirspace, //!< server write to situation stored in airspace monitor, the simulator is not included
+            StageMatching, //!< model matching of one aircraft
+            StageFrame, //!< one simulator frame with all matched aircraft
+            StageCount
+        };
+
+        //! Constructor, the model set is used by the matcher
+        CTrafficPipeline(const BlackMisc::Simulation::CAircraftModelList &modelSet, QObject *parent = nullptr);
+
+        //! Destructor
+        virtual ~CTrafficPipeline() override;
+
+        //! Start the server and connect the FSD client as pilot
+        bool connectToLoopback(int timeoutMs);
+
+        //! Disconnect the FSD client and stop the frames
+        void disconnectFromLoopback();
+
+        //! Send one FSD line from the server, pilot data updates are stamped for the latency
+        void sendLine(const QString &line);
+
+        //! Process events until all aircraft are in range and matched, or the timeout
+        bool waitForAircraft(int aircraftCount, int timeoutMs);
+
+        //! Number of aircraft in range of the airspace monitor
+        int getAircraftInRangeCount() const;
+
+        //! Number of matched aircraft
+        int getMatchedCount() const { return m_interpolators.size(); }
+
+        //! Lines sent by the server
+        qint64 getSentLines() const { return m_sentLines; }
+
+        //! Situations stored by the airspace monitor
+        qint64 getStoredSituations() const { return m_storedSituations; }
+
+        //! Parts stored by the airspace monitor
+        qint64 getStoredParts() const { return m_storedParts; }
+
+        //! Simulator frames
+        qint64 getFrames() const { return m_frames; }
+
+        //! Histogram of stage
+        const CLatencyHistogram &getHistogram(Stage stage) const { return m_histograms[stage]; }
+
+        //! Latencies, CPU time, allocations and memory as multi line string
+        QString getReport() const;
+
+        //! Stage name
+        static const QString &stageName(Stage stage);
+
+        //! Own callsign of the client, recorded lines should address it
+        static const BlackMisc::Aviation::CCallsign &ownCallsign();
+
+        //! CPU time of the calling thread in ns, -1 if not available
+        static qint64 threadCpuNs();
+
+        //! CPU time of the process in ns, -1 if not available
+        static qint64 processCpuNs();
+
+        //! Peak resident set size in KB, -1 if not available
+        static qint64 peakRssKb();
+
+        //! Heap allocations of the calling thread
+        static qint64 threadAllocations();
+
+        //! Heap allocations of the process
+        static qint64 processAllocations();
+
+        //! Callsign of a pilot data update line, empty for other lines
+        //! \remark visual updates are not handled by the FSD client, they do not add aircraft
+        static QString pilotDataUpdateCallsign(const QString &line);
+
+        //! Model for the matcher model set
+        static BlackMisc::Simulation::CAircraftModel createModel(const QString &modelString, const QString &aircraftIcao, const QString &airlineIcao);
+
+    signals:
+        //! Line the FSD client sent to the server
+        void clientLineReceived(const QString &line);
+
+    private:
+        //! FSD client received a position, called in the FSD thread
+        void onFsdPositionReceived(const BlackMisc::Aviation::CCallsign &callsign);
+
+        //! Airspace monitor stored a situation
+        void onAddedAircraftSituation(const BlackMisc::Aviation::CAircraftSituation &situation);
+
+        //! Match the aircraft and add it to the simulator
+        void onReadyForModelMatching(const BlackMisc::Simulation::CSimulatedAircraft &aircraft);
+
+        //! Aircraft removed from airspace
+        void onRemovedAircraft(const BlackMisc::Aviation::CCallsign &callsign);
+
+        //! One simulator frame
+        void updateRemoteAircraft();
+
+        CFsdLoopbackServer m_server;
+        BlackCore::Fsd::CFSDClient *m_fsdClient = nullptr; //!< own thread, deleted later
+        BlackCore::CAirspaceMonitor *m_airspace = nullptr;
+        BlackCore::CAircraftMatcher *m_matcher = nullptr;
+        QTimer m_frameTimer;
+        QElapsedTimer m_clock; //!< monotonic time base of all stamps
+
+        // written in the pipeline thread, read in the FSD thread
+        mutable QMutex m_mutex;
+        QHash<BlackMisc::Aviation::CCallsign, QQueue<qint64>> m_sentNs; //!< server write times not yet received
+        QHash<BlackMisc::Aviation::CCallsign, std::pair<qint64, qint64>> m_receivedNs; //!< latest server write and receive time
+        std::atomic<qint64> m_fsdThreadCpuNs { -1 };
+        std::atomic<qint64> m_fsdThreadAllocations { 0 };
+
+        std::array<CLatencyHistogram, StageCount> m_histograms; //!< StageFsd guarded by m_mutex
+
+        // pipeline thread only
+        QMap<BlackMisc::Aviation::CCallsign, BlackMisc::Simulation::CInterpolatorMultiWrapper> m_interpolators;
+        BlackMisc::Simulation::CLastSentFingerprints m_lastSentFingerprints;
+        qint64 m_sentLines = 0;
+        qint64 m_storedSituations = 0;
+        qint64 m_storedParts = 0;
+        qint64 m_frames = 0;
+        qint64 m_sentSituations = 0;
+        qint64 m_interpolatedSituations = 0;
+        qint64 m_sentParts = 0;
+        qint64 m_serverCpuNs = 0;
+        qint64 m_matchingCpuNs = 0;
+        qint64 m_frameCpuNs = 0;
+        qint64 m_matchingAllocations = 0;
+        qint64 m_frameAllocations = 0;
+        qint64 m_startThreadCpuNs = 0;
+        qint64 m_startProcessCpuNs = 0;
+        qint64 m_startThreadAllocations = 0;
+    };
+} // ns
+
+#endif // guard
+
+//! \endcond
@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackcore
+
+#include "blackcore/simulator.h"
+#include "blackmisc/simulation/simulatedaircraft.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/pq/length.h"
+#include "test.h"
+
+#include <QTest>
+
+using namespace BlackCore;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackCoreTest
+{
+    //! Order of the aircraft updated within a frame budget
+    class CTestFrameBudget : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Ranks follow the distance, not the callsign
+        void distanceRanks();
+
+        //! Deferred, followed, moving near ground, then by distance
+        void priorityOrder();
+
+    private:
+        //! Aircraft at distance
+        static CSimulatedAircraft aircraft(const QString &callsign, double distanceKm);
+    };
+
+    CSimulatedAircraft CTestFrameBudget::aircraft(const QString &callsign, double distanceKm)
+    {
+        CSimulatedAircraft aircraft;
+        aircraft.setCallsign(CCallsign(callsign));
+        aircraft.setRelativeDistance(CLength(distanceKm, CLengthUnit::km()));
+        return aircraft;
+    }
+
+    void CTestFrameBudget::distanceRanks()
+    {
+        // callsign order is the opposite of the distance order
+        CSimulatedAircraftList aircraftList;
+        aircraftList.push_back(aircraft("AAA", 100.0));
+        aircraftList.push_back(aircraft("MMM", 10.0));
+        aircraftList.push_back(aircraft("ZZZ", 1.0));
+
+        const QHash<CCallsign, int> ranks = ISimulator::getDistanceRanks(aircraftList);
+        QCOMPARE(ranks.size(), 3);
+        QCOMPARE(ranks.value(CCallsign("ZZZ")), 0);
+        QCOMPARE(ranks.value(CCallsign("MMM")), 1);
+        QCOMPARE(ranks.value(CCallsign("AAA")), 2);
+    }
+
+    void CTestFrameBudget::priorityOrder()
+    {
+        CSimulatedAircraftList aircraftList;
+        aircraftList.push_back(aircraft("AAA", 100.0));
+        aircraftList.push_back(aircraft("MMM", 10.0));
+        aircraftList.push_back(aircraft("ZZZ", 1.0));
+        const QHash<CCallsign, int> ranks = ISimulator::getDistanceRanks(aircraftList);
+
+        // the requests of a frame, in the order of the driver, the last one is not ranked
+        QVector<ISimulator::FrameBudgetPriority> priorities(4);
+        priorities[0].distanceRank = ranks.value(CCallsign("AAA"));
+        priorities[1].distanceRank = ranks.value(CCallsign("MMM"));
+        priorities[2].distanceRank = ranks.value(CCallsign("ZZZ"));
+        const QVector<int> byDistance { 2, 1, 0, 3 };
+        QCOMPARE(ISimulator::getFrameBudgetPriorityOrder(priorities), byDistance);
+
+        // moving near ground before distance
+        priorities[1].movingNearGround = true;
+        QCOMPARE(ISimulator::getFrameBudgetPriorityOrder(priorities), QVector<int>({ 1, 2, 0, 3 }));
+
+        // followed aircraft before moving near ground
+        priorities[0].followed = true;
+        QCOMPARE(ISimulator::getFrameBudgetPriorityOrder(priorities), QVector<int>({ 0, 1, 2, 3 }));
+
+        // deferred aircraft first, longest deferred first
+        priorities[3].deferredFrames = 1;
+        priorities[2].deferredFrames = 2;
+        QCOMPARE(ISimulator::getFrameBudgetPriorityOrder(priorities), QVector<int>({ 2, 3, 0, 1 }));
+    }
+} // namespace
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackCoreTest::CTestFrameBudget);
+
+#include "testframebudget.moc"
+
+//! \endcond
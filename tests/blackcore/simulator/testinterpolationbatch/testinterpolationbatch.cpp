@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackcore
+
+#include "blackcore/simulator.h"
+#include "blackmisc/simulation/interpolatormulti.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "test.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTest>
+#include <QThread>
+#include <QtDebug>
+#include <memory>
+#include <vector>
+
+using namespace BlackCore;
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackCoreTest
+{
+    //! Per frame interpolation of many aircraft, as done by the simulator drivers
+    class CTestInterpolationBatch : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Parallel batch gives the same results as the serial one, with timing of a frame of 400 aircraft
+        void parallelEqualsSerial();
+
+    private:
+        //! Situations for the given number of aircraft
+        static void insertSituations(CRemoteAircraftProviderDummy &provider, int aircraftCount, qint64 ts);
+
+        //! One interpolator per aircraft
+        static std::vector<std::unique_ptr<CInterpolatorMulti>> createInterpolators(CRemoteAircraftProviderDummy &provider, int aircraftCount);
+
+        //! Callsign of aircraft number
+        static CCallsign callsign(int number) { return CCallsign(QStringLiteral("SWIFT%1").arg(number)); }
+
+        //! Jobs for all interpolators
+        static QVector<ISimulator::InterpolationJob> createJobs(const std::vector<std::unique_ptr<CInterpolatorMulti>> &interpolators);
+    };
+
+    void CTestInterpolationBatch::parallelEqualsSerial()
+    {
+        constexpr int aircraftCount = 400;
+        constexpr int frames = 50;
+        const qint64 ts = 1425000000000;
+
+        CRemoteAircraftProviderDummy provider;
+        insertSituations(provider, aircraftCount, ts);
+        const auto serialInterpolators = createInterpolators(provider, aircraftCount);
+        const auto parallelInterpolators = createInterpolators(provider, aircraftCount);
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1000);
+
+        qint64 serialMs = 0;
+        qint64 parallelMs = 0;
+        QElapsedTimer timer;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            const qint64 now = ts - 5000 + frame * 20;
+
+            QVector<ISimulator::InterpolationJob> serial = createJobs(serialInterpolators);
+            timer.start();
+            ISimulator::interpolateBatch(serial, now, false);
+            serialMs += timer.elapsed();
+
+            QVector<ISimulator::InterpolationJob> parallel = createJobs(parallelInterpolators);
+            timer.start();
+            ISimulator::interpolateBatch(parallel, now, true);
+            parallelMs += timer.elapsed();
+
+            QCOMPARE(parallel.size(), serial.size());
+            for (int i = 0; i < serial.size(); ++i)
+            {
+                QVERIFY2(serial[i].result.getInterpolationStatus().hasValidSituation(), "Expect valid situation");
+                QVERIFY2(parallel[i].result.getInterpolatedSituation() == serial[i].result.getInterpolatedSituation(), "Same situation in parallel and serial");
+            }
+        }
+
+        qDebug() << aircraftCount << "aircraft," << frames << "frames, serial" << serialMs << "ms, parallel" << parallelMs << "ms," << QThread::idealThreadCount() << "threads";
+    }
+
+    void CTestInterpolationBatch::insertSituations(CRemoteAircraftProviderDummy &provider, int aircraftCount, qint64 ts)
+    {
+        constexpr int situationsPerAircraft = 10;
+        for (int a = 0; a < aircraftCount; ++a)
+        {
+            const CCallsign cs = callsign(a);
+            for (int i = situationsPerAircraft - 1; i >= 0; i--)
+            {
+                // newest situation last, 5 secs apart
+                const CCoordinateGeodetic position(10.0 + a * 0.01 - i * 0.001, 20.0 + a * 0.01, 1000.0 + i * 10);
+                CAircraftSituation situation(cs, position);
+                situation.setMSecsSinceEpoch(ts - 5000 * i);
+                situation.setTimeOffsetMs(5000);
+                provider.insertNewSituation(situation);
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<CInterpolatorMulti>> CTestInterpolationBatch::createInterpolators(CRemoteAircraftProviderDummy &provider, int aircraftCount)
+    {
+        std::vector<std::unique_ptr<CInterpolatorMulti>> interpolators;
+        for (int a = 0; a < aircraftCount; ++a)
+        {
+            interpolators.push_back(std::make_unique<CInterpolatorMulti>(callsign(a), nullptr, nullptr, &provider));
+        }
+        return interpolators;
+    }
+
+    QVector<ISimulator::InterpolationJob> CTestInterpolationBatch::createJobs(const std::vector<std::unique_ptr<CInterpolatorMulti>> &interpolators)
+    {
+        QVector<ISimulator::InterpolationJob> jobs;
+        for (const auto &interpolator : interpolators)
+        {
+            jobs.push_back({ interpolator.get(), {}, jobs.size(), {} });
+        }
+        return jobs;
+    }
+} // ns
+
+//! main
+BLACKTEST_MAIN(BlackCoreTest::CTestInterpolationBatch);
+
+#include "testinterpolationbatch.moc"
+
+//! \endcond
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackgui
+
+#include "blackgui/models/aircraftmodellistmodel.h"
+#include "blackgui/models/modelsortkeys.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/variant.h"
+#include "test.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QTest>
+#include <QtDebug>
+#include <algorithm>
+#include <numeric>
+
+using namespace BlackGui::Models;
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackGuiTest
+{
+    //! Sorting list models
+    class CTestListModelSort : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Typed keys, full and incremental sort
+        void sortKeys();
+
+        //! Sorting 50k models compared with the comparator sort
+        void sortModels();
+
+    private:
+        //! Models with unique model strings and keys, names with duplicates
+        static CAircraftModelList generateModels(int number);
+
+        //! Sorted as before, with the comparator only
+        static CAircraftModelList sortedByComparator(const CAircraftModelList &models, const CPropertyIndex &index, Qt::SortOrder order);
+
+        //! Model strings in order
+        static QStringList modelStrings(const CAircraftModelList &models);
+    };
+
+    void CTestListModelSort::sortKeys()
+    {
+        QVector<CVariant> values;
+        for (int i = 0; i < 1000; ++i) { values.push_back(CVariant::fromValue((i * 7919) % 1000)); }
+        const CModelSortKeys numbers(values, false);
+        QCOMPARE(numbers.getType(), CModelSortKeys::NumericKeys);
+        QCOMPARE(numbers.size(), values.size());
+
+        const auto noTies = [](int a, int b) { return a < b; };
+        int changed = -1;
+        const QVector<int> rows = numbers.sortedRows(Qt::DescendingOrder, noTies, &changed);
+        QCOMPARE(rows.size(), values.size());
+        for (int i = 1; i < rows.size(); ++i) { QVERIFY(values[rows[i - 1]].toInt() > values[rows[i]].toInt()); }
+        QCOMPARE(changed, values.size());
+
+        // sorted values with a few changes, only those are sorted
+        QVector<CVariant> sorted;
+        for (int row : rows) { sorted.push_back(values[row]); }
+        sorted[10] = CVariant::fromValue(-5);
+        sorted[500] = CVariant::fromValue(5000);
+        const CModelSortKeys incremental(sorted, false);
+        const QVector<int> incrementalRows = incremental.sortedRows(Qt::DescendingOrder, noTies, &changed);
+        QCOMPARE(changed, 2);
+        QCOMPARE(sorted[incrementalRows.front()].toInt(), 5000);
+        QCOMPARE(sorted[incrementalRows.back()].toInt(), -5);
+
+        // strings, case insensitive
+        const QVector<CVariant> strings { CVariant::fromValue(QStringLiteral("b")), CVariant::fromValue(QStringLiteral("A")), CVariant::fromValue(QStringLiteral("a")), CVariant::fromValue(QStringLiteral("C")) };
+        const CModelSortKeys stringKeys(strings, true);
+        QCOMPARE(stringKeys.getType(), CModelSortKeys::StringKeys);
+        QCOMPARE(stringKeys.sortedRows(Qt::AscendingOrder, noTies), QVector<int>({ 1, 2, 0, 3 }));
+        QCOMPARE(CModelSortKeys(strings, false).sortedRows(Qt::AscendingOrder, noTies), QVector<int>({ 1, 3, 2, 0 }));
+
+        // mixed or unsupported types
+        const QVector<CVariant> mixed { CVariant::fromValue(1), CVariant::fromValue(QStringLiteral("a")) };
+        QVERIFY(!CModelSortKeys(mixed, false).isValid());
+        QVERIFY(!CModelSortKeys({ CVariant::fromValue(CAircraftIcaoCode("B738")) }, false).isValid());
+
+        // chunks cover all rows
+        const QVector<QPair<int, int>> chunks = CModelSortKeys::chunks(100001);
+        QCOMPARE(chunks.front().first, 0);
+        QCOMPARE(chunks.back().second, 100001);
+        for (int i = 1; i < chunks.size(); ++i) { QCOMPARE(chunks[i].first, chunks[i - 1].second); }
+    }
+
+    void CTestListModelSort::sortModels()
+    {
+        constexpr int number = 50000;
+        const CAircraftModelList models = generateModels(number);
+        CAircraftModelListModel model(CAircraftModelListModel::OwnAircraftModelClient);
+
+        const QList<CPropertyIndex> indexes { CPropertyIndex(CAircraftModel::IndexModelString), CPropertyIndex(CAircraftModel::IndexName) };
+        for (const CPropertyIndex &index : indexes)
+        {
+            QVERIFY2(model.setSortColumnByPropertyIndex(index), "Expect sort column");
+            const int column = model.getSortColumn();
+            for (Qt::SortOrder order : { Qt::AscendingOrder, Qt::DescendingOrder })
+            {
+                QElapsedTimer time;
+                time.start();
+                const CAircraftModelList expected = sortedByComparator(models, index, order);
+                const qint64 comparatorMs = time.restart();
+                const CAircraftModelList sorted = model.sortContainerByColumn(models, column, order);
+                const qint64 keysMs = time.restart();
+                QCOMPARE(modelStrings(sorted), modelStrings(expected));
+
+                // a few changed rows in the sorted list
+                CAircraftModelList changed(sorted);
+                for (int i = 0; i < 50; ++i)
+                {
+                    CAircraftModel &m = changed[(i * 997) % number];
+                    m.setName(QStringLiteral("changed %1").arg(i));
+                    m.setModelString(QStringLiteral("CHANGED %1").arg(i));
+                }
+                time.restart();
+                const CAircraftModelList resorted = model.sortContainerByColumn(changed, column, order);
+                const qint64 resortMs = time.elapsed();
+                QCOMPARE(modelStrings(resorted), modelStrings(sortedByComparator(changed, index, order)));
+
+                qDebug() << number << "models by" << index.toQString() << (order == Qt::AscendingOrder ? "asc" : "desc")
+                         << "comparator" << comparatorMs << "ms, keys" << keysMs << "ms, re-sort" << resortMs << "ms";
+            }
+        }
+    }
+
+    CAircraftModelList CTestListModelSort::generateModels(int number)
+    {
+        static const QStringList designators { "B738", "A320", "A321", "B77W", "C172", "E190", "CRJ9", "DH8D", "A359", "B789" };
+        QRandomGenerator random(4711);
+        CAircraftModelList models;
+        for (int i = 0; i < number; ++i)
+        {
+            const QString designator = designators.at(random.bounded(designators.size()));
+            CAircraftModel m(QStringLiteral("%1 MODEL %2 %3").arg(designator).arg(random.generate(), 8, 16, QLatin1Char('0')).arg(i), CAircraftModel::TypeOwnSimulatorModel);
+            m.setName(QStringLiteral("%1 %2").arg(random.bounded(2) ? designator : designator.toLower()).arg(random.bounded(500)));
+            m.setDescription(QStringLiteral("description %1").arg(i));
+            m.setAircraftIcaoCode(CAircraftIcaoCode(designator));
+            m.setDbKey(i + 1);
+            models.push_back(m);
+        }
+        return models;
+    }
+
+    CAircraftModelList CTestListModelSort::sortedByComparator(const CAircraftModelList &models, const CPropertyIndex &index, Qt::SortOrder order)
+    {
+        const CPropertyIndexList tieBreakers({ CAircraftModel::keyIndex() });
+        return models.sorted([&](const CAircraftModel &a, const CAircraftModel &b) {
+            return Private::compareForModelSort<CAircraftModel>(a, b, order, index, tieBreakers, std::true_type());
+        });
+    }
+
+    QStringList CTestListModelSort::modelStrings(const CAircraftModelList &models)
+    {
+        QStringList strings;
+        for (const CAircraftModel &m : models) { strings.push_back(m.getModelString()); }
+        return strings;
+    }
+} // ns
+
+//! main
+BLACKTEST_MAIN(BlackGuiTest::CTestListModelSort);
+
+#include "testlistmodelsort.moc"
+
+//! \endcond
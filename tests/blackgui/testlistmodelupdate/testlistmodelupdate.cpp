@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackgui
+
+#include "blackgui/models/atcstationlistmodel.h"
+#include "blackmisc/aviation/atcstationlist.h"
+#include "blackmisc/pq/frequency.h"
+#include "blackmisc/pq/units.h"
+#include "test.h"
+
+#include <QPersistentModelIndex>
+#include <QSignalSpy>
+#include <QTest>
+
+using namespace BlackGui::Models;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackGuiTest
+{
+    //! Incremental list model updates
+    class CTestListModelUpdate : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Removed, moved, inserted and changed rows without reset
+        void rowDiff();
+
+        //! Cases where the model is reset
+        void reset();
+
+        //! Formatted cells are cached until the rows change
+        void displayCache();
+
+    private:
+        //! Station with frequency
+        static CAtcStation station(const QString &callsign, double frequencyMHz);
+
+        //! Row of a callsign
+        static int row(const CAtcStationListModel &model, const QString &callsign);
+    };
+
+    void CTestListModelUpdate::rowDiff()
+    {
+        CAtcStationListModel model(CAtcStationListModel::StationsOnline);
+        model.setNoSorting();
+        const CAtcStationList stations({ station("EDDM_DEL", 121.775), station("EDDM_GND", 121.825), station("EDDM_TWR", 118.7), station("EDDM_APP", 128.025), station("EDMM_CTR", 129.1) });
+        model.update(stations, false);
+        QCOMPARE(model.rowCount(), 5);
+
+        const QPersistentModelIndex selectedTower = model.index(row(model, "EDDM_TWR"), 0);
+        QSignalSpy reset(&model, &CAtcStationListModel::modelReset);
+        QSignalSpy removed(&model, &CAtcStationListModel::rowsRemoved);
+        QSignalSpy inserted(&model, &CAtcStationListModel::rowsInserted);
+        QSignalSpy layout(&model, &CAtcStationListModel::layoutChanged);
+        QSignalSpy changed(&model, &CAtcStationListModel::dataChanged);
+
+        // GND removed, TWR and APP swapped, CTR frequency changed, EDDM_ATIS added
+        const CAtcStationList update({ station("EDDM_DEL", 121.775), station("EDDM_APP", 128.025), station("EDDM_TWR", 118.7), station("EDDM_ATIS", 123.125), station("EDMM_CTR", 132.55) });
+        model.update(update, false);
+
+        QCOMPARE(reset.count(), 0);
+        QCOMPARE(removed.count(), 1);
+        QCOMPARE(inserted.count(), 1);
+        QCOMPARE(layout.count(), 1);
+        QCOMPARE(changed.count(), 1);
+        QCOMPARE(model.container(), update);
+        QCOMPARE(model.rowCount(), 5);
+        QCOMPARE(selectedTower.row(), 2);
+        QCOMPARE(model.at(model.index(4, 0)).getFrequency(), CFrequency(132.55, CFrequencyUnit::MHz()));
+
+        // same data, nothing signalled
+        model.update(update, false);
+        QCOMPARE(reset.count(), 0);
+        QCOMPARE(changed.count(), 1);
+        QCOMPARE(layout.count(), 1);
+    }
+
+    void CTestListModelUpdate::reset()
+    {
+        CAtcStationListModel model(CAtcStationListModel::StationsOnline);
+        model.setNoSorting();
+        const CAtcStationList stations({ station("EDDF_TWR", 119.9), station("EDDF_GND", 121.9), station("EDDF_APP", 120.8) });
+        model.update(stations, false);
+        QSignalSpy reset(&model, &CAtcStationListModel::modelReset);
+
+        // mostly new rows
+        model.update(CAtcStationList({ station("EDDF_TWR", 119.9), station("EGLL_TWR", 118.5), station("EGLL_GND", 121.9), station("EGLL_APP", 119.725) }), false);
+        QCOMPARE(reset.count(), 1);
+
+        // duplicate keys
+        model.update(CAtcStationList({ station("EDDF_TWR", 119.9), station("EDDF_TWR", 119.9), station("EGLL_GND", 121.9), station("EGLL_APP", 119.725) }), false);
+        QCOMPARE(reset.count(), 2);
+
+        // switched off
+        model.setIncrementalUpdates(false);
+        model.update(CAtcStationList({ station("EDDF_TWR", 119.9), station("EGLL_GND", 121.9), station("EGLL_APP", 119.725) }), false);
+        QCOMPARE(reset.count(), 3);
+    }
+
+    void CTestListModelUpdate::displayCache()
+    {
+        CAtcStationListModel model(CAtcStationListModel::StationsOnline);
+        model.setNoSorting();
+        model.update(CAtcStationList({ station("EDDM_TWR", 118.7), station("EDDM_APP", 128.025) }), false);
+        QCOMPARE(model.getDisplayCacheSize(), CAtcStationListModel::displayCacheSize);
+
+        // column showing the callsign
+        int column = 0;
+        while (column < model.columnCount() && model.data(model.index(0, column), Qt::DisplayRole).toString() != "EDDM_TWR") { ++column; }
+        QVERIFY(column < model.columnCount());
+        const QModelIndex tower = model.index(0, column);
+        QVERIFY(model.getDisplayCacheCount() > 0);
+        const int cached = model.getDisplayCacheCount();
+        QCOMPARE(model.data(tower, Qt::DisplayRole).toString(), QString("EDDM_TWR"));
+        QCOMPARE(model.getDisplayCacheCount(), cached);
+
+        // changed rows
+        model.update(CAtcStationList({ station("EDDF_TWR", 119.9), station("EDDF_APP", 120.8) }), false);
+        QCOMPARE(model.getDisplayCacheCount(), 0);
+        QCOMPARE(model.data(tower, Qt::DisplayRole).toString(), QString("EDDF_TWR"));
+        QCOMPARE(model.getDisplayCacheCount(), 1);
+
+        // switched off
+        model.setDisplayCacheSize(0);
+        QCOMPARE(model.data(tower, Qt::DisplayRole).toString(), QString("EDDF_TWR"));
+        QCOMPARE(model.getDisplayCacheCount(), 0);
+    }
+
+    CAtcStation CTestListModelUpdate::station(const QString &callsign, double frequencyMHz)
+    {
+        CAtcStation station(callsign);
+        station.setFrequency(CFrequency(frequencyMHz, CFrequencyUnit::MHz()));
+        return station;
+    }
+
+    int CTestListModelUpdate::row(const CAtcStationListModel &model, const QString &callsign)
+    {
+        for (int row = 0; row < model.rowCount(); ++row)
+        {
+            if (model.container()[row].getCallsign().asString() == callsign) { return row; }
+        }
+        return -1;
+    }
+} // ns
+
+//! main
+BLACKTEST_MAIN(BlackGuiTest::CTestListModelUpdate);
+
+#include "testlistmodelupdate.moc"
+
+//! \endcond
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackgui
+
+#include "blackgui/models/aircraftmodelfilter.h"
+#include "blackgui/models/aircraftmodellistmodel.h"
+#include "blackgui/models/filtersearchindex.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "test.h"
+
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QTest>
+#include <QtDebug>
+#include <memory>
+
+using namespace BlackGui::Models;
+using namespace BlackMisc;
+using namespace BlackMisc::Simulation;
+
+namespace BlackGuiTest
+{
+    //! Model filters with search index and in background
+    class CTestModelFilter : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Rows matching filter expressions
+        void searchIndex();
+
+        //! Filtering a large container in background, restarted by the next filter
+        void backgroundFilter();
+
+    private:
+        //! Models with model strings and descriptions
+        static CAircraftModelList generateModels(int number);
+
+        //! Filter by model string and description
+        static std::unique_ptr<IModelFilter<CAircraftModelList>> modelFilter(const QString &modelString, const QString &description = {});
+    };
+
+    void CTestModelFilter::searchIndex()
+    {
+        const CFilterSearchIndex index({ "B738 Lufthansa", " b737 Lufthansa ", "A320 Swiss", "", "A3*0 Wildcard" });
+        QCOMPARE(index.size(), 5);
+        QCOMPARE(index.matchingRows("b737 LUFTHANSA"), QVector<int>({ 1 }));
+        QCOMPARE(index.matchingRows("B73"), QVector<int>());
+        QCOMPARE(index.matchingRows("b73*"), QVector<int>({ 0, 1 }));
+        QCOMPARE(index.matchingRows("*lufthansa"), QVector<int>({ 0, 1 }));
+        QCOMPARE(index.matchingRows("*THANS*"), QVector<int>({ 0, 1 }));
+        QCOMPARE(index.matchingRows("*20 s*"), QVector<int>({ 2 }));
+        QCOMPARE(index.matchingRows("*a*"), QVector<int>({ 0, 1, 2, 4 }));
+        QCOMPARE(index.matchingRows("*"), QVector<int>({ 0, 1, 2, 4 }));
+        QCOMPARE(index.matchingRows(""), QVector<int>({ 3 }));
+        QCOMPARE(index.matchingRows("A*0"), QVector<int>({ 4 }));
+        QCOMPARE(index.matchingRows("*xyz*"), QVector<int>());
+        QCOMPARE(CFilterSearchIndex::intersected({ 1, 3, 5, 7 }, { 0, 3, 4, 7 }), QVector<int>({ 3, 7 }));
+
+        // same as the filter itself
+        const CAircraftModelList models = generateModels(2000);
+        const CFilterSearchIndex modelStrings = CFilterSearchIndex::fromContainer(models, CAircraftModel::IndexModelString);
+        for (const QString &expression : { QStringLiteral("*a32*"), QStringLiteral("B738*"), QStringLiteral("*7"), QStringLiteral("*SWISS 1*") })
+        {
+            const CAircraftModelList expected = modelFilter(expression)->filter(models);
+            const QVector<int> rows = modelStrings.matchingRows(expression);
+            QCOMPARE(rows.size(), expected.size());
+            for (int i = 0; i < rows.size(); ++i) { QCOMPARE(models[rows[i]], expected[i]); }
+        }
+    }
+
+    void CTestModelFilter::backgroundFilter()
+    {
+        const CAircraftModelList models = generateModels(40000);
+        CAircraftModelListModel model(CAircraftModelListModel::OwnAircraftModelClient);
+        model.setNoSorting();
+        model.update(models, false);
+        QCOMPARE(model.rowCount(), models.size());
+
+        // restarted before the first filter has finished, only rows of the last filter are shown
+        const CAircraftModelList expected = modelFilter("*a32*", "*swiss*")->filter(models);
+        QSignalSpy inserted(&model, &CAircraftModelListModel::rowsInserted);
+        QElapsedTimer time;
+        time.start();
+        std::unique_ptr<IModelFilter<CAircraftModelList>> first = modelFilter("*a*");
+        model.takeFilterOwnership(first);
+        std::unique_ptr<IModelFilter<CAircraftModelList>> filter = modelFilter("*a32*", "*swiss*");
+        model.takeFilterOwnership(filter);
+        const qint64 blockedMs = time.elapsed();
+        QVERIFY(model.hasFilter());
+        QTRY_COMPARE(model.containerFiltered(), expected);
+        const qint64 filteredMs = time.elapsed();
+        QCOMPARE(model.rowCount(), expected.size());
+        QVERIFY(inserted.count() > 0);
+
+        // search index of the container is reused
+        const CAircraftModelList expectedNext = modelFilter("*b73*")->filter(models);
+        time.restart();
+        std::unique_ptr<IModelFilter<CAircraftModelList>> next = modelFilter("*b73*");
+        model.takeFilterOwnership(next);
+        QTRY_COMPARE(model.containerFiltered(), expectedNext);
+        const qint64 refilteredMs = time.elapsed();
+
+        // data updates filter synchronously, so the rows stay visible
+        model.update(models, false);
+        QCOMPARE(model.containerFiltered(), expectedNext);
+        QCOMPARE(model.rowCount(), expectedNext.size());
+
+        qDebug() << models.size() << "models, blocked" << blockedMs << "ms, filtered" << filteredMs << "ms, filtered again" << refilteredMs << "ms";
+
+        // synchronous when switched off
+        model.setBackgroundFiltering(false);
+        std::unique_ptr<IModelFilter<CAircraftModelList>> sync = modelFilter("*a32*", "*swiss*");
+        model.takeFilterOwnership(sync);
+        QCOMPARE(model.containerFiltered(), expected);
+
+        model.removeFilter();
+        QCOMPARE(model.rowCount(), models.size());
+    }
+
+    CAircraftModelList CTestModelFilter::generateModels(int number)
+    {
+        static const QStringList designators { "B738", "A320", "A321", "B77W", "C172", "E190", "CRJ9", "DH8D", "A359", "B789" };
+        static const QStringList airlines { "Lufthansa", "Swiss", "Austrian", "Condor", "Eurowings" };
+        CAircraftModelList models;
+        for (int i = 0; i < number; ++i)
+        {
+            const QString designator = designators.at(i % designators.size());
+            const QString airline = airlines.at((i / designators.size()) % airlines.size());
+            CAircraftModel m(QStringLiteral("%1 %2 %3").arg(designator, airline.toUpper()).arg(i), CAircraftModel::TypeOwnSimulatorModel);
+            m.setDescription(QStringLiteral("%1 in %2 colors").arg(designator, airline));
+            models.push_back(m);
+        }
+        return models;
+    }
+
+    std::unique_ptr<IModelFilter<CAircraftModelList>> CTestModelFilter::modelFilter(const QString &modelString, const QString &description)
+    {
+        return std::make_unique<CAircraftModelFilter>(-1, modelString, description, CAircraftModel::All, Db::All,
+                                                      Qt::PartiallyChecked, Qt::PartiallyChecked,
+                                                      QString(), QString(), QString(), QString(), QString(), QString(), QString());
+    }
+} // ns
+
+//! main
+BLACKTEST_MAIN(BlackGuiTest::CTestModelFilter);
+
+#include "testmodelfilter.moc"
+
+//! \endcond
@@ -5,15 +5,23 @@
 //! \file
 //! \ingroup testblackmisc
 
+#include "blackmisc/aviation/airportlist.h"
 #include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/coordinategeodeticlist.h"
 #include "blackmisc/geo/earthangle.h"
 #include "blackmisc/geo/latitude.h"
+#include "blackmisc/geo/normalvectors.h"
 #include "blackmisc/pq/physicalquantity.h"
 #include "blackmisc/pq/units.h"
 #include "test.h"
 
+#include <QElapsedTimer>
+#include <QRandomGenerator>
 #include <QTest>
+#include <QtDebug>
+#include <cmath>
 
+using namespace BlackMisc::Aviation;
 using namespace BlackMisc::Geo;
 using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Math;
@@ -31,6 +39,12 @@ namespace BlackMiscTest
 
         //! CCoordinateGeodetic unit tests
         void coordinateGeodetic();
+
+        //! Range and closest queries with geo index, same results as without
+        void geoIndex();
+
+        //! Batch distances and bearings compared with the single calculations
+        void batchDistancesAndBearings();
     };
 
     void CTestGeo::geoBasics()
@@ -74,6 +88,123 @@ namespace BlackMiscTest
         latValue = testCoordinate.latitude().value(CAngleUnit::deg());
         QCOMPARE(latValue, newLat.value(CAngleUnit::deg()));
     }
+
+    void CTestGeo::geoIndex()
+    {
+        // 40k airports, half over the whole world, half in Europe
+        QRandomGenerator random(4711);
+        CAirportList airports;
+        for (int i = 0; i < 40000; ++i)
+        {
+            const bool europe = i % 2;
+            const double lat = europe ? 35.0 + random.bounded(30.0) : std::asin(random.bounded(2.0) - 1.0) * 180.0 / M_PI;
+            const double lng = europe ? -10.0 + random.bounded(40.0) : random.bounded(360.0) - 180.0;
+            airports.push_back(CAirport(CAirportIcaoCode(QStringLiteral("X%1").arg(i)), CCoordinateGeodetic(lat, lng)));
+        }
+        airports.push_back(CAirport(CAirportIcaoCode("NULL"), CCoordinateGeodetic::null()));
+        airports.push_back(CAirport(CAirportIcaoCode("POLE"), CCoordinateGeodetic(90.0, 0.0)));
+        airports.push_back(CAirport(CAirportIcaoCode("DATE"), CCoordinateGeodetic(0.0, 180.0)));
+
+        QElapsedTimer time;
+        time.start();
+        CAirportList indexed(airports);
+        indexed.attachGeoIndex();
+        const qint64 indexMs = time.elapsed();
+        QVERIFY(indexed.hasGeoIndex());
+        QVERIFY(!airports.hasGeoIndex());
+
+        const CLength range(100, CLengthUnit::NM());
+        const QList<CCoordinateGeodetic> positions { { 48.35, 11.78 }, { 47.46, 8.55 }, { 89.9, 0.0 }, { -33.9, 151.2 }, { 0.0, -179.95 }, { 10.0, -30.0 } };
+        qint64 linearMs = 0;
+        qint64 indexedMs = 0;
+        for (const CCoordinateGeodetic &position : positions)
+        {
+            time.restart();
+            const CAirportList withinRange = airports.findWithinRange(position, range);
+            const CAirportList closest = airports.findClosest(20, position);
+            linearMs += time.elapsed();
+            time.restart();
+            const CAirportList withinRangeIndexed = indexed.findWithinRange(position, range);
+            const CAirportList closestIndexed = indexed.findClosest(20, position);
+            indexedMs += time.elapsed();
+
+            QCOMPARE(withinRangeIndexed, withinRange);
+            QCOMPARE(closestIndexed.size(), closest.size());
+            for (int i = 0; i < closest.size(); ++i)
+            {
+                // the order of equal distances is not defined
+                QCOMPARE(calculateEuclideanDistanceSquared(closestIndexed[i], position), calculateEuclideanDistanceSquared(closest[i], position));
+            }
+            QCOMPARE(indexed.findClosestWithinRange(position, range), airports.findClosestWithinRange(position, range));
+            QCOMPARE(indexed.findFirstWithinRangeOrDefault(position, range), airports.findFirstWithinRangeOrDefault(position, range));
+            QCOMPARE(indexed.containsObjectInRange(position, range), airports.containsObjectInRange(position, range));
+        }
+        qDebug() << airports.size() << "airports, index built" << indexMs << "ms," << positions.size() << "range and closest queries" << linearMs << "ms, with index" << indexedMs << "ms";
+
+        // modified, index is no longer used
+        const CCoordinateGeodetic munich(48.35, 11.78);
+        indexed.push_back(CAirport(CAirportIcaoCode("EDDM"), munich));
+        QVERIFY(!indexed.hasGeoIndex());
+        QCOMPARE(indexed.findWithinRange(munich, range).size(), airports.findWithinRange(munich, range).size() + 1);
+    }
+
+    void CTestGeo::batchDistancesAndBearings()
+    {
+        QRandomGenerator random(815);
+        CCoordinateGeodeticList positions;
+        for (int i = 0; i < 10000; ++i)
+        {
+            positions.push_back(CCoordinateGeodetic(random.bounded(170.0) - 85.0, random.bounded(360.0) - 180.0));
+        }
+        const CCoordinateGeodetic reference(48.35, 11.78);
+        const CNormalVectors normalVectors = CNormalVectors::fromContainer(positions);
+        QCOMPARE(normalVectors.size(), positions.size());
+
+        const QVector<double> distances = calculateGreatCircleDistances(normalVectors, reference.normalVectorDouble());
+        const QVector<double> bearings = calculateBearings(normalVectors, reference.normalVectorDouble());
+        QCOMPARE(distances.size(), positions.size());
+        QCOMPARE(bearings.size(), positions.size());
+        for (int i = 0; i < positions.size(); ++i)
+        {
+            // the single calculations use floats
+            const double distance = calculateGreatCircleDistance(positions[i], reference).value(CLengthUnit::m());
+            QVERIFY2(std::abs(distances[i] - distance) <= 5.0 + distance * 1e-6, qPrintable(QStringLiteral("distance %1 vs. %2").arg(distances[i]).arg(distance)));
+            if (distance < 50000.0) { continue; } // bearing of close positions suffers from float precision
+            const double bearing = calculateBearing(positions[i], reference).value(CAngleUnit::rad());
+            const double bearingDiff = std::remainder(bearings[i] - bearing, 2 * M_PI);
+            QVERIFY2(std::abs(bearingDiff) <= 1e-4, qPrintable(QStringLiteral("bearing %1 vs. %2").arg(bearings[i]).arg(bearing)));
+        }
+
+        // first match searches stop early, but find the same object as the full search
+        for (const CLength &range : { CLength(10, CLengthUnit::km()), CLength(500, CLengthUnit::km()), CLength(20000, CLengthUnit::km()) })
+        {
+            const CCoordinateGeodeticList within = positions.findWithinRange(reference, range);
+            QCOMPARE(positions.containsObjectInRange(reference, range), !within.isEmpty());
+            QCOMPARE(positions.findFirstWithinRangeOrDefault(reference, range), within.frontOrDefault());
+            QCOMPARE(positions.containsObjectOutsideRange(reference, range), !positions.findOutsideRange(reference, range).isEmpty());
+        }
+
+        // list helpers, null positions stay null
+        CAirportList airports;
+        airports.push_back(CAirport(CAirportIcaoCode("EDDF"), CCoordinateGeodetic(50.03, 8.57)));
+        airports.push_back(CAirport(CAirportIcaoCode("LSZH"), CCoordinateGeodetic(47.46, 8.55)));
+        airports.push_back(CAirport(CAirportIcaoCode("KJFK"), CCoordinateGeodetic(40.64, -73.78)));
+        airports.push_back(CAirport());
+        airports.calculcateAndUpdateRelativeDistanceAndBearing(reference);
+        for (const CAirport &airport : airports)
+        {
+            if (airport.isNull())
+            {
+                QVERIFY(airport.getRelativeDistance().isNull());
+                QVERIFY(airport.getRelativeBearing().isNull());
+                continue;
+            }
+            QVERIFY(std::abs(airport.getRelativeDistance().value(CLengthUnit::m()) - airport.calculateGreatCircleDistance(reference).value(CLengthUnit::m())) <= 5.0);
+            QVERIFY(std::abs(std::remainder(airport.getRelativeBearing().value(CAngleUnit::rad()) - airport.calculateBearing(reference).value(CAngleUnit::rad()), 2 * M_PI)) <= 1e-4);
+        }
+        airports.removeIfOutsideRange(reference, CLength(500, CLengthUnit::km()), false);
+        QCOMPARE(airports.size(), 2); // a null distance counts as outside range, as before
+    }
 } // ns
 
 //! main
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/aircraftinrangedelta.h"
+#include "blackmisc/simulation/aircraftinrangesync.h"
+#include "blackmisc/sharedstate/datalinklocal.h"
+#include "blackmisc/registermetadata.h"
+#include "test.h"
+
+#include <QTest>
+#include <memory>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::SharedState;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Aircraft in range delta synchronization tests
+    class CTestAircraftInRange : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Init test case environment
+        void initTestCase();
+
+        //! Diff and apply deltas
+        void diffAndApply();
+
+        //! Journal and replica over local datalink
+        void localSync();
+
+        //! Snapshot request without reply and lost datalink
+        void lostSync();
+
+    private:
+        //! Aircraft with given callsign and transponder code
+        static CSimulatedAircraft aircraft(const QString &callsign, int code);
+
+        //! Same callsigns and values, order ignored
+        static bool sameAircraft(const CSimulatedAircraftList &a, const CSimulatedAircraftList &b);
+    };
+
+    void CTestAircraftInRange::initTestCase()
+    {
+        BlackMisc::registerMetadata();
+    }
+
+    void CTestAircraftInRange::diffAndApply()
+    {
+        const CSimulatedAircraftList v1 { aircraft("DLH1", 1000), aircraft("DLH2", 2000), aircraft("DLH3", 3000) };
+        const CSimulatedAircraftList v2 { aircraft("DLH1", 1000), aircraft("DLH3", 3300), aircraft("DLH4", 4000) };
+
+        const CAircraftInRangeDelta delta = CAircraftInRangeDelta::diff(v1, v2, 2);
+        QCOMPARE(delta.getRevision(), qint64(2));
+        QVERIFY(!delta.isSnapshot());
+        QCOMPARE(delta.getChangedAircraft().size(), 2); // DLH3 changed, DLH4 added
+        QVERIFY(delta.getRemovedCallsigns().contains(CCallsign("DLH2")));
+        QCOMPARE(delta.getRemovedCallsigns().size(), 1);
+
+        CSimulatedAircraftList applied(v1);
+        delta.applyTo(applied);
+        QVERIFY2(sameAircraft(applied, v2), "delta applied to old list gives new list");
+
+        QVERIFY2(CAircraftInRangeDelta::diff(v2, v2, 3).isEmpty(), "no changes, empty delta");
+
+        CSimulatedAircraftList replaced { aircraft("AFR1", 1) };
+        CAircraftInRangeDelta::snapshot(v2, 3).applyTo(replaced);
+        QVERIFY2(sameAircraft(replaced, v2), "snapshot replaces list");
+    }
+
+    void CTestAircraftInRange::localSync()
+    {
+        CDataLinkLocal dataLink;
+        CAircraftInRangeJournal journal(this);
+        CAircraftInRangeReplica replica(this);
+        journal.initialize(&dataLink);
+
+        const CSimulatedAircraftList v1 { aircraft("DLH1", 1000), aircraft("DLH2", 2000) };
+        journal.publish(v1);
+
+        // joins late, gets the snapshot
+        replica.initialize(&dataLink);
+        bool ok = qWaitFor([&] { return replica.getRevision() == journal.getRevision(); });
+        QVERIFY2(ok, "replica synchronized by snapshot");
+        QVERIFY(sameAircraft(replica.getAircraftInRange(), v1));
+        QCOMPARE(replica.getResyncCount(), 1);
+
+        const CSimulatedAircraftList v2 { aircraft("DLH1", 1100), aircraft("DLH3", 3000) };
+        journal.publish(v2);
+        ok = qWaitFor([&] { return replica.getRevision() == journal.getRevision(); });
+        QVERIFY2(ok, "replica synchronized by delta");
+        QVERIFY(sameAircraft(replica.getAircraftInRange(), v2));
+        QCOMPARE(replica.getResyncCount(), 1);
+    }
+
+    void CTestAircraftInRange::lostSync()
+    {
+        auto dataLink = std::make_unique<CDataLinkLocal>();
+        CAircraftInRangeJournal journal(this);
+        CAircraftInRangeReplica replica(this);
+        replica.setResyncTimeoutMs(100);
+
+        // no journal yet, the snapshot request is never answered
+        replica.initialize(dataLink.get());
+        journal.initialize(dataLink.get());
+        QTest::qWait(300);
+
+        // timed out, so the next delta requests a snapshot again
+        const CSimulatedAircraftList v1 { aircraft("DLH1", 1000), aircraft("DLH2", 2000) };
+        journal.publish(v1);
+        const bool ok = qWaitFor([&] { return replica.getRevision() == journal.getRevision(); });
+        QVERIFY2(ok, "replica synchronized after a lost snapshot request");
+        QVERIFY(sameAircraft(replica.getAircraftInRange(), v1));
+        QCOMPARE(replica.getResyncCount(), 1);
+
+        // no longer synchronized without datalink
+        dataLink.reset();
+        QVERIFY(qWaitFor([&] { return replica.getRevision() < 0; }));
+    }
+
+    CSimulatedAircraft CTestAircraftInRange::aircraft(const QString &callsign, int code)
+    {
+        CSimulatedAircraft aircraft;
+        aircraft.setCallsign(CCallsign(callsign));
+        aircraft.setTransponderCode(code);
+        return aircraft;
+    }
+
+    bool CTestAircraftInRange::sameAircraft(const CSimulatedAircraftList &a, const CSimulatedAircraftList &b)
+    {
+        if (a.size() != b.size()) { return false; }
+        for (const CSimulatedAircraft &aircraft : a)
+        {
+            if (b.findFirstByCallsign(aircraft.getCallsign()) != aircraft) { return false; }
+        }
+        return true;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestAircraftInRange);
+
+#include "testaircraftinrange.moc"
+
+//! \endcond
@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/backgroundvalidation.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "test.h"
+
+#include <QHash>
+#include <QTest>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Incremental validation of model files
+    class CTestBackgroundValidation : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Unchanged and changed models
+        void splitUnchangedModels();
+
+    private:
+        //! Model with file
+        static CAircraftModel model(const QString &modelString, const QString &fileName);
+    };
+
+    CAircraftModel CTestBackgroundValidation::model(const QString &modelString, const QString &fileName)
+    {
+        CAircraftModel model(modelString, CAircraftModel::TypeOwnSimulatorModel);
+        model.setFileName(fileName);
+        return model;
+    }
+
+    void CTestBackgroundValidation::splitUnchangedModels()
+    {
+        // two models share one aircraft.cfg
+        const CAircraftModel unchanged1 = model("UNCHANGED 1", "/sim/a/aircraft.cfg");
+        const CAircraftModel unchanged2 = model("UNCHANGED 2", "/sim/a/aircraft.cfg");
+        const CAircraftModel edited = model("EDITED", "/sim/b/aircraft.cfg");
+        const CAircraftModel moved = model("MOVED", "/sim/d/aircraft.cfg");
+        const CAircraftModel added = model("ADDED", "/sim/e/aircraft.cfg");
+        const CAircraftModel deleted = model("DELETED", "/sim/f/aircraft.cfg");
+        const CAircraftModel noFile = model("NO FILE", {});
+        const CAircraftModelList models({ unchanged1, unchanged2, edited, moved, added, deleted, noFile });
+
+        const CAircraftModelList lastValid({ unchanged1, unchanged2, edited, model("MOVED", "/sim/c/aircraft.cfg"), deleted, noFile });
+        const QHash<QString, qint64> lastFileTimestamps {
+            { "/sim/a/aircraft.cfg", 1000 }, { "/sim/b/aircraft.cfg", 1000 }, { "/sim/c/aircraft.cfg", 1000 }, { "/sim/f/aircraft.cfg", 1000 }
+        };
+        const QHash<QString, qint64> fileTimestamps {
+            { "/sim/a/aircraft.cfg", 1000 }, { "/sim/b/aircraft.cfg", 2000 }, { "/sim/d/aircraft.cfg", 1000 }, { "/sim/e/aircraft.cfg", 1000 }, { "/sim/f/aircraft.cfg", -1 }
+        };
+
+        CAircraftModelList unchangedModels;
+        const CAircraftModelList changedModels = CBackgroundValidation::splitUnchangedModels(models, lastValid, lastFileTimestamps, fileTimestamps, unchangedModels);
+        QCOMPARE(unchangedModels.getModelStringList(false), QStringList({ "UNCHANGED 1", "UNCHANGED 2" }));
+        QCOMPARE(changedModels.getModelStringList(false), QStringList({ "EDITED", "MOVED", "ADDED", "DELETED", "NO FILE" }));
+
+        // nothing validated before, all models are changed
+        unchangedModels.clear();
+        QCOMPARE(CBackgroundValidation::splitUnchangedModels(models, {}, {}, fileTimestamps, unchangedModels).size(), models.size());
+        QVERIFY(unchangedModels.isEmpty());
+    }
+} // namespace
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestBackgroundValidation);
+
+#include "testbackgroundvalidation.moc"
+
+//! \endcond
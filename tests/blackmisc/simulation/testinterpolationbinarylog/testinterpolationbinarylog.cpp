@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/interpolationbinarylog.h"
+#include "blackmisc/simulation/interpolationlogger.h"
+#include "blackmisc/simulation/lastsentfingerprints.h"
+#include "blackmisc/aviation/aircraftenginelist.h"
+#include "blackmisc/aviation/aircraftlights.h"
+#include "blackmisc/aviation/aircraftparts.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+#include "blackmisc/fileutils.h"
+#include "test.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QPointer>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QtDebug>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Binary interpolation log
+    class CTestInterpolationBinaryLog : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Records from situation and parts logs
+        void records();
+
+        //! Nothing is buffered when not recording
+        void notRecording();
+
+        //! Threads appending while the writer writes, read back
+        void roundTrip();
+
+        //! Only one writer at a time
+        void oneWriter();
+
+        //! Files which are no binary logs
+        void invalidFile();
+    };
+
+    void CTestInterpolationBinaryLog::records()
+    {
+        const CCallsign cs("DAMBZ");
+        const CAircraftParts parts(CAircraftLights(true, false, true, false, true, false), true, 20, false, CAircraftEngineList({ true, false }), true);
+
+        CAircraftSituation situation(cs, CCoordinateGeodetic(48.3536, 11.7858, 3000), CHeading(270, CHeading::True, CAngleUnit::deg()), CAngle(2, CAngleUnit::deg()), CAngle(-5, CAngleUnit::deg()), CSpeed(250, CSpeedUnit::kts()));
+        situation.setAltitude(CAltitude(3000, CAltitude::MeanSeaLevel, CLengthUnit::ft()));
+
+        SituationLog log;
+        log.interpolator = 's';
+        log.tsCurrent = 1000;
+        log.tsInterpolated = 800;
+        log.simTimeFraction = 0.5;
+        log.useParts = true;
+        log.interpolantRecalc = true;
+        log.noNetworkSituations = 3;
+        log.callsign = cs;
+        log.parts = parts;
+        log.situationCurrent = situation;
+        log.altCorrection = CAircraftSituation::altitudeCorrectionToString(CAircraftSituation::Underflow);
+
+        const CInterpolationBinaryLog::Record r = CInterpolationBinaryLog::fromSituationLog(log);
+        QCOMPARE(r.type, static_cast<quint8>(CInterpolationBinaryLog::SituationRecord));
+        QCOMPARE(r.getCallsign(), cs.asString());
+        QCOMPARE(r.interpolator, static_cast<quint8>('s'));
+        QCOMPARE(r.tsCurrent, Q_INT64_C(1000));
+        QCOMPARE(r.tsInterpolated, Q_INT64_C(800));
+        QCOMPARE(r.networkCount, 3);
+        QCOMPARE(r.altCorrection, static_cast<quint8>(CAircraftSituation::Underflow));
+        QVERIFY2(r.flags & CInterpolationBinaryLog::UseParts, "Expect parts flag");
+        QVERIFY2(r.flags & CInterpolationBinaryLog::InterpolantRecalculated, "Expect recalculated flag");
+        QVERIFY2(!(r.flags & CInterpolationBinaryLog::VtolAircraft), "Expect no VTOL flag");
+        QVERIFY2(std::abs(r.latitudeDeg - 48.3536) < 1e-6, "Expect latitude");
+        QVERIFY2(std::abs(r.altitudeFt - 3000) < 1e-3, "Expect altitude");
+        QVERIFY2(std::abs(r.headingDeg - 270) < 1e-3, "Expect heading");
+        QVERIFY2(std::abs(r.groundSpeedKts - 250) < 1e-3, "Expect ground speed");
+        QVERIFY2(std::isnan(r.cgFt), "Expect no CG");
+        QCOMPARE(r.partsBits, CLastSentFingerprints::partsBits(parts));
+
+        PartsLog partsLog;
+        partsLog.tsCurrent = 2000;
+        partsLog.callsign = cs;
+        partsLog.parts = parts;
+        partsLog.noNetworkParts = 2;
+        const CInterpolationBinaryLog::Record p = CInterpolationBinaryLog::fromPartsLog(partsLog);
+        QCOMPARE(p.type, static_cast<quint8>(CInterpolationBinaryLog::PartsRecord));
+        QCOMPARE(p.partsBits, r.partsBits);
+        QCOMPARE(p.networkCount, 2);
+
+        const QString partsString = CInterpolationBinaryLog::partsBitsToString(p.partsBits);
+        QVERIFY2(partsString.contains("strobe") && partsString.contains("gear") && partsString.contains("on ground"), qPrintable(partsString));
+        QVERIFY2(partsString.contains("flaps 20%") && partsString.contains("engines 10"), qPrintable(partsString));
+        QVERIFY2(!partsString.contains("landing"), qPrintable(partsString));
+
+        // long callsigns are cut, but terminated
+        partsLog.callsign = CCallsign("ABCDEFGHIJKLMNOP");
+        QCOMPARE(CInterpolationBinaryLog::fromPartsLog(partsLog).getCallsign().size(), static_cast<int>(sizeof(p.callsign)) - 1);
+    }
+
+    void CTestInterpolationBinaryLog::notRecording()
+    {
+        QVERIFY2(!CInterpolationBinaryLog::isRecording(), "Expect not recording");
+        const CInterpolationBinaryLog::Record r {};
+        constexpr int Calls = 1000000;
+        QElapsedTimer time;
+        time.start();
+        for (int i = 0; i < Calls; ++i) { CInterpolationBinaryLog::append(r); }
+        qDebug() << "not recording append" << time.nsecsElapsed() / Calls << "ns per call";
+
+        QByteArray buffered;
+        QCOMPARE(CInterpolationBinaryLog::drain(buffered), 0);
+    }
+
+    void CTestInterpolationBinaryLog::roundTrip()
+    {
+        QTemporaryDir dir;
+        QVERIFY2(dir.isValid(), "Expect temp dir");
+        const QString fileName = CFileUtils::appendFilePaths(dir.path(), "test.ipl");
+
+        const qint64 writtenBefore = CInterpolationBinaryLog::getWrittenCount();
+        const qint64 droppedBefore = CInterpolationBinaryLog::getDroppedCount();
+        QPointer<CInterpolationBinaryLogWriter> writer(new CInterpolationBinaryLogWriter(this, fileName));
+        QVERIFY2(writer->isValid(), "Expect valid writer");
+        QVERIFY2(CInterpolationBinaryLog::isRecording(), "Expect recording");
+        writer->start(QThread::LowPriority);
+
+        constexpr int Threads = 4;
+        constexpr int PerThread = 20000;
+        QElapsedTimer time;
+        time.start();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < Threads; ++t)
+        {
+            threads.emplace_back([t] {
+                const CCallsign cs(QStringLiteral("TEST%1").arg(t));
+                PartsLog log;
+                log.callsign = cs;
+                CInterpolationBinaryLog::Record r = CInterpolationBinaryLog::fromPartsLog(log);
+                for (int i = 0; i < PerThread; ++i)
+                {
+                    r.tsCurrent = i;
+                    CInterpolationBinaryLog::append(r);
+                    if (i % 1000 == 0) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); }
+                }
+            });
+        }
+        for (std::thread &t : threads) { t.join(); }
+        qDebug() << "appended" << Threads * PerThread << "records in" << time.elapsed() << "ms";
+
+        writer->quitAndWait();
+        QVERIFY2(!CInterpolationBinaryLog::isRecording(), "Expect stopped after quit");
+
+        const qint64 written = CInterpolationBinaryLog::getWrittenCount() - writtenBefore;
+        const qint64 dropped = CInterpolationBinaryLog::getDroppedCount() - droppedBefore;
+        QCOMPARE(written + dropped, static_cast<qint64>(Threads * PerThread));
+        qDebug() << CInterpolationBinaryLog::getStatistics() << "file size" << QFileInfo(fileName).size() << "bytes";
+
+        QVector<CInterpolationBinaryLog::Record> records;
+        const CStatusMessage m = CInterpolationBinaryLog::readFile(fileName, records);
+        QVERIFY2(m.isSuccess(), qPrintable(m.getMessage()));
+        QCOMPARE(records.size(), static_cast<int>(written));
+
+        // records of one thread are in order
+        QHash<QString, qint64> last;
+        for (const CInterpolationBinaryLog::Record &r : std::as_const(records))
+        {
+            const QString cs = r.getCallsign();
+            QVERIFY2(r.tsCurrent > last.value(cs, -1), "Expect records of a thread in order");
+            last.insert(cs, r.tsCurrent);
+        }
+        QCOMPARE(last.size(), Threads);
+
+        const QString csv = CInterpolationBinaryLog::toCsv(records);
+        QCOMPARE(csv.count('\n'), records.size() + 1);
+        QVERIFY2(CInterpolationBinaryLog::toHtml(records.mid(0, 10)).contains("<table"), "Expect HTML table");
+    }
+
+    void CTestInterpolationBinaryLog::oneWriter()
+    {
+        QTemporaryDir dir;
+        QPointer<CInterpolationBinaryLogWriter> writer(new CInterpolationBinaryLogWriter(this, CFileUtils::appendFilePaths(dir.path(), "1.ipl")));
+        QVERIFY2(writer->isValid(), "Expect valid writer");
+
+        auto *second = new CInterpolationBinaryLogWriter(this, CFileUtils::appendFilePaths(dir.path(), "2.ipl"));
+        QVERIFY2(!second->isValid(), "Expect only one writer");
+        delete second;
+        QVERIFY2(CInterpolationBinaryLog::isRecording(), "Expect first writer still recording");
+
+        writer->start(QThread::LowPriority);
+        writer->quitAndWait();
+        QVERIFY2(!CInterpolationBinaryLog::isRecording(), "Expect stopped after quit");
+
+        // no records, but a valid file
+        QVector<CInterpolationBinaryLog::Record> records;
+        QVERIFY(CInterpolationBinaryLog::readFile(CFileUtils::appendFilePaths(dir.path(), "1.ipl"), records).isSuccess());
+        QVERIFY(records.isEmpty());
+    }
+
+    void CTestInterpolationBinaryLog::invalidFile()
+    {
+        QTemporaryDir dir;
+        const QString fileName = CFileUtils::appendFilePaths(dir.path(), "invalid.ipl");
+        QVERIFY(CFileUtils::writeStringToFile("no interpolation log", fileName));
+
+        QVector<CInterpolationBinaryLog::Record> records;
+        QVERIFY2(CInterpolationBinaryLog::readFile(fileName, records).isFailure(), "Expect no binary log");
+        QVERIFY2(CInterpolationBinaryLog::readFile(CFileUtils::appendFilePaths(dir.path(), "missing.ipl"), records).isFailure(), "Expect missing file");
+        QVERIFY(records.isEmpty());
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestInterpolationBinaryLog);
+
+#include "testinterpolationbinarylog.moc"
+
+//! \endcond
@@ -43,6 +43,26 @@ namespace BlackMiscTest
         gs2.setMaxRenderedDistance(l);
         QVERIFY2(gs1 != gs2, "Expect unequal setups");
 
+        CInterpolationAndRenderingSetupGlobal gs3(gs1);
+        QVERIFY2(!gs3.isUsingUpdateTiers(), "Expect update tiers off by default");
+        QVERIFY2(gs3.setUpdateTiers(CLength(10, CLengthUnit::NM()), CLength(30, CLengthUnit::NM()), 2, 4), "Expect changed tiers");
+        QVERIFY2(gs3.isUsingUpdateTiers(), "Expect update tiers");
+        QCOMPARE(gs3.getUpdateTierFrames(CLength(5, CLengthUnit::NM())), 1);
+        QCOMPARE(gs3.getUpdateTierFrames(CLength(20, CLengthUnit::NM())), 2);
+        QCOMPARE(gs3.getUpdateTierFrames(CLength(50, CLengthUnit::NM())), 4);
+        QCOMPARE(gs3.getUpdateTierFrames(CLength::null()), 1);
+        QVERIFY2(gs1 != gs3, "Expect unequal setups (tiers)");
+
+        CInterpolationAndRenderingSetupGlobal gs4(gs1);
+        QVERIFY2(!gs4.isUsingFrameBudget(), "Expect no frame budget by default");
+        QVERIFY2(gs4.setFrameBudgetMs(5), "Expect changed budget");
+        QVERIFY2(!gs4.setFrameBudgetMs(5), "Expect unchanged budget");
+        QVERIFY2(gs4.isUsingFrameBudget(), "Expect frame budget");
+        QCOMPARE(gs4.propertyByIndex(CInterpolationAndRenderingSetupGlobal::IndexFrameBudgetMs).toInt(), 5);
+        QVERIFY2(gs1 != gs4, "Expect unequal setups (budget)");
+        QVERIFY2(gs4.setFrameBudgetMs(-1), "Expect budget off");
+        QCOMPARE(gs4.getFrameBudgetMs(), 0);
+
         const CCallsign cs("DAMBZ");
         const CInterpolationAndRenderingSetupPerCallsign setup1(cs, gs1);
         CInterpolationAndRenderingSetupPerCallsign setup2(setup1);
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/interpolatorspline.h"
+#include "blackmisc/simulation/interpolationrenderingsetup.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/simulation/simulatedaircraft.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/elevationplane.h"
+#include "blackmisc/network/user.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+#include "test.h"
+
+#include <QTest>
+#include <QThread>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::Network;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Spline interpolator tests
+    class CTestInterpolatorSpline : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Same output whether or not the interpolant is recalculated for every modification
+        void recalculation();
+
+    private:
+        //! Interpolate both and compare
+        static void compareInterpolation(CInterpolatorSpline &full, CInterpolatorSpline &incremental, qint64 from, qint64 to, qint64 step);
+
+        //! Test situation, number 0 is the latest
+        static CAircraftSituation getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset);
+
+        //! Wait so the provider marks the situations as modified later than before
+        static void waitForNextModification() { QThread::msleep(5); }
+    };
+
+    void CTestInterpolatorSpline::recalculation()
+    {
+        const CCallsign cs("SWIFT");
+        CRemoteAircraftProviderDummy provider;
+        CInterpolatorSpline full(cs, nullptr, nullptr, &provider);
+        CInterpolatorSpline incremental(cs, nullptr, nullptr, &provider);
+        full.markAsUnitTest();
+        incremental.markAsUnitTest();
+
+        // fixed time so everything can be debugged
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000; // ms
+        const qint64 offset = 5000; // ms
+        constexpr int situations = 6;
+        QVERIFY(provider.addNewAircraftInRange(CSimulatedAircraft(cs, CUser(), getTestSituation(cs, 0, ts, deltaT, offset))));
+        for (int i = situations - 1; i >= 0; i--) { provider.insertNewSituation(getTestSituation(cs, i, ts, deltaT, offset)); }
+
+        // within the segment before the latest situation
+        const qint64 segmentStart = ts - deltaT + offset;
+        compareInterpolation(full, incremental, segmentStart, segmentStart + deltaT / 2, deltaT / 20);
+
+        // elevation only update of an older situation, full recalculates, incremental keeps its segment
+        waitForNextModification();
+        const CAircraftSituation older = getTestSituation(cs, 2, ts, deltaT, offset);
+        const CElevationPlane olderPlane(older, CAltitude(5, CAltitude::MeanSeaLevel, CLengthUnit::m()), CLength(100, CLengthUnit::m()));
+        QCOMPARE(provider.updateAircraftGroundElevation(cs, olderPlane, CAircraftSituation::FromProvider, nullptr), 1);
+        compareInterpolation(full, incremental, segmentStart + deltaT / 2, segmentStart + 3 * deltaT / 4, deltaT / 20);
+
+        // elevation only update of the latest situation, above the aircraft, both recalculate
+        waitForNextModification();
+        const CAircraftSituation latest = getTestSituation(cs, 0, ts, deltaT, offset);
+        const CElevationPlane latestPlane(latest, CAltitude(2000, CAltitude::MeanSeaLevel, CLengthUnit::m()), CLength(100, CLengthUnit::m()));
+        QCOMPARE(provider.updateAircraftGroundElevation(cs, latestPlane, CAircraftSituation::FromProvider, nullptr), 1);
+        compareInterpolation(full, incremental, segmentStart + 3 * deltaT / 4, segmentStart + deltaT, deltaT / 20);
+    }
+
+    void CTestInterpolatorSpline::compareInterpolation(CInterpolatorSpline &full, CInterpolatorSpline &incremental, qint64 from, qint64 to, qint64 step)
+    {
+        CInterpolationAndRenderingSetupPerCallsign fullSetup;
+        fullSetup.setForceFullInterpolation(true);
+        const CInterpolationAndRenderingSetupPerCallsign incrementalSetup;
+
+        for (qint64 currentTime = from; currentTime < to; currentTime += step)
+        {
+            const CInterpolationResult fullResult = full.getInterpolation(currentTime, fullSetup);
+            const CInterpolationResult incrementalResult = incremental.getInterpolation(currentTime, incrementalSetup);
+            QVERIFY2(fullResult.getInterpolationStatus().isInterpolated(), "Not interpolated");
+            QVERIFY2(incrementalResult.getInterpolationStatus().isInterpolated(), "Not interpolated");
+
+            const CAircraftSituation fullSituation(fullResult);
+            const CAircraftSituation incrementalSituation(incrementalResult);
+            const double distanceM = fullSituation.calculateGreatCircleDistance(incrementalSituation).value(CLengthUnit::m());
+            const double altitudeDeltaM = (fullSituation.getAltitude() - incrementalSituation.getAltitude()).abs().value(CLengthUnit::m());
+            QVERIFY2(distanceM < 0.1, qPrintable(QStringLiteral("Position differs by %1m at %2").arg(distanceM).arg(currentTime)));
+            QVERIFY2(altitudeDeltaM < 0.1, qPrintable(QStringLiteral("Altitude differs by %1m at %2").arg(altitudeDeltaM).arg(currentTime)));
+        }
+    }
+
+    CAircraftSituation CTestInterpolatorSpline::getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset)
+    {
+        // straight and level flight to the north, about 1km per situation
+        const CCoordinateGeodetic position(48.0 - 0.01 * number, 11.0, 1000);
+        CAircraftSituation s(callsign, position, CHeading(0, CHeading::True, CAngleUnit::deg()), CAngle(0, CAngleUnit::deg()), CAngle(0, CAngleUnit::deg()), CSpeed(400, CSpeedUnit::km_h()));
+        s.setAltitude(CAltitude(1000, CAltitude::MeanSeaLevel, CLengthUnit::m()));
+        s.setGroundElevation(CAltitude(0, CAltitude::MeanSeaLevel, CLengthUnit::m()), CAircraftSituation::Test);
+        s.setMSecsSinceEpoch(ts - deltaT * number); // values in past
+        s.setTimeOffsetMs(offset);
+        return s;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestInterpolatorSpline);
+
+#include "testinterpolatorspline.moc"
+
+//! \endcond
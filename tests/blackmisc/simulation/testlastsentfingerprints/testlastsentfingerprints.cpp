@@ -0,0 +1,260 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/lastsentfingerprints.h"
+#include "blackmisc/aviation/aircraftenginelist.h"
+#include "blackmisc/aviation/aircraftlights.h"
+#include "blackmisc/aviation/aircraftparts.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+#include "test.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QTest>
+#include <QtDebug>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Fingerprints of last sent situations and parts
+    class CTestLastSentFingerprints : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Situation changes within and beyond the tolerances
+        void situations();
+
+        //! Parts changes
+        void parts();
+
+        //! Compare and remember in one call, forgetting after failed sends
+        void rememberIfChanged();
+
+        //! Quantising is bucketing by the tolerance
+        void bucketing();
+
+        //! Slots of removed callsigns are reused
+        void slotReuse();
+
+        //! Memory and time compared with copies of the situations
+        void comparedWithCopies();
+
+    private:
+        //! Test situation
+        static CAircraftSituation getTestSituation(const CCallsign &callsign, double offsetDeg = 0.0);
+    };
+
+    void CTestLastSentFingerprints::situations()
+    {
+        CLastSentFingerprints fingerprints;
+        const CCallsign cs("DAMBZ");
+        const CAircraftSituation s = getTestSituation(cs);
+        QVERIFY2(!fingerprints.isEqualLastSent(s), "Nothing sent yet");
+
+        fingerprints.rememberLastSent(s);
+        QVERIFY2(fingerprints.isEqualLastSent(s), "Expect same situation");
+        QVERIFY2(!fingerprints.isEqualLastSent(CAircraftSituation(CCallsign("OTHER"))), "Expect other callsign to differ");
+
+        CAircraftSituation moved(s);
+        moved.setPosition(getTestSituation(cs, 0.001).getPosition()); // about 100m
+        QVERIFY2(!fingerprints.isEqualLastSent(moved), "Expect moved situation");
+
+        CAircraftSituation turned(s);
+        turned.setHeading(CHeading(s.getHeading().value(CAngleUnit::deg()) + 1.0, CHeading::True, CAngleUnit::deg()));
+        QVERIFY2(!fingerprints.isEqualLastSent(turned), "Expect turned situation");
+
+        CAircraftSituation climbed(s);
+        climbed.setAltitude(CAltitude(s.getAltitude().value(CLengthUnit::m()) + 1.0, CAltitude::MeanSeaLevel, CLengthUnit::m()));
+        QVERIFY2(!fingerprints.isEqualLastSent(climbed), "Expect climbed situation");
+
+        CAircraftSituation elevation(s);
+        elevation.setGroundElevation(CAltitude(100, CAltitude::MeanSeaLevel, CLengthUnit::m()), CAircraftSituation::Test);
+        QVERIFY2(!fingerprints.isEqualLastSent(elevation), "Expect changed elevation");
+
+        // within tolerance
+        CAircraftSituation tiny(s);
+        tiny.setAltitude(CAltitude(s.getAltitude().value(CLengthUnit::m()) + 0.001, CAltitude::MeanSeaLevel, CLengthUnit::m()));
+        fingerprints.setTolerances(CLength(1, CLengthUnit::m()), CLength(1, CLengthUnit::m()), CAngle(1, CAngleUnit::deg()));
+        QVERIFY2(fingerprints.size() == 0, "Expect fingerprints dropped for new tolerances");
+        fingerprints.rememberLastSent(s);
+        QVERIFY2(fingerprints.isEqualLastSent(tiny), "Expect change within tolerance");
+        QVERIFY2(!fingerprints.isEqualLastSent(moved), "Expect moved situation beyond tolerance");
+
+        QVERIFY2(fingerprints.isLastSentMoving(cs), "Expect moving");
+        QVERIFY2(fingerprints.getLastSentCanLikelySkipNearGroundInterpolation().contains(cs), "Expect fast aircraft can skip near ground");
+    }
+
+    void CTestLastSentFingerprints::parts()
+    {
+        CLastSentFingerprints fingerprints;
+        const CCallsign cs("DAMBZ");
+        const CAircraftParts p(CAircraftLights(true, false, true, false, true, false), true, 20, false, CAircraftEngineList({ true, true }), true);
+        QVERIFY2(!fingerprints.isEqualLastSent(p, cs), "Nothing sent yet");
+
+        fingerprints.rememberLastSent(p, cs);
+        QVERIFY2(fingerprints.isEqualLastSent(p, cs), "Expect same parts");
+
+        CAircraftParts p2(p);
+        p2.setMSecsSinceEpoch(p.getMSecsSinceEpoch() + 1000);
+        QVERIFY2(fingerprints.isEqualLastSent(p2, cs), "Expect timestamp to be ignored");
+        QVERIFY2(p2.equalValues(p), "Expect timestamp to be ignored by parts");
+
+        p2.setFlapsPercent(25);
+        QVERIFY2(!fingerprints.isEqualLastSent(p2, cs), "Expect changed flaps");
+
+        CAircraftParts p3(p);
+        p3.setEngines(CAircraftEngineList({ true, false }));
+        QVERIFY2(!fingerprints.isEqualLastSent(p3, cs), "Expect changed engines");
+
+        CAircraftParts p4(p);
+        p4.lights().setLandingOn(true);
+        QVERIFY2(!fingerprints.isEqualLastSent(p4, cs), "Expect changed lights");
+
+        // situation and parts share the slot
+        fingerprints.rememberLastSent(getTestSituation(cs));
+        QVERIFY2(fingerprints.isEqualLastSent(p, cs), "Expect parts kept");
+        QVERIFY2(fingerprints.size() == 1, "Expect one aircraft");
+    }
+
+    void CTestLastSentFingerprints::rememberIfChanged()
+    {
+        CLastSentFingerprints fingerprints;
+        const CCallsign cs("DAMBZ");
+        const CAircraftSituation s = getTestSituation(cs);
+        QVERIFY2(fingerprints.rememberLastSentIfChanged(s), "Nothing sent yet");
+        QVERIFY2(!fingerprints.rememberLastSentIfChanged(s), "Expect same situation");
+        QVERIFY2(fingerprints.rememberLastSentIfChanged(s, true), "Expect forced situation");
+
+        const CAircraftSituation moved = getTestSituation(cs, 0.001);
+        QVERIFY2(fingerprints.rememberLastSentIfChanged(moved), "Expect moved situation");
+        QVERIFY2(fingerprints.isEqualLastSent(moved), "Expect moved situation remembered");
+
+        const CAircraftParts p(CAircraftLights(true, false, true, false, true, false), true, 20, false, CAircraftEngineList({ true, true }), true);
+        QVERIFY2(fingerprints.rememberLastSentIfChanged(p, cs), "No parts sent yet");
+        QVERIFY2(!fingerprints.rememberLastSentIfChanged(p, cs), "Expect same parts");
+
+        // sending failed
+        fingerprints.forgetLastSentSituation(cs);
+        QVERIFY2(!fingerprints.isEqualLastSent(moved), "Expect situation forgotten");
+        QVERIFY2(fingerprints.isEqualLastSent(p, cs), "Expect parts kept");
+        QVERIFY2(fingerprints.rememberLastSentIfChanged(moved), "Expect situation sent again");
+
+        fingerprints.forgetLastSentParts(cs);
+        QVERIFY2(!fingerprints.isEqualLastSent(p, cs), "Expect parts forgotten");
+        QVERIFY2(fingerprints.isEqualLastSent(moved), "Expect situation kept");
+        QVERIFY2(fingerprints.rememberLastSentIfChanged(p, cs), "Expect parts sent again");
+    }
+
+    void CTestLastSentFingerprints::bucketing()
+    {
+        CLastSentFingerprints fingerprints;
+        fingerprints.setTolerances(CLength(1, CLengthUnit::m()), CLength(1, CLengthUnit::m()), CAngle(1, CAngleUnit::deg()));
+        const CCallsign cs("DAMBZ");
+        const auto atAltitude = [&](double altitudeM) {
+            CAircraftSituation s = getTestSituation(cs);
+            s.setAltitude(CAltitude(altitudeM, CAltitude::MeanSeaLevel, CLengthUnit::m()));
+            return s;
+        };
+
+        fingerprints.rememberLastSent(atAltitude(100.6));
+        QVERIFY2(fingerprints.isEqualLastSent(atAltitude(101.4)), "Expect same bucket, 0.8m apart");
+        QVERIFY2(!fingerprints.isEqualLastSent(atAltitude(100.4)), "Expect other bucket, 0.2m apart");
+        QVERIFY2(!fingerprints.isEqualLastSent(atAltitude(101.6)), "Expect a difference of the tolerance to be a change");
+    }
+
+    void CTestLastSentFingerprints::slotReuse()
+    {
+        CLastSentFingerprints fingerprints;
+        for (int i = 0; i < 10; ++i) { fingerprints.rememberLastSent(getTestSituation(CCallsign(QStringLiteral("SWIFT%1").arg(i)), i)); }
+        QVERIFY2(fingerprints.size() == 10, "Expect 10 aircraft");
+
+        const CCallsign removed("SWIFT3");
+        fingerprints.remove(removed);
+        QVERIFY2(fingerprints.size() == 9, "Expect 9 aircraft");
+        QVERIFY2(!fingerprints.isEqualLastSent(getTestSituation(removed, 3)), "Expect removed aircraft to be unknown");
+
+        const CCallsign added("SWIFT10");
+        fingerprints.rememberLastSent(getTestSituation(added, 10));
+        QVERIFY2(fingerprints.getSlotCount() == 10, "Expect the slot to be reused");
+        QVERIFY2(fingerprints.isEqualLastSent(getTestSituation(added, 10)), "Expect added aircraft");
+        QVERIFY2(!fingerprints.isEqualLastSent(getTestSituation(CCallsign("SWIFT4"), 10)), "Expect other position to differ");
+
+        fingerprints.clear();
+        QVERIFY2(fingerprints.size() == 0, "Expect no aircraft");
+    }
+
+    void CTestLastSentFingerprints::comparedWithCopies()
+    {
+        constexpr int aircraftCount = 1000;
+        constexpr int rounds = 50;
+        QList<CAircraftSituation> situations;
+        for (int i = 0; i < aircraftCount; ++i) { situations.push_back(getTestSituation(CCallsign(QStringLiteral("SWIFT%1").arg(i)), i * 0.001)); }
+
+        QElapsedTimer timer;
+        timer.start();
+        CAircraftSituationPerCallsign copies;
+        int equalCopies = 0;
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (const CAircraftSituation &s : std::as_const(situations))
+            {
+                if (copies.contains(s.getCallsign()) && s.equalPbhVectorAltitudeElevation(copies.value(s.getCallsign()))) { equalCopies++; }
+                else { copies.insert(s.getCallsign(), s); }
+            }
+        }
+        const qint64 copiesNs = qMax(timer.nsecsElapsed(), 1LL);
+
+        timer.start();
+        CLastSentFingerprints fingerprints;
+        int equalFingerprints = 0;
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (const CAircraftSituation &s : std::as_const(situations))
+            {
+                if (fingerprints.isEqualLastSent(s)) { equalFingerprints++; }
+                else { fingerprints.rememberLastSent(s); }
+            }
+        }
+        const qint64 fingerprintsNs = qMax(timer.nsecsElapsed(), 1LL);
+
+        const int copyBytes = aircraftCount * static_cast<int>(sizeof(CCallsign) + sizeof(CAircraftSituation));
+        qDebug() << "copies" << copiesNs / 1000 << "us" << copyBytes << "bytes (shallow),"
+                 << "fingerprints" << fingerprintsNs / 1000 << "us" << fingerprints.getMemoryBytes() << "bytes";
+        QCOMPARE(equalFingerprints, equalCopies);
+        QVERIFY2(fingerprints.getMemoryBytes() < copyBytes, "Expect fingerprints to be smaller");
+    }
+
+    CAircraftSituation CTestLastSentFingerprints::getTestSituation(const CCallsign &callsign, double offsetDeg)
+    {
+        const CCoordinateGeodetic position(48.3536 + offsetDeg, 11.7858, 3000);
+        CAircraftSituation s(callsign, position, CHeading(270, CHeading::True, CAngleUnit::deg()), CAngle(2, CAngleUnit::deg()), CAngle(-5, CAngleUnit::deg()), CSpeed(250, CSpeedUnit::kts()));
+        s.setAltitude(CAltitude(3000, CAltitude::MeanSeaLevel, CLengthUnit::ft()));
+        return s;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestLastSentFingerprints);
+
+#include "testlastsentfingerprints.moc"
+
+//! \endcond
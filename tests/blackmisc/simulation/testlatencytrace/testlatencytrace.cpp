@@ -0,0 +1,256 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/latencytrace.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/callsign.h"
+#include "test.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QStringBuilder>
+#include <QTest>
+#include <QtDebug>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Latency trace of remote aircraft positions
+    class CTestLatencyTrace : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Start each test with an empty, enabled trace
+        void init();
+
+        //! Disable tracing after each test
+        void cleanup();
+
+        //! Nothing is recorded when disabled or not stamped
+        void disabled();
+
+        //! Stages of a position and the scope
+        void stages();
+
+        //! Threads write their own buffers
+        void threads();
+
+        //! Old events are overwritten
+        void overflow();
+
+        //! Chrome trace event JSON
+        void chromeTrace();
+
+        //! Positions of one socket read are separate flows
+        void chromeTraceSameRead();
+    };
+
+    void CTestLatencyTrace::init()
+    {
+        CLatencyTrace::clear();
+        CLatencyTrace::setEnabled(true);
+    }
+
+    void CTestLatencyTrace::cleanup()
+    {
+        CLatencyTrace::setEnabled(false);
+    }
+
+    void CTestLatencyTrace::disabled()
+    {
+        const CCallsign cs("DAMBZ");
+        CLatencyTrace::setEnabled(false);
+
+        constexpr int Calls = 1000000;
+        QElapsedTimer time;
+        time.start();
+        for (int i = 0; i < Calls; ++i) { CLatencyTrace::record(CLatencyTrace::Interpolation, cs, i, i, i + 1); }
+        qDebug() << "disabled record" << time.nsecsElapsed() / Calls << "ns per call";
+        QVERIFY2(CLatencyTrace::getEvents().isEmpty(), "Expect no events when disabled");
+
+        CLatencyTrace::setEnabled(true);
+        CLatencyTrace::record(CLatencyTrace::Interpolation, cs, -1, 0, 1);
+        QVERIFY2(CLatencyTrace::getEvents().isEmpty(), "Expect no events without stamp");
+
+        const CAircraftSituation situation(cs);
+        QVERIFY2(!situation.hasTraceReceivedNs(), "Expect situations not stamped by default");
+        {
+            const CLatencyTraceScope scope(CLatencyTrace::ProviderStore, situation);
+        }
+        QVERIFY2(CLatencyTrace::getEvents().isEmpty(), "Expect no scope event without stamp");
+    }
+
+    void CTestLatencyTrace::stages()
+    {
+        const CCallsign cs("DAMBZ");
+        CAircraftSituation situation(cs);
+        const qint64 receivedNs = CLatencyTrace::nowNs();
+        situation.setTraceReceivedNs(receivedNs);
+        CLatencyTrace::record(CLatencyTrace::FsdReceived, cs, receivedNs, receivedNs, CLatencyTrace::nowNs());
+        {
+            const CLatencyTraceScope scope(CLatencyTrace::AirspaceMonitor, situation);
+            const CLatencyTraceScope nested(CLatencyTrace::ProviderStore, situation);
+        }
+
+        // stamp is copied with the situation, but not compared
+        const CAircraftSituation copy(situation);
+        QCOMPARE(copy.getTraceReceivedNs(), receivedNs);
+        QVERIFY2(copy == CAircraftSituation(cs), "Expect stamp ignored by comparison");
+        CLatencyTrace::record(CLatencyTrace::Interpolation, cs, copy.getTraceReceivedNs(), CLatencyTrace::nowNs(), CLatencyTrace::nowNs());
+
+        const QVector<CLatencyTrace::Event> events = CLatencyTrace::getEvents();
+        QCOMPARE(events.size(), 4);
+        QSet<int> stages;
+        for (const CLatencyTrace::Event &e : events)
+        {
+            QCOMPARE(e.getCallsign(), cs.asString());
+            QCOMPARE(e.receivedNs, receivedNs);
+            QVERIFY2(e.getDurationNs() >= 0, "Expect non negative duration");
+            QVERIFY2(e.getSinceReceivedNs() >= 0, "Expect stage after receive");
+            stages.insert(e.stage);
+        }
+        QCOMPARE(stages.size(), 4);
+
+        const QString histogram = CLatencyTrace::getHistogram(events);
+        QVERIFY2(histogram.contains(CLatencyTrace::stageName(CLatencyTrace::ProviderStore)), "Expect stage in histogram");
+        QVERIFY2(!histogram.contains(CLatencyTrace::stageName(CLatencyTrace::SimulatorSend)), "Expect no stage without events");
+
+        CLatencyTrace::clear();
+        QVERIFY2(CLatencyTrace::getEvents().isEmpty(), "Expect no events after clear");
+    }
+
+    void CTestLatencyTrace::threads()
+    {
+        constexpr int Threads = 4;
+        constexpr int PerThread = 1000;
+        std::atomic_int started { 0 };
+        std::vector<std::thread> threads;
+        for (int t = 0; t < Threads; ++t)
+        {
+            threads.emplace_back([&started, t] {
+                // all threads alive at the same time, so none reuses the buffer of another
+                started++;
+                while (started.load() < Threads) { std::this_thread::yield(); }
+
+                const CCallsign cs(QStringLiteral("TEST%1").arg(t));
+                for (int i = 0; i < PerThread; ++i)
+                {
+                    const qint64 now = CLatencyTrace::nowNs();
+                    CLatencyTrace::record(CLatencyTrace::Interpolation, cs, now, now, CLatencyTrace::nowNs());
+                }
+            });
+        }
+        for (std::thread &t : threads) { t.join(); }
+
+        const QVector<CLatencyTrace::Event> events = CLatencyTrace::getEvents();
+        QCOMPARE(events.size(), Threads * PerThread);
+        QSet<int> buffers;
+        for (int i = 0; i < events.size(); ++i)
+        {
+            buffers.insert(events[i].thread);
+            if (i > 0) { QVERIFY2(events[i - 1].startNs <= events[i].startNs, "Expect sorted by start"); }
+        }
+        QCOMPARE(buffers.size(), Threads);
+    }
+
+    void CTestLatencyTrace::overflow()
+    {
+        const CCallsign cs("DAMBZ");
+        constexpr int Extra = 100;
+        for (int i = 0; i < CLatencyTrace::EventsPerThread + Extra; ++i)
+        {
+            const qint64 now = CLatencyTrace::nowNs();
+            CLatencyTrace::record(CLatencyTrace::SimulatorSend, cs, now - i, now, now);
+        }
+        const QVector<CLatencyTrace::Event> events = CLatencyTrace::getEvents();
+        QCOMPARE(events.size(), CLatencyTrace::EventsPerThread);
+        qint64 oldest = std::numeric_limits<qint64>::max();
+        for (const CLatencyTrace::Event &e : events) { oldest = std::min(oldest, e.getSinceReceivedNs()); }
+        QCOMPARE(oldest, static_cast<qint64>(Extra)); // the first events are overwritten
+    }
+
+    void CTestLatencyTrace::chromeTrace()
+    {
+        const CCallsign cs("DAMBZ");
+        const qint64 receivedNs = CLatencyTrace::nowNs();
+        CLatencyTrace::record(CLatencyTrace::FsdReceived, cs, receivedNs, receivedNs, receivedNs + 2000);
+        CLatencyTrace::record(CLatencyTrace::Interpolation, cs, receivedNs, receivedNs + 5000, receivedNs + 9000);
+        CLatencyTrace::record(CLatencyTrace::SimulatorSend, cs, receivedNs, receivedNs + 9000, receivedNs + 9500);
+
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(CLatencyTrace::toChromeTraceJson(CLatencyTrace::getEvents()).toUtf8(), &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        const QJsonArray traceEvents = doc.object().value("traceEvents").toArray();
+
+        int slices = 0;
+        QStringList flow;
+        for (const QJsonValue &v : traceEvents)
+        {
+            const QJsonObject e = v.toObject();
+            const QString ph = e.value("ph").toString();
+            if (ph == "X")
+            {
+                slices++;
+                QCOMPARE(e.value("args").toObject().value("callsign").toString(), cs.asString());
+            }
+            else if (ph == "s" || ph == "t" || ph == "f")
+            {
+                flow << ph;
+                QCOMPARE(e.value("id").toString(), QString(cs.asString() % u"_" % QString::number(receivedNs, 16)));
+            }
+        }
+        QCOMPARE(slices, 3);
+        QCOMPARE(flow, QStringList({ "s", "t", "f" }));
+    }
+
+    void CTestLatencyTrace::chromeTraceSameRead()
+    {
+        // all lines of one read are stamped with the same receive time
+        const CCallsign cs1("DAMBZ");
+        const CCallsign cs2("DLH123");
+        const qint64 receivedNs = CLatencyTrace::nowNs();
+        for (const CCallsign &cs : { cs1, cs2 })
+        {
+            CLatencyTrace::record(CLatencyTrace::FsdReceived, cs, receivedNs, receivedNs, receivedNs + 2000);
+            CLatencyTrace::record(CLatencyTrace::SimulatorSend, cs, receivedNs, receivedNs + 9000, receivedNs + 9500);
+        }
+
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(CLatencyTrace::toChromeTraceJson(CLatencyTrace::getEvents()).toUtf8(), &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+
+        QHash<QString, QStringList> flows; // id, phases
+        for (const QJsonValue &v : doc.object().value("traceEvents").toArray())
+        {
+            const QJsonObject e = v.toObject();
+            const QString ph = e.value("ph").toString();
+            if (ph == "s" || ph == "t" || ph == "f") { flows[e.value("id").toString()] << ph; }
+        }
+        QCOMPARE(flows.size(), 2);
+        for (const QStringList &phases : std::as_const(flows)) { QCOMPARE(phases, QStringList({ "s", "f" })); }
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestLatencyTrace);
+
+#include "testlatencytrace.moc"
+
+//! \endcond
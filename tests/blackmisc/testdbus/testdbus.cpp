@@ -10,11 +10,13 @@
 
 #include "blackmisc/registermetadata.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
+#include "blackmisc/test/testdata.h"
 #include "blackmisc/test/testservice.h"
 #include "blackmisc/test/testserviceinterface.h"
 #include "blackmisc/dbusutils.h"
 #include "test.h"
 #include <QDBusConnection>
+#include <QElapsedTimer>
 #include <QTest>
 
 using namespace BlackMisc;
@@ -37,6 +39,10 @@ namespace BlackMiscTest
 
         //! Signature size
         void signatureSize();
+
+        //! Large containers marshalled as one QDataStream blob
+        void dataStreamSignature();
+
     };
 
     void CTestDBus::initTestCase()
@@ -57,6 +63,32 @@ namespace BlackMiscTest
         ITestServiceInterface testServiceInterface(CTestService::InterfaceName(), CTestService::ObjectPath(), connection);
         const int errors = ITestServiceInterface::pingTests(testServiceInterface, false);
         QVERIFY2(errors == 0, "DBus Ping tests fail");
+
+        // large containers, with throughput
+        constexpr int count = 5000;
+        CAircraftModelList models;
+        CSimulatedAircraftList aircraft;
+        for (int i = 0; i < count; i++)
+        {
+            CAircraftModel model = CTestData::getDbAircraftModelFsxAerosoftA320();
+            model.setModelString(model.getModelString() + QString::number(i));
+            models.push_back(model);
+
+            CSimulatedAircraft ac = CTestData::getA320Aircraft();
+            ac.setCallsign(Aviation::CCallsign(QStringLiteral("SWIFT%1").arg(i)));
+            aircraft.push_back(ac);
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        const CAircraftModelList modelsPing = testServiceInterface.pingAircraftModelList(models);
+        const qint64 modelsMs = timer.restart();
+        const CSimulatedAircraftList aircraftPing = testServiceInterface.pingAircraftList(aircraft);
+        const qint64 aircraftMs = timer.elapsed();
+
+        QVERIFY2(modelsPing == models, "Large model list round trip");
+        QVERIFY2(aircraftPing == aircraft, "Large aircraft list round trip");
+        qDebug() << "Round trip" << count << "models:" << modelsMs << "ms," << count << "aircraft:" << aircraftMs << "ms";
     }
 
     void CTestDBus::signatureSize()
@@ -77,6 +109,22 @@ namespace BlackMiscTest
         s = CDBusUtils::dBusSignature(al);
         QVERIFY2(s.length() <= max, "Signature CSimulatedAircraftList");
     }
+
+    void CTestDBus::dataStreamSignature()
+    {
+        const QString blob("(ay)");
+        QDBusArgument arg1;
+        arg1 << CAircraftModelList();
+        QCOMPARE(arg1.currentSignature(), blob);
+
+        QDBusArgument arg2;
+        arg2 << CSimulatedAircraftList();
+        QCOMPARE(arg2.currentSignature(), blob);
+
+        QDBusArgument arg3;
+        arg3 << CStatusMessageList();
+        QCOMPARE(arg3.currentSignature(), blob);
+    }
 }
 
 //! main
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+
+/*!
+ * \file
+ * \ingroup testblackmisc
+ */
+
+#include "blackmisc/directorystatcache.h"
+#include "blackmisc/fileutils.h"
+#include "test.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+#include <atomic>
+
+using namespace BlackMisc;
+
+namespace BlackMiscTest
+{
+    //! Testing the directory stat cache
+    class CTestDirectoryStatCache : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Existing and missing files
+        void existingFiles();
+
+        //! Reuse of unchanged directories
+        void reuseDirectories();
+
+        //! Modification times of files
+        void fileTimestamps();
+    };
+
+    void CTestDirectoryStatCache::existingFiles()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY2(tempDir.isValid(), "Invalid directory");
+        QVERIFY(QDir(tempDir.path()).mkpath("a"));
+        QVERIFY(QDir(tempDir.path()).mkpath("b"));
+
+        const QString a1 = CFileUtils::appendFilePaths(tempDir.path(), "a/aircraft.cfg");
+        const QString a2 = CFileUtils::appendFilePaths(tempDir.path(), "a/missing.cfg");
+        const QString b1 = CFileUtils::appendFilePaths(tempDir.path(), "b/aircraft.cfg");
+        const QString c1 = CFileUtils::appendFilePaths(tempDir.path(), "c/aircraft.cfg");
+        QVERIFY(CFileUtils::writeStringToFile("[fltsim.0]", a1));
+        QVERIFY(CFileUtils::writeStringToFile("[fltsim.0]", b1));
+
+        CDirectoryStatCache cache;
+        const std::atomic_bool stopped { false };
+        const QSet<QString> existing = cache.getExistingFiles({ a1, a2, b1, c1 }, stopped);
+        QCOMPARE(existing, QSet<QString>({ a1, b1 }));
+        QCOMPARE(cache.size(), 3);
+        QCOMPARE(cache.getCheckedDirectoriesCount(), 3);
+        QCOMPARE(cache.getReusedDirectoriesCount(), 0);
+    }
+
+    void CTestDirectoryStatCache::reuseDirectories()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY2(tempDir.isValid(), "Invalid directory");
+        const QString a1 = CFileUtils::appendFilePaths(tempDir.path(), "aircraft.cfg");
+        QVERIFY(CFileUtils::writeStringToFile("[fltsim.0]", a1));
+
+        CDirectoryStatCache cache;
+        const std::atomic_bool stopped { false };
+        QCOMPARE(cache.getExistingFiles({ a1 }, stopped), QSet<QString>({ a1 }));
+
+        QCOMPARE(cache.getExistingFiles({ a1 }, stopped), QSet<QString>({ a1 }));
+        QCOMPARE(cache.getReusedDirectoriesCount(), 1);
+        QCOMPARE(cache.getCheckedDirectoriesCount(), 0);
+
+        QVERIFY(tempDir.remove());
+        QVERIFY(cache.getExistingFiles({ a1 }, stopped).isEmpty());
+        QCOMPARE(cache.getCheckedDirectoriesCount(), 1);
+    }
+
+    void CTestDirectoryStatCache::fileTimestamps()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY2(tempDir.isValid(), "Invalid directory");
+        QVERIFY(QDir(tempDir.path()).mkpath("a"));
+
+        const QString a1 = CFileUtils::appendFilePaths(tempDir.path(), "a/aircraft.cfg");
+        const QString a2 = CFileUtils::appendFilePaths(tempDir.path(), "a/missing.cfg");
+        const QString c1 = CFileUtils::appendFilePaths(tempDir.path(), "c/aircraft.cfg");
+        QVERIFY(CFileUtils::writeStringToFile("[fltsim.0]", a1));
+
+        const std::atomic_bool stopped { false };
+        const QHash<QString, qint64> timestamps = CDirectoryStatCache::getFileTimestamps({ a1, a2, c1 }, stopped);
+        QCOMPARE(timestamps.size(), 3);
+        QCOMPARE(timestamps.value(a1), QFileInfo(a1).lastModified().toMSecsSinceEpoch());
+        QCOMPARE(timestamps.value(a2), qint64(-1));
+        QCOMPARE(timestamps.value(c1), qint64(-1));
+    }
+}
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestDirectoryStatCache);
+
+#include "testdirectorystatcache.moc"
+
+//! \endcond
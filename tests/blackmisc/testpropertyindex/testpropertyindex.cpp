@@ -6,6 +6,8 @@
 //! \ingroup testblackmisc
 
 #include "blackmisc/simulation/simulatedaircraft.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/propertyaccessor.h"
 #include "blackmisc/statusmessagelist.h"
 #include "blackmisc/sequence.h"
 #include "blackmisc/comparefunctions.h"
@@ -30,6 +32,9 @@ namespace BlackMiscTest
 
         //! Sorting based on property index
         void propertyIndexSort();
+
+        //! Compiled accessors return and compare as propertyByIndex and comparePropertyByIndex
+        void propertyAccessor();
     };
 
     void CTestPropertyIndex::propertyIndexCSimulatedAircraft()
@@ -104,6 +109,60 @@ namespace BlackMiscTest
         QVERIFY(msgs.front().getMSecsSinceEpoch() == 4000);
         QVERIFY(msgs.back().getMSecsSinceEpoch() == 1000);
     }
+
+    void CTestPropertyIndex::propertyAccessor()
+    {
+        CAircraftModel m1("B738 Lufthansa", CAircraftModel::TypeOwnSimulatorModel);
+        m1.setName("boeing 737");
+        m1.setDescription("Lufthansa B737-800");
+        m1.setFileName("c:/models/b738/aircraft.cfg");
+        m1.setSupportedParts("EFGLSDT");
+        m1.setFileTimestamp(QDateTime::fromMSecsSinceEpoch(2000, Qt::UTC));
+        m1.setDbKey(20);
+        CAircraftModel m2("a320 Lufthansa", CAircraftModel::TypeOwnSimulatorModel);
+        m2.setName("Airbus A320");
+        m2.setDescription("lufthansa A320");
+        m2.setFileName("c:/models/A320/aircraft.cfg");
+        m2.setSupportedParts("efgl");
+        m2.setDbKey(10);
+        const QList<CAircraftModel> models { m1, m2, m1 };
+
+        const QList<CPropertyIndex> compiled {
+            CAircraftModel::IndexModelString, CAircraftModel::IndexName, CAircraftModel::IndexDescription,
+            CAircraftModel::IndexFileName, CAircraftModel::IndexSupportedParts, CAircraftModel::IndexFileTimestamp,
+            CAircraftModel::IndexHasQueriedModelString, CAircraftModel::IndexDbIntegerKey
+        };
+        for (const CPropertyIndex &index : compiled)
+        {
+            const CPropertyAccessor<CAircraftModel> accessor(index);
+            QVERIFY2(accessor.isCompiled(), qPrintable(index.toQString()));
+            for (const CAircraftModel &a : models)
+            {
+                QCOMPARE(accessor.value(a), a.propertyByIndex(index));
+                for (const CAircraftModel &b : models) { QCOMPARE(accessor.compare(a, b), a.comparePropertyByIndex(index, b)); }
+            }
+        }
+
+        // typed values
+        QCOMPARE(CPropertyAccessor<CAircraftModel>(CAircraftModel::IndexModelString).string(m2), m2.getModelString());
+        QCOMPARE(CPropertyAccessor<CAircraftModel>(CAircraftModel::IndexModelString).getCaseSensitivity(), Qt::CaseInsensitive);
+        QCOMPARE(CPropertyAccessor<CAircraftModel>(CAircraftModel::IndexDbIntegerKey).number(m1), 20.0);
+        QCOMPARE(CPropertyAccessor<CAircraftModel>(CAircraftModel::IndexFileTimestamp).timestamp(m1), qint64(2000));
+        QVERIFY(CPropertyAccessor<CAircraftModel>(CAircraftModel::IndexFileTimestamp).timestamp(m2) < 0);
+
+        // nested, not registered and classes without accessors are resolved at runtime
+        const CPropertyIndex nested({ CAircraftModel::IndexAircraftIcaoCode, CAircraftIcaoCode::IndexAircraftDesignator });
+        for (const CPropertyIndex &index : { nested, CPropertyIndex(CAircraftModel::IndexModelType) })
+        {
+            const CPropertyAccessor<CAircraftModel> accessor(index);
+            QVERIFY(!accessor.isCompiled());
+            QCOMPARE(accessor.value(m1), m1.propertyByIndex(index));
+            QCOMPARE(accessor.compare(m1, m2), m1.comparePropertyByIndex(index, m2));
+        }
+        const CPropertyAccessor<CCallsign> callsign(CCallsign::IndexCallsignString);
+        QVERIFY(!callsign.isCompiled());
+        QCOMPARE(callsign.compare(CCallsign("DLH1000"), CCallsign("DLH2000")), CCallsign("DLH1000").comparePropertyByIndex(CCallsign::IndexCallsignString, CCallsign("DLH2000")));
+    }
 } // namespace
 
 //! main
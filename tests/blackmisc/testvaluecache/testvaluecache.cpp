@@ -22,6 +22,7 @@
 #include <QCoreApplication>
 #include <QDateTime>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFileInfo>
 #include <QFlags>
 #include <QJsonObject>
@@ -34,9 +35,12 @@
 #include <QThread>
 #include <QTimer>
 #include <QtDebug>
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <ratio>
+#include <thread>
+#include <vector>
 
 namespace BlackMiscTest
 {
@@ -73,6 +77,9 @@ namespace BlackMiscTest
 
         //! Test saving to and loading from files.
         void saveAndLoad();
+
+        //! Benchmark of 8 threads reading a value while the owner thread keeps writing it.
+        void readContention();
     };
 
     //! Simple class which uses CCached, for testing.
@@ -299,6 +306,48 @@ namespace BlackMiscTest
         QCOMPARE(test2Values, testData);
     }
 
+    void CTestValueCache::readContention()
+    {
+        CValueCache cache(1);
+        for (int i = 0; i < 2; ++i) { QTest::ignoreMessage(QtDebugMsg, QRegularExpression("Empty cache value")); }
+        CValueCacheUser user(&cache);
+
+        constexpr int readerCount = 8;
+        std::atomic_bool stop { false };
+        std::atomic_bool invalid { false };
+        std::atomic<qint64> reads { 0 };
+        std::vector<std::thread> readers;
+        for (int r = 0; r < readerCount; ++r)
+        {
+            readers.emplace_back([&] {
+                qint64 count = 0;
+                while (!stop)
+                {
+                    const int value = user.m_value1.get();
+                    if (value < 0 || value > 100) { invalid = true; }
+                    count++;
+                }
+                reads += count;
+            });
+        }
+
+        QElapsedTimer time;
+        time.start();
+        int writes = 0;
+        while (time.elapsed() < 1000)
+        {
+            user.m_value1.set(writes++ % 100);
+            QCoreApplication::processEvents();
+        }
+        stop = true;
+        for (auto &reader : readers) { reader.join(); }
+        const qint64 ms = time.elapsed();
+
+        qDebug() << readerCount << "readers:" << reads.load() << "reads," << writes << "writes in" << ms << "ms," << (reads.load() / qMax<qint64>(ms, 1)) << "reads/ms";
+        QVERIFY2(!invalid, "Readers only see valid values");
+        QVERIFY2(reads > 0, "Readers are not starved");
+    }
+
     //! Is value between 0 - 100?
     bool validator(int value, QString &)
     {
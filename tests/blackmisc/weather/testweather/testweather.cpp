@@ -20,6 +20,7 @@
 #include "blackmisc/weather/cloudlayerlist.h"
 #include "blackmisc/weather/metar.h"
 #include "blackmisc/weather/metardecoder.h"
+#include "blackmisc/weather/metarlist.h"
 #include "blackmisc/weather/presentweather.h"
 #include "blackmisc/weather/presentweatherlist.h"
 #include "blackmisc/weather/temperaturelayer.h"
@@ -30,7 +31,11 @@
 #include "blackmisc/weather/windlayerlist.h"
 #include "test.h"
 
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QStringList>
 #include <QTest>
+#include <QtDebug>
 
 using namespace BlackMisc::Weather;
 using namespace BlackMisc::Aviation;
@@ -58,6 +63,13 @@ namespace BlackMiscTest
 
         //! Testing METAR decoder
         void metarDecoder();
+
+        //! Single pass decoder compared with the former decoder over a generated corpus
+        void metarDecoderConformance();
+
+    private:
+        //! Random METARs, mostly valid, some with misplaced or broken groups
+        static QStringList generateMetarCorpus(int count);
     };
 
     void CTestWeather::cloudLayer()
@@ -210,6 +222,96 @@ namespace BlackMiscTest
         QVERIFY2(cloudLayers2.findByBase(CAltitude(30000, CAltitude::AboveGround, CLengthUnit::ft())).getCoverage() == CCloudLayer::Scattered, "Failed to parse cloud layer in 30000 ft");
     }
 
+    void CTestWeather::metarDecoderConformance()
+    {
+        const QStringList corpus = generateMetarCorpus(20000);
+        const CMetarDecoder metarDecoder;
+
+        QElapsedTimer time;
+        time.start();
+        int valid = 0;
+        QList<CMetar> metars;
+        metars.reserve(corpus.size());
+        for (const QString &metarString : corpus)
+        {
+            const CMetar metar = metarDecoder.decode(metarString);
+            if (metar != CMetar()) { valid++; }
+            metars.push_back(metar);
+        }
+        const qint64 singlePassMs = time.restart();
+
+        for (int i = 0; i < corpus.size(); ++i)
+        {
+            const CMetar reference = metarDecoder.decodeByRewriting(corpus.at(i));
+            QVERIFY2(metars.at(i) == reference, qPrintable(corpus.at(i)));
+        }
+        const qint64 rewritingMs = time.restart();
+
+        int invalid = -1;
+        const CMetarList bulk = metarDecoder.decode(corpus, &invalid);
+        const qint64 bulkMs = time.elapsed();
+        QCOMPARE(bulk.size(), valid);
+        QCOMPARE(invalid, corpus.size() - valid);
+        QVERIFY2(valid > corpus.size() / 2, "Expect mostly valid METARs");
+        QVERIFY2(invalid > 0, "Expect some invalid METARs");
+
+        qDebug() << corpus.size() << "METARs," << valid << "valid, single pass" << singlePassMs << "ms, rewriting" << rewritingMs << "ms, parallel" << bulkMs << "ms";
+    }
+
+    QStringList CTestWeather::generateMetarCorpus(int count)
+    {
+        QRandomGenerator random(4711);
+        const auto pick = [&random](const QStringList &tokens) { return tokens.at(random.bounded(tokens.size())); };
+        const auto chance = [&random](int percent) { return random.bounded(100) < percent; };
+
+        const QStringList airports = { "EDDM", "EDDF", "KLBB", "KJFK", "LOWW", "EGLL", "LSZH", "YSSY", "RJTT", "CYYZ" };
+        const QStringList status = { "AUTO", "COR", "NIL", "CCA", "XYZZY" };
+        const QStringList winds = { "20009KT", "VRB02KT", "27015G25KT", "00000KT", "/////KT", "12005MPS", "090110KT", "18010KMH", "33012G22MPS", "27010XX" };
+        const QStringList variations = { "240V300", "010V090", "350V040" };
+        const QStringList visibilities = { "CAVOK", "9999", "9000NDV", "0800", "10SM", "1/2SM", "1 1/2SM", "M1/4SM", "4000SW" };
+        const QStringList rvrs = { "R26L/1200N", "R08/P1500", "R35R/0600V1000FT/U", "R24/M0050D" };
+        const QStringList weathers = { "-SHRA", "+TSRA", "BR", "FG", "VCSH", "-DZ", "FZFG", "BLSN", "+FC", "SN" };
+        const QStringList clouds = { "FEW045", "SCT220", "BKN012CB", "OVC008", "SCT030TCU", "NSC", "SKC", "CLR", "NCD", "BKN///" };
+        const QStringList verticalVisibilities = { "VV002", "VV///" };
+        const QStringList temperatures = { "28/17", "M02/M05", "15/10", "00/M01", "/////", "M12/" };
+        const QStringList pressures = { "Q1013", "A3022", "Q0998", "Q////", "A2992" };
+        const QStringList recentWeathers = { "RESHRA", "RETS", "RE-DZ" };
+        const QStringList windShears = { "WS ALL RWY", "WS RWY26L", "WS R08" };
+        const QStringList remarks = { "NOSIG", "BECMG 4000", "TEMPO SHRA", "RMK AO2 SLP201", "RMK QFE 745.5", "QFE 1010.2" };
+
+        QStringList corpus;
+        corpus.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            QStringList tokens;
+            if (chance(20)) { tokens << (chance(50) ? "METAR" : "SPECI"); }
+            tokens << pick(airports);
+            tokens << QStringLiteral("%1%2%3Z").arg(random.bounded(1, 29), 2, 10, QChar('0')).arg(random.bounded(24), 2, 10, QChar('0')).arg(random.bounded(60), 2, 10, QChar('0'));
+            if (chance(10)) { tokens << pick(status); }
+            if (chance(95)) { tokens << pick(winds); }
+            if (chance(15)) { tokens << pick(variations); }
+            if (chance(90)) { tokens << pick(visibilities); }
+            if (chance(10)) { tokens << pick(rvrs); }
+            for (int w = random.bounded(3); w > 0; --w) { tokens << pick(weathers); }
+            for (int c = random.bounded(4); c > 0; --c) { tokens << pick(clouds); }
+            if (chance(5)) { tokens << pick(verticalVisibilities); }
+            if (chance(90)) { tokens << pick(temperatures); }
+            if (chance(90)) { tokens << pick(pressures); }
+            if (chance(10)) { tokens << pick(recentWeathers); }
+            if (chance(5)) { tokens << pick(windShears); }
+            if (chance(30)) { tokens << pick(remarks); }
+
+            // misplaced, missing or broken groups
+            if (chance(5) && tokens.size() > 3) { tokens.swapItemsAt(random.bounded(tokens.size() - 1), tokens.size() - 1); }
+            if (chance(3)) { tokens.removeAt(random.bounded(tokens.size())); }
+            if (chance(3)) { tokens.insert(random.bounded(tokens.size()), QStringLiteral("#?!")); }
+
+            // extra blanks are simplified by the decoder
+            corpus.push_back(tokens.join(chance(5) ? QStringLiteral("  ") : QStringLiteral(" ")));
+        }
+        return corpus;
+    }
+
 } // namespace
 
 //! main
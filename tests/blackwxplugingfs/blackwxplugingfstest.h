@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+#ifndef BLACKWXPLUGINGFSTEST_H
+#define BLACKWXPLUGINGFSTEST_H
+
+//! \cond PRIVATE_TESTS
+
+/*!
+ * \defgroup testpluginsgfs BlackWxPlugin GFS Unit Tests
+ * \ingroup tests
+ * Unit tests for the GFS weather data plugin. Unit tests do have their own namespace, so
+ * the regular namespace BlackWxPlugin is completely free of unit tests.
+ */
+
+//! \endcond
+
+#endif // guard
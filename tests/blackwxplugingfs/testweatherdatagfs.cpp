@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: Copyright (C) 2024 swift Project Community / Contributors
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-swift-pilot-client-1
+
+//! \cond PRIVATE_TESTS
+
+/*!
+ * \file
+ * \ingroup testpluginsgfs
+ */
+
+#include "plugins/weatherdata/gfs/gfstilecache.h"
+#include "plugins/weatherdata/gfs/weatherdatagfs.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/weather/weathergrid.h"
+#include "test.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace BlackWxPlugin::Gfs;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Weather;
+
+namespace BlackWxPluginGfsTest
+{
+    //! GFS weather data plugin tests
+    class CTestWeatherDataGfs : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Tile cache miss, hit and expiry
+        void tileCache();
+
+        //! A new forecast hour misses the cache and expires the older hours
+        void forecastHourKey();
+
+        //! Fetch from cached tiles only, and a request while fetching
+        void cachedFetch();
+
+    private:
+        //! Synthetic grid point
+        static GfsGridPoint gridPoint(float latitude, float longitude);
+    };
+
+    GfsGridPoint CTestWeatherDataGfs::gridPoint(float latitude, float longitude)
+    {
+        GfsGridPoint point;
+        point.latitude = latitude;
+        point.longitude = longitude;
+        point.pressureAtMsl = 101325.0f;
+        point.surfaceRain = 1.0f;
+        point.cloudLayers.push_back({ 85000.0f, 70000.0f, 50.0f, 270.0f });
+        point.isobaricLayers.push_back({ 50000.0f, 250.0f, 40.0f, 10.0f, -5.0f });
+        point.isobaricLayers.push_back({ 85000.0f, 280.0f, 70.0f, 3.0f, 2.0f });
+        return point;
+    }
+
+    void CTestWeatherDataGfs::tileCache()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const CGfsTileCache cache(dir.path());
+        const GfsTile tile { 40, 0 };
+        const QVector<GfsGridPoint> points { gridPoint(47.5f, 8.5f), gridPoint(42.0f, 5.0f) };
+
+        // miss
+        QVector<GfsGridPoint> read;
+        QVERIFY(!cache.contains("2024051206", tile));
+        QVERIFY(!cache.readTile("2024051206", tile, read));
+
+        // hit, same run only
+        QVERIFY(cache.writeTile("2024051206", tile, points));
+        QVERIFY(cache.contains("2024051206", tile));
+        QVERIFY(!cache.contains("2024051200", tile));
+        QVERIFY(!cache.contains("2024051206", GfsTile { 40, 10 }));
+        QVERIFY(cache.readTile("2024051206", tile, read));
+        QCOMPARE(read.size(), points.size());
+        for (int i = 0; i < points.size(); ++i)
+        {
+            QCOMPARE(read[i].latitude, points[i].latitude);
+            QCOMPARE(read[i].longitude, points[i].longitude);
+            QCOMPARE(read[i].pressureAtMsl, points[i].pressureAtMsl);
+            QCOMPARE(read[i].cloudLayers.size(), points[i].cloudLayers.size());
+            QCOMPARE(read[i].isobaricLayers.size(), points[i].isobaricLayers.size());
+            QCOMPARE(read[i].isobaricLayers.back().windU, points[i].isobaricLayers.back().windU);
+        }
+
+        // a corrupt tile is a miss
+        QFile corrupt(cache.getFileName("2024051212", tile));
+        QVERIFY(corrupt.open(QIODevice::WriteOnly));
+        corrupt.write("not a tile");
+        corrupt.close();
+        QVERIFY(!cache.readTile("2024051212", tile, read));
+
+        // expiry, the tiles of other runs are removed
+        QCOMPARE(cache.removeExpiredTiles("2024051212"), 1);
+        QVERIFY(!cache.contains("2024051206", tile));
+        QVERIFY(cache.contains("2024051212", tile));
+        QCOMPARE(cache.removeExpiredTiles("2024051212"), 0);
+    }
+
+    void CTestWeatherDataGfs::forecastHourKey()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const CGfsTileCache cache(dir.path());
+        const GfsTile tile { 40, 0 };
+
+        const QDateTime cycle(QDate(2024, 5, 12), QTime(6, 0), Qt::UTC);
+        const QString hour1 = CWeatherDataGfs::getRunKey(cycle, 1);
+        const QString hour2 = CWeatherDataGfs::getRunKey(cycle, 2);
+        QCOMPARE(hour1, QString("2024051206_f001"));
+        QVERIFY(hour1 != hour2);
+
+        // same run, next forecast hour is a miss
+        QVERIFY(cache.writeTile(hour1, tile, { gridPoint(47.5f, 8.5f) }));
+        QVERIFY(cache.contains(hour1, tile));
+        QVERIFY(!cache.contains(hour2, tile));
+
+        // the older hour expires
+        QVERIFY(cache.writeTile(hour2, tile, { gridPoint(47.5f, 8.5f) }));
+        QCOMPARE(cache.removeExpiredTiles(hour2), 1);
+        QVERIFY(!cache.contains(hour1, tile));
+        QVERIFY(cache.contains(hour2, tile));
+    }
+
+    void CTestWeatherDataGfs::cachedFetch()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const CGfsTileCache cache(dir.path());
+
+        // all tiles around the requested position, one point near, one far away
+        const QString runKey = CWeatherDataGfs::getCurrentRunKey();
+        for (int south : { 30, 40, 50 })
+        {
+            for (int west : { 350, 0, 10 })
+            {
+                const GfsTile tile { south, west };
+                const QVector<GfsGridPoint> points { gridPoint(south + 7.5f, west + 8.5f), gridPoint(south + 2.0f, west + 5.0f) };
+                QVERIFY(cache.writeTile(runKey, tile, points));
+            }
+        }
+        const GfsTile oldTile { 40, 0 };
+        QVERIFY(cache.writeTile("2000010100", oldTile, { gridPoint(47.4f, 8.5f) }));
+
+        CWeatherDataGfs gfs;
+        gfs.setTileCacheDirectory(dir.path());
+        QCOMPARE(gfs.getTileCache().getDirectory(), dir.path());
+        QSignalSpy finished(&gfs, &CWeatherDataGfs::fetchingFinished);
+
+        const CWeatherGrid grid(CCoordinateGeodetic(47.4, 8.5));
+        const CLength range(100, CLengthUnit::km());
+        gfs.fetchWeatherData(grid, range);
+        QTRY_COMPARE_WITH_TIMEOUT(finished.size(), 1, 10000);
+
+        const CWeatherGrid weather = gfs.getWeatherData();
+        QCOMPARE(weather.size(), 1);
+        QCOMPARE(qRound(weather.front().getPosition().latitude().value(CAngleUnit::deg()) * 10), 475);
+        QCOMPARE(qRound(weather.front().getPosition().longitude().value(CAngleUnit::deg()) * 10), 85);
+        QVERIFY(!weather.front().getTemperatureLayers().isEmpty());
+        QVERIFY(!cache.contains("2000010100", oldTile));
+
+        // a request while fetching is answered after the running one
+        gfs.fetchWeatherData(grid, range);
+        gfs.fetchWeatherData(grid, CLength(10, CLengthUnit::km()));
+        QTRY_COMPARE_WITH_TIMEOUT(finished.size(), 3, 10000);
+        QVERIFY(gfs.getWeatherData().isEmpty());
+    }
+} // ns
+
+//! main
+BLACKTEST_MAIN(BlackWxPluginGfsTest::CTestWeatherDataGfs);
+
+#include "testweatherdatagfs.moc"
+
+//! \endcond